@@ -14,6 +14,7 @@
 #include "actions/ferm/linop/asqtad_mdagm_s.h"
 #include "actions/ferm/linop/asqtad_linop_s.h"
 #include "actions/ferm/fermacts/asqtad_fermact_s.h"
+#include "actions/ferm/fermstates/stag_link_cache_s.h"
 #include "util/gauge/stag_phases_s.h"
 
 namespace Chroma 
@@ -129,9 +130,18 @@ namespace Chroma
       u_with_phases[i] *= StagPhases::alpha(i);
     }
 
-    // Make Fat7 and triple links
-    Fat7_Links(u_with_phases, u_fat, param.u0);
-    Triple_Links(u_with_phases, u_triple, param.u0);
+    // Make Fat7 and triple links, unless already made on this gauge field
+    std::ostringstream key;
+    key.precision(17);
+    key << AsqtadFermActEnv::name << " u0=" << toDouble(param.u0);
+
+    if (! StagLinkCacheEnv::lookup(key.str(), u_with_phases, u_fat, u_triple))
+    {
+      Fat7_Links(u_with_phases, u_fat, param.u0);
+      Triple_Links(u_with_phases, u_triple, param.u0);
+
+      StagLinkCacheEnv::insert(key.str(), u_with_phases, u_fat, u_triple);
+    }
 
     return new AsqtadConnectState(cfs->getFermBC(), u_with_phases, u_fat, u_triple);
   }
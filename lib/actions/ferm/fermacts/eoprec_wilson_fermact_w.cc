@@ -11,6 +11,7 @@
 
 #include "actions/ferm/invert/syssolver_linop_factory.h"
 #include "actions/ferm/invert/syssolver_mdagm_factory.h"
+#include "actions/ferm/invert/solver_perf.h"
 
 #include "actions/ferm/fermbcs/fermbcs_reader_w.h"
 
@@ -82,12 +83,15 @@ namespace Chroma
   {
     std::istringstream  is(invParam.xml);
     XMLReader  paramtop(is);
-	
-    return TheLinOpFermSystemSolverFactory::Instance().createObject(invParam.id,
-								    paramtop,
-								    invParam.path,
-								    state,
-								    linOp(state));
+
+    // Count the work of the solver
+    Handle< LinearOperator<T> > A(new TimedLinearOperator<T>(linOp(state)));
+    Handle< LinOpSystemSolver<T> > invA(TheLinOpFermSystemSolverFactory::Instance().createObject(invParam.id,
+												paramtop,
+												invParam.path,
+												state,
+												A));
+    return new TimedSystemSolver< T, LinOpSystemSolver<T> >(invA);
   }
 
 
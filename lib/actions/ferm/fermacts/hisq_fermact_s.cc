@@ -36,6 +36,7 @@ theory (one day).
 #include "actions/ferm/linop/asqtad_mdagm_s.h"
 #include "actions/ferm/linop/asqtad_linop_s.h"
 #include "actions/ferm/fermacts/hisq_fermact_s.h"
+#include "actions/ferm/fermstates/stag_link_cache_s.h"
 #include "util/gauge/stag_phases_s.h"
 #include "util/gauge/reunit.h"
 #include "util/gauge/sun_proj.h"
@@ -154,6 +155,14 @@ namespace Chroma
     u_with_phases = u_;
     getFermBC().modify(u_with_phases);
 
+    // The links only depend on the gauge field and epsilon
+    std::ostringstream key;
+    key.precision(17);
+    key << HisqFermActEnv::name << " epsilon=" << toDouble(param.epsilon);
+
+    if (StagLinkCacheEnv::lookup(key.str(), u_with_phases, u_fat, u_triple))
+      return new AsqtadConnectState(cfs->getFermBC(), u_with_phases, u_fat, u_triple);
+
 #if 0 
     // DEBUG DEBUG DEBUG DEBUG DEBUG DEBUG DEBUG DEBUG DEBUG 
     fat7_param pp ; 
@@ -228,6 +237,8 @@ namespace Chroma
 
     // ---------------------------------------------------
 
+    StagLinkCacheEnv::insert(key.str(), u_with_phases, u_fat, u_triple);
+
     return new AsqtadConnectState(cfs->getFermBC(), u_with_phases, u_fat, u_triple);
   }
 
@@ -20,6 +20,7 @@
 // Linops I can make
 #include "actions/ferm/linop/lovlapms_w.h"
 #include "actions/ferm/linop/lovlap_double_pass_w.h"
+#include "actions/ferm/linop/lovlap_mixed_prec_w.h"
 #include "actions/ferm/linop/lovddag_w.h"
 #include "actions/ferm/linop/lovddag_double_pass_w.h"
 #include "actions/ferm/linop/lg5eps_w.h"
@@ -125,6 +126,13 @@ namespace Chroma
 
       read(in, "InnerSolve/MaxCG", invParamInner.MaxCG);
       read(in, "InnerSolve/RsdCG", invParamInner.RsdCG);
+      if( in.count("InnerSolve/RsdCGSingle") == 1 ) {
+	read(in, "InnerSolve/RsdCGSingle", invParamInner.RsdCGSingle);
+      }
+      else {
+	// Only used by the MIXED_PREC inner solver
+	invParamInner.RsdCGSingle = 1.0e-5;
+      }
       if( in.count("InnerSolve/ReorthFreq") == 1 ) {
 	read(in, "InnerSolve/ReorthFreq", ReorthFreqInner);
       }
@@ -162,6 +170,8 @@ namespace Chroma
     push(xml_out, "InnerSolve");
     write(xml_out, "MaxCG", p.invParamInner.MaxCG);
     write(xml_out, "RsdCG", p.invParamInner.RsdCG);
+    if (p.inner_solver_type == OVERLAP_INNER_CG_MIXED_PREC)
+      write(xml_out, "RsdCGSingle", p.invParamInner.RsdCGSingle);
     write(xml_out, "ReorthFreq", p.ReorthFreqInner);
     write(xml_out, "SolverType", p.inner_solver_type);
     write(xml_out, "ApproximationType", p.approximation_type);
@@ -238,6 +248,20 @@ namespace Chroma
       // This should free things up at the end
       Handle<UnprecWilsonTypeFermAct<T,P,Q> >  S_w(S_aux);
       Mact = S_w;
+
+      // The mixed precision inner solver builds its own single
+      // precision kernel, which is only available for Wilson
+      if (params.inner_solver_type == OVERLAP_INNER_CG_MIXED_PREC)
+      {
+	if (auxfermact != "UNPREC_WILSON")
+	{
+	  QDPIO::cerr << OvlapPartFrac4DFermActEnv::name 
+		      << ": MIXED_PREC inner solver requires an UNPREC_WILSON auxiliary action" 
+		      << std::endl;
+	  QDP_abort(1);
+	}
+	kernel_param = WilsonFermActParams(fermacttop, fermact_path);
+      }
     }
     catch( const UnprecCastFailure& e) {
 
@@ -512,6 +536,9 @@ namespace Chroma
     case OVERLAP_INNER_CG_DOUBLE_PASS:
       QDPIO::cout << "Using Neuberger/Chu Double Pass Inner Solver" << std::endl;
       break;
+    case OVERLAP_INNER_CG_MIXED_PREC:
+      QDPIO::cout << "Using Mixed Precision Inner Solver" << std::endl;
+      break;
     default:
       QDPIO::cerr << "Unknown inner solver type " << std::endl;
       QDP_abort(1);
@@ -788,6 +815,9 @@ namespace Chroma
     case OVERLAP_INNER_CG_DOUBLE_PASS:
       QDPIO::cout << "Using Neuberger/Chu Double Pass Inner Solver" << std::endl;
       break;
+    case OVERLAP_INNER_CG_MIXED_PREC:
+      QDPIO::cout << "Using Mixed Precision Inner Solver" << std::endl;
+      break;
     default:
       QDPIO::cerr << "Unknown inner solver type " << std::endl;
       QDP_abort(1);
@@ -890,6 +920,14 @@ namespace Chroma
 				      params.invParamInner.RsdCG, 
 				      params.ReorthFreqInner);
 	break;
+      case OVERLAP_INNER_CG_MIXED_PREC:
+	return new lovlap_mixed_prec(*Mact, state_, kernel_param, m_q,
+				     numroot, coeffP, resP, rootQ, 
+				     NEig, EigValFunc, state.getEvectors(),
+				     params.invParamInner.MaxCG, 
+				     params.invParamInner.RsdCG, 
+				     params.invParamInner.RsdCGSingle);
+	break;
       default:
 	QDPIO::cerr << "Unknown OverlapInnerSolverType " << params.inner_solver_type << std::flush << std::endl;
 	QDP_abort(1);
@@ -964,6 +1002,13 @@ namespace Chroma
 				      NEig, EigValFunc, state.getEvectors(),
 				      params.invParamInner.MaxCG, params.invParamInner.RsdCG, params.ReorthFreqInner);
 	break;
+      case OVERLAP_INNER_CG_MIXED_PREC:
+	return new lovlap_mixed_prec(*Mact, state_, kernel_param, params.Mass,
+				     numroot, coeffP, resP, rootQ, 
+				     NEig, EigValFunc, state.getEvectors(),
+				     params.invParamInner.MaxCG, params.invParamInner.RsdCG, 
+				     params.invParamInner.RsdCGSingle);
+	break;
       default:
 	QDPIO::cerr << "Unknown OverlapInnerSolverType " << params.inner_solver_type << std::endl;
 	QDP_abort(1);
@@ -1026,6 +1071,8 @@ namespace Chroma
       /* Finally construct and pack the operator */
       /* This is the operator of the form (1/2)*[(1+mu) + (1-mu)*gamma_5*eps] */
       switch( params.inner_solver_type ) { 
+      case OVERLAP_INNER_CG_MIXED_PREC:
+        // No mixed precision variant here: use the single pass solver
       case OVERLAP_INNER_CG_SINGLE_PASS:
 	return new lg5eps(*Mact, state_,
 			  numroot, coeffP, resP, rootQ, 
@@ -1098,6 +1145,8 @@ namespace Chroma
     /* Finally construct and pack the operator */
     /* This is the operator of the form (1/2)*[(1+mu) + (1-mu)*gamma_5*eps] */
     switch( params.inner_solver_type ) { 
+    case OVERLAP_INNER_CG_MIXED_PREC:
+      // No mixed precision variant here: use the single pass solver
     case OVERLAP_INNER_CG_SINGLE_PASS:
       return new lg5eps(*Mact, state_,
 			numroot, coeffP, resP, rootQ, 
@@ -1188,6 +1237,8 @@ namespace Chroma
       // Finally construct and pack the operator 
       // This is the operator of the form (1/2)*[(1+mu) + (1-mu)*gamma_5*eps]
       switch( params.inner_solver_type ) { 
+      case OVERLAP_INNER_CG_MIXED_PREC:
+        // No mixed precision variant here: use the single pass solver
       case OVERLAP_INNER_CG_SINGLE_PASS:
 	return new lovddag(*Mact, state_, params.Mass,
 			   numroot, coeffP, resP, rootQ, 
@@ -1259,6 +1310,8 @@ namespace Chroma
       // Finally construct and pack the operator 
       // This is the operator of the form (1/2)*[(1+mu) + (1-mu)*gamma_5*eps]
       switch( params.inner_solver_type ) { 
+      case OVERLAP_INNER_CG_MIXED_PREC:
+        // No mixed precision variant here: use the single pass solver
       case OVERLAP_INNER_CG_SINGLE_PASS:
 	return new lovddag(*Mact, state_, params.Mass,
 			   numroot, coeffP, resP, rootQ, 
@@ -9,6 +9,7 @@
 
 #include "actions/ferm/fermacts/overlap_fermact_base_w.h"
 #include "actions/ferm/fermstates/eigen_state.h"
+#include "actions/ferm/fermacts/wilson_fermact_params_w.h"
 #include "meas/eig/eig_w.h"
 // #include "io/overlap_state_info.h"
 #include "io/enum_io/enum_io.h"
@@ -46,6 +47,7 @@ namespace Chroma
     struct InvParamInner
     {
       Real RsdCG;
+      Real RsdCGSingle;   // target of the single precision solves in MIXED_PREC
       int  MaxCG;
     } invParamInner;
     OverlapInnerSolverType inner_solver_type;
@@ -196,6 +198,8 @@ namespace Chroma
     Handle< CreateFermState<T,P,Q> >  cfs;   // fermion state creator
     // Auxilliary action used for kernel of operator
     Handle< UnprecWilsonTypeFermAct<T,P,Q> > Mact;   
+    // Kernel params, only filled for the mixed precision inner solver
+    WilsonFermActParams kernel_param;
     OvlapPartFrac4DFermActParams params;
   };
 
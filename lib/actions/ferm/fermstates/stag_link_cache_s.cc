@@ -0,0 +1,122 @@
+/*! \file
+ *  \brief Cache of staggered fat and long links keyed by the gauge field
+ */
+
+#include "actions/ferm/fermstates/stag_link_cache_s.h"
+
+namespace Chroma 
+{ 
+
+  namespace StagLinkCacheEnv
+  {
+    namespace
+    {
+      //! Tag of the open scope, empty if none
+      std::string                  cur_tag;
+
+      //! The last links saved
+      bool                         validP = false;
+      std::string                  entry_tag;
+      std::string                  entry_key;
+      multi1d<LatticeColorMatrix>  entry_u;
+      multi1d<LatticeColorMatrix>  entry_fat;
+      multi1d<LatticeColorMatrix>  entry_triple;
+    }
+
+
+    // Turn the cache on for one gauge field
+    GaugeScope::GaugeScope(const std::string& tag)
+    {
+      if (tag.empty())
+      {
+	QDPIO::cerr << "StagLinkCache: empty gauge field tag" << std::endl;
+	QDP_abort(1);
+      }
+
+      // Links of another gauge field are of no more use
+      if (tag != entry_tag)
+	clear();
+
+      cur_tag = tag;
+    }
+
+
+    // Turn the cache off again
+    GaugeScope::~GaugeScope()
+    {
+      cur_tag = "";
+    }
+
+
+    //! Find the links for this key in the current scope, if present
+    bool lookup(const std::string& key,
+		const multi1d<LatticeColorMatrix>& u,
+		multi1d<LatticeColorMatrix>& u_fat,
+		multi1d<LatticeColorMatrix>& u_triple)
+    {
+      if (cur_tag.empty() || ! validP || entry_tag != cur_tag || entry_key != key)
+	return false;
+
+      START_CODE();
+
+      // Same boundary conditions
+      if (u.size() != entry_u.size())
+      {
+	END_CODE();
+	return false;
+      }
+
+      for(int mu=0; mu < u.size(); ++mu)
+      {
+	if (toDouble(norm2(u[mu] - entry_u[mu])) != 0.0)
+	{
+	  END_CODE();
+	  return false;
+	}
+      }
+
+      u_fat    = entry_fat;
+      u_triple = entry_triple;
+
+      QDPIO::cout << "StagLinkCache: reusing links for " << key << std::endl;
+
+      END_CODE();
+      return true;
+    }
+
+
+    //! Save the links for this key in the current scope, if any
+    void insert(const std::string& key,
+		const multi1d<LatticeColorMatrix>& u,
+		const multi1d<LatticeColorMatrix>& u_fat,
+		const multi1d<LatticeColorMatrix>& u_triple)
+    {
+      if (cur_tag.empty())
+	return;
+
+      START_CODE();
+
+      entry_tag    = cur_tag;
+      entry_key    = key;
+      entry_u      = u;
+      entry_fat    = u_fat;
+      entry_triple = u_triple;
+      validP       = true;
+
+      END_CODE();
+    }
+
+
+    //! Drop all the entries
+    void clear()
+    {
+      validP = false;
+      entry_tag = "";
+      entry_key = "";
+      entry_u.resize(0);
+      entry_fat.resize(0);
+      entry_triple.resize(0);
+    }
+  }
+
+} // End Namespace Chroma
@@ -0,0 +1,68 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Cache of staggered fat and long links keyed by the gauge field
+ */
+
+#ifndef __stag_link_cache_s_h__
+#define __stag_link_cache_s_h__
+
+#include "chromabase.h"
+
+namespace Chroma 
+{ 
+  //! Cache of smeared staggered links
+  /*! 
+   * \ingroup fermstates
+   *
+   * Several staggered actions are often created on the same gauge
+   * field, e.g. one per mass in a spectrum run. The fat and long
+   * (triple/Naik) links only depend on the gauge field and the link
+   * coefficients, so they can be kept here and handed back instead of
+   * being smeared again.
+   *
+   * The cache is off unless a caller opens a GaugeScope with a tag that
+   * identifies the gauge field, e.g. its named object id and creation
+   * number. Within the scope the actions look up and save their links
+   * under the tag and a key built from their link parameters. The links
+   * with the boundary conditions applied are compared exactly, since the
+   * key does not describe those. Only the last links are kept, and they
+   * are dropped when a scope with another tag is opened. Outside a
+   * scope, e.g. in HMC where the field changes at every step, nothing is
+   * computed or kept.
+   */
+  namespace StagLinkCacheEnv
+  {
+    //! Turn the cache on for one gauge field
+    class GaugeScope
+    {
+    public:
+      //! Tag must identify the gauge field and be the same on all nodes
+      GaugeScope(const std::string& tag);
+
+      //! Turn the cache off again
+      ~GaugeScope();
+
+    private:
+      GaugeScope(const GaugeScope&);
+      void operator=(const GaugeScope&);
+    };
+
+    //! Find the links for this key in the current scope, if present
+    bool lookup(const std::string& key,
+		const multi1d<LatticeColorMatrix>& u,
+		multi1d<LatticeColorMatrix>& u_fat,
+		multi1d<LatticeColorMatrix>& u_triple);
+
+    //! Save the links for this key in the current scope, if any
+    void insert(const std::string& key,
+		const multi1d<LatticeColorMatrix>& u,
+		const multi1d<LatticeColorMatrix>& u_fat,
+		const multi1d<LatticeColorMatrix>& u_triple);
+
+    //! Drop all the entries
+    void clear();
+  }
+
+} // End Namespace Chroma
+
+#endif
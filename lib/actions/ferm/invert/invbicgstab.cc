@@ -4,6 +4,7 @@
 
 #include "chromabase.h"
 #include "actions/ferm/invert/invbicgstab.h"
+#include "actions/ferm/invert/solver_perf.h"
 
 namespace Chroma {
 
@@ -22,7 +23,12 @@ InvBiCGStab_a(const LinearOperator<T>& A,
   FlopCounter flopcount;
   flopcount.reset();
   const Subset& s = A.subset();
-  bool convP = false;	
+  bool convP = false;
+
+  // Site flops and bytes of one vector for the solver counters
+  const double vsites = s.numSiteTable();
+  const double vbytes = SolverPerfEnv::vectorBytes<T>(s, 1);
+	
 	ret.n_count = MaxBiCGStab;
 	
   swatch.reset();
@@ -74,7 +80,10 @@ InvBiCGStab_a(const LinearOperator<T>& A,
   for(int k = 1; k <= MaxBiCGStab && !convP ; k++) { 
     
     // rho_{k+1} = < r_0 | r >
-    rho = innerProduct(r0,r,s);
+    {
+      SolverPerfTimer tm(SolverPerfEnv::REDUCE, 8*Nc*Ns*vsites, 2*vbytes);
+      rho = innerProduct(r0,r,s);
+    }
 
 
     if( toBool( real(rho) == 0 ) && toBool( imag(rho) == 0 ) ) {
@@ -93,8 +102,11 @@ InvBiCGStab_a(const LinearOperator<T>& A,
     // then do p = r + beta tmp
     CR omega_r = omega;
     CR beta_r = beta;
-    tmp[s] = p - omega_r*v;
-    p[s] = r + beta_r*tmp;
+    {
+      SolverPerfTimer tm(SolverPerfEnv::BLAS, 16*Nc*Ns*vsites, 6*vbytes);
+      tmp[s] = p - omega_r*v;
+      p[s] = r + beta_r*tmp;
+    }
 
 
     // v = Ap
@@ -103,7 +115,11 @@ InvBiCGStab_a(const LinearOperator<T>& A,
 
     // alpha = rho_{k+1} / < r_0 | v >
     // put <r_0 | v > into tmp
-    DComplex ctmp = innerProduct(r0,v,s);
+    DComplex ctmp;
+    {
+      SolverPerfTimer tm(SolverPerfEnv::REDUCE, 8*Nc*Ns*vsites, 2*vbytes);
+      ctmp = innerProduct(r0,v,s);
+    }
 
 
     if( toBool( real(ctmp) == 0 ) && toBool( imag(ctmp) == 0 ) ) {
@@ -119,7 +135,10 @@ InvBiCGStab_a(const LinearOperator<T>& A,
     // s = r - alpha v
     // I can overlap s with r, because I recompute it at the end.
     CR alpha_r = alpha;
-    r[s]  -=  alpha_r*v;
+    {
+      SolverPerfTimer tm(SolverPerfEnv::BLAS, 8*Nc*Ns*vsites, 3*vbytes);
+      r[s]  -=  alpha_r*v;
+    }
 
 
     // t = As  = Ar 
@@ -127,7 +146,11 @@ InvBiCGStab_a(const LinearOperator<T>& A,
     // omega = < t | s > / < t | t > = < t | r > / norm2(t);
 
     // This does the full 5D norm
-    Double t_norm = norm2(t,s);
+    Double t_norm;
+    {
+      SolverPerfTimer tm(SolverPerfEnv::REDUCE, 4*Nc*Ns*vsites, vbytes);
+      t_norm = norm2(t,s);
+    }
 
 
     if( toBool(t_norm == 0) ) { 
@@ -136,7 +159,10 @@ InvBiCGStab_a(const LinearOperator<T>& A,
     }
 
     // accumulate <t | s > = <t | r> into omega
-    omega = innerProduct(t,r,s);
+    {
+      SolverPerfTimer tm(SolverPerfEnv::REDUCE, 8*Nc*Ns*vsites, 2*vbytes);
+      omega = innerProduct(t,r,s);
+    }
     omega /= t_norm;
 
     // psi = psi + omega s + alpha p 
@@ -146,18 +172,28 @@ InvBiCGStab_a(const LinearOperator<T>& A,
     // then add in the alpha p
     omega_r = omega;
     alpha_r = alpha;
-    tmp[s] = psi + omega_r*r;   
-    psi[s] = tmp + alpha_r*p;
+    {
+      SolverPerfTimer tm(SolverPerfEnv::BLAS, 16*Nc*Ns*vsites, 6*vbytes);
+      tmp[s] = psi + omega_r*r;   
+      psi[s] = tmp + alpha_r*p;
+    }
 
 
 
     // r = s - omega t = r - omega t1G
 
     
-    r[s] -= omega_r*t;
+    {
+      SolverPerfTimer tm(SolverPerfEnv::BLAS, 8*Nc*Ns*vsites, 3*vbytes);
+      r[s] -= omega_r*t;
+    }
 
 
-    Double r_norm = norm2(r,s);
+    Double r_norm;
+    {
+      SolverPerfTimer tm(SolverPerfEnv::REDUCE, 4*Nc*Ns*vsites, vbytes);
+      r_norm = norm2(r,s);
+    }
 
 
     //    QDPIO::cout << "Iteration " << k << " : r = " << r_norm << std::endl;
@@ -4,6 +4,7 @@
 
 #include "chromabase.h"
 #include "actions/ferm/invert/invcg2.h"
+#include "actions/ferm/invert/solver_perf.h"
 
 using namespace QDP::Hints;
 #undef PAT
@@ -89,6 +90,10 @@ namespace Chroma
 
     chi_internal[s] = chi;
 
+    // Site flops and bytes of one vector for the solver counters
+    const double vsites = s.numSiteTable();
+    const double vbytes = SolverPerfEnv::vectorBytes<T>(s, 1);
+
     QDPIO::cout << "InvCG2: starting" << std::endl;
     FlopCounter flopcount;
     flopcount.reset();
@@ -162,7 +167,11 @@ namespace Chroma
       M(mp, p, PLUS);  flopcount.addFlops(M.nFlops());
 
       //  d = | mp | ** 2
-      d = norm2(mp, s);  flopcount.addSiteFlops(4*Nc*Ns,s);
+      {
+	SolverPerfTimer t(SolverPerfEnv::REDUCE, 4*Nc*Ns*vsites, vbytes);
+	d = norm2(mp, s);
+      }
+      flopcount.addSiteFlops(4*Nc*Ns,s);
 
       //  r[k] -= a[k] A . p[k] ;
       //      	       +            +
@@ -175,14 +184,25 @@ namespace Chroma
 
       RT ar = a;
 
-      r[s] -= ar * mmp;
+      {
+	SolverPerfTimer t(SolverPerfEnv::BLAS, 4*Nc*Ns*vsites, 3*vbytes);
+	r[s] -= ar * mmp;
+      }
       flopcount.addSiteFlops(4*Nc*Ns, s);
 
       //  cp  =  | r[k] |**2
-      cp = norm2(r, s);    flopcount.addSiteFlops(4*Nc*Ns,s);
+      {
+	SolverPerfTimer t(SolverPerfEnv::REDUCE, 4*Nc*Ns*vsites, vbytes);
+	cp = norm2(r, s);
+      }
+      flopcount.addSiteFlops(4*Nc*Ns,s);
 
       //  Psi[k] += a[k] p[k]
-      psi[s] += ar * p;    flopcount.addSiteFlops(4*Nc*Ns,s);
+      {
+	SolverPerfTimer t(SolverPerfEnv::BLAS, 4*Nc*Ns*vsites, 3*vbytes);
+	psi[s] += ar * p;
+      }
+      flopcount.addSiteFlops(4*Nc*Ns,s);
 
 
 
@@ -217,7 +237,11 @@ namespace Chroma
       RT br = b;
 
       //  p[k+1] := r[k] + b[k+1] p[k]
-      p[s] = r + br*p;    flopcount.addSiteFlops(4*Nc*Ns,s);
+      {
+	SolverPerfTimer t(SolverPerfEnv::BLAS, 4*Nc*Ns*vsites, 3*vbytes);
+	p[s] = r + br*p;
+      }
+      flopcount.addSiteFlops(4*Nc*Ns,s);
     }
     res.n_count = MaxCG;
     res.resid   = sqrt(cp);
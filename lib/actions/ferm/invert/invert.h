@@ -28,6 +28,7 @@
 #include "minvsumr.h"
 #include "invbicgstab.h"
 #include "invbicgstab_array.h"
+#include "solver_perf.h"
 
 #endif
 
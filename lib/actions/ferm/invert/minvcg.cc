@@ -416,6 +416,22 @@ namespace Chroma
   }
 
 
+#if BASE_PRECISION == 64
+  /*! \ingroup invert */
+  template<>
+  void MInvCG(const LinearOperator<LatticeFermionF>& M,
+	      const LatticeFermionF& chi, 
+	      multi1d<LatticeFermionF>& psi, 
+	      const multi1d<Real>& shifts,
+	      const multi1d<Real>& RsdCG, 
+	      int MaxCG,
+	      int &n_count)
+  {
+    MInvCG_a(M, chi, psi, shifts, RsdCG, MaxCG, n_count);
+  }
+#endif
+
+
   /*! \ingroup invert */
   template<>
   void MInvCG(const DiffLinearOperator<LatticeFermion,
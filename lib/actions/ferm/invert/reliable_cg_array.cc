@@ -0,0 +1,218 @@
+/*! \file
+ *  \brief Mixed precision Conjugate-Gradient with reliable updates for 5D operators
+ */
+
+#include "chromabase.h"
+#include "actions/ferm/invert/reliable_cg_array.h"
+
+namespace Chroma 
+{
+
+  //! The 5D version of RelInvCG_a (see reliable_cg.cc)
+  template<typename T, typename TF, typename RF>
+  SystemSolverResults_t
+  RelInvCGArray_a(const LinearOperatorArray<T>& A,
+		  const LinearOperatorArray<TF>& AF,
+		  const multi1d<T>& chi,
+		  multi1d<T>& psi,
+		  const Real& RsdCG,
+		  const Real& Delta,
+		  int MaxCG)
+  {
+    START_CODE();
+    SystemSolverResults_t ret;
+
+    const Subset& s = A.subset();
+    const int N = A.size();
+
+    if (AF.size() != N)
+    {
+      QDPIO::cerr << __func__ << ": single precision operator has N5 = " << AF.size()
+		  << " but the operator has N5 = " << N << std::endl;
+      QDP_abort(1);
+    }
+
+    bool convP = false;
+
+    multi1d<TF> r(N);
+    multi1d<T>  b(N); 
+    multi1d<T>  r_dble(N);
+    multi1d<T>  x_dble(N);
+    int k;
+
+    StopWatch swatch;
+    FlopCounter flopcount;
+    flopcount.reset();
+    swatch.reset();
+    swatch.start();
+
+    for(int n=0; n < N; ++n)
+      b[n][s] = chi[n];
+
+    Double chi_norm = norm2(chi,s);
+    Double rsd_sq = RsdCG*RsdCG*chi_norm;
+
+    // b = chi - A^dag A psi
+    {
+      multi1d<T> tmp1(N), tmp2(N);
+      A(tmp1, psi, PLUS);
+      A(tmp2, tmp1, MINUS);
+      for(int n=0; n < N; ++n)
+	b[n][s] -= tmp2[n];
+      flopcount.addFlops(2*A.nFlops());
+      flopcount.addSiteFlops(2*Nc*Ns*N,s);
+    }
+
+    multi1d<TF> x(N);
+    for(int n=0; n < N; ++n)
+    {
+      x[n][s] = zero;
+      r[n][s] = b[n];
+    }
+
+    Double r_sq = norm2(r,s);
+    flopcount.addSiteFlops(4*Nc*Ns*N,s);
+
+    QDPIO::cout << "Reliable CG Array: || r0 ||/|| b ||=" << sqrt(r_sq/chi_norm) << std::endl;
+
+    Double rNorm = sqrt(r_sq);
+    Double r0Norm = rNorm;
+    Double maxrx = rNorm;
+    Double maxrr = rNorm;
+    bool updateR = false;
+    bool updateX = false;
+
+    multi1d<TF> p(N);
+    multi1d<TF> mp(N), mmp(N);
+    Double a, c, d;
+
+    // The iterations 
+    for(k = 0; k < MaxCG && !convP; k++) 
+    { 
+      if( k == 0 ) { 
+	for(int n=0; n < N; ++n)
+	  p[n][s] = r[n];
+      }
+      else { 
+	Double beta = r_sq / c;
+	RF br = beta;
+	for(int n=0; n < N; ++n)
+	  p[n][s] = r[n] + br*p[n];
+	flopcount.addSiteFlops(4*Nc*Ns*N,s);
+      }
+
+      c = r_sq;
+
+      AF(mp, p, PLUS); 
+      d = norm2(mp,s); 
+      AF(mmp, mp, MINUS); 
+
+      a = c/d;
+      RF ar = a;
+      for(int n=0; n < N; ++n)
+      {
+	x[n][s] += ar*p[n];  
+	r[n][s] -= ar*mmp[n]; 
+      }
+
+      r_sq = norm2(r,s); 
+
+      flopcount.addSiteFlops(16*Nc*Ns*N,s);
+      flopcount.addFlops(2*A.nFlops());
+
+      // Reliable update part...
+      rNorm = sqrt(r_sq);
+      if( toBool( rNorm > maxrx) ) maxrx = rNorm;
+      if( toBool( rNorm > maxrr) ) maxrr = rNorm;
+      
+      updateX = toBool ( rNorm < Delta*r0Norm && r0Norm <= maxrx );
+      updateR = toBool ( rNorm < Delta*maxrr && r0Norm <= maxrr ) || updateX;
+
+      // Do the R update with the real base precision residual
+      if( updateR ) 
+      { 
+	{
+	  multi1d<T> tmp1(N), tmp2(N);
+	  for(int n=0; n < N; ++n)
+	    x_dble[n][s] = x[n];
+	  
+	  A(tmp1, x_dble, PLUS);  // Use full solution so far
+	  A(tmp2, tmp1, MINUS);
+
+	  for(int n=0; n < N; ++n)
+	    r_dble[n][s] = b[n] - tmp2[n];
+	}
+
+	for(int n=0; n < N; ++n)
+	  r[n][s] = r_dble[n];   // new R = b - Ax
+	r_sq = norm2(r_dble,s);
+
+	flopcount.addSiteFlops(6*Nc*Ns*N,s);
+	flopcount.addFlops(2*A.nFlops());
+
+	rNorm = sqrt(r_sq);
+	maxrr = rNorm;
+	
+	// Group wise x update
+	if( updateX ) 
+	{ 
+	  for(int n=0; n < N; ++n)
+	  {
+	    psi[n][s] += x_dble[n];  // Add on group accumulated solution
+	    x[n][s] = zero;
+	    b[n][s] = r_dble[n];
+	  }
+	  flopcount.addSiteFlops(2*Nc*Ns*N,s);
+
+	  r0Norm = rNorm;
+	  maxrx = rNorm;
+	}
+      }
+
+      // Convergence check
+      if( toBool(r_sq < rsd_sq ) ) 
+      {
+	for(int n=0; n < N; ++n)
+	{
+	  x_dble[n][s] = x[n];
+	  psi[n][s] += x_dble[n];
+	}
+	flopcount.addSiteFlops(2*Nc*Ns*N,s);
+	ret.resid = rNorm;
+	ret.n_count = k;
+	convP = true;
+      }
+      else { 
+	convP = false;
+      }
+    }
+
+    // Loop is finished. Report FLOP Count...
+    swatch.stop();
+    flopcount.report("reliable_invcg2_array", swatch.getTimeInSeconds());
+
+    // Check for nonconvergence
+    if( k >= MaxCG ) { 
+      QDPIO::cout << "Nonconvergence: Reliable CG Array Failed to converge in " << MaxCG << " iterations " << std::endl;
+      QDP_abort(1);
+    }
+
+    END_CODE();
+    return ret;
+  }
+
+
+  // single inner, base precision outer
+  SystemSolverResults_t
+  InvCGReliableArray(const LinearOperatorArray<LatticeFermion>& A,
+		     const LinearOperatorArray<LatticeFermionF>& AF,
+		     const multi1d<LatticeFermion>& chi,
+		     multi1d<LatticeFermion>& psi,
+		     const Real& RsdCG, 
+		     const Real& Delta,
+		     int MaxCG)
+  {
+    return RelInvCGArray_a<LatticeFermion, LatticeFermionF, RealF>(A, AF, chi, psi, RsdCG, Delta, MaxCG);
+  }
+
+}  // end namespace Chroma
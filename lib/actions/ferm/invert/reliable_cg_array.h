@@ -0,0 +1,38 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Mixed precision Conjugate-Gradient with reliable updates for 5D operators
+ */
+
+#ifndef __reliable_cg_array_h__
+#define __reliable_cg_array_h__
+
+#include "linearop.h"
+#include "syssolver.h"
+
+namespace Chroma 
+{
+
+  //! Conjugate-Gradient with reliable updates on the normal equations of a 5D operator
+  /*! \ingroup invert
+   *
+   * Solves  A^dag A psi = chi  with the iterations done using the
+   * single precision operator AF, while the true residual is recomputed
+   * with the base precision operator A whenever the iterated residual
+   * has dropped by a factor Delta.
+   *
+   * @{
+   */
+  SystemSolverResults_t
+  InvCGReliableArray(const LinearOperatorArray<LatticeFermion>& A,
+		     const LinearOperatorArray<LatticeFermionF>& AF,
+		     const multi1d<LatticeFermion>& chi,
+		     multi1d<LatticeFermion>& psi,
+		     const Real& RsdCG, 
+		     const Real& Delta,
+		     int MaxCG);
+
+  /*! @} */  // end of group invert
+	    
+}  // end namespace Chroma
+
+#endif
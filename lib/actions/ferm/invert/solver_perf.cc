@@ -0,0 +1,203 @@
+/*! \file
+ *  \brief Performance counters of the linear system solvers
+ */
+
+#include "actions/ferm/invert/solver_perf.h"
+
+#include <vector>
+
+namespace Chroma
+{
+
+  // Write the performance counters of a solve
+  void write(XMLWriter& xml, const std::string& path, const SolverPerf_t& perf)
+  {
+    push(xml, path);
+
+    write(xml, "secs", perf.secs);
+    write(xml, "gflops", perf.gflops());
+    if (perf.peak_gflops > 0)
+      write(xml, "percent_peak", perf.percentPeak());
+
+    push(xml, "LinOp");
+    write(xml, "n_apply", perf.n_linop);
+    write(xml, "flops", perf.linop_flops);
+    write(xml, "bytes", perf.linop_bytes);
+    write(xml, "secs", perf.linop_secs);
+    write(xml, "secs_max", perf.linop_secs_max);
+    pop(xml);
+
+    push(xml, "Blas");
+    write(xml, "flops", perf.blas_flops);
+    write(xml, "bytes", perf.blas_bytes);
+    write(xml, "secs", perf.blas_secs);
+    pop(xml);
+
+    push(xml, "Reduce");
+    write(xml, "n_reduce", perf.n_reduce);
+    write(xml, "flops", perf.reduce_flops);
+    write(xml, "bytes", perf.reduce_bytes);
+    write(xml, "secs", perf.reduce_secs);
+    pop(xml);
+
+    pop(xml);
+  }
+
+
+  namespace SolverPerfEnv
+  {
+    //! Anonymous namespace
+    namespace
+    {
+      //! The counters of an open solve on this node
+      struct Counts
+      {
+	Counts() : n_linop(0), n_reduce(0)
+	{
+	  for(int i=0; i < 3; ++i)
+	    flops[i] = bytes[i] = secs[i] = 0;
+	}
+
+	int     n_linop;
+	int     n_reduce;
+	double  flops[3];
+	double  bytes[3];
+	double  secs[3];
+	StopWatch swatch;
+      };
+
+      //! The open solves, innermost last
+      std::vector<Counts> open_solves;
+
+      //! Peak GFLOP/s of one node
+      double peak_gflops = 0;
+    }
+
+
+    // Open a solve
+    void begin()
+    {
+      open_solves.push_back(Counts());
+      open_solves.back().swatch.start();
+    }
+
+
+    // Close the innermost solve and return its counters
+    SolverPerf_t end()
+    {
+      SolverPerf_t perf;
+
+      if (open_solves.empty())
+      {
+	QDPIO::cerr << "SolverPerfEnv::" << __func__ << ": no open solve" << std::endl;
+	QDP_abort(1);
+      }
+
+      Counts c = open_solves.back();
+      open_solves.pop_back();
+      c.swatch.stop();
+
+      // Nested solves, e.g. preconditioners, count in the enclosing one too
+      if (! open_solves.empty())
+      {
+	Counts& outer = open_solves.back();
+	outer.n_linop  += c.n_linop;
+	outer.n_reduce += c.n_reduce;
+	for(int i=0; i < 3; ++i)
+	{
+	  outer.flops[i] += c.flops[i];
+	  outer.bytes[i] += c.bytes[i];
+	  outer.secs[i]  += c.secs[i];
+	}
+      }
+
+      // Sum the work over the nodes and average the times
+      const int nodes = Layout::numNodes();
+
+      double sums[10];
+      for(int i=0; i < 3; ++i)
+      {
+	sums[3*i+0] = c.flops[i];
+	sums[3*i+1] = c.bytes[i];
+	sums[3*i+2] = c.secs[i];
+      }
+      sums[9] = c.swatch.getTimeInSeconds();
+      QDPInternal::globalSumArray(sums, 10);
+
+      // The operator time of every node, to find the slowest one
+      std::vector<double> node_secs(nodes, 0.0);
+      node_secs[Layout::nodeNumber()] = c.secs[LINOP];
+      QDPInternal::globalSumArray(&node_secs[0], nodes);
+
+      perf.n_linop        = c.n_linop;
+      perf.n_reduce       = c.n_reduce;
+      perf.linop_flops    = sums[0];
+      perf.linop_bytes    = sums[1];
+      perf.linop_secs     = sums[2] / nodes;
+      perf.blas_flops     = sums[3];
+      perf.blas_bytes     = sums[4];
+      perf.blas_secs      = sums[5] / nodes;
+      perf.reduce_flops   = sums[6];
+      perf.reduce_bytes   = sums[7];
+      perf.reduce_secs    = sums[8] / nodes;
+      perf.secs           = sums[9] / nodes;
+      perf.peak_gflops    = peak_gflops * nodes;
+
+      for(int n=0; n < nodes; ++n)
+	if (node_secs[n] > perf.linop_secs_max)
+	  perf.linop_secs_max = node_secs[n];
+
+      QDPIO::cout << "SOLVER_PERF: n_linop= " << perf.n_linop
+		  << "  secs= " << perf.secs
+		  << "  GFLOP/s= " << perf.gflops();
+      if (perf.peak_gflops > 0)
+	QDPIO::cout << "  peak%= " << perf.percentPeak();
+      QDPIO::cout << "  linop/blas/reduce secs= " << perf.linop_secs
+		  << " / " << perf.blas_secs
+		  << " / " << perf.reduce_secs
+		  << "  linop max node secs= " << perf.linop_secs_max << std::endl;
+
+      return perf;
+    }
+
+
+    // Is a solve open?
+    bool active()
+    {
+      return ! open_solves.empty();
+    }
+
+
+    // Add work to the innermost open solve
+    void add(Kind kind, double flops, double bytes, double secs)
+    {
+      if (open_solves.empty())
+	return;
+
+      Counts& c = open_solves.back();
+      c.flops[kind] += flops;
+      c.bytes[kind] += bytes;
+      c.secs[kind]  += secs;
+
+      if (kind == LINOP)
+	++c.n_linop;
+      else if (kind == REDUCE)
+	++c.n_reduce;
+    }
+
+
+    // Peak GFLOP/s of one node
+    double peakGFlops()
+    {
+      return peak_gflops;
+    }
+
+
+    // Set the peak GFLOP/s of one node
+    void setPeakGFlops(double peak)
+    {
+      peak_gflops = peak;
+    }
+  }
+
+}  // end namespace Chroma
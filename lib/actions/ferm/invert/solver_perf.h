@@ -0,0 +1,242 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Performance counters of the linear system solvers
+ */
+
+#ifndef __solver_perf_h__
+#define __solver_perf_h__
+
+#include "chromabase.h"
+#include "linearop.h"
+#include "handle.h"
+#include "syssolver.h"
+#include "util/info/region_profiler.h"
+
+namespace Chroma
+{
+
+  //! Write the performance counters of a solve
+  /*! \ingroup invert */
+  void write(XMLWriter& xml, const std::string& path, const SolverPerf_t& perf);
+
+
+  //! Accumulation of the solver performance counters
+  /*! \ingroup invert
+   *
+   * A solve is bracketed by begin() and end(). In between, the timed
+   * linear operators and the SolverPerfTimer scopes in the solvers add
+   * their flops, bytes and time to the counters of the innermost open
+   * solve. Nothing is counted when no solve is open, so the operators
+   * and kernels cost only a flag test outside a solve.
+   *
+   * The counters are node local until end(), which sums the flops and
+   * bytes over the nodes and averages the times.
+   */
+  namespace SolverPerfEnv
+  {
+    //! The kinds of work counted
+    enum Kind {LINOP, BLAS, REDUCE};
+
+    //! Open a solve
+    void begin();
+
+    //! Close the innermost solve and return its counters
+    SolverPerf_t end();
+
+    //! Is a solve open?
+    bool active();
+
+    //! Add work to the innermost open solve
+    void add(Kind kind, double flops, double bytes, double secs);
+
+    //! Peak GFLOP/s of one node, 0 if not known
+    double peakGFlops();
+
+    //! Set the peak GFLOP/s of one node
+    void setPeakGFlops(double peak);
+
+    //! Bytes of nvec vectors of T on a subset of this node
+    template<typename T>
+    inline double vectorBytes(const Subset& s, int nvec)
+    {
+      return double(nvec) * sizeof(typename T::Subtype_t) * s.numSiteTable();
+    }
+  }
+
+
+  //! Times a scope and adds it to the open solve
+  /*! \ingroup invert
+   *
+   * Usage:
+   *
+   *   {
+   *     SolverPerfTimer t(SolverPerfEnv::REDUCE, 4*Nc*Ns*s.numSiteTable(),
+   *                       SolverPerfEnv::vectorBytes<T>(s, 1));
+   *     cp = norm2(r, s);
+   *   }
+   */
+  class SolverPerfTimer
+  {
+  public:
+    //! Start timing the work, flops and bytes on this node
+    SolverPerfTimer(SolverPerfEnv::Kind kind_, double flops_, double bytes_) :
+      kind(kind_), flops(flops_), bytes(bytes_), on(SolverPerfEnv::active())
+    {
+      if (on)
+	swatch.start();
+    }
+
+    //! Add the work to the open solve
+    ~SolverPerfTimer()
+    {
+      if (on)
+      {
+	swatch.stop();
+	SolverPerfEnv::add(kind, flops, bytes, swatch.getTimeInSeconds());
+      }
+    }
+
+  private:
+    SolverPerfEnv::Kind kind;
+    double flops;
+    double bytes;
+    bool on;
+    StopWatch swatch;
+  };
+
+
+  //! Linear operator whose applications are counted
+  /*! \ingroup invert
+   *
+   * The flops are nFlops() of the operator. The bytes are only the
+   * source and destination vectors, a lower bound of the traffic since
+   * the operator does not say what else it reads.
+   */
+  template<typename T>
+  class TimedLinearOperator : public LinearOperator<T>
+  {
+  public:
+    //! Wrap an operator
+    TimedLinearOperator(Handle< LinearOperator<T> > A_) : A(A_) {}
+
+    //! Apply the operator
+    void operator() (T& chi, const T& psi, enum PlusMinus isign) const
+    {
+      SolverPerfTimer t(SolverPerfEnv::LINOP, A->nFlops(),
+			SolverPerfEnv::vectorBytes<T>(A->subset(), 2));
+      (*A)(chi, psi, isign);
+    }
+
+    //! Apply the operator with a precision hint
+    void operator() (T& chi, const T& psi, enum PlusMinus isign, Real epsilon) const
+    {
+      SolverPerfTimer t(SolverPerfEnv::LINOP, A->nFlops(),
+			SolverPerfEnv::vectorBytes<T>(A->subset(), 2));
+      (*A)(chi, psi, isign, epsilon);
+    }
+
+    const Subset& subset() const {return A->subset();}
+
+    unsigned long nFlops() const {return A->nFlops();}
+
+  private:
+    Handle< LinearOperator<T> > A;
+  };
+
+
+  //! Linear operator on arrays whose applications are counted
+  /*! \ingroup invert */
+  template<typename T>
+  class TimedLinearOperatorArray : public LinearOperatorArray<T>
+  {
+  public:
+    //! Wrap an operator
+    TimedLinearOperatorArray(Handle< LinearOperatorArray<T> > A_) : A(A_) {}
+
+    int size() const {return A->size();}
+
+    //! Apply the operator
+    void operator() (multi1d<T>& chi, const multi1d<T>& psi, enum PlusMinus isign) const
+    {
+      SolverPerfTimer t(SolverPerfEnv::LINOP, A->nFlops(),
+			SolverPerfEnv::vectorBytes<T>(A->subset(), 2*A->size()));
+      (*A)(chi, psi, isign);
+    }
+
+    //! Apply the operator with a precision hint
+    void operator() (multi1d<T>& chi, const multi1d<T>& psi, enum PlusMinus isign, Real epsilon) const
+    {
+      SolverPerfTimer t(SolverPerfEnv::LINOP, A->nFlops(),
+			SolverPerfEnv::vectorBytes<T>(A->subset(), 2*A->size()));
+      (*A)(chi, psi, isign, epsilon);
+    }
+
+    const Subset& subset() const {return A->subset();}
+
+    unsigned long nFlops() const {return A->nFlops();}
+
+  private:
+    Handle< LinearOperatorArray<T> > A;
+  };
+
+
+  //! Solver that returns its performance counters
+  /*! \ingroup invert
+   *
+   * Opens a solve around the wrapped solver and returns the counters
+   * in SystemSolverResults_t::perf.
+   */
+  template<typename T, typename S>
+  class TimedSystemSolver : public S
+  {
+  public:
+    //! Wrap a solver
+    TimedSystemSolver(Handle<S> invA_) : invA(invA_) {}
+
+    //! Solve the system
+    SystemSolverResults_t operator() (T& psi, const T& chi) const
+    {
+      CHROMA_REGION("solve");
+      SolverPerfEnv::begin();
+      SystemSolverResults_t res = (*invA)(psi, chi);
+      res.perf = SolverPerfEnv::end();
+      return res;
+    }
+
+    const Subset& subset() const {return invA->subset();}
+
+  private:
+    Handle<S> invA;
+  };
+
+
+  //! Solver of arrays that returns its performance counters
+  /*! \ingroup invert */
+  template<typename T, typename S>
+  class TimedSystemSolverArray : public S
+  {
+  public:
+    //! Wrap a solver
+    TimedSystemSolverArray(Handle<S> invA_) : invA(invA_) {}
+
+    int size() const {return invA->size();}
+
+    //! Solve the system
+    SystemSolverResults_t operator() (multi1d<T>& psi, const multi1d<T>& chi) const
+    {
+      CHROMA_REGION("solve");
+      SolverPerfEnv::begin();
+      SystemSolverResults_t res = (*invA)(psi, chi);
+      res.perf = SolverPerfEnv::end();
+      return res;
+    }
+
+    const Subset& subset() const {return invA->subset();}
+
+  private:
+    Handle<S> invA;
+  };
+
+}  // end namespace Chroma
+
+#endif
@@ -0,0 +1,46 @@
+/*! \file
+ *  \brief Params of the GCRO-DR recycling solver
+ */
+#include <string>
+#include "actions/ferm/invert/syssolver_gcrodr_params.h"
+
+namespace Chroma
+{
+
+  // Read parameters
+  void read(XMLReader& xml, const std::string& path, SysSolverGCRODRParams& p)
+  {
+    XMLReader paramtop(xml, path);
+
+    read(paramtop, "RsdTarget", p.RsdTarget);
+    read(paramtop, "NKrylov",   p.NKrylov);
+    read(paramtop, "NDefl",     p.NDefl);
+    read(paramtop, "MaxIter",   p.MaxIter);
+  }
+
+  // Writer parameters
+  void write(XMLWriter& xml, const std::string& path, const SysSolverGCRODRParams& p)
+  {
+    push(xml, path);
+    write(xml, "RsdTarget", p.RsdTarget);
+    write(xml, "NKrylov",   p.NKrylov);
+    write(xml, "NDefl",     p.NDefl);
+    write(xml, "MaxIter",   p.MaxIter);
+    pop(xml);
+  }
+
+  SysSolverGCRODRParams::SysSolverGCRODRParams()
+  {
+    RsdTarget = 0;
+    NKrylov = 0;
+    NDefl = 0;
+    MaxIter = 0;
+  }
+
+  //! Read parameters
+  SysSolverGCRODRParams::SysSolverGCRODRParams(XMLReader& xml, const std::string& path)
+  {
+    read(xml, path, *this);
+  }
+
+}
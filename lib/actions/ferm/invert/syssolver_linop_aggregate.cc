@@ -18,6 +18,7 @@
 #include "actions/ferm/invert/syssolver_linop_rel_ibicgstab_clover.h"
 #include "actions/ferm/invert/syssolver_linop_rel_cg_clover.h"
 #include "actions/ferm/invert/syssolver_linop_fgmres_dr.h"
+#include "actions/ferm/invert/syssolver_linop_gcrodr.h"
 
 
 #include "chroma_config.h"
@@ -31,6 +32,7 @@
 
 #include "actions/ferm/invert/syssolver_linop_cg_array.h"
 #include "actions/ferm/invert/syssolver_linop_eigcg_array.h"
+#include "actions/ferm/invert/syssolver_linop_rel_cg_array.h"
 
 #ifdef BUILD_QOP_MG
 #include "actions/ferm/invert/qop_mg/syssolver_linop_qop_mg_w.h"
@@ -74,6 +76,7 @@ namespace Chroma
 	success &= LinOpSysSolverReliableIBiCGStabCloverEnv::registerAll();
 	success &= LinOpSysSolverReliableCGCloverEnv::registerAll();
 	success &= LinOpSysSolverFGMRESDREnv::registerAll();
+	success &= LinOpSysSolverGCRODREnv::registerAll();
 
 #ifdef BUILD_QUDA
 	success &= LinOpSysSolverQUDACloverEnv::registerAll();
@@ -117,6 +120,7 @@ namespace Chroma
 	success &= LinOpSysSolverMDWFArrayEnv::registerAll();
 #endif
 	success &= LinOpSysSolverEigCGArrayEnv::registerAll();
+	success &= LinOpSysSolverReliableCGArrayEnv::registerAll();
 	registered = true;
       }
       return success;
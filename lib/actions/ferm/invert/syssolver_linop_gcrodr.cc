@@ -0,0 +1,446 @@
+/*! \file
+ *  \brief Solve a M*psi=chi linear system by GCRO-DR with subspace recycling
+ */
+#include "chromabase.h"
+#include "qdp-lapack.h"
+#include "actions/ferm/invert/syssolver_linop_factory.h"
+#include "actions/ferm/invert/syssolver_linop_aggregate.h"
+
+#include "actions/ferm/invert/syssolver_linop_gcrodr.h"
+
+namespace Chroma
+{
+
+  //! GCRODR system solver namespace
+  namespace LinOpSysSolverGCRODREnv
+  {
+    //! Callback function
+    LinOpSystemSolver<LatticeFermion>* createFerm(XMLReader& xml_in,
+						  const std::string& path,
+						  Handle< FermState< LatticeFermion, multi1d<LatticeColorMatrix>, multi1d<LatticeColorMatrix> > > state,
+						  Handle< LinearOperator<LatticeFermion> > A)
+    {
+      return new LinOpSysSolverGCRODR(A, state, SysSolverGCRODRParams(xml_in, path));
+    }
+
+
+    //! Name to be used
+    const std::string name("GCRODR_INVERTER");
+
+    //! Local registration flag
+    static bool registered = false;
+
+    //! Register all the factories
+    bool registerAll()
+    {
+      bool success = true;
+      if (! registered)
+      {
+	success &= Chroma::TheLinOpFermSystemSolverFactory::Instance().registerObject(name, createFerm);
+	registered = true;
+      }
+      return success;
+    }
+  }
+
+
+  // Constructor
+  LinOpSysSolverGCRODR::LinOpSysSolverGCRODR(Handle< LinearOperator<T> > A,
+					     Handle< FermState<T,Q,Q> > state,
+					     const SysSolverGCRODRParams& invParam) :
+    A_(A), invParam_(invParam), n_recycled_(0)
+  {
+    if (invParam_.NKrylov < 1 || invParam_.NDefl < 0 || invParam_.NDefl >= invParam_.NKrylov)
+    {
+      QDPIO::cerr << "GCRODR: need NKrylov > NDefl >= 0, have NKrylov=" << invParam_.NKrylov
+		  << " NDefl=" << invParam_.NDefl << std::endl;
+      QDP_abort(1);
+    }
+
+#ifndef BUILD_LAPACK
+    if( invParam_.NDefl > 0 ) {
+      QDPIO::cerr << "GCRODR: NDefl > 0 needs LAPACK, reconfigure with --enable-lapack=lapack" << std::endl;
+      QDP_abort(1);
+    }
+#endif
+
+    const int n_krylov = invParam_.NKrylov;
+    const int n_defl   = invParam_.NDefl;
+
+    U_.resize(n_defl);
+    C_.resize(n_defl);
+    V_.resize(n_krylov+1);
+    H_.resize(n_krylov, n_krylov+1);
+    R_.resize(n_krylov, n_krylov+1);
+    B_.resize(n_krylov, (n_defl > 0) ? n_defl : 1);
+    givens_rots_.resize(n_krylov+1);
+    g_.resize(n_krylov+1);
+  }
+
+
+  /*! Arnoldi process on the residual in V[0].
+   *
+   * Builds (1 - C C^H) A V_j = V_{j+1} H_j with B = C^H A V, and
+   * reduces H to R with Givens rotations, which are also applied to g
+   * to track the residuum. Stops after n_krylov steps, on convergence or
+   * when the iterations run out.
+   */
+  int LinOpSysSolverGCRODR::Arnoldi(int n_krylov, const Double& rsd_target) const
+  {
+    const Subset& s = A_->subset();
+    const int k = n_recycled_;
+
+    for(int j=0; j < n_krylov; ++j) {
+
+      T w;
+      (*A_)(w, V_[j], PLUS);
+
+      // Project out the recycled space
+      for(int i=0; i < k; ++i) {
+	B_(j,i) = innerProduct(C_[i], w, s);
+	w[s] -= B_(j,i)*C_[i];
+      }
+
+      // Fill out column j
+      for(int i=0; i <= j; ++i) {
+	H_(j,i) = innerProduct(V_[i], w, s);
+	w[s] -= H_(j,i)*V_[i];
+      }
+
+      Double wnorm = sqrt(norm2(w,s));
+      H_(j,j+1) = DComplex(wnorm);
+
+      // An exact invariant subspace: the solution of this cycle is exact
+      bool breakdown = toBool( wnorm < Double(1.0e-14) );
+      if (breakdown)
+	V_[j+1] = zero;
+      else
+	V_[j+1][s] = (Double(1)/wnorm)*w;
+
+      for(int i=0; i <= j+1; ++i) {
+	R_(j,i) = H_(j,i);
+      }
+
+      // Apply Existing Givens Rotations to this column of R
+      for(int i=0; i < j; ++i) {
+	(*givens_rots_[i])(j,R_);
+      }
+
+      // Compute next Givens Rot for this column
+      givens_rots_[j] = new Givens(j,R_);
+
+      (*givens_rots_[j])(j,R_); // Apply it to R
+      (*givens_rots_[j])(g_);   // Apply it to the g vector
+
+      Double accum_resid = sqrt(norm2(g_[j+1]));
+
+      QDPIO::cout << "GCRODR: Iter " << j+1 << " || r || = " << accum_resid << " Target=" << rsd_target << std::endl;
+
+      if (breakdown || toBool( accum_resid <= rsd_target ))
+	return j+1;
+    }
+
+    return n_krylov;
+  }
+
+
+  // Back substitution of R eta = g
+  void LinOpSysSolverGCRODR::LeastSquaresSolve(multi1d<DComplex>& eta, int dim) const
+  {
+    eta.resize(dim);
+    for(int row = dim-1; row >= 0; --row) {
+      eta[row] = g_[row];
+      for(int col=row+1; col < dim; ++col) {
+	eta[row] -= R_(col,row)*eta[col];
+      }
+      eta[row] /= R_(row,row);
+    }
+  }
+
+
+  /*! New recycled space from the cycle just finished.
+   *
+   * With W = [C V_{dim+1}] and What = [U V_dim] one has A What = W G,
+   *
+   *   G = [ 1  B ]
+   *       [ 0  H ]
+   *
+   * The harmonic Ritz vectors What z of A over span(What) solve
+   *
+   *   G^H G z = theta G^H W^H What z
+   *
+   * For the NDefl z of smallest |theta|, put in P, the QR decomposition
+   * G P = Q R gives the new C = W Q and U = What P R^{-1}, so that still
+   * A U = C and C^H C = 1. Without a recycled space this is the
+   * eigenproblem of GetEigenvectors() in FGMRES-DR.
+   */
+  void LinOpSysSolverGCRODR::UpdateRecycledSpace(int dim) const
+  {
+    const Subset& s = A_->subset();
+    const int k    = n_recycled_;
+    const int mhat = k + dim;
+    int k_new = (invParam_.NDefl < mhat) ? invParam_.NDefl : mhat;
+
+    if (k_new == 0)
+      return;
+
+    // G and W^H What, both (mhat+1) x mhat, stored (col,row)
+    multi2d<DComplex> G(mhat, mhat+1);
+    multi2d<DComplex> WhW(mhat, mhat+1);
+    for(int col=0; col < mhat; ++col) {
+      for(int row=0; row < mhat+1; ++row) {
+	G(col,row) = zero;
+	WhW(col,row) = zero;
+      }
+    }
+
+    for(int i=0; i < k; ++i) {
+      G(i,i) = Double(1);
+    }
+    for(int j=0; j < dim; ++j) {
+      for(int i=0; i < k; ++i) {
+	G(k+j,i) = B_(j,i);
+      }
+      for(int i=0; i <= j+1; ++i) {
+	G(k+j,k+i) = H_(j,i);
+      }
+    }
+
+    // U is not orthonormal and not orthogonal to V, so its block is
+    // computed. The V block is the identity.
+    for(int col=0; col < k; ++col) {
+      for(int i=0; i < k; ++i) {
+	WhW(col,i) = innerProduct(C_[i], U_[col], s);
+      }
+      for(int i=0; i <= dim; ++i) {
+	WhW(col,k+i) = innerProduct(V_[i], U_[col], s);
+      }
+    }
+    for(int j=0; j < dim; ++j) {
+      WhW(k+j,k+j) = Double(1);
+    }
+
+    // P = G^H W^H What and S = G^H G
+    multi2d<DComplex> P(mhat, mhat);
+    multi2d<DComplex> S(mhat, mhat);
+    for(int col=0; col < mhat; ++col) {
+      for(int row=0; row < mhat; ++row) {
+	P(col,row) = zero;
+	S(col,row) = zero;
+	for(int l=0; l < mhat+1; ++l) {
+	  P(col,row) += conj(G(row,l))*WhW(col,l);
+	  S(col,row) += conj(G(row,l))*G(col,l);
+	}
+      }
+    }
+
+    // The standard eigenproblem P^{-1} S z = theta z
+    multi1d<int> ipiv(mhat);
+    int info;
+    QDPLapack::zgetrf(mhat,mhat,P,mhat,ipiv,info);
+    if (info != 0) {
+      QDPIO::cerr << "GCRODR: ZGETRF reported failure: info=" << info << std::endl;
+      QDP_abort(1);
+    }
+
+    char trans='N';
+    multi2d<DComplex> X(mhat, mhat);
+    multi1d<DComplex> x_col(mhat);
+    for(int col=0; col < mhat; ++col) {
+      for(int row=0; row < mhat; ++row) {
+	x_col[row] = S(col,row);
+      }
+      QDPLapack::zgetrs(trans,mhat,1,P,mhat,ipiv,x_col,mhat,info);
+      if (info != 0) {
+	QDPIO::cerr << "GCRODR: ZGETRS reported failure: info=" << info << std::endl;
+	QDP_abort(1);
+      }
+      for(int row=0; row < mhat; ++row) {
+	X(col,row) = x_col[row];
+      }
+    }
+
+    multi1d<DComplex> evals(mhat);
+    multi2d<DComplex> evecs(mhat, mhat);
+    QDPLapack::zgeev(mhat, X, evals, evecs);
+
+    // Order by modulus, only the first k_new are needed
+    multi1d<int> order(mhat);
+    for(int i=0; i < mhat; ++i) {
+      order[i] = i;
+    }
+    for(int i=0; i < k_new; ++i) {
+      for(int j=i+1; j < mhat; ++j) {
+	if ( toBool( norm2(evals[order[j]]) < norm2(evals[order[i]]) ) ) {
+	  int t = order[i];
+	  order[i] = order[j];
+	  order[j] = t;
+	}
+      }
+    }
+
+    // Pk and G Pk, the latter is QR decomposed in place
+    multi2d<DComplex> Pk(k_new, mhat);
+    multi2d<DComplex> GP(k_new, mhat+1);
+    for(int i=0; i < k_new; ++i) {
+      for(int row=0; row < mhat; ++row) {
+	Pk(i,row) = evecs(order[i], row);
+      }
+      for(int row=0; row < mhat+1; ++row) {
+	GP(i,row) = zero;
+	for(int l=0; l < mhat; ++l) {
+	  GP(i,row) += G(l,row)*Pk(i,l);
+	}
+      }
+    }
+
+    multi1d<DComplex> tau;
+    QDPLapack::zgeqrf(mhat+1, k_new, GP, tau);
+
+    multi2d<DComplex> Rk(k_new, k_new);
+    for(int col=0; col < k_new; ++col) {
+      for(int row=0; row < k_new; ++row) {
+	if (row <= col)
+	  Rk(col,row) = GP(col,row);
+	else
+	  Rk(col,row) = zero;
+      }
+    }
+
+    QDPLapack::zungqr(mhat+1, k_new, k_new, GP, tau);
+
+    // A (nearly) rank deficient G P would blow up U, keep what is safe
+    for(int i=0; i < k_new; ++i) {
+      if ( toBool( sqrt(norm2(Rk(i,i))) < Double(1.0e-12) ) ) {
+	k_new = i;
+	break;
+      }
+    }
+
+    // C = W Q and U = What P R^{-1}
+    multi1d<T> new_C(k_new);
+    multi1d<T> new_U(k_new);
+    for(int i=0; i < k_new; ++i) {
+      new_C[i][s] = zero;
+      for(int l=0; l < k; ++l) {
+	new_C[i][s] += GP(i,l)*C_[l];
+      }
+      for(int l=0; l <= dim; ++l) {
+	new_C[i][s] += GP(i,k+l)*V_[l];
+      }
+
+      new_U[i][s] = zero;
+      for(int l=0; l < k; ++l) {
+	new_U[i][s] += Pk(i,l)*U_[l];
+      }
+      for(int l=0; l < dim; ++l) {
+	new_U[i][s] += Pk(i,k+l)*V_[l];
+      }
+      for(int l=0; l < i; ++l) {
+	new_U[i][s] -= Rk(i,l)*new_U[l];
+      }
+      new_U[i][s] *= DComplex(1)/Rk(i,i);
+    }
+
+    for(int i=0; i < k_new; ++i) {
+      U_[i][s] = new_U[i];
+      C_[i][s] = new_C[i];
+    }
+    n_recycled_ = k_new;
+
+    QDPIO::cout << "GCRODR: recycled space of dimension " << n_recycled_
+		<< ", smallest harmonic Ritz value " << evals[order[0]] << std::endl;
+  }
+
+
+  /*! Solve the linear system  A psi = chi  via GCRO-DR
+   *
+   *  Every cycle restarts from the true residual, so the recycled space
+   *  only has to span the low modes well, not to be exact.
+   */
+  SystemSolverResults_t
+  LinOpSysSolverGCRODR::operator() (T& psi, const T& chi) const
+  {
+    START_CODE();
+    SystemSolverResults_t res; // Value to return
+
+    const Subset& s = A_->subset();
+    Double norm_rhs = sqrt(norm2(chi,s));   //  || b ||
+    Double target = norm_rhs * invParam_.RsdTarget; // Target  || r || < || b || RsdTarget
+
+    if (n_recycled_ > 0)
+      QDPIO::cout << "GCRODR: starting with a recycled space of dimension " << n_recycled_ << std::endl;
+
+    T r = zero; T tmp = zero;
+    Double r_norm;
+
+    int iters_total = 0;
+    int n_cycles = 0;
+
+    while (true) {
+
+      // True residuum
+      r[s] = chi;
+      (*A_)(tmp, psi, PLUS);
+      r[s] -= tmp;
+
+      // Take out the part in span(C):  psi += U C^H r,  r -= C C^H r
+      for(int i=0; i < n_recycled_; ++i) {
+	DComplex alpha = innerProduct(C_[i], r, s);
+	psi[s] += alpha*U_[i];
+	r[s] -= alpha*C_[i];
+      }
+
+      r_norm = sqrt(norm2(r,s));
+      QDPIO::cout << "GCRODR: || r || = " << r_norm <<  " target = " << target << std::endl;
+
+      if ( toBool( r_norm <= target ) || iters_total >= invParam_.MaxIter )
+	break;
+
+      ++n_cycles;
+
+      // Start the Arnoldi from the projected residual
+      for(int j=0; j < g_.size(); ++j) {
+	g_[j] = zero;
+      }
+      g_[0] = r_norm;
+      V_[0][s] = (Double(1)/r_norm)*r;
+
+      int n_krylov = invParam_.NKrylov;
+      if (iters_total + n_krylov > invParam_.MaxIter)
+	n_krylov = invParam_.MaxIter - iters_total;
+
+      int dim = Arnoldi(n_krylov, target);
+
+      // psi += V eta - U B eta
+      multi1d<DComplex> eta;
+      LeastSquaresSolve(eta, dim);
+
+      T dx = zero;
+      for(int j=0; j < dim; ++j) {
+	dx[s] += eta[j]*V_[j];
+      }
+      for(int i=0; i < n_recycled_; ++i) {
+	DComplex b_eta = zero;
+	for(int j=0; j < dim; ++j) {
+	  b_eta += B_(j,i)*eta[j];
+	}
+	dx[s] -= b_eta*U_[i];
+      }
+      psi[s] += dx;
+
+      QDPIO::cout << "GCRODR: Cycle finished with " << dim << " iterations" << std::endl;
+      iters_total += dim;
+
+      // The space is updated after the last cycle as well, for the next solve
+      UpdateRecycledSpace(dim);
+    }
+
+    res.n_count = iters_total;
+    res.resid = r_norm;
+    QDPIO::cout << "GCRODR: Done. Cycles=" << n_cycles << ", Iters=" << iters_total << " || r ||/|| b ||=" << r_norm / norm_rhs << " Target=" << invParam_.RsdTarget << std::endl;
+    END_CODE();
+    return res;
+  }
+
+}
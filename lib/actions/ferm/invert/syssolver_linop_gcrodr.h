@@ -0,0 +1,116 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Solve a M*psi=chi linear system by GCRO-DR with subspace recycling
+ */
+
+#ifndef __syssolver_linop_gcrodr_h__
+#define __syssolver_linop_gcrodr_h__
+
+#include "chroma_config.h"
+#include "handle.h"
+#include "state.h"
+#include "syssolver.h"
+#include "linearop.h"
+
+#include "actions/ferm/invert/syssolver_linop.h"
+#include "actions/ferm/invert/syssolver_linop_fgmres_dr.h"
+#include "actions/ferm/invert/syssolver_gcrodr_params.h"
+
+namespace Chroma
+{
+
+  //! GCRODR system solver namespace
+  namespace LinOpSysSolverGCRODREnv
+  {
+    //! Register the syssolver
+    bool registerAll();
+  }
+
+
+  //! Solve a M*psi=chi linear system by GCRO-DR
+  /*! \ingroup invert
+   *
+   * GMRES with deflated restarting that keeps its deflation space from
+   * one solve to the next (Parks, de Sturler, Mackey, Johnson and Maiti,
+   * SIAM J. Sci. Comput. 28 (2006) 1651). The solver holds NDefl vectors
+   * U and C = A U with C^H C = 1. Every cycle first removes the part of
+   * the residual in span(C),
+   *
+   *   psi += U C^H r,   r -= C C^H r
+   *
+   * and then runs NKrylov Arnoldi steps with (1 - C C^H) A. At the end of
+   * the cycle U and C are replaced by the NDefl harmonic Ritz vectors of
+   * smallest modulus over span(U, V), as in FGMRES-DR.
+   *
+   * The space is kept across calls, so the later columns of a propagator
+   * or the later sources of a distillation solve start with the low modes
+   * found by the earlier ones. The operator must be the same for all the
+   * calls, which holds since the solver is made for a fixed A.
+   */
+  class LinOpSysSolverGCRODR : public LinOpSystemSolver<LatticeFermion>
+  {
+  public:
+    typedef LatticeFermion T;
+    typedef LatticeColorMatrix U;
+    typedef multi1d<U> Q;
+ 
+    //! Constructor
+    /*!
+     * \param A_        Linear operator ( Read )
+     * \param invParam  inverter parameters ( Read )
+     */
+    LinOpSysSolverGCRODR(Handle< LinearOperator<T> > A,
+			 Handle< FermState<T,Q,Q> > state,
+			 const SysSolverGCRODRParams& invParam);
+
+    //! Destructor is automatic
+    ~LinOpSysSolverGCRODR() {}
+    
+    //! Return the subset on which the operator acts
+    const Subset& subset() const {return A_->subset();}
+
+    //! Solver the linear system
+    /*!
+     * \param psi      solution ( Modify )
+     * \param chi      source ( Read )
+     * \return syssolver results
+     */
+    SystemSolverResults_t operator() (T& psi, const T& chi) const;
+
+    //! Number of vectors in the recycled space
+    int recycledDim() const {return n_recycled_;}
+
+  private:
+    //! Arnoldi with (1 - C C^H) A from V[0], returns the dimension reached
+    int Arnoldi(int n_krylov, const Double& rsd_target) const;
+
+    //! Back substitution of R eta = g
+    void LeastSquaresSolve(multi1d<DComplex>& eta, int dim) const;
+
+    //! New U and C from the harmonic Ritz vectors over span(U, V)
+    void UpdateRecycledSpace(int dim) const;
+
+    // Hide default constructor
+    LinOpSysSolverGCRODR() {}
+
+    Handle< LinearOperator<T> > A_;
+    SysSolverGCRODRParams invParam_;
+
+    // The recycled space, kept from solve to solve
+    mutable multi1d<T> U_;         /*!< Recycled vectors */
+    mutable multi1d<T> C_;         /*!< C = A U, orthonormal */
+    mutable int n_recycled_;       /*!< Number of valid U and C */
+
+    // Workspace of a cycle
+    mutable multi1d<T> V_;                          /*!< Arnoldi basis */
+    mutable multi2d<DComplex> H_;                   /*!< Hessenberg matrix, H(col,row) */
+    mutable multi2d<DComplex> R_;                   /*!< H reduced with Givens rotations */
+    mutable multi2d<DComplex> B_;                   /*!< B(col,row) = C_row^H A V_col */
+    mutable multi1d< Handle<Givens> > givens_rots_;
+    mutable multi1d<DComplex> g_;                   /*!< Rotated right hand side */
+  };
+
+} // End namespace
+
+#endif 
+
@@ -0,0 +1,141 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Solve a M*psi=chi linear system for 5D DWF/NEF by mixed precision reliable CG
+ */
+
+#ifndef __syssolver_linop_rel_cg_array_h__
+#define __syssolver_linop_rel_cg_array_h__
+
+#include "chroma_config.h"
+#include "handle.h"
+#include "state.h"
+#include "syssolver.h"
+#include "linearop.h"
+#include "actions/ferm/fermstates/periodic_fermstate.h"
+#include "actions/ferm/invert/reliable_cg_array.h"
+#include "actions/ferm/invert/syssolver_linop.h"
+#include "actions/ferm/invert/syssolver_rel_cg_array_params.h"
+#include "actions/ferm/linop/eoprec_nef_dumb_linop_array_w.h"
+
+
+namespace Chroma
+{
+
+  //! Reliable CG array system solver namespace
+  namespace LinOpSysSolverReliableCGArrayEnv
+  {
+    //! Register the syssolver
+    bool registerAll();
+  }
+
+
+  //! Solve a M*psi=chi linear system by CGNE with single precision iterations
+  /*! \ingroup invert
+   *
+   *** WARNING THIS SOLVER WORKS FOR EVEN-ODD PRECONDITIONED DWF AND NEF ONLY ***
+   *
+   * The operator A is applied in base precision for the reliable
+   * updates. The inner iterations use a single precision copy of the
+   * operator, built from the links of the state and the operator
+   * parameters in the solver params.
+   */
+  class LinOpSysSolverReliableCGArray : public LinOpSystemSolverArray<LatticeFermion>
+  {
+  public:
+    typedef LatticeFermion T;
+    typedef multi1d<LatticeColorMatrix> Q;
+ 
+    typedef LatticeFermionF TF;
+    typedef multi1d<LatticeColorMatrixF> QF;
+
+    //! Constructor
+    /*!
+     * \param A_        Linear operator ( Read )
+     * \param state_    Fermion state of A ( Read )
+     * \param invParam  inverter parameters ( Read )
+     */
+    LinOpSysSolverReliableCGArray(Handle< LinearOperatorArray<T> > A_,
+				  Handle< FermState<T,Q,Q> > state_,
+				  const SysSolverReliableCGArrayParams& invParam_) : 
+      A(A_), invParam(invParam_) 
+    {
+      if (A->size() != invParam.N5)
+      {
+	QDPIO::cerr << "LinOpSysSolverReliableCGArray: operator has N5 = " << A->size()
+		    << " but the solver params have N5 = " << invParam.N5 << std::endl;
+	QDP_abort(1);
+      }
+
+      // The links of the state already have the gauge BCs applied
+      QF links_single(Nd);
+      const Q& links = state_->getLinks();
+      for(int mu=0; mu < Nd; mu++)
+	links_single[mu] = links[mu];
+
+      fstate_single = new PeriodicFermState<TF,QF,QF>(links_single);
+      M_single = new EvenOddPrecDumbNEFDWFLinOpArray(fstate_single,
+						      invParam.OverMass, invParam.b5, invParam.c5,
+						      invParam.Mass, invParam.N5, invParam.anisoParam);
+    }
+
+    //! Destructor is automatic
+    ~LinOpSysSolverReliableCGArray() {}
+
+    //! Expected length of array index
+    int size() const {return A->size();}
+
+    //! Return the subset on which the operator acts
+    const Subset& subset() const {return A->subset();}
+
+    //! Solver the linear system
+    /*!
+     * \param psi      solution ( Modify )
+     * \param chi      source ( Read )
+     * \return syssolver results
+     */
+    SystemSolverResults_t operator() (multi1d<T>& psi, const multi1d<T>& chi) const
+    {
+      START_CODE();
+
+      // This is a CGNE. So create new RHS
+      multi1d<T> chi_tmp(size());
+      (*A)(chi_tmp, chi, MINUS);
+
+      SystemSolverResults_t res = InvCGReliableArray(*A, *M_single, chi_tmp, psi,
+						     invParam.RsdTarget, invParam.Delta, 
+						     invParam.MaxIter);
+
+      // The true residual of the original system
+      { 
+	multi1d<T> tmp(size());
+	(*A)(tmp, psi, PLUS);
+
+	for(int n=0; n < size(); ++n)
+	  tmp[n][A->subset()] -= chi[n];
+
+	res.resid = sqrt(norm2(tmp, A->subset()));
+      }
+      QDPIO::cout << "RELIABLE_CG_ARRAY_SOLVER: " << res.n_count << " iterations. Rsd = " << res.resid 
+		  << " Relative Rsd = " << res.resid/sqrt(norm2(chi,A->subset())) << std::endl;
+
+      END_CODE();
+
+      return res;
+    }
+
+
+  private:
+    // Hide default constructor
+    LinOpSysSolverReliableCGArray() {}
+
+    Handle< LinearOperatorArray<T> > A;
+    SysSolverReliableCGArrayParams invParam;
+
+    Handle< FermState<TF,QF,QF> > fstate_single;
+    Handle< LinearOperatorArray<TF> > M_single;
+  };
+
+
+} // End namespace
+
+#endif 
@@ -10,6 +10,7 @@
 #include "actions/ferm/invert/syssolver_mdagm_ibicgstab.h"
 #include "actions/ferm/invert/syssolver_mdagm_cg_timing.h"
 #include "actions/ferm/invert/syssolver_mdagm_cg_array.h"
+#include "actions/ferm/invert/syssolver_mdagm_rel_cg_array.h"
 #include "actions/ferm/invert/syssolver_mdagm_eigcg.h"
 #include "actions/ferm/invert/syssolver_mdagm_richardson_multiprec_clover.h"
 #include "actions/ferm/invert/syssolver_mdagm_rel_bicgstab_clover.h"
@@ -89,6 +90,7 @@ namespace Chroma
       {
 	// Sources
 	success &= MdagMSysSolverCGArrayEnv::registerAll();
+	success &= MdagMSysSolverReliableCGArrayEnv::registerAll();
 	registered = true;
       }
       return success;
@@ -0,0 +1,48 @@
+/*! \file
+ *  \brief Solve a MdagM*psi=chi linear system for 5D DWF/NEF by mixed precision reliable CG
+ */
+
+#include "actions/ferm/invert/syssolver_mdagm_factory.h"
+#include "actions/ferm/invert/syssolver_mdagm_aggregate.h"
+
+#include "actions/ferm/invert/syssolver_mdagm_rel_cg_array.h"
+
+namespace Chroma
+{
+
+  //! Reliable CG array system solver namespace
+  namespace MdagMSysSolverReliableCGArrayEnv
+  {
+    //! Callback function
+    MdagMSystemSolverArray<LatticeFermion>* createFerm(XMLReader& xml_in,
+						       const std::string& path,
+						       Handle< FermState<
+					                                 LatticeFermion, 
+						                         multi1d<LatticeColorMatrix>,
+						                         multi1d<LatticeColorMatrix> 
+						             > 
+							  > state, 
+						       Handle< LinearOperatorArray<LatticeFermion> > A)
+    {
+      return new MdagMSysSolverReliableCGArray(A, state, SysSolverReliableCGArrayParams(xml_in, path));
+    }
+
+    //! Name to be used
+    const std::string name("RELIABLE_CG_MP_ARRAY_INVERTER");
+
+    //! Local registration flag
+    static bool registered = false;
+
+    //! Register all the factories
+    bool registerAll() 
+    {
+      bool success = true; 
+      if (! registered)
+      {
+	success &= Chroma::TheMdagMFermSystemSolverArrayFactory::Instance().registerObject(name, createFerm);
+	registered = true;
+      }
+      return success;
+    }
+  }
+}
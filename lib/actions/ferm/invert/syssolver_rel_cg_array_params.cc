@@ -0,0 +1,61 @@
+/*! \file
+ *  \brief Params of the mixed precision reliable CG for 5D domain-wall operators
+ */
+
+#include "actions/ferm/invert/syssolver_rel_cg_array_params.h"
+#include "chromabase.h"
+
+
+using namespace QDP;
+
+namespace Chroma 
+{
+  
+  SysSolverReliableCGArrayParams::SysSolverReliableCGArrayParams(XMLReader& xml, 
+								 const std::string& path)
+  {
+    XMLReader paramtop(xml, path);
+
+    read(paramtop, "MaxIter", MaxIter);
+    read(paramtop, "RsdTarget", RsdTarget);
+    read(paramtop, "Delta", Delta);
+
+    read(paramtop, "OverMass", OverMass);
+    read(paramtop, "Mass", Mass);
+    read(paramtop, "N5", N5);
+
+    b5 = 1;
+    c5 = 0;
+    if (paramtop.count("b5") != 0)
+      read(paramtop, "b5", b5);
+    if (paramtop.count("c5") != 0)
+      read(paramtop, "c5", c5);
+
+    if (paramtop.count("AnisoParam") != 0) 
+      read(paramtop, "AnisoParam", anisoParam);
+  }
+
+  void read(XMLReader& xml, const std::string& path, 
+	    SysSolverReliableCGArrayParams& p)
+  {
+    SysSolverReliableCGArrayParams tmp(xml, path);
+    p = tmp;
+  }
+
+  void write(XMLWriter& xml, const std::string& path, 
+	     const SysSolverReliableCGArrayParams& p) 
+  {
+    push(xml, path);
+    write(xml, "MaxIter", p.MaxIter);
+    write(xml, "RsdTarget", p.RsdTarget);
+    write(xml, "Delta", p.Delta);
+    write(xml, "OverMass", p.OverMass);
+    write(xml, "Mass", p.Mass);
+    write(xml, "N5", p.N5);
+    write(xml, "b5", p.b5);
+    write(xml, "c5", p.c5);
+    write(xml, "AnisoParam", p.anisoParam);
+    pop(xml);
+  }
+
+}
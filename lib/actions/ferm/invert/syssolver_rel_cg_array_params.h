@@ -0,0 +1,46 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Params of the mixed precision reliable CG for 5D domain-wall operators
+ */
+
+#ifndef __SYSSOLVER_REL_CG_ARRAY_PARAMS_H__
+#define __SYSSOLVER_REL_CG_ARRAY_PARAMS_H__
+
+#include "chromabase.h"
+#include "io/aniso_io.h"
+
+namespace Chroma 
+{
+  //! Params of the mixed precision reliable CG for 5D operators
+  /*! \ingroup invert
+   *
+   * Besides the solver parameters these hold the parameters of the
+   * even-odd preconditioned 5D operator being inverted, from which the
+   * single precision copy of the operator is made. DWF is b5=1, c5=0,
+   * which are the defaults; NEF takes the values of the action.
+   */
+  struct SysSolverReliableCGArrayParams 
+  { 
+    SysSolverReliableCGArrayParams(XMLReader& xml, const std::string& path);
+    SysSolverReliableCGArrayParams() {};
+
+    int MaxIter;
+    Real RsdTarget;
+    Real Delta;
+
+    Real OverMass;
+    Real Mass;
+    int  N5;
+    Real b5;
+    Real c5;
+    AnisoParam_t anisoParam;
+  };
+
+  void read(XMLReader& xml, const std::string& path, SysSolverReliableCGArrayParams& p);
+
+  void write(XMLWriter& xml, const std::string& path, 
+	     const SysSolverReliableCGArrayParams& param);
+
+}
+
+#endif
@@ -0,0 +1,247 @@
+/*! \file
+ *  \brief Site-loop "asq" or "asqtad" dslash operator D' with neighbor tables
+ */
+
+#include "chromabase.h"
+#include "actions/ferm/linop/asq_dsl_site_s.h"
+
+
+namespace Chroma
+{
+
+  //! Site kernels of the asqtad dslash
+  namespace SiteStaggeredDslashEnv
+  {
+    //! Hop length indices in the neighbor table
+    const int one_hop   = 0;
+    const int three_hop = 1;
+
+    template<typename TL, typename QL>
+    struct ApplyArgs
+    {
+      TL& chi;
+      const TL& psi;
+      const SiteHaloField<TL>& halo;
+      const SiteNeighborTable& table;
+      const QL& u_fat;
+      const QL& u_triple;
+      const QL& u_fat_back;
+      const QL& u_triple_back;
+      const int* sites;
+      int sign;            // +1 for PLUS, -1 for MINUS
+    };
+
+
+    //! res += s * U v   for an Nc x Nc complex U
+    template<typename R>
+    inline
+    void addMatVec(R* res, const R* u, const R* v, R s)
+    {
+      for(int i=0; i < Nc; ++i)
+      {
+	R re = 0;
+	R im = 0;
+	for(int j=0; j < Nc; ++j)
+	{
+	  const R* uij = u + 2*(Nc*i + j);
+	  re += uij[0]*v[2*j]   - uij[1]*v[2*j+1];
+	  im += uij[0]*v[2*j+1] + uij[1]*v[2*j];
+	}
+	res[2*i]   += s*re;
+	res[2*i+1] += s*im;
+      }
+    }
+
+
+    //! Pointer to the color vector of a staggered fermion site
+    template<typename S>
+    inline
+    const typename WordType<S>::Type_t* vecPtr(const S& s)
+    {
+      return &(s.elem(0).elem(0).real());
+    }
+
+    //! Pointer to the color matrix of a gauge field site
+    template<typename U>
+    inline
+    const typename WordType<U>::Type_t* linkPtr(const multi1d<U>& u, int mu, int site)
+    {
+      return &(u[mu].elem(site).elem().elem(0,0).real());
+    }
+
+
+    //! The asqtad dslash on a list of sites
+    /*!
+     * chi(x) = sign * sum_mu [ U(x) psi(x+mu) + U3(x) psi(x+3mu)
+     *                         - Ub(x) psi(x-mu) - U3b(x) psi(x-3mu) ]
+     */
+    template<typename TL, typename QL>
+    inline
+    void siteLoop(int lo, int hi, int my_id, ApplyArgs<TL,QL>* a)
+    {
+      typedef typename WordType<TL>::Type_t R;
+
+      const SiteNeighborTable& tab = a->table;
+      const R one = 1;
+      const R mone = -1;
+
+      for(int j=lo; j < hi; ++j)
+      {
+	int site = a->sites[j];
+
+	R res[2*Nc];
+	for(int i=0; i < 2*Nc; ++i)
+	  res[i] = 0;
+
+	for(int mu=0; mu < Nd; ++mu)
+	{
+	  int f1 = tab.neighbor(site, tab.hop(mu, +1, one_hop));
+	  int f3 = tab.neighbor(site, tab.hop(mu, +1, three_hop));
+	  int b1 = tab.neighbor(site, tab.hop(mu, -1, one_hop));
+	  int b3 = tab.neighbor(site, tab.hop(mu, -1, three_hop));
+
+	  addMatVec(res, linkPtr(a->u_fat, mu, site),
+		    vecPtr(a->halo.site(a->psi, f1)), one);
+	  addMatVec(res, linkPtr(a->u_triple, mu, site),
+		    vecPtr(a->halo.site(a->psi, f3)), one);
+	  addMatVec(res, linkPtr(a->u_fat_back, mu, site),
+		    vecPtr(a->halo.site(a->psi, b1)), mone);
+	  addMatVec(res, linkPtr(a->u_triple_back, mu, site),
+		    vecPtr(a->halo.site(a->psi, b3)), mone);
+	}
+
+	R* out = &(a->chi.elem(site).elem(0).elem(0).real());
+	const R sign = a->sign;
+	for(int i=0; i < 2*Nc; ++i)
+	  out[i] = sign*res[i];
+      }
+    }
+
+
+    //! Halo exchange overlapped with the interior sites
+    template<typename TL, typename QL>
+    void applyKernel(TL& chi, const TL& psi, enum PlusMinus isign, int cb,
+		     const SiteNeighborTable& table, SiteHaloField<TL>& halo,
+		     const QL& u_fat, const QL& u_triple,
+		     const QL& u_fat_back, const QL& u_triple_back)
+    {
+      int sign = (isign == PLUS) ? +1 : -1;
+
+      halo.start(psi);
+
+      const multi1d<int>& inner = table.innerSites(cb);
+      ApplyArgs<TL,QL> inner_arg = {chi, psi, halo, table,
+				    u_fat, u_triple, u_fat_back, u_triple_back,
+				    inner.slice(), sign};
+      dispatch_to_threads(inner.size(), inner_arg, siteLoop<TL,QL>);
+
+      halo.finish();
+
+      const multi1d<int>& face = table.faceSites(cb);
+      ApplyArgs<TL,QL> face_arg = {chi, psi, halo, table,
+				   u_fat, u_triple, u_fat_back, u_triple_back,
+				   face.slice(), sign};
+      dispatch_to_threads(face.size(), face_arg, siteLoop<TL,QL>);
+    }
+  }
+
+
+  //! Creation routine
+  /*!
+   * Builds the neighbor tables for hops of length 1 and 3, and
+   * the backward links. This is the only place with lattice shifts.
+   */
+  void SiteStaggeredDslash::create(Handle<AsqtadConnectStateBase> state_)
+  {
+    START_CODE();
+
+    state = state_;
+    single_initP = false;
+
+    multi1d<int> hops(2);
+    hops[SiteStaggeredDslashEnv::one_hop]   = 1;
+    hops[SiteStaggeredDslashEnv::three_hop] = 3;
+    table = new SiteNeighborTable(hops);
+    halo  = new SiteHaloField<T>(*table);
+
+    u_fat    = state->getFatLinks();
+    u_triple = state->getTripleLinks();
+
+    u_fat_back.resize(Nd);
+    u_triple_back.resize(Nd);
+
+    for(int mu=0; mu < Nd; ++mu)
+    {
+      // Ub(x) = U^dag(x-mu)
+      u_fat_back[mu] = shift(adj(u_fat[mu]), BACKWARD, mu);
+
+      // U3b(x) = U3^dag(x-3mu)
+      LatticeColorMatrix tmp = shift(adj(u_triple[mu]), BACKWARD, mu);
+      u_triple_back[mu] = shift(shift(tmp, BACKWARD, mu), BACKWARD, mu);
+    }
+
+    END_CODE();
+  }
+
+
+  //! Apply the operator
+  /*!
+   * \param chi     Result                                    (Write)
+   * \param psi     Pseudofermion field - Source	      (Read)
+   * \param isign   D' or D'^+  ( PLUS | MINUS )              (Read)
+   * \param cb      Checkerboard of OUTPUT std::vector        (Read)
+   */
+  void SiteStaggeredDslash::apply (LatticeStaggeredFermion& chi,
+				   const LatticeStaggeredFermion& psi,
+				   enum PlusMinus isign, int cb) const
+  {
+    START_CODE();
+
+    SiteStaggeredDslashEnv::applyKernel(chi, psi, isign, cb, *table, *halo,
+					u_fat, u_triple, u_fat_back, u_triple_back);
+
+    END_CODE();
+  }
+
+
+#if BASE_PRECISION == 64
+  //! Make the single precision links
+  void SiteStaggeredDslash::initSingle() const
+  {
+    if (single_initP)
+      return;
+
+    u_fat_f.resize(Nd);
+    u_triple_f.resize(Nd);
+    u_fat_back_f.resize(Nd);
+    u_triple_back_f.resize(Nd);
+
+    for(int mu=0; mu < Nd; ++mu)
+    {
+      u_fat_f[mu]         = u_fat[mu];
+      u_triple_f[mu]      = u_triple[mu];
+      u_fat_back_f[mu]    = u_fat_back[mu];
+      u_triple_back_f[mu] = u_triple_back[mu];
+    }
+
+    halo_f = new SiteHaloField<TF>(*table);
+    single_initP = true;
+  }
+
+
+  //! Single precision variant of apply
+  void SiteStaggeredDslash::apply (LatticeStaggeredFermionF& chi,
+				   const LatticeStaggeredFermionF& psi,
+				   enum PlusMinus isign, int cb) const
+  {
+    START_CODE();
+
+    initSingle();
+    SiteStaggeredDslashEnv::applyKernel(chi, psi, isign, cb, *table, *halo_f,
+					u_fat_f, u_triple_f, u_fat_back_f, u_triple_back_f);
+
+    END_CODE();
+  }
+#endif
+
+} // End Namespace Chroma
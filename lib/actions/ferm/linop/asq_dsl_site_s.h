@@ -0,0 +1,111 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Site-loop "asq" or "asqtad" dslash operator D' with neighbor tables
+ */
+
+#ifndef __asqdslash_site_h__
+#define __asqdslash_site_h__
+
+#include "linearop.h"
+#include "actions/ferm/fermstates/asqtad_state.h"
+#include "util/gauge/site_neighbor_table.h"
+
+
+namespace Chroma
+{
+  //! The "asq" or "asqtad" dslash operator D' as a fused site loop
+  /*!
+   * \ingroup linop
+   *
+   * This routine is specific to staggered fermions!
+   *
+   * Applies the same operator as QDPStaggeredDslash (see asq_dsl_s.h),
+   * but without full lattice shifts. At creation the backward links
+   *
+   *    Ub (x) = U^dag (x-mu)    and    Ub (x) = U^dag (x-3mu)
+   *      mu       mu                     3,mu     3,mu
+   *
+   * are formed once, so that every term of D' is local to the output
+   * site. An application then
+   *   1) exchanges a halo of depth 3 of psi once, for all directions,
+   *   2) runs a threaded loop over the sites that need no halo,
+   *   3) waits for the halo and finishes the face sites,
+   * gathering the 1-hop and 3-hop neighbors through a SiteNeighborTable.
+   *
+   * The links are the fat and triple (Naik) links of the state, so the
+   * operator serves both asqtad and HISQ. Besides the usual base
+   * precision apply there is a single precision apply, with the links
+   * converted on first use.
+   *
+   * Note the KS phase factors are already included in the U's!
+   */
+  class SiteStaggeredDslash : public DslashLinearOperator<
+    LatticeStaggeredFermion, multi1d<LatticeColorMatrix>, multi1d<LatticeColorMatrix> >
+  {
+  public:
+    // Typedefs to save typing
+    typedef LatticeStaggeredFermion      T;
+    typedef multi1d<LatticeColorMatrix>  P;
+    typedef multi1d<LatticeColorMatrix>  Q;
+
+    typedef LatticeStaggeredFermionF     TF;
+    typedef multi1d<LatticeColorMatrixF> QF;
+
+    //! Empty constructor. Must use create later
+    SiteStaggeredDslash() : single_initP(false) {}
+
+    //! Full constructor
+    SiteStaggeredDslash(Handle<AsqtadConnectStateBase> state_) : single_initP(false)
+    {create(state_);}
+
+    //! Creation routine
+    void create(Handle<AsqtadConnectStateBase> state_);
+
+    //! No real need for cleanup here
+    ~SiteStaggeredDslash() {}
+
+    /*! Arguments:
+     *
+     *  \param chi       Result                                         (Write)
+     *  \param psi       Pseudofermion field - Source		        (Read)
+     *  \param isign     D' or D'^+  ( +1 | -1 ) respectively		(Read)
+     *  \param cb	 Checkerboard of OUTPUT std::vector		(Read)
+     */
+    void apply (LatticeStaggeredFermion& chi, const LatticeStaggeredFermion& psi,
+		enum PlusMinus isign, int cb) const;
+
+#if BASE_PRECISION == 64
+    //! Single precision variant of apply
+    void apply (LatticeStaggeredFermionF& chi, const LatticeStaggeredFermionF& psi,
+		enum PlusMinus isign, int cb) const;
+#endif
+
+    //! Subset is all here
+    const Subset& subset() const {return all;}
+
+    //! Return the fermion BC object for this linear operator
+    const FermBC<T,P,Q>& getFermBC() const {return state->getBC();}
+
+  private:
+#if BASE_PRECISION == 64
+    //! Make the single precision links
+    void initSingle() const;
+#endif
+
+    Handle<AsqtadConnectStateBase> state;
+    Handle<SiteNeighborTable> table;
+    Handle< SiteHaloField<T> > halo;
+    mutable Handle< SiteHaloField<TF> > halo_f;
+
+    // Forward and backward fat and triple links, all in base precision
+    Q u_fat, u_triple, u_fat_back, u_triple_back;
+
+    // Single precision copies, made on first use
+    mutable bool single_initP;
+    mutable QF u_fat_f, u_triple_f, u_fat_back_f, u_triple_back_f;
+  };
+
+} // End Namespace Chroma
+
+
+#endif
@@ -7,6 +7,20 @@
 #ifndef DSLASH_S_H
 #define DSLASH_S_H
 
+#include "chroma_config.h"
+
+#ifdef BUILD_SITE_ASQTAD_DSLASH
+#include "actions/ferm/linop/asq_dsl_site_s.h"
+
+namespace Chroma 
+{
+  //! Site loop version of Asqtad dslash with neighbor tables
+  /*! \ingroup linop */ 
+  typedef SiteStaggeredDslash AsqtadDslash; 
+
+}  // end namespace Chroma
+
+#else
 #include "actions/ferm/linop/asq_dsl_s.h"
 
 namespace Chroma 
@@ -18,3 +32,5 @@ namespace Chroma
 }  // end namespace Chroma
 
 #endif
+
+#endif
@@ -35,6 +35,12 @@ namespace Chroma {
 typedef PABWilsonDslashArray WilsonDslashArray;
 }  // end namespace Chroma
 
+#elif defined BUILD_SITE_WILSON_DSLASH_ARRAY && ! defined QDP_IS_QDPJIT
+# include "lwldslash_array_site_w.h"
+namespace Chroma {
+typedef SiteWilsonDslashArray WilsonDslashArray;
+}  // end namespace Chroma
+
 #else
 
 // Bottom line, if no optimised Dslash-s exist then the naive QDP Dslash
@@ -7,6 +7,99 @@ using namespace QDP::Hints;
 
 namespace Chroma 
 { 
+#ifndef QDP_IS_QDPJIT
+  //! Site kernels of the 4D-style even-odd preconditioned DWF operator
+  namespace EvenOddPrecDWLinOpArrayEnv
+  {
+    typedef LatticeFermion::Subtype_t  Spinor;
+
+    //! (1 + isign gamma_5)/2
+    template<bool plusP>
+    inline
+    Spinor projA(const Spinor& p)
+    {
+      Spinor d;
+      if (plusP)
+	d = chiralProjectPlus(p);
+      else
+	d = chiralProjectMinus(p);
+      return d;
+    }
+
+    //! (1 - isign gamma_5)/2
+    template<bool plusP>
+    inline
+    Spinor projB(const Spinor& p)
+    {
+      Spinor d;
+      if (plusP)
+	d = chiralProjectMinus(p);
+      else
+	d = chiralProjectPlus(p);
+      return d;
+    }
+
+
+    struct DiagInvArgs
+    {
+      multi1d<LatticeFermion>& chi;
+      const multi1d<LatticeFermion>& psi;
+      int N5;
+      const Real& two_kappa;
+      const Real& invd_two_kappa;
+      const Real* fact_l;
+      const Real* fact_r;
+      const int* tab;
+    };
+
+    //! The inverse of the diagonal block, solved over s for each site
+    /*!
+     * Same steps as the whole-lattice version: forward solve with L
+     * (rolling in the scaling by 2Kappa and the corner term), back
+     * substitution with R, and finally the inverse of Rm.
+     */
+    template<bool plusP>
+    inline
+    void diagInvSiteLoop(int lo, int hi, int my_id, DiagInvArgs* a)
+    {
+      const int N5 = a->N5;
+      const int N5m1 = N5-1;
+      const Real::Subtype_t& tk   = a->two_kappa.elem();
+      const Real::Subtype_t& idtk = a->invd_two_kappa.elem();
+
+      for(int ssite=lo; ssite < hi; ++ssite)
+      {
+	int site = a->tab[ssite];
+
+	const Spinor& p0 = a->psi[0].elem(site);
+	Spinor& xN = a->chi[N5m1].elem(site);
+
+	a->chi[0].elem(site) = tk * p0;
+	xN = idtk * a->psi[N5m1].elem(site) - a->fact_l[0].elem() * projB<plusP>(p0);
+
+	for(int s=1; s < N5m1; ++s)
+	{
+	  const Spinor& ps = a->psi[s].elem(site);
+	  a->chi[s].elem(site) = tk * ps + tk * projA<plusP>(a->chi[s-1].elem(site));
+	  xN -= a->fact_l[s].elem() * projB<plusP>(ps);
+	}
+
+	xN += idtk * projA<plusP>(a->chi[N5-2].elem(site));
+
+	// The inverse of R. Back substitution
+	for(int s=N5-2; s >= 0; --s)
+	  a->chi[s].elem(site) += tk * projB<plusP>(a->chi[s+1].elem(site));
+
+	// Finally the inverse of Rm
+	Spinor xN_a = projA<plusP>(xN);
+	for(int s=0; s < N5m1; ++s)
+	  a->chi[s].elem(site) -= a->fact_r[s].elem() * xN_a;
+      }
+    }
+  }
+#endif
+
+
   // Check Conventions... Currently I (Kostas) am using Blum et.al.
 
 
@@ -202,6 +295,42 @@ namespace Chroma
 
     if( chi.size() != N5 ) chi.resize(N5);
 
+#ifndef QDP_IS_QDPJIT
+    // The LU solve over s is done per site, with all N5 spinors of a site
+    // at hand, instead of as a sequence of whole-lattice passes.
+    // Coefficients of the corner terms: m_q (2Kappa)^(s+2)/D for the
+    // forward solve with L, and m_q (2Kappa)^(s+1) for the inverse of Rm.
+    multi1d<Real> fact_l(N5);
+    multi1d<Real> fact_r(N5);
+    Real fl = m_q*TwoKappa*TwoKappa*invDfactor;
+    Real fr = m_q*TwoKappa;
+    for(int s=0; s < N5; ++s)
+    {
+      fact_l[s] = fl;
+      fact_r[s] = fr;
+      fl *= TwoKappa;
+      fr *= TwoKappa;
+    }
+
+    Real invDTwoKappa = invDfactor*TwoKappa;
+
+    EvenOddPrecDWLinOpArrayEnv::DiagInvArgs arg = {chi, psi, N5, TwoKappa, invDTwoKappa,
+						   fact_l.slice(), fact_r.slice(),
+						   rb[cb].siteTable().slice()};
+
+    switch ( isign ) {
+
+    case PLUS:
+      dispatch_to_threads(rb[cb].numSiteTable(), arg,
+			  EvenOddPrecDWLinOpArrayEnv::diagInvSiteLoop<true>);
+      break ;
+    
+    case MINUS:
+      dispatch_to_threads(rb[cb].numSiteTable(), arg,
+			  EvenOddPrecDWLinOpArrayEnv::diagInvSiteLoop<false>);
+      break ;
+    }
+#else
     switch ( isign ) {
 
     case PLUS:
@@ -224,9 +353,6 @@ namespace Chroma
 	// Nc Ns flops/site
 	chi[s][rb[cb]] = TwoKappa * psi[s] + TwoKappa*chiralProjectPlus(chi[s-1]);
 
-	// 2Nc Ns flops/site
-	// chi[s][rb[cb]] += TwoKappa*chiralProjectPlus(chi[s-1]);
-
 	// 2Nc Ns flops/site
 	chi[N5-1][rb[cb]] -= fact*chiralProjectMinus(psi[s]);
 	fact *= TwoKappa;
@@ -267,14 +393,12 @@ namespace Chroma
       for(int s = 1; s < N5-1; s++) {
 	// 2Nc Ns flops
 	chi[s][rb[cb]] = TwoKappa * psi[s] + TwoKappa*chiralProjectMinus(chi[s-1]);
-	//	chi[s][rb[cb]] += TwoKappa*chiralProjectMinus(chi[s-1]);
 	chi[N5-1][rb[cb]] -= fact*chiralProjectPlus(psi[s]);
 	fact *= TwoKappa;
 
       }      
       chi[N5-1][rb[cb]] += invDTwoKappa*chiralProjectMinus(chi[N5-2]);
 
-
            
       //The inverse of R. Back substitution...... Getting there! 
       for(int s = N5-2; s >=0; s--) {
@@ -292,6 +416,7 @@ namespace Chroma
     }
     break ;
     }
+#endif
 
     //Done! That was not that bad after all....
     //See, I told you so...
@@ -0,0 +1,276 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Even-odd preconditioned NEF domain-wall operator for the inner solves of mixed precision solvers
+ */
+
+#ifndef __prec_nef_dumb_linop_array_w_h__
+#define __prec_nef_dumb_linop_array_w_h__
+
+#include "state.h"
+#include "fermbc.h"
+#include "linearop.h"
+#include "io/aniso_io.h"
+#include "actions/ferm/linop/lwldslash_w.h"
+
+
+namespace Chroma 
+{ 
+  //! Even-odd preconditioned NEF domain-wall Dirac operator of any precision
+  /*!
+   * \ingroup linop
+   *
+   * This routine is specific to Wilson fermions!
+   *
+   * A dumb version with only a constructor and the Schur complement
+   *
+   *      M  =  A_oo - A_oe A^(-1)_ee A_eo
+   *
+   * on the odd checkerboard, with the same normalization as
+   * EvenOddPrecNEFDWLinOpArray. With b5 = 1 and c5 = 0 it is exactly
+   * EvenOddPrecDWLinOpArray, including the anisotropic case. It is
+   * templated on the fermion type so that a single precision copy of
+   * a 5D operator can be built from the links of a double one.
+   */
+  template<typename T, typename P, typename Q>
+  class EvenOddPrecDumbNEFDWLinOpArrayT : public LinearOperatorArray<T>
+  {
+  public:
+    //! Full constructor
+    EvenOddPrecDumbNEFDWLinOpArrayT(Handle< FermState<T,P,Q> > fs,
+				    const Real& WilsonMass_, 
+				    const Real& b5_, 
+				    const Real& c5_, 
+				    const Real& m_q_, 
+				    int N5_,
+				    const AnisoParam_t& aniso)
+    {
+      WilsonMass = WilsonMass_;
+      m_q = m_q_;
+      b5  = b5_;
+      c5  = c5_;
+      N5  = N5_;
+
+      D.create(fs, aniso);
+
+      Real ff = where(aniso.anisoP, aniso.nu / aniso.xi_0, Real(1));
+      Real diag = 1 + (Nd-1)*ff - WilsonMass;
+
+      c5InvTwoKappa = 1.0 - c5*diag;
+      b5InvTwoKappa = 1.0 + b5*diag;
+      b5TwoKappa = 1.0 / b5InvTwoKappa;
+      TwoKappa = c5InvTwoKappa / b5InvTwoKappa;
+      invDfactor = 1.0/(1.0 + m_q*pow(TwoKappa,N5));
+    }
+
+    //! Destructor is automatic
+    ~EvenOddPrecDumbNEFDWLinOpArrayT() {}
+
+    //! Length of DW flavor index/space
+    int size() const {return N5;}
+
+    //! Only defined on the odd lattice
+    const Subset& subset() const {return rb[1];}
+
+    //! Return the fermion BC object for this linear operator
+    const FermBC<T,P,Q>& getFermBC() const {return D.getFermBC();}
+
+    //! Apply the operator onto a source std::vector
+    void operator() (multi1d<T>& chi, const multi1d<T>& psi, 
+		     enum PlusMinus isign) const
+    {
+      START_CODE();
+
+      multi1d<T>  tmp1(N5);
+      multi1d<T>  tmp2(N5);
+
+      /*  Tmp1   =  D     A^(-1)     D    Psi  */
+      /*      O      O,E        E,E   E,O    O */
+      applyOffDiag(tmp1, psi, isign, 0);
+      applyDiagInv(tmp2, tmp1, isign, 0);
+      applyOffDiag(tmp1, tmp2, isign, 1);
+
+      /*  Chi   =  A    Psi  -  Tmp1  */
+      /*     O      O,O    O        O */
+      applyDiag(chi, psi, isign, 1);
+      for(int n=0; n < N5; ++n)
+	chi[n][rb[1]] -= tmp1[n];
+
+      getFermBC().modifyF(chi, rb[1]);
+
+      END_CODE();
+    }
+
+  private:
+    //! The diagonal block
+    void applyDiag(multi1d<T>& chi, const multi1d<T>& psi, 
+		   enum PlusMinus isign, int cb) const
+    {
+      if( chi.size() != N5 ) chi.resize(N5);
+
+      Real c5InvTwoKappamf = m_q*c5InvTwoKappa;
+
+      switch ( isign ) 
+      {
+      case PLUS:
+	for(int s(1);s<N5-1;s++) { 
+	  chi[s][rb[cb]] = b5InvTwoKappa*psi[s] - c5InvTwoKappa*chiralProjectPlus(psi[s-1]);
+	  chi[s][rb[cb]] -= c5InvTwoKappa*chiralProjectMinus(psi[s+1]);
+	}
+	chi[0][rb[cb]] = b5InvTwoKappa*psi[0] - c5InvTwoKappa*chiralProjectMinus(psi[1]);
+	chi[0][rb[cb]] += c5InvTwoKappamf*chiralProjectPlus(psi[N5-1]);
+
+	chi[N5-1][rb[cb]] = b5InvTwoKappa*psi[N5-1] - c5InvTwoKappa*chiralProjectPlus(psi[N5-2]);
+	chi[N5-1][rb[cb]] += c5InvTwoKappamf*chiralProjectMinus(psi[0]);
+	break;
+
+      case MINUS:
+	for(int s(1);s<N5-1;s++) { 
+	  chi[s][rb[cb]] = b5InvTwoKappa*psi[s] - c5InvTwoKappa*chiralProjectPlus(psi[s+1]);
+	  chi[s][rb[cb]] -= c5InvTwoKappa*chiralProjectMinus(psi[s-1]);
+	}
+	chi[0][rb[cb]] = b5InvTwoKappa*psi[0] - c5InvTwoKappa*chiralProjectPlus(psi[1]);
+	chi[0][rb[cb]] += c5InvTwoKappamf*chiralProjectMinus(psi[N5-1]);
+
+	chi[N5-1][rb[cb]] = b5InvTwoKappa*psi[N5-1] - c5InvTwoKappa*chiralProjectMinus(psi[N5-2]);
+	chi[N5-1][rb[cb]] += c5InvTwoKappamf*chiralProjectPlus(psi[0]);
+	break;
+      }
+    }
+
+    //! The inverse of the diagonal block
+    void applyDiagInv(multi1d<T>& chi, const multi1d<T>& psi, 
+		      enum PlusMinus isign, int cb) const
+    {
+      if( chi.size() != N5 ) chi.resize(N5);
+
+      Real fact = m_q*TwoKappa*b5TwoKappa*invDfactor;
+      Real invDTwoKappa = invDfactor*TwoKappa;
+      Real invDb5TwoKappa = invDfactor*b5TwoKappa;
+
+      switch ( isign ) 
+      {
+      case PLUS:
+	chi[0][rb[cb]] = b5TwoKappa*psi[0];
+	chi[N5-1][rb[cb]] = invDb5TwoKappa*psi[N5-1] - fact*chiralProjectMinus(psi[0]);
+	fact *= TwoKappa;
+
+	for(int s = 1; s < N5-1; s++) {
+	  chi[s][rb[cb]] = b5TwoKappa*psi[s] + TwoKappa*chiralProjectPlus(chi[s-1]);
+	  chi[N5-1][rb[cb]] -= fact*chiralProjectMinus(psi[s]);
+	  fact *= TwoKappa;
+	}
+	chi[N5-1][rb[cb]] += invDTwoKappa*chiralProjectPlus(chi[N5-2]);
+
+	for(int s(N5-2);s>-1;s--)
+	  chi[s][rb[cb]] += TwoKappa*chiralProjectMinus(chi[s+1]);
+
+	fact = m_q*TwoKappa;
+	for(int s(0);s<N5-1;s++) {
+	  chi[s][rb[cb]] -= fact*chiralProjectPlus(chi[N5-1]);
+	  fact *= TwoKappa;
+	}
+	break;
+
+      case MINUS:
+	chi[0][rb[cb]] = b5TwoKappa*psi[0];
+	chi[N5-1][rb[cb]] = invDb5TwoKappa*psi[N5-1] - fact*chiralProjectPlus(psi[0]);
+	fact *= TwoKappa;
+
+	for(int s = 1; s < N5-1; s++) {
+	  chi[s][rb[cb]] = b5TwoKappa*psi[s] + TwoKappa*chiralProjectMinus(chi[s-1]);
+	  chi[N5-1][rb[cb]] -= fact*chiralProjectPlus(psi[s]);
+	  fact *= TwoKappa;
+	}
+	chi[N5-1][rb[cb]] += invDTwoKappa*chiralProjectMinus(chi[N5-2]);
+
+	for(int s(N5-2);s>-1;s--)
+	  chi[s][rb[cb]] += TwoKappa*chiralProjectPlus(chi[s+1]);
+
+	fact = m_q*TwoKappa;
+	for(int s(0);s<N5-1;s++) {
+	  chi[s][rb[cb]] -= fact*chiralProjectMinus(chi[N5-1]);
+	  fact *= TwoKappa;
+	}
+	break;
+      }
+    }
+
+    //! The off diagonal block
+    void applyOffDiag(multi1d<T>& chi, const multi1d<T>& psi, 
+		      enum PlusMinus isign, int cb) const
+    {
+      if( chi.size() != N5 ) chi.resize(N5);
+
+      Real fb5 = -Real(0.5)*b5;
+      Real fc5 = -Real(0.5)*c5;
+      Real fc5mf = fc5*m_q;
+
+      multi1d<T> tmp(N5);
+
+      switch ( isign ) 
+      {
+      case PLUS:
+      {
+	int otherCB = (cb + 1)%2;
+
+	for(int s = 1; s < N5-1; s++) {
+	  tmp[s][rb[otherCB]] = fb5*psi[s] + fc5*chiralProjectPlus(psi[s-1]);
+	  tmp[s][rb[otherCB]]+= fc5*chiralProjectMinus(psi[s+1]);
+	}
+	tmp[0][rb[otherCB]] = fb5*psi[0] + fc5*chiralProjectMinus(psi[1]);
+	tmp[0][rb[otherCB]] -= fc5mf*chiralProjectPlus(psi[N5-1]);
+
+	tmp[N5-1][rb[otherCB]] = fb5*psi[N5-1] + fc5*chiralProjectPlus(psi[N5-2]);
+	tmp[N5-1][rb[otherCB]] -= fc5mf*chiralProjectMinus(psi[0]);
+
+	for(int s = 0; s < N5; s++)
+	  D.apply(chi[s], tmp[s], isign, cb);
+      }
+      break;
+
+      case MINUS:
+      {
+	for(int s = 0; s < N5; s++)
+	  D.apply(tmp[s], psi[s], isign, cb);
+
+	for(int s(1);s<N5-1;s++) {
+	  chi[s][rb[cb]] = fb5*tmp[s] + fc5*chiralProjectPlus(tmp[s+1]);
+	  chi[s][rb[cb]] += fc5*chiralProjectMinus(tmp[s-1]);
+	}
+	chi[0][rb[cb]] = fb5*tmp[0] + fc5*chiralProjectPlus(tmp[1]);
+	chi[0][rb[cb]] -= fc5mf*chiralProjectMinus(tmp[N5-1]);
+
+	chi[N5-1][rb[cb]] = fb5*tmp[N5-1] + fc5*chiralProjectMinus(tmp[N5-2]);
+	chi[N5-1][rb[cb]] -= fc5mf*chiralProjectPlus(tmp[0]);
+      }
+      break;
+      }
+    }
+
+  private:
+    Real WilsonMass;
+    Real m_q;
+    Real b5;
+    Real c5;
+    int  N5;
+
+    Real c5InvTwoKappa;
+    Real b5InvTwoKappa;
+    Real b5TwoKappa;
+    Real TwoKappa;
+    Real invDfactor;
+
+    QDPWilsonDslashT<T,P,Q>  D;
+  };
+
+
+  //! Single precision NEF operator
+  /*! \ingroup linop */
+  typedef EvenOddPrecDumbNEFDWLinOpArrayT<LatticeFermionF, 
+					  multi1d<LatticeColorMatrixF>,
+					  multi1d<LatticeColorMatrixF> > EvenOddPrecDumbNEFDWFLinOpArray;
+
+} // End Namespace Chroma
+
+
+#endif
@@ -7,12 +7,108 @@
 //  recoded by mcneile
 //
 //  NO CHECKERBOARDING HERE
+//
+//  The staples are built from nested half staples, outermost last,
+//  so the 3-link staples are shared by the Lepage, 5-link and 7-link
+//  terms and each full staple needs only two shifts. Under QDP-JIT
+//  the staples are built one by one with shifts, as before.
+//
 
 #include "actions/ferm/linop/improvement_terms_s.h"
 
 namespace Chroma 
 { 
 
+#ifndef QDP_IS_QDPJIT
+  //! Fused site kernels for the fat links
+  namespace Fat7LinksEnv
+  {
+    typedef PColorMatrix<QDP::RComplex<REAL>, Nc>  CMat;
+
+    struct StapleArgs
+    {
+      LatticeColorMatrix& acc;             // acc += c * U_nu(x) X(x+nu) U_nu^dag(x+mu)
+      LatticeColorMatrix& w;               // w = U_nu^dag(x) X(x) U_nu(x+mu)
+      const LatticeColorMatrix& u_nu;
+      const LatticeColorMatrix& u_nu_mu;   // U_nu(x+mu)
+      const LatticeColorMatrix& x;
+      const LatticeColorMatrix& x_nu;      // X(x+nu)
+      REAL c;
+      bool do_fwd;
+      bool do_bwd;
+      const int* tab;
+    };
+
+    //! Both half staples of X in one pass over the sites
+    inline
+    void stapleSiteLoop(int lo, int hi, int my_id, StapleArgs* a)
+    {
+      for(int ssite=lo; ssite < hi; ++ssite)
+      {
+	int site = a->tab[ssite];
+
+	const CMat& u  = a->u_nu.elem(site).elem();
+	const CMat& um = a->u_nu_mu.elem(site).elem();
+
+	if (a->do_fwd)
+	{
+	  CMat t = u * a->x_nu.elem(site).elem();
+	  CMat s = t * adj(um);
+
+	  CMat& r = a->acc.elem(site).elem();
+	  for(int i=0; i < Nc; ++i)
+	    for(int j=0; j < Nc; ++j)
+	    {
+	      r.elem(i,j).real() += a->c * s.elem(i,j).real();
+	      r.elem(i,j).imag() += a->c * s.elem(i,j).imag();
+	    }
+	}
+
+	if (a->do_bwd)
+	{
+	  CMat t = adj(u) * a->x.elem(site).elem();
+	  a->w.elem(site).elem() = t * um;
+	}
+      }
+    }
+
+
+    //! Add the half staples of X in the nu direction to the mu link
+    /*!
+     *  fwd_acc += cf * U_nu(x) X(x+nu) U_nu^dag(x+mu)
+     *  bwd_acc += cb * U_nu^dag(x-nu) X(x-nu) U_nu(x-nu+mu)
+     *
+     * Either half is skipped if its coefficient pointer is null.
+     */
+    void halfStaples(LatticeColorMatrix* fwd_acc, const Real* cf,
+		     LatticeColorMatrix* bwd_acc, const Real* cb,
+		     const LatticeColorMatrix& x,
+		     const multi1d<LatticeColorMatrix>& u,
+		     const LatticeColorMatrix& u_nu_mu,
+		     int nu)
+    {
+      const Subset& s = all;
+      bool do_fwd = (fwd_acc != 0);
+      bool do_bwd = (bwd_acc != 0);
+
+      LatticeColorMatrix x_nu;
+      if (do_fwd)
+	x_nu = shift(x, FORWARD, nu);
+
+      LatticeColorMatrix w;
+      StapleArgs arg = {do_fwd ? *fwd_acc : w, w, u[nu], u_nu_mu, x,
+			do_fwd ? x_nu : x,
+			REAL(do_fwd ? toDouble(*cf) : 0.0), do_fwd, do_bwd,
+			s.siteTable().slice()};
+      dispatch_to_threads(s.numSiteTable(), arg, stapleSiteLoop);
+
+      if (do_bwd)
+	*bwd_acc += (*cb) * shift(w, BACKWARD, nu);
+    }
+  }
+#endif
+
+
   //
   //  u(Nd), probably should check
   //  uf(Nd),
@@ -24,94 +120,16 @@ namespace Chroma
   {
     START_CODE();
   
-    LatticeColorMatrix tmp_0;
-    LatticeColorMatrix tmp_1;
-    LatticeColorMatrix tmp_2;
-    LatticeColorMatrix tmp_3;
-    LatticeColorMatrix tmp_4;
-    Real c_1l;
-    Real c_3l;
-    Real c_5l;
-    Real c_7l;
-    Real c_Lepage;
-    int mu;
-    int nu;
-    int rho;
-    int sigma;
-
     // SZIN parameters from macros/primitives.mh
     // probably should be checked
-    //
-    //  enum SZINdir { BACKWARD= 0 ,  FORWARD = 1 }  ;
-
-  
-    if (Nd == 4)
-    {
-      c_1l = (Real)(5) / (Real)(8);
-      c_3l = (Real)(-1) / (u0*u0*(Real)(16));
-      c_5l = - c_3l / (u0*u0*(Real)(4));
-      c_7l = - c_5l / (u0*u0*(Real)(6));
-      c_Lepage = c_3l / (u0*u0);
-
-                    
-      for(mu=0; mu < Nd; ++mu)
-      {
-	uf[mu] = u[mu] * c_1l;
-      
-	for(nu=0; nu < Nd; ++nu) 
-	  if(nu != mu)
-	  {
-	    tmp_0 = u[nu] * shift(u[mu], FORWARD, nu); 
-	    tmp_2 = tmp_0 * shift(adj(u[nu]),  FORWARD, mu);
-					
-	    tmp_0 = u[nu] * shift(tmp_2,  FORWARD, nu);
-	    tmp_1 = tmp_0 * shift(adj(u[nu]),  FORWARD, mu);
-
-	    uf[mu] += tmp_1 * c_Lepage;
-
-	    tmp_0 = u[mu] * shift(u[nu] , FORWARD, mu);
-	    tmp_1 = shift(adj(u[nu]),  BACKWARD, nu) * shift(tmp_0, BACKWARD, nu);
-			
-	    tmp_2 += tmp_1;
-	    uf[mu] += tmp_2 * c_3l;
-
-	    tmp_0 = tmp_1 * shift(u[nu], FORWARD, mu);
-	    tmp_1 = shift(adj(u[nu]),  BACKWARD, nu) * shift(tmp_0, BACKWARD, nu);
-			
-	    uf[mu] += tmp_1 * c_Lepage;
-			
-	    for(rho=0; rho < Nd; ++rho) if(rho != mu && rho != nu)
-	    {
-	      tmp_0 = u[rho] * shift(tmp_2, FORWARD, rho);
-	      tmp_3 = tmp_0 * shift(adj(u[rho]), FORWARD, mu);
-
-	      tmp_0 = tmp_2 * shift(u[rho], FORWARD, mu);
-	      tmp_3 += shift(adj(u[rho]), BACKWARD, rho) * shift(tmp_0, BACKWARD, rho);
-			   
-	      uf[mu] += tmp_3 * c_5l;
-
-	      for(sigma=0; sigma < Nd; ++sigma)
-		if(sigma != mu && sigma != nu && sigma != rho)
-		{
-		  tmp_0 = u[sigma] * shift(tmp_3, FORWARD, sigma);
-		  tmp_1 = tmp_0 * shift(adj(u[sigma]), FORWARD, mu);
-
-		  tmp_0 = tmp_3 * shift(u[sigma], FORWARD, mu);
-		  tmp_1 += shift(adj(u[sigma]), BACKWARD, sigma) * shift(tmp_0,  BACKWARD, sigma);
-
-		  uf[mu] += tmp_1 * c_7l;
-			     
-		}	  
-	    }	     
-	  }	   
-      }	     
-    }			    
-    else
-    {
-      QDPIO::cerr << __func__ 
-		  << ": Fat7_links (generic) not implemented for this dim, Nd=" << Nd << std::endl;
-      QDP_abort(1);
-    }
+    fat7_param pp;
+    pp.c_1l = (Real)(5) / (Real)(8);
+    pp.c_3l = (Real)(-1) / (u0*u0*(Real)(16));
+    pp.c_5l = - pp.c_3l / (u0*u0*(Real)(4));
+    pp.c_7l = - pp.c_5l / (u0*u0*(Real)(6));
+    pp.c_Lepage = pp.c_3l / (u0*u0);
+
+    Fat7_Links(u, uf, pp);
   
     END_CODE();
   }
@@ -124,88 +142,151 @@ namespace Chroma
   {
     START_CODE();
   
+    if (Nd != 4)
+    {
+      QDPIO::cerr << __func__ 
+		  << ": Fat7_links (generic) not implemented for this dim, Nd=" << Nd << std::endl;
+      QDP_abort(1);
+    }
+
+#ifndef QDP_IS_QDPJIT
+    using namespace Fat7LinksEnv;
+
+    const Real one = 1;
+    const bool lepageP = toBool(pp.c_Lepage != Real(0));
+
+    // U_nu(x+mu), shared by every staple
+    multi2d<LatticeColorMatrix> u_up(Nd,Nd);
+    for(int mu=0; mu < Nd; ++mu)
+      for(int nu=0; nu < Nd; ++nu)
+	if (nu != mu)
+	  u_up(mu,nu) = shift(u[nu], FORWARD, mu);
+
+    uf.resize(Nd);
+
+    multi1d<LatticeColorMatrix> fwd(Nd);    // forward 3-link staples
+    multi1d<LatticeColorMatrix> bwd(Nd);    // backward 3-link staples
+    multi1d<LatticeColorMatrix> st3(Nd);    // full 3-link staples
+
+    for(int mu=0; mu < Nd; ++mu)
+    {
+      uf[mu] = u[mu] * pp.c_1l;
+
+      // 3-link staples: S_nu U_mu
+      for(int nu=0; nu < Nd; ++nu)
+      {
+	if (nu == mu)
+	  continue;
+
+	fwd[nu] = zero;
+	bwd[nu] = zero;
+	halfStaples(&fwd[nu], &one, &bwd[nu], &one, u[mu], u, u_up(mu,nu), nu);
+
+	st3[nu] = fwd[nu] + bwd[nu];
+	uf[mu] += st3[nu] * pp.c_3l;
+      }
+
+      // Lepage: the forward (backward) staple of the forward (backward) staple
+      if (lepageP)
+      {
+	for(int nu=0; nu < Nd; ++nu)
+	{
+	  if (nu == mu)
+	    continue;
+
+	  halfStaples(&uf[mu], &pp.c_Lepage, 0, 0, fwd[nu], u, u_up(mu,nu), nu);
+	  halfStaples(0, 0, &uf[mu], &pp.c_Lepage, bwd[nu], u, u_up(mu,nu), nu);
+	}
+      }
+
+      // 5- and 7-link staples. By linearity
+      //   sum c5 S_a S_b U + c7 S_a S_b S_c U  =  sum_a S_a [ sum_b S_b ( c5 U + c7 S_c U ) ]
+      // with a, b, c distinct and different from mu.
+      for(int a=0; a < Nd; ++a)
+      {
+	if (a == mu)
+	  continue;
+
+	LatticeColorMatrix y = zero;
+
+	for(int b=0; b < Nd; ++b)
+	{
+	  if (b == mu || b == a)
+	    continue;
+
+	  int c = 0;
+	  while (c == mu || c == a || c == b)
+	    ++c;
+
+	  LatticeColorMatrix x = u[mu] * pp.c_5l + st3[c] * pp.c_7l;
+	  halfStaples(&y, &one, &y, &one, x, u, u_up(mu,b), b);
+	}
+
+	halfStaples(&uf[mu], &one, &uf[mu], &one, y, u, u_up(mu,a), a);
+      }
+    }
+#else
     LatticeColorMatrix tmp_0;
     LatticeColorMatrix tmp_1;
     LatticeColorMatrix tmp_2;
     LatticeColorMatrix tmp_3;
-    LatticeColorMatrix tmp_4;
 
-    int mu;
-    int nu;
-    int rho;
-    int sigma;
+    uf.resize(Nd);
 
-    // SZIN parameters from macros/primitives.mh
-    // probably should be checked
-    //
-    //  enum SZINdir { BACKWARD= 0 ,  FORWARD = 1 }  ;
-
-  
-    if (Nd == 4)
+    for(int mu=0; mu < Nd; ++mu)
     {
-                    
-      for(mu=0; mu < Nd; ++mu)
-      {
-	uf[mu] = u[mu] * pp.c_1l;
+      uf[mu] = u[mu] * pp.c_1l;
       
-	for(nu=0; nu < Nd; ++nu) 
-	  if(nu != mu)
-	  {
-	    tmp_0 = u[nu] * shift(u[mu], FORWARD, nu); 
-	    tmp_2 = tmp_0 * shift(adj(u[nu]),  FORWARD, mu);
+      for(int nu=0; nu < Nd; ++nu) 
+	if(nu != mu)
+	{
+	  tmp_0 = u[nu] * shift(u[mu], FORWARD, nu); 
+	  tmp_2 = tmp_0 * shift(adj(u[nu]),  FORWARD, mu);
 					
-	    tmp_0 = u[nu] * shift(tmp_2,  FORWARD, nu);
-	    tmp_1 = tmp_0 * shift(adj(u[nu]),  FORWARD, mu);
+	  tmp_0 = u[nu] * shift(tmp_2,  FORWARD, nu);
+	  tmp_1 = tmp_0 * shift(adj(u[nu]),  FORWARD, mu);
 
-	    uf[mu] += tmp_1 * pp.c_Lepage;
+	  uf[mu] += tmp_1 * pp.c_Lepage;
 
-	    tmp_0 = u[mu] * shift(u[nu] , FORWARD, mu);
-	    tmp_1 = shift(adj(u[nu]),  BACKWARD, nu) * shift(tmp_0, BACKWARD, nu);
+	  tmp_0 = u[mu] * shift(u[nu] , FORWARD, mu);
+	  tmp_1 = shift(adj(u[nu]),  BACKWARD, nu) * shift(tmp_0, BACKWARD, nu);
 			
-	    tmp_2 += tmp_1;
-	    uf[mu] += tmp_2 * pp.c_3l;
+	  tmp_2 += tmp_1;
+	  uf[mu] += tmp_2 * pp.c_3l;
 
-	    tmp_0 = tmp_1 * shift(u[nu], FORWARD, mu);
-	    tmp_1 = shift(adj(u[nu]),  BACKWARD, nu) * shift(tmp_0, BACKWARD, nu);
+	  tmp_0 = tmp_1 * shift(u[nu], FORWARD, mu);
+	  tmp_1 = shift(adj(u[nu]),  BACKWARD, nu) * shift(tmp_0, BACKWARD, nu);
 			
-	    uf[mu] += tmp_1 * pp.c_Lepage;
+	  uf[mu] += tmp_1 * pp.c_Lepage;
 			
-	    for(rho=0; rho < Nd; ++rho) if(rho != mu && rho != nu)
-	    {
-	      tmp_0 = u[rho] * shift(tmp_2, FORWARD, rho);
-	      tmp_3 = tmp_0 * shift(adj(u[rho]), FORWARD, mu);
+	  for(int rho=0; rho < Nd; ++rho) if(rho != mu && rho != nu)
+	  {
+	    tmp_0 = u[rho] * shift(tmp_2, FORWARD, rho);
+	    tmp_3 = tmp_0 * shift(adj(u[rho]), FORWARD, mu);
 
-	      tmp_0 = tmp_2 * shift(u[rho], FORWARD, mu);
-	      tmp_3 += shift(adj(u[rho]), BACKWARD, rho) * shift(tmp_0, BACKWARD, rho);
+	    tmp_0 = tmp_2 * shift(u[rho], FORWARD, mu);
+	    tmp_3 += shift(adj(u[rho]), BACKWARD, rho) * shift(tmp_0, BACKWARD, rho);
 			   
-	      uf[mu] += tmp_3 * pp.c_5l;
-
-	      for(sigma=0; sigma < Nd; ++sigma)
-		if(sigma != mu && sigma != nu && sigma != rho)
-		{
-		  tmp_0 = u[sigma] * shift(tmp_3, FORWARD, sigma);
-		  tmp_1 = tmp_0 * shift(adj(u[sigma]), FORWARD, mu);
-
-		  tmp_0 = tmp_3 * shift(u[sigma], FORWARD, mu);
-		  tmp_1 += shift(adj(u[sigma]), BACKWARD, sigma) * shift(tmp_0,  BACKWARD, sigma);
-
-		  uf[mu] += tmp_1 * pp.c_7l;
-			     
-		}	  
-	    }	     
-	  }	   
-      }	     
-    }			    
-    else
-    {
-      QDPIO::cerr << __func__ 
-		  << ": Fat7_links (generic) not implemented for this dim, Nd=" << Nd << std::endl;
-      QDP_abort(1);
-    }
+	    uf[mu] += tmp_3 * pp.c_5l;
+
+	    for(int sigma=0; sigma < Nd; ++sigma)
+	      if(sigma != mu && sigma != nu && sigma != rho)
+	      {
+		tmp_0 = u[sigma] * shift(tmp_3, FORWARD, sigma);
+		tmp_1 = tmp_0 * shift(adj(u[sigma]), FORWARD, mu);
+
+		tmp_0 = tmp_3 * shift(u[sigma], FORWARD, mu);
+		tmp_1 += shift(adj(u[sigma]), BACKWARD, sigma) * shift(tmp_0,  BACKWARD, sigma);
+
+		uf[mu] += tmp_1 * pp.c_7l;
+	      }	  
+	  }	     
+	}	   
+    }	     
+#endif
 
     END_CODE();
   }
 
 } // End Namespace Chroma
 
-
@@ -4,6 +4,7 @@
 #include <math.h>
 #include "chromabase.h"
 #include "actions/ferm/linop/lg5eps_w.h"
+#include "actions/ferm/linop/lovlap_lowmode_proj_w.h"
 #include "meas/eig/gramschm.h"
 
 
@@ -80,19 +81,10 @@ void lg5eps::operator() (LatticeFermion& chi, const LatticeFermion& psi,
   // chi  +=  func(lambda) * EigVec * <EigVec, psi>  
   // Usually "func(.)" is sgn(.); it is precomputed in EigValFunc. 
   // for all the eigenvalues
-  if (NEig > 0)
-  {
-    Complex cconsts;
-    LatticeFermion tmp3 = tmp1;
-    for(int i = 0; i < NEig; ++i)
-    {
-      cconsts = innerProduct(EigVec[i], tmp3);
-      tmp1 -= EigVec[i] * cconsts;
-
-      cconsts *= EigValFunc[i];
-      chi += EigVec[i] * cconsts;
-    }
-  }
+  //
+  // All the overlaps < EigVec, tmp1 > are formed in one pass over the
+  // lattice and the projection is reconstructed in a second pass
+  lowModeProject(chi, tmp1, EigVec, EigValFunc, NEig);
 
   // tmp1 <- H * Projected psi 
   //      <- gamma_5 * M * psi 
@@ -0,0 +1,209 @@
+/*! \file
+ *  \brief Blocked projection of low modes for the overlap sign function
+ */
+
+#include "chromabase.h"
+#include "actions/ferm/linop/lovlap_lowmode_proj_w.h"
+
+namespace Chroma
+{
+
+#ifndef QDP_IS_QDPJIT
+  //! Site kernels for the blocked low mode projection
+  namespace LowModeProjEnv
+  {
+    //! Number of reals in one site of a fermion
+    const int site_len = 2*Ns*Nc;
+
+    struct CoeffArgs
+    {
+      const multi1d<LatticeFermion>& EigVec;
+      const LatticeFermion& psi;
+      const int* tab;
+      int NEig;
+      REAL64* partial;     // 2*NEig reals per thread
+    };
+
+    //! Accumulate < EigVec[i], psi > for all i over a block of sites
+    inline
+    void coeffSiteLoop(int lo, int hi, int my_id, CoeffArgs* a)
+    {
+      const int NEig = a->NEig;
+      REAL64* acc = a->partial + 2*NEig*my_id;
+
+      for(int i=0; i < 2*NEig; ++i)
+	acc[i] = 0;
+
+      for(int ssite=lo; ssite < hi; ++ssite)
+      {
+	int site = a->tab[ssite];
+	const REAL* p = (const REAL *)&(a->psi.elem(site).elem(0).elem(0).real());
+
+	for(int i=0; i < NEig; ++i)
+	{
+	  const REAL* v = (const REAL *)&(a->EigVec[i].elem(site).elem(0).elem(0).real());
+
+	  REAL64 re = 0;
+	  REAL64 im = 0;
+	  for(int j=0; j < site_len; j+=2)
+	  {
+	    re += v[j]*p[j] + v[j+1]*p[j+1];
+	    im += v[j]*p[j+1] - v[j+1]*p[j];
+	  }
+	  acc[2*i]   += re;
+	  acc[2*i+1] += im;
+	}
+      }
+    }
+
+
+    struct ProjArgs
+    {
+      LatticeFermion& chi;
+      LatticeFermion& psi;
+      const multi1d<LatticeFermion>& EigVec;
+      const int* tab;
+      int NEig;
+      const REAL* c;       // c_i
+      const REAL* fc;      // EigValFunc[i] * c_i
+    };
+
+    //! psi -= sum_i c_i v_i  and  chi += sum_i f_i c_i v_i  over a block of sites
+    inline
+    void projSiteLoop(int lo, int hi, int my_id, ProjArgs* a)
+    {
+      const int NEig = a->NEig;
+
+      for(int ssite=lo; ssite < hi; ++ssite)
+      {
+	int site = a->tab[ssite];
+	REAL* p = (REAL *)&(a->psi.elem(site).elem(0).elem(0).real());
+	REAL* x = (REAL *)&(a->chi.elem(site).elem(0).elem(0).real());
+
+	for(int i=0; i < NEig; ++i)
+	{
+	  const REAL* v = (const REAL *)&(a->EigVec[i].elem(site).elem(0).elem(0).real());
+	  const REAL c_re  = a->c[2*i];
+	  const REAL c_im  = a->c[2*i+1];
+	  const REAL fc_re = a->fc[2*i];
+	  const REAL fc_im = a->fc[2*i+1];
+
+	  for(int j=0; j < site_len; j+=2)
+	  {
+	    p[j]   -= v[j]*c_re - v[j+1]*c_im;
+	    p[j+1] -= v[j]*c_im + v[j+1]*c_re;
+	    x[j]   += v[j]*fc_re - v[j+1]*fc_im;
+	    x[j+1] += v[j]*fc_im + v[j+1]*fc_re;
+	  }
+	}
+      }
+    }
+  }
+#endif
+
+
+  //! Compute all low mode coefficients in one sweep
+  void lowModeCoeffs(multi1d<DComplex>& coeffs,
+		     const multi1d<LatticeFermion>& EigVec,
+		     int NEig,
+		     const LatticeFermion& psi)
+  {
+    START_CODE();
+
+    coeffs.resize(NEig);
+    if (NEig <= 0)
+    {
+      END_CODE();
+      return;
+    }
+
+    if (EigVec.size() < NEig)
+    {
+      QDPIO::cerr << __func__ << ": fewer eigenvectors than NEig = " << NEig << std::endl;
+      QDP_abort(1);
+    }
+
+#ifndef QDP_IS_QDPJIT
+    const Subset& s = all;
+    const int nthr = qdpNumThreads();
+
+    multi1d<REAL64> partial(2*NEig*nthr);
+    LowModeProjEnv::CoeffArgs arg = {EigVec, psi, s.siteTable().slice(), NEig, partial.slice()};
+    dispatch_to_threads(s.numSiteTable(), arg, LowModeProjEnv::coeffSiteLoop);
+
+    // Sum over threads, then one global sum for all the coefficients
+    multi1d<REAL64> sums(2*NEig);
+    sums = 0;
+    for(int t=0; t < nthr; ++t)
+      for(int i=0; i < 2*NEig; ++i)
+	sums[i] += partial[2*NEig*t + i];
+
+    QDPInternal::globalSumArray(sums.slice(), 2*NEig);
+
+    for(int i=0; i < NEig; ++i)
+      coeffs[i] = cmplx(Double(sums[2*i]), Double(sums[2*i+1]));
+#else
+    for(int i=0; i < NEig; ++i)
+      coeffs[i] = innerProduct(EigVec[i], psi);
+#endif
+
+    END_CODE();
+  }
+
+
+  //! Project out low modes and add their exact sign function contribution
+  void lowModeProject(LatticeFermion& chi,
+		      LatticeFermion& psi,
+		      const multi1d<LatticeFermion>& EigVec,
+		      const multi1d<Real>& EigValFunc,
+		      int NEig)
+  {
+    START_CODE();
+
+    if (NEig <= 0)
+    {
+      END_CODE();
+      return;
+    }
+
+#ifndef QDP_IS_QDPJIT
+    // Pass 1: all the overlaps at once
+    multi1d<DComplex> coeffs;
+    lowModeCoeffs(coeffs, EigVec, NEig, psi);
+
+    multi1d<REAL> c(2*NEig);
+    multi1d<REAL> fc(2*NEig);
+    for(int i=0; i < NEig; ++i)
+    {
+      Complex cc = coeffs[i];
+      Complex fcc = cc * EigValFunc[i];
+
+      c[2*i]    = toDouble(real(cc));
+      c[2*i+1]  = toDouble(imag(cc));
+      fc[2*i]   = toDouble(real(fcc));
+      fc[2*i+1] = toDouble(imag(fcc));
+    }
+
+    // Pass 2: reconstruct both the projected vector and the low mode part
+    const Subset& s = all;
+    LowModeProjEnv::ProjArgs arg = {chi, psi, EigVec, s.siteTable().slice(), NEig,
+				    c.slice(), fc.slice()};
+    dispatch_to_threads(s.numSiteTable(), arg, LowModeProjEnv::projSiteLoop);
+#else
+    // The overlaps are all taken with the unprojected vector
+    LatticeFermion tmp = psi;
+
+    for(int i=0; i < NEig; ++i)
+    {
+      Complex cconsts = innerProduct(EigVec[i], tmp);
+      psi -= EigVec[i] * cconsts;
+
+      cconsts *= EigValFunc[i];
+      chi += EigVec[i] * cconsts;
+    }
+#endif
+
+    END_CODE();
+  }
+
+} // End Namespace Chroma
@@ -0,0 +1,66 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Blocked projection of low modes for the overlap sign function
+ */
+
+#ifndef __lovlap_lowmode_proj_w_h__
+#define __lovlap_lowmode_proj_w_h__
+
+#include "chromabase.h"
+
+namespace Chroma
+{
+  //! Compute all low mode coefficients in one sweep
+  /*!
+   * \ingroup linop
+   *
+   * Computes  coeffs[i] = < EigVec[i], psi >  for i < NEig.
+   *
+   * The lattice is traversed once; at each site psi is loaded a single
+   * time and contracted against all the eigenvectors. The NEig partial
+   * sums are combined in a single global reduction instead of one per
+   * eigenvector.
+   *
+   * \param coeffs     the coefficients < EigVec[i], psi >    (Write)
+   * \param EigVec     eigenvectors                           (Read)
+   * \param NEig       number of eigenvectors to use          (Read)
+   * \param psi        source                                 (Read)
+   */
+  void lowModeCoeffs(multi1d<DComplex>& coeffs,
+		     const multi1d<LatticeFermion>& EigVec,
+		     int NEig,
+		     const LatticeFermion& psi);
+
+
+  //! Project out low modes and add their exact sign function contribution
+  /*!
+   * \ingroup linop
+   *
+   * Equivalent to the usual loop
+   *
+   *   c_i  = < EigVec[i], psi >
+   *   psi -= c_i EigVec[i]
+   *   chi += EigValFunc[i] c_i EigVec[i]
+   *
+   * but with all the c_i computed in one fused pass (see lowModeCoeffs)
+   * and both updates reconstructed in a second pass over the lattice.
+   * The coefficients are taken from the original psi, hence this is a
+   * classical Gram-Schmidt. It agrees with the modified version
+   * for orthonormal eigenvectors. Under QDP-JIT the usual loop is kept.
+   *
+   * \param chi        accumulates the low mode part of eps(H)  (Modify)
+   * \param psi        vector to be projected                   (Modify)
+   * \param EigVec     eigenvectors                             (Read)
+   * \param EigValFunc function of the eigenvalues, e.g. sgn()  (Read)
+   * \param NEig       number of eigenvectors to use            (Read)
+   */
+  void lowModeProject(LatticeFermion& chi,
+		      LatticeFermion& psi,
+		      const multi1d<LatticeFermion>& EigVec,
+		      const multi1d<Real>& EigValFunc,
+		      int NEig);
+
+} // End Namespace Chroma
+
+
+#endif
@@ -0,0 +1,227 @@
+/*! \file
+ *  \brief Overlap-pole operator with a mixed precision inner solve
+ */
+#include <math.h>
+#include "chromabase.h"
+#include "actions/ferm/linop/lovlap_mixed_prec_w.h"
+#include "actions/ferm/linop/lovlap_lowmode_proj_w.h"
+#include "actions/ferm/linop/unprec_wilson_dumb_linop_w.h"
+#include "actions/ferm/fermstates/periodic_fermstate.h"
+#include "actions/ferm/invert/minvcg.h"
+#include "meas/eig/gramschm.h"
+#include "lmdagm.h"
+
+
+namespace Chroma 
+{ 
+  //! Maximum number of double precision corrections per pole
+  static const int max_outer_mixed_prec = 10;
+
+
+  //! Creation routine
+  lovlap_mixed_prec::lovlap_mixed_prec(const UnprecWilsonTypeFermAct<T,P,Q>& S_aux,
+				       Handle< FermState<T,P,Q> > state,
+				       const WilsonFermActParams& kernel_param,
+				       const Real& _m_q, int _numroot, 
+				       const Real& _constP, 
+				       const multi1d<Real>& _resP,
+				       const multi1d<Real>& _rootQ, 
+				       int _NEig,
+				       const multi1d<Real>& _EigValFunc,
+				       const multi1d<LatticeFermion>& _EigVec,
+				       int _MaxCG,
+				       const Real& _RsdCG,
+				       const Real& _RsdCGSingle) :
+    M(S_aux.linOp(state)), MdagM(S_aux.lMdagM(state)), fbc(state->getFermBC()),
+    m_q(_m_q), numroot(_numroot), constP(_constP),
+    resP(_resP), rootQ(_rootQ), EigVec(_EigVec), EigValFunc(_EigValFunc),
+    NEig(_NEig), MaxCG(_MaxCG), RsdCG(_RsdCG), RsdCGSingle(_RsdCGSingle)
+  {
+    START_CODE();
+
+    // The links of the state already have the BCs applied,
+    // so a periodic single precision state is enough
+    QF links_single(Nd);
+    const Q& links = state->getLinks();
+    for(int mu=0; mu < Nd; ++mu)
+      links_single[mu] = links[mu];
+
+    fstate_single = new PeriodicFermState<TF,QF,QF>(links_single);
+
+    Handle< LinearOperator<TF> > M_single(new UnprecDumbWilsonFLinOp(fstate_single, kernel_param));
+    MdagM_single = new MdagMLinOp<TF>(M_single);
+
+    END_CODE();
+  }
+
+
+  void lovlap_mixed_prec::operator() (LatticeFermion& chi, const LatticeFermion& psi, 
+				      enum PlusMinus isign) const
+  {
+    operator()(chi, psi, isign, RsdCG);
+  }
+
+
+  //! Apply the GW operator onto a source std::vector
+  /*! \ingroup linop
+   *
+   * The operator applied is:
+   *       D       =    (1/2)[  (1+m) + (1-m)gamma_5 sgn(H_w) ] psi
+   * or    D^{dag} =    (1/2)[  (1+m) + (1-m) sgn(H_w) gamma_5 psi
+   * 
+   * \param chi     result std::vector                              (Write)  
+   * \param psi 	  source std::vector         	             (Read)
+   * \param isign   Hermitian Conjugation Flag 
+   *                ( PLUS = no dagger| MINUS = dagger )       (Read)
+   * \param epsilon target accuracy of the sign function       (Read)
+   */
+  void lovlap_mixed_prec::operator() (LatticeFermion& chi, const LatticeFermion& psi, 
+				      enum PlusMinus isign, Real epsilon) const
+  {
+    START_CODE();
+
+    LatticeFermion tmp1, tmp2;
+
+    // Gamma_5 
+    int G5 = Ns*Ns - 1;
+
+    // Mass for shifted system
+    Real mass = Real(1 + m_q) / Real(1 - m_q);
+
+    switch (isign)
+    {
+    case PLUS:
+      //  chi  :=  gamma_5 * (gamma_5 * mass + sgn(H)) * Psi  
+      tmp1 = psi;
+      break;
+
+    case MINUS:
+      //  chi  :=  (mass + sgn(H) * gamma_5) * Psi  
+      tmp1 = Gamma(G5) * psi;
+      break;
+
+    default:
+      QDP_error_exit("unknown isign value", isign);
+    }
+
+    chi = zero;
+
+    // Exact low mode part of eps(H), and project those modes out of tmp1
+    lowModeProject(chi, tmp1, EigVec, EigValFunc, NEig);
+
+    // b <- H * Projected tmp1
+    LatticeFermion b;
+    (*M)(tmp2, tmp1, PLUS);
+    b = Gamma(G5) * tmp2;
+
+    Double c = norm2(b);
+
+    /* If exactly 0 norm, then solution must be 0 (for pos. def. operator) */
+    if (toBool(c == 0))
+    {
+      chi = zero;
+      END_CODE();
+      return;
+    }
+
+    // Same residual target for each pole as lovlapms
+    Real epsilon_normalise = epsilon*(Real(1)-m_q)/Real(2);
+    Real epsilon_target = epsilon_normalise/(Real(2) + epsilon_normalise);
+    Double rsd_sq = norm2(psi)*epsilon_target*epsilon_target;
+
+    if (isign == PLUS)
+    {
+      tmp2 = Gamma(G5) * psi;
+      chi += tmp2 * mass;
+    }
+    else
+    {
+      chi += psi * mass;
+    }
+
+    // Multiply in P(0) -- this may well be 0 for type 0 rational approximations
+    chi += b * constP;
+
+    // *******************************************************************
+    // Single precision multi-shift:  (MdagM + rootQ_n) x_n = b
+    // The relative target is never tighter than single precision can deliver
+    multi1d<Real> rsd_single(numroot);
+    {
+      Real rsd_rel = Real(sqrt(rsd_sq / c));
+      for(int s = 0; s < numroot; ++s)
+	rsd_single[s] = where(rsd_rel > RsdCGSingle, rsd_rel, RsdCGSingle);
+    }
+
+    TF b_single;
+    b_single = b;
+    multi1d<TF> x_single(numroot);
+    int n_count_single = 0;
+    MInvCG(*MdagM_single, b_single, x_single, rootQ, rsd_single, MaxCG, n_count_single);
+
+    // *******************************************************************
+    // Double precision correction of each pole, then accumulate
+    //   chi += sum_n resP_n x_n
+    int n_count_correct = 0;
+    multi1d<Real> one_shift(1);
+    multi1d<Real> one_rsd(1);
+    one_rsd[0] = RsdCGSingle;
+
+    for(int s = 0; s < numroot; ++s)
+    {
+      LatticeFermion x, r;
+      x = x_single[s];
+      one_shift[0] = rootQ[s];
+
+      int k;
+      for(k = 0; k < max_outer_mixed_prec; ++k)
+      {
+	// r = b - (MdagM + rootQ_n) x   in double
+	(*MdagM)(tmp2, x, PLUS);
+	tmp2 += x * rootQ[s];
+	r = b - tmp2;
+	GramSchm(r, EigVec, NEig, all);
+
+	if (toBool(norm2(r) < rsd_sq))
+	  break;
+
+	// Single precision correction  (MdagM + rootQ_n) e = r
+	TF r_single;
+	r_single = r;
+	multi1d<TF> e_single(1);
+	int n_count = 0;
+	MInvCG(*MdagM_single, r_single, e_single, one_shift, one_rsd, MaxCG, n_count);
+	n_count_correct += n_count;
+
+	tmp2 = e_single[0];
+	x += tmp2;
+      }
+
+      if (k == max_outer_mixed_prec)
+      {
+	QDPIO::cerr << "lovlap_mixed_prec: pole " << s 
+		    << " not converged after " << k << " corrections" << std::endl;
+	QDP_abort(1);
+      }
+
+      chi += x * resP[s];
+    }
+
+    QDPIO::cout << "Overlap Inner Solve (lovlap_mixed_prec): " << n_count_single 
+		<< " single prec. multi-shift iterations, " 
+		<< n_count_correct << " correction iterations" << std::endl;
+
+    // Now fix up the thing. Multiply in gamma5 if needed 
+    // and then rescale to correct normalisation.
+    if (isign == PLUS)
+    {
+      tmp1 = Gamma(G5) * chi;
+      chi = tmp1;
+    }
+
+    // Rescale to the correct normalization 
+    chi *= 0.5 * (1 - m_q);
+
+    END_CODE();
+  }
+
+} // End Namespace Chroma
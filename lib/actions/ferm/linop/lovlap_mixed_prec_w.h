@@ -0,0 +1,128 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Internal Overlap-pole operator with a mixed precision inner solve
+ */
+
+#ifndef __lovlap_mixed_prec_w_h__
+#define __lovlap_mixed_prec_w_h__
+
+#include "linearop.h"
+#include "unprec_wilstype_fermact_w.h" 
+#include "actions/ferm/fermacts/wilson_fermact_params_w.h"
+
+
+namespace Chroma 
+{ 
+  //! Internal Overlap-pole operator with mixed precision multi-shift
+  /*!
+   * \ingroup linop
+   *
+   * This routine is specific to Wilson fermions!
+   *
+   *   Chi  =   (1/2)*((1+m_q) + (1-m_q) * gamma_5 * B) . Psi 
+   *  where  B  is the pole approx. to eps(H(m)) 
+   *
+   * Same operator as lovlapms, but the shifted systems
+   *
+   *   (H^2 + rootQ_n) x_n = H psi
+   *
+   * are first solved with a single precision multi-shift CG. Each x_n
+   * is then corrected in double precision: the true residual is formed
+   * with the double precision kernel and a single precision (single shift)
+   * CG solves for the correction, until the residual meets the target
+   * of lovlapms.
+   *
+   * The single precision kernel is an unpreconditioned Wilson operator
+   * built from the (already BC modified) links of the state, so the
+   * auxiliary action must be UNPREC_WILSON.
+   */
+  class lovlap_mixed_prec : public UnprecLinearOperator<LatticeFermion, 
+	    multi1d<LatticeColorMatrix>, multi1d<LatticeColorMatrix> >
+  {
+  public:
+    // Typedefs to save typing
+    typedef LatticeFermion               T;
+    typedef multi1d<LatticeColorMatrix>  P;
+    typedef multi1d<LatticeColorMatrix>  Q;
+
+    typedef LatticeFermionF              TF;
+    typedef multi1d<LatticeColorMatrixF> QF;
+
+    //! Creation routine
+    /*!
+     * \ingroup linop
+     *
+     * \param S_aux           Auxiliary (kernel) action          (Read)
+     * \param state           Gauge field state                  (Read)
+     * \param kernel_param    Mass and aniso of the kernel       (Read)
+     * \param _m_q            quark mass                         (Read)
+     * \param _numroot 	    number of poles in expansion       (Read)
+     * \param _constP         constant coeff                     (Read)
+     * \param _resP           numerator                          (Read)
+     * \param _rootQ          denom                              (Read)
+     * \param _NEig           number of eigenvalues              (Read)
+     * \param _EigValFunc     eigenvalues      	               (Read)
+     * \param _EigVec         eigenvectors      	               (Read)
+     * \param _MaxCG          MaxCG inner CG                     (Read)
+     * \param _RsdCG          residual for inner CG              (Read)
+     * \param _RsdCGSingle    residual for single prec. solves   (Read)
+     */
+    lovlap_mixed_prec(const UnprecWilsonTypeFermAct<T,P,Q>& S_aux,
+		      Handle< FermState<T,P,Q> > state,
+		      const WilsonFermActParams& kernel_param,
+		      const Real& _m_q, int _numroot, 
+		      const Real& _constP, 
+		      const multi1d<Real>& _resP,
+		      const multi1d<Real>& _rootQ, 
+		      int _NEig,
+		      const multi1d<Real>& _EigValFunc,
+		      const multi1d<LatticeFermion>& _EigVec,
+		      int _MaxCG,
+		      const Real& _RsdCG,
+		      const Real& _RsdCGSingle);
+
+    //! Destructor is automatic
+    ~lovlap_mixed_prec() {}
+ 
+    //! Only defined on the entire lattice
+    const Subset& subset() const {return all;}
+
+    //! Apply the operator onto a source std::vector
+    void operator() (LatticeFermion& chi, const LatticeFermion& psi, enum PlusMinus isign) const;
+
+    //! Apply the operator onto a source std::vector
+    //! but to specified accuracy. In this case epsilon is the accuracy
+    //! (RsdCG) for the multi shift solve
+    void operator() (LatticeFermion& chi, const LatticeFermion& psi, enum PlusMinus isign, Real epsilon) const;
+ 
+    //! Return the fermion BC object for this linear operator
+    const FermBC<T,P,Q>& getFermBC() const {return *fbc;}
+
+  private:
+    Handle< DiffLinearOperator<T,P,Q> > M;
+    Handle< DiffLinearOperator<T,P,Q> > MdagM;
+    Handle< FermBC<T,P,Q> >     fbc;
+
+    // Single precision kernel
+    Handle< FermState<TF,QF,QF> > fstate_single;
+    Handle< LinearOperator<TF> >  MdagM_single;
+
+    // Copy all of these rather than reference them.
+    const Real m_q;
+    int numroot;
+    const Real constP;
+    const multi1d<Real> resP;
+    const multi1d<Real> rootQ;
+    const multi1d<LatticeFermion> EigVec;
+    const multi1d<Real> EigValFunc;
+    int NEig;
+    int MaxCG;
+    const Real RsdCG;
+    const Real RsdCGSingle;
+  };
+
+
+} // End Namespace Chroma
+
+
+#endif
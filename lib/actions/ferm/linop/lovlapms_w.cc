@@ -4,6 +4,7 @@
 #include <math.h>
 #include "chromabase.h"
 #include "actions/ferm/linop/lovlapms_w.h"
+#include "actions/ferm/linop/lovlap_lowmode_proj_w.h"
 #include "meas/eig/gramschm.h"
 
 
@@ -81,26 +82,10 @@ void lovlapms::operator() (LatticeFermion& chi, const LatticeFermion& psi,
   // at this stage tmp1 holds either psi or gamma_5 psi as required
   // so we must project from tmp1
 
-  if (NEig > 0)
-  {
-    Complex cconsts;
-    LatticeFermion tmp3 = tmp1;
-
-    for(int i = 0; i < NEig; ++i)
-    {
-
-      // BUG Should this not be innerProduct(EigVec[i], psi) ???
-      //                     or innerProduct(EigVec[i], g5 psi) ????
-
-      cconsts = innerProduct(EigVec[i], tmp3);
-      tmp1 -= EigVec[i] * cconsts;
-
-      cconsts *= EigValFunc[i];
-      chi += EigVec[i] * cconsts;
-    }
-
-    // tmp3 should go out of scope here and be freed.
-  }
+  //
+  // All the overlaps < EigVec, tmp1 > are formed in one pass over the
+  // lattice and the projection is reconstructed in a second pass
+  lowModeProject(chi, tmp1, EigVec, EigValFunc, NEig);
 
   // tmp1 <- H * Projected tmp_1, where tmp1 = psi or gamma_5 psi as needed
   //      <- gamma_5 * M * tmp1
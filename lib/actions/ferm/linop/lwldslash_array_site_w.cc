@@ -0,0 +1,257 @@
+/*! \file
+ *  \brief Wilson Dslash linear operator over arrays, with the fifth dimension innermost
+ */
+
+#include "chromabase.h"
+#include "actions/ferm/linop/lwldslash_array_site_w.h"
+
+#ifndef QDP_IS_QDPJIT
+
+namespace Chroma 
+{ 
+
+  //! Site kernels of the array dslash
+  namespace SiteWilsonDslashArrayEnv
+  {
+    typedef LatticeFermion::Subtype_t      Spinor;
+    typedef LatticeHalfFermion::Subtype_t  HalfSpinor;
+    typedef LatticeColorMatrix::Subtype_t  ColorMat;
+
+    //! acc += recon( U * proj(p) ) in direction mu, with (1 - gamma_mu) if minusP
+    inline
+    void addHop(Spinor& acc, const ColorMat& u, const Spinor& p, int mu, bool minusP)
+    {
+      HalfSpinor h;
+      HalfSpinor uh;
+
+      switch (mu)
+      {
+      case 0:
+	if (minusP) {h = spinProjectDir0Minus(p); uh = u*h; acc += spinReconstructDir0Minus(uh);}
+	else        {h = spinProjectDir0Plus(p);  uh = u*h; acc += spinReconstructDir0Plus(uh);}
+	break;
+      case 1:
+	if (minusP) {h = spinProjectDir1Minus(p); uh = u*h; acc += spinReconstructDir1Minus(uh);}
+	else        {h = spinProjectDir1Plus(p);  uh = u*h; acc += spinReconstructDir1Plus(uh);}
+	break;
+      case 2:
+	if (minusP) {h = spinProjectDir2Minus(p); uh = u*h; acc += spinReconstructDir2Minus(uh);}
+	else        {h = spinProjectDir2Plus(p);  uh = u*h; acc += spinReconstructDir2Plus(uh);}
+	break;
+      case 3:
+	if (minusP) {h = spinProjectDir3Minus(p); uh = u*h; acc += spinReconstructDir3Minus(uh);}
+	else        {h = spinProjectDir3Plus(p);  uh = u*h; acc += spinReconstructDir3Plus(uh);}
+	break;
+      }
+    }
+
+
+    struct ApplyArgs
+    {
+      LatticeFermion** chi;
+      const LatticeFermion** psi;
+      SiteHaloField<LatticeFermion>** halo;
+      int n;
+      const SiteNeighborTable& table;
+      const multi1d<LatticeColorMatrix>& u;
+      const multi1d<LatticeColorMatrix>& u_back;
+      const int* sites;
+      bool plus;
+    };
+
+    //! Dslash on a list of sites, for all the slices at once
+    /*!
+     * For PLUS the forward hop uses (1 - gamma_mu) and the backward
+     * hop (1 + gamma_mu); for MINUS the other way round.
+     */
+    inline
+    void siteLoop(int lo, int hi, int my_id, ApplyArgs* a)
+    {
+      const SiteNeighborTable& tab = a->table;
+      const int n = a->n;
+
+      for(int j=lo; j < hi; ++j)
+      {
+	int site = a->sites[j];
+
+	for(int s=0; s < n; ++s)
+	  zero_rep(a->chi[s]->elem(site));
+
+	for(int mu=0; mu < Nd; ++mu)
+	{
+	  int f = tab.neighbor(site, tab.hop(mu, +1, 0));
+	  int b = tab.neighbor(site, tab.hop(mu, -1, 0));
+
+	  // Each link once, for all the slices
+	  const ColorMat& uf = a->u[mu].elem(site);
+	  for(int s=0; s < n; ++s)
+	    addHop(a->chi[s]->elem(site), uf, a->halo[s]->site(*(a->psi[s]), f), mu, a->plus);
+
+	  const ColorMat& ub = a->u_back[mu].elem(site);
+	  for(int s=0; s < n; ++s)
+	    addHop(a->chi[s]->elem(site), ub, a->halo[s]->site(*(a->psi[s]), b), mu, ! a->plus);
+	}
+      }
+    }
+  }
+
+
+  //! Creation routine
+  void SiteWilsonDslashArray::create(Handle< FermState<T,P,Q> > state, int N5_)
+  {
+    multi1d<Real> cf(Nd);
+    cf = 1.0;
+    create(state, N5_, cf);
+  }
+
+
+  //! Creation routine with anisotropy
+  void SiteWilsonDslashArray::create(Handle< FermState<T,P,Q> > state, int N5_,
+				     const AnisoParam_t& anisoParam) 
+  {
+    START_CODE();
+
+    create(state, N5_, makeFermCoeffs(anisoParam));
+
+    END_CODE();
+  }
+
+  //! Creation routine
+  void SiteWilsonDslashArray::create(Handle< FermState<T,P,Q> > state, int N5_,
+				     const multi1d<Real>& coeffs_)
+  {
+    START_CODE();
+
+    N5 = N5_;
+    coeffs = coeffs_;
+
+    // Save a copy of the fermbc
+    fbc = state->getFermBC();
+
+    // Sanity check
+    if (fbc.operator->() == 0)
+    {
+      QDPIO::cerr << "SiteWilsonDslashArray: error: fbc is null" << std::endl;
+      QDP_abort(1);
+    }
+
+    // Get links
+    u = state->getLinks();
+
+    // Rescale the u fields by the anisotropy, and form the backward links
+    u_back.resize(Nd);
+    for(int mu=0; mu < u.size(); ++mu)
+    {
+      u[mu] *= coeffs[mu];
+      u_back[mu] = shift(adj(u[mu]), BACKWARD, mu);
+    }
+
+    // Nearest neighbor tables and a halo per slice
+    multi1d<int> hops(1);
+    hops[0] = 1;
+    table = new SiteNeighborTable(hops);
+
+    halos.resize((N5 > 0) ? N5 : 1);
+    for(int s=0; s < halos.size(); ++s)
+      halos[s] = new SiteHaloField<LatticeFermion>(*table);
+
+    END_CODE();
+  }
+
+
+  //! Apply to n slices given by pointers
+  void 
+  SiteWilsonDslashArray::applySlices(LatticeFermion** chi, const LatticeFermion** psi, int n,
+				     enum PlusMinus isign, int cb) const
+  {
+#if (QDP_NC == 2) || (QDP_NC == 3)
+    multi1d<SiteHaloField<LatticeFermion>*> halo(n);
+    for(int s=0; s < n; ++s)
+    {
+      halo[s] = halos[s].operator->();
+      halo[s]->start(*(psi[s]));
+    }
+
+    const multi1d<int>& inner = table->innerSites(cb);
+    SiteWilsonDslashArrayEnv::ApplyArgs inner_arg = {chi, psi, halo.slice(), n, *table,
+						     u, u_back, inner.slice(), isign == PLUS};
+    dispatch_to_threads(inner.size(), inner_arg, SiteWilsonDslashArrayEnv::siteLoop);
+
+    for(int s=0; s < n; ++s)
+      halo[s]->finish();
+
+    const multi1d<int>& face = table->faceSites(cb);
+    SiteWilsonDslashArrayEnv::ApplyArgs face_arg = {chi, psi, halo.slice(), n, *table,
+						    u, u_back, face.slice(), isign == PLUS};
+    dispatch_to_threads(face.size(), face_arg, SiteWilsonDslashArrayEnv::siteLoop);
+
+    for(int s=0; s < n; ++s)
+      getFermBC().modifyF(*(chi[s]), QDP::rb[cb]);
+#else
+    QDPIO::cerr<<"lwldslash_array_site_w: not implemented for NC!=3\n";
+    QDP_abort(13) ;
+#endif
+  }
+
+
+  //! General Wilson-Dirac dslash
+  /*! \ingroup linop
+   * Wilson dslash
+   *
+   * Arguments:
+   *
+   *  \param chi      Result				                (Write)
+   *  \param psi      Pseudofermion field				(Read)
+   *  \param isign    D'^dag or D' ( MINUS | PLUS ) resp.		(Read)
+   *  \param cb	      Checkerboard of OUTPUT std::vector			(Read) 
+   */
+  void 
+  SiteWilsonDslashArray::apply (multi1d<LatticeFermion>& chi, 
+				const multi1d<LatticeFermion>& psi, 
+				enum PlusMinus isign, int cb) const
+  {
+    START_CODE();
+
+    if( chi.size() != N5 ) chi.resize(N5);
+
+    multi1d<LatticeFermion*> chi_p(N5);
+    multi1d<const LatticeFermion*> psi_p(N5);
+    for(int s=0; s < N5; ++s)
+    {
+      chi_p[s] = &(chi[s]);
+      psi_p[s] = &(psi[s]);
+    }
+
+    applySlices(chi_p.slice(), psi_p.slice(), N5, isign, cb);
+
+    END_CODE();
+  }
+
+
+  //! General Wilson-Dirac dslash
+  /*! \ingroup linop
+   * Wilson dslash
+   *
+   * Arguments:
+   *
+   *  \param chi	      Result				                (Write)
+   *  \param psi	      Pseudofermion field				(Read)
+   *  \param isign      D'^dag or D' ( MINUS | PLUS ) resp.		(Read)
+   *  \param cb	      Checkerboard of OUTPUT std::vector			(Read) 
+   */
+  void 
+  SiteWilsonDslashArray::apply (LatticeFermion& chi, const LatticeFermion& psi, 
+				enum PlusMinus isign, int cb) const
+  {
+    START_CODE();
+
+    LatticeFermion* chi_p = &chi;
+    const LatticeFermion* psi_p = &psi;
+
+    applySlices(&chi_p, &psi_p, 1, isign, cb);
+
+    END_CODE();
+  }
+
+} // End Namespace Chroma
+#endif
@@ -0,0 +1,143 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Wilson Dslash linear operator over arrays, with the fifth dimension innermost
+ */
+
+#ifndef __lwldslash_array_site_h__
+#define __lwldslash_array_site_h__
+
+#include "state.h"
+#include "actions/ferm/linop/lwldslash_base_array_w.h"
+#include "util/gauge/site_neighbor_table.h"
+
+
+namespace Chroma 
+{ 
+  //! General Wilson-Dirac dslash of arrays as one site loop over all slices
+  /*!
+   * \ingroup linop
+   *
+   * DSLASH
+   *
+   * This routine is specific to Wilson fermions!
+   *
+   * Applies the same operator as QDPWilsonDslashArrayOpt, but the loop over
+   * the fifth dimension is the innermost one: for each site and each hop the
+   * gauge link is loaded once and applied to all N5 slices. The backward links
+   * U^dag(x-mu) are formed once at creation, the neighbors come from a
+   * SiteNeighborTable, and the halos of all the slices are exchanged together
+   * while the interior sites are done.
+   *
+   *	       Nd-1
+   *	       ---
+   *	       \
+   *   chi(x)  :=  >  U  (x) (1 - isign gamma  ) psi(x+mu)
+   *	       /    mu			  mu
+   *	       ---
+   *	       mu=0
+   *
+   *	             Nd-1
+   *	             ---
+   *	             \    +
+   *                +    >  U  (x-mu) (1 + isign gamma  ) psi(x-mu)
+   *	             /    mu			   mu
+   *	             ---
+   *	             mu=0
+   *
+   */
+  class SiteWilsonDslashArray : public WilsonDslashBaseArray
+  {
+  public:
+    // Typedefs to save typing
+    typedef LatticeFermion               T;
+    typedef multi1d<LatticeColorMatrix>  P;
+    typedef multi1d<LatticeColorMatrix>  Q;
+
+    //! Empty constructor. Must use create later
+    SiteWilsonDslashArray() {}
+
+    //! Full constructor
+    SiteWilsonDslashArray(Handle< FermState<T,P,Q> > state,
+			  int N5_)
+      {create(state,N5_);}
+
+    //! Full constructor
+    SiteWilsonDslashArray(Handle< FermState<T,P,Q> > state,
+			  int N5_,
+			  const AnisoParam_t& aniso_)
+      {create(state,N5_,aniso_);}
+
+    //! Creation routine
+    void create(Handle< FermState<T,P,Q> > state,
+		int N5_);
+
+    //! Creation routine
+    void create(Handle< FermState<T,P,Q> > state,
+		int N5_,
+		const AnisoParam_t& aniso_);
+
+    //! Creation routine
+    void create(Handle< FermState<T,P,Q> > state,
+		int N5_,
+		const multi1d<Real>& coeffs_);
+
+    //! Expected length of array index
+    int size() const {return N5;}
+
+    //! No real need for cleanup here
+    ~SiteWilsonDslashArray() {}
+
+    /**
+     * Apply a dslash
+     *
+     * \param chi     result                                      (Write)
+     * \param psi     source                                      (Read)
+     * \param isign   D'^dag or D'  ( MINUS | PLUS ) resp.        (Read)
+     * \param cb      Checkerboard of OUTPUT std::vector               (Read) 
+     *
+     * \return The output of applying dslash on psi
+     */
+    void apply (multi1d<LatticeFermion>& chi, 
+		const multi1d<LatticeFermion>& psi, 
+		enum PlusMinus isign, int cb) const;
+
+    /**
+     * Apply a dslash
+     *
+     * \param chi     result                                      (Write)
+     * \param psi     source                                      (Read)
+     * \param isign   D'^dag or D'  ( MINUS | PLUS ) resp.        (Read)
+     * \param cb      Checkerboard of OUTPUT std::vector               (Read) 
+     *
+     * \return The output of applying dslash on psi
+     */
+    void apply (LatticeFermion& chi, 
+		const LatticeFermion& psi, 
+		enum PlusMinus isign, int cb) const;
+     
+    //! Return the fermion BC object for this linear operator
+    const FermBC<T,P,Q>& getFermBC() const {return *fbc;}
+
+  protected:
+    //! Get the anisotropy parameters
+    const multi1d<Real>& getCoeffs() const {return coeffs;}
+
+  private:
+    //! Apply to n slices given by pointers
+    void applySlices(LatticeFermion** chi, const LatticeFermion** psi, int n,
+		     enum PlusMinus isign, int cb) const;
+
+    int N5;
+    multi1d<Real> coeffs;  /*!< Nd array of coefficients of terms in the action */
+    multi1d<LatticeColorMatrix> u;       // fold in anisotropy
+    multi1d<LatticeColorMatrix> u_back;  // U^dag(x-mu)
+    Handle< FermBC<T,P,Q> > fbc;
+    Handle<SiteNeighborTable> table;
+    multi1d< Handle< SiteHaloField<LatticeFermion> > > halos;  // one per slice
+  };
+
+
+} // End Namespace Chroma
+
+
+#endif
@@ -0,0 +1,64 @@
+/*! \file
+ *  \brief Unpreconditioned single precision Wilson linear operator
+ */
+
+#include "chromabase.h"
+#include "actions/ferm/linop/unprec_wilson_dumb_linop_w.h"
+
+namespace Chroma 
+{ 
+  //! Creation routine
+  /*!
+   * \param fs 	    single precision fermion state   (Read)
+   * \param param_  Mass and anisotropy              (Read)
+   */
+  void UnprecDumbWilsonFLinOp::create(Handle< FermState<T,P,Q> > fs,
+				      const WilsonFermActParams& param_)
+  {
+    START_CODE();
+
+    D.create(fs, param_.anisoParam);
+
+    const AnisoParam_t& anisoParam = param_.anisoParam;
+    Real ff = where(anisoParam.anisoP, anisoParam.nu / anisoParam.xi_0, Real(1));
+    fact = 1 + (Nd-1)*ff + param_.Mass;
+
+    END_CODE();
+  }
+
+
+  //! Apply unpreconditioned Wilson fermion linear operator
+  /*!
+   * \param chi 	  Pseudofermion field     	       (Write)
+   * \param psi 	  Pseudofermion field     	       (Read)
+   * \param isign   Flag ( PLUS | MINUS )   	       (Read)
+   */
+  void UnprecDumbWilsonFLinOp::operator() (T& chi, const T& psi, 
+					   enum PlusMinus isign) const
+  {
+    START_CODE();
+
+    //
+    //  Chi   =  (Nd+Mass)*Psi  -  (1/2) * D' Psi
+    //
+    T tmp;
+    RealF mhalf = -0.5;
+    RealF ffact = fact;
+
+    D(tmp, psi, isign);
+    chi = ffact*psi + mhalf*tmp;
+
+    getFermBC().modifyF(chi);
+
+    END_CODE();
+  }
+
+
+  //! Return flops performed by the operator()
+  unsigned long UnprecDumbWilsonFLinOp::nFlops() const
+  {
+    unsigned long site_flops = D.nFlops()+4*Nc*Ns;
+    return site_flops*Layout::sitesOnNode();
+  }
+
+} // End Namespace Chroma
@@ -0,0 +1,70 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Unpreconditioned single precision Wilson linear operator
+ */
+
+#ifndef __unprec_wilson_dumb_linop_w_h__
+#define __unprec_wilson_dumb_linop_w_h__
+
+#include "state.h"
+#include "fermbc.h"
+#include "linearop.h"
+#include "actions/ferm/fermacts/wilson_fermact_params_w.h"
+#include "actions/ferm/linop/dslash_w.h"
+
+
+namespace Chroma 
+{ 
+  //! Unpreconditioned Wilson-Dirac operator
+  /*!
+   * \ingroup linop
+   *
+   * This routine is specific to Wilson fermions!
+   *
+   *      M  =  (d+M) - (1/2) D'
+   *
+   * This is a dumb version with only a constructor and an 
+   * apply method. It is fixed to single precision and is used as
+   * the inner kernel of mixed precision solvers.
+   */
+  class UnprecDumbWilsonFLinOp : public LinearOperator<LatticeFermionF>
+  {
+  public:
+    typedef LatticeFermionF T;
+    typedef LatticeColorMatrixF U;
+    typedef multi1d<U> P;
+    typedef multi1d<U> Q;
+
+    //! Full constructor
+    UnprecDumbWilsonFLinOp(Handle< FermState<T,P,Q> > fs,
+			   const WilsonFermActParams& param_)
+      {create(fs,param_);}
+
+    //! Destructor is automatic
+    ~UnprecDumbWilsonFLinOp() {}
+
+    //! Return the fermion BC object for this linear operator
+    const FermBC<T,P,Q>& getFermBC() const {return D.getFermBC();}
+
+    //! Creation routine
+    void create(Handle< FermState<T,P,Q> > fs,
+		const WilsonFermActParams& param_);
+
+    //! Only defined on the entire lattice
+    const Subset& subset() const {return all;}
+
+    //! Apply the operator onto a source std::vector
+    void operator() (T& chi, const T& psi, enum PlusMinus isign) const;
+
+    //! Return flops performed by the operator()
+    unsigned long nFlops() const;
+
+  private:
+    WilsonDslashF D;
+    Real fact;  // tmp holding  Nd+Mass
+  };
+
+} // End Namespace Chroma
+
+
+#endif
@@ -92,6 +92,7 @@
 #include "chromabase.h"
 #include "actions/ferm/qprop/nef_quarkprop4_w.h"
 #include "util/ferm/transf.h"
+#include "actions/ferm/invert/solver_perf.h"
 #include "util/ft/sftmom.h"
 
 
@@ -186,6 +187,8 @@ namespace Chroma
 	  write(xml_out, "spin_source", spin_source);
 	  write(xml_out, "n_count", result.n_count);
 	  write(xml_out, "resid", result.resid);
+	  if (result.perf.n_linop > 0)
+	    write(xml_out, "Perf", result.perf);
 	  pop(xml_out);
 	}
 
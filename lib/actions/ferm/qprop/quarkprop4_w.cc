@@ -8,6 +8,7 @@
 #include "util/ferm/transf.h"
 #include "actions/ferm/qprop/quarkprop4_w.h"
 #include "actions/ferm/invert/syssolver_linop_factory.h"
+#include "actions/ferm/invert/solver_perf.h"
 #include "actions/ferm/invert/syssolver_mdagm_factory.h"
 #include "actions/ferm/invert/multi_syssolver_linop_factory.h"
 #include "actions/ferm/invert/multi_syssolver_mdagm_factory.h"
@@ -101,6 +102,8 @@ namespace Chroma
 	  write(xml_out, "spin_source", spin_source);
 	  write(xml_out, "n_count", result.n_count);
 	  write(xml_out, "resid", result.resid);
+	  if (result.perf.n_linop > 0)
+	    write(xml_out, "Perf", result.perf);
 	  pop(xml_out);
 	}
 
@@ -284,12 +287,15 @@ namespace Chroma
   {
     std::istringstream  xml(invParam.xml);
     XMLReader  paramtop(xml);
-	
-    return TheLinOpFermSystemSolverFactory::Instance().createObject(invParam.id,
-								    paramtop,
-								    invParam.path,
-								    state,
-								    this->linOp(state));
+
+    // Count the work of the solver
+    Handle< LinearOperator<LF> > A(new TimedLinearOperator<LF>(this->linOp(state)));
+    Handle< LinOpSystemSolver<LF> > invA(TheLinOpFermSystemSolverFactory::Instance().createObject(invParam.id,
+												  paramtop,
+												  invParam.path,
+												  state,
+												  A));
+    return new TimedSystemSolver< LF, LinOpSystemSolver<LF> >(invA);
   }
 
 
@@ -374,12 +380,15 @@ namespace Chroma
   {
     std::istringstream  xml(invParam.xml);
     XMLReader  paramtop(xml);
-	
-    return TheLinOpFermSystemSolverArrayFactory::Instance().createObject(invParam.id,
-									 paramtop,
-									 invParam.path,
-									 state,
-									 this->linOp(state));
+
+    // Count the work of the solver
+    Handle< LinearOperatorArray<LF> > A(new TimedLinearOperatorArray<LF>(this->linOp(state)));
+    Handle< LinOpSystemSolverArray<LF> > invA(TheLinOpFermSystemSolverArrayFactory::Instance().createObject(invParam.id,
+													    paramtop,
+													    invParam.path,
+													    state,
+													    A));
+    return new TimedSystemSolverArray< LF, LinOpSystemSolverArray<LF> >(invA);
   }
 
 
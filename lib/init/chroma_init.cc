@@ -6,6 +6,11 @@
 
 #include "init/chroma_init.h"
 #include "io/xmllog_io.h"
+#include "actions/ferm/fermstates/stag_link_cache_s.h"
+#include "actions/ferm/invert/solver_perf.h"
+#include "util/info/region_profiler.h"
+
+#include <cstdlib>
 
 #if defined(BUILD_JIT_CLOVER_TERM)
 #if defined(QDPJIT_IS_QDPJITPTX)
@@ -119,6 +124,9 @@ namespace Chroma
 		    << "   --chroma-l   [" << getXMLLogFileName() << "]  xml log file name\n"
 		    << "   -cwd         [" << getCWD() << "]  xml log file name\n"
 		    << "   --chroma-cwd [" << getCWD() << "]  xml log file name\n"
+		    << "   --chroma-peak-gflops [" << SolverPerfEnv::peakGFlops() << "]  peak GFLOP/s of a node for the solver counters\n"
+		    << "   --chroma-profile        print a table of the time in each region at exit\n"
+		    << "   --chroma-trace <file>   also write the regions as a Chrome trace\n"
 
 		    
 		    << std::endl;
@@ -187,6 +195,42 @@ namespace Chroma
 	}
       }
 
+      // Search for --chroma-peak-gflops
+      if( argv_i == std::string("--chroma-peak-gflops") ) 
+      {
+	if( i + 1 < *argc ) {
+	  SolverPerfEnv::setPeakGFlops(std::atof( (*argv)[i+1] ));
+	  // Skip over next
+	  i++;
+	}
+	else {
+	  // i + 1 is too big
+	  QDPIO::cerr << "Error: dangling --chroma-peak-gflops specified. " << std::endl;
+	  QDP_abort(1);
+	}
+      }
+
+      // Search for --chroma-profile
+      if( argv_i == std::string("--chroma-profile") ) 
+      {
+	RegionProfilerEnv::enable("");
+      }
+
+      // Search for --chroma-trace
+      if( argv_i == std::string("--chroma-trace") ) 
+      {
+	if( i + 1 < *argc ) {
+	  RegionProfilerEnv::enable(std::string( (*argv)[i+1] ));
+	  // Skip over next
+	  i++;
+	}
+	else {
+	  // i + 1 is too big
+	  QDPIO::cerr << "Error: dangling --chroma-trace specified. " << std::endl;
+	  QDP_abort(1);
+	}
+      }
+
     }
 
 
@@ -244,7 +288,9 @@ namespace Chroma
     if (! QDP_isInitialized())
       return;
 
-    
+    // Report the regions while the nodes can still communicate
+    RegionProfilerEnv::finish();
+
     /*
     if( xmlInputP ) { 
       Chroma::getXMLInputInstance().close();
@@ -257,6 +303,9 @@ namespace Chroma
       Chroma::getXMLLogInstance().close();
     }
 
+    // Release any cached staggered links before QDP goes away
+    StagLinkCacheEnv::clear();
+
     QDP_finalize();
   }
 
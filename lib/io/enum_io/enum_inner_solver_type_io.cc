@@ -18,6 +18,8 @@ namespace Chroma {
 								      OVERLAP_INNER_CG_SINGLE_PASS );
       success &= theOverlapInnerSolverTypeMap::Instance().registerPair(std::string("DOUBLE_PASS"),
 								       OVERLAP_INNER_CG_DOUBLE_PASS );
+      success &= theOverlapInnerSolverTypeMap::Instance().registerPair(std::string("MIXED_PREC"),
+								       OVERLAP_INNER_CG_MIXED_PREC );
       return success;
     }
     const std::string typeIDString = "OverlapInnerSolverType";
@@ -24,7 +24,8 @@ namespace Chroma {
   //! OverlapInnerSolver type
   enum OverlapInnerSolverType { 
     OVERLAP_INNER_CG_SINGLE_PASS,
-    OVERLAP_INNER_CG_DOUBLE_PASS
+    OVERLAP_INNER_CG_DOUBLE_PASS,
+    OVERLAP_INNER_CG_MIXED_PREC
   };
 
   namespace OverlapInnerSolverTypeEnv { 
@@ -5,6 +5,7 @@
 #include "chromabase.h"
 #include "meas/gfix/coulgauge.h"
 #include "meas/gfix/grelax.h"
+#include "meas/gfix/grelax_site.h"
 #include "util/gauge/reunit.h"
 
 namespace Chroma {
@@ -143,6 +144,13 @@ void coulGauge(multi1d<LatticeColorMatrix>& u,
   // Gauge transf. matrices always start from identity
   g = 1; 
 
+#ifndef QDP_IS_QDPJIT
+  // All the SU(2) subgroups of a checkerboard in one site loop
+  Handle<GRelaxSite> relax;
+  if (Nc > 1)
+    relax = new GRelaxSite(u, j_decay);
+#endif
+
   /* Gauge fix until converged or too many iterations */
   n_gf = 0;
   bool wrswitch = true;    /* switch for writing of gauge fixing term */
@@ -159,12 +167,17 @@ void coulGauge(multi1d<LatticeColorMatrix>& u,
     {
       if (Nc > 1)
       {
+#ifndef QDP_IS_QDPJIT
+	/* Gauge fixing relaxation step over all SU(2) subgroups */
+	(*relax)(g, cb, OrDo, OrPara);
+#else
 	/* Loop over SU(2) subgroup index */
 	for(int su2_index=0; su2_index < Nc*(Nc-1)/2; ++su2_index)
 	{
 	  /* Now do a gauge fixing relaxation step */
 	  grelax(g, u, j_decay, su2_index, cb, OrDo, OrPara);
 	}   /* end su2_index loop */
+#endif
       }
       else
       {
@@ -0,0 +1,296 @@
+/*! \file
+ *  \brief Fourier accelerated Coulomb (and Landau) gauge fixing
+ */
+
+#include "chromabase.h"
+#include "meas/gfix/fourier_gauge.h"
+#include "util/ft/lattice_fft.h"
+#include "util/gauge/taproj.h"
+#include "util/gauge/expm12.h"
+#include "util/gauge/reunit.h"
+
+namespace Chroma {
+
+/********************** HACK ******************************/
+// Primitive way for now to indicate the time direction
+static int tDir() {return Nd-1;}
+static Real xi_0() {return 1.0;}
+/******************** END HACK ***************************/
+
+
+//! Fourier accelerated Coulomb (and Landau) gauge fixing
+/*!
+ * \ingroup gfix
+ *
+ * Driver for gauge fixing to Coulomb gauge in slices perpendicular
+ * to the direction "j_decay".
+ * If j_decay >= Nd: fix to Landau gauge.
+
+ * \param u        (gauge fixed) gauge field ( Modify )
+ * \param n_gf     number of gauge fixing iterations ( Write )
+ * \param j_decay  direction perpendicular to slices to be gauge fixed ( Read )
+ * \param GFAccu   desired accuracy for gauge fixing ( Read )
+ * \param GFMax    maximal number of gauge fixing iterations ( Read )
+ * \param alpha    step size ( Read )
+ */
+
+void fourierGauge(multi1d<LatticeColorMatrix>& u,
+		  int& n_gf,
+		  int j_decay, const Real& GFAccu, int GFMax,
+		  const Real& alpha)
+{
+  LatticeColorMatrix g;
+
+  fourierGauge(u, g, n_gf, j_decay, GFAccu, GFMax, alpha);
+}
+
+
+
+//! Fourier accelerated Coulomb (and Landau) gauge fixing
+/*!
+ * \ingroup gfix
+ *
+ * Each iteration takes the gradient of the functional
+ *
+ *   Delta(x) = sum_mu [U_mu(x-mu) - U_mu(x)]_{traceless antihermitian}
+ *
+ * over the gauge fixed directions, scales its Fourier modes by
+ * p^2_max/p^2 so the slow long wavelength modes move as fast as the
+ * short ones, and gauge rotates by g = exp(alpha/2 Delta~).
+ * The transform runs over the gauge fixed directions only, so in
+ * Coulomb gauge each slice is preconditioned on its own.
+
+ * \param u        (gauge fixed) gauge field ( Modify )
+ * \param g        Gauge transformation matrices (Write)
+ * \param n_gf     number of gauge fixing iterations ( Write )
+ * \param j_decay  direction perpendicular to slices to be gauge fixed ( Read )
+ * \param GFAccu   desired accuracy for gauge fixing ( Read )
+ * \param GFMax    maximal number of gauge fixing iterations ( Read )
+ * \param alpha    step size ( Read )
+ */
+
+void fourierGauge(multi1d<LatticeColorMatrix>& u,
+		  LatticeColorMatrix& g,
+		  int& n_gf,
+		  int j_decay, const Real& GFAccu, int GFMax,
+		  const Real& alpha)
+{
+  Double tgfold;
+  Double tgfnew;
+  Double tgf_t;
+  Double tgf_s;
+  Double norm;
+  int num_sdir;
+  bool tdirp;
+
+  START_CODE();
+
+  Real xi_sq = pow(xi_0(),2);
+  if( j_decay >= 0 && j_decay < Nd )
+  {
+    if( tDir() >= 0 && tDir() != j_decay )
+    {
+      num_sdir = Nd - 2;
+      tdirp = true;
+      norm = Double(Layout::vol()*Nc) * (Double(num_sdir)+Double(xi_sq));
+    }
+    else
+    {
+      num_sdir = Nd - 1;
+      tdirp = false;
+      norm = Double(Layout::vol()*Nc*num_sdir);
+    }
+  }
+  else
+  {
+    if( tDir() >= 0 && tDir() < Nd )
+    {
+      num_sdir = Nd - 1;
+      tdirp = true;
+      norm = Double(Layout::vol()*Nc) * (Double(num_sdir)+Double(xi_sq));
+    }
+    else
+    {
+      num_sdir = Nd;
+      tdirp = false;
+      norm = Double(Layout::vol()*Nc*num_sdir);
+    }
+  }
+
+  /* The gauge fixed directions, their weights and the transform over them */
+  multi1d<bool> gdir(Nd);
+  multi1d<Real> wgt(Nd);
+  int vol_gdir = 1;
+  int num_gdir = 0;
+  for(int mu=0; mu<Nd; ++mu)
+  {
+    gdir[mu] = (mu != j_decay);
+    wgt[mu] = (tdirp && mu == tDir()) ? xi_sq : Real(1);
+    if( gdir[mu] )
+    {
+      vol_gdir *= Layout::lattSize()[mu];
+      ++num_gdir;
+    }
+  }
+
+  LatticeFFT fft(gdir);
+
+  /* Momentum space preconditioner p^2_max/p^2, with the zero mode dropped */
+  LatticeReal fac;
+  {
+    LatticeReal p_sq = zero;
+    for(int mu=0; mu<Nd; ++mu)
+      if( gdir[mu] )
+      {
+	LatticeReal s = sin(Chroma::twopi * LatticeReal(Layout::latticeCoordinate(mu))
+			    / Real(2*Layout::lattSize()[mu]));
+	p_sq += Real(4) * s * s;
+      }
+
+    Real p_sq_max = Real(4*num_gdir);
+    LatticeBoolean nonzero = p_sq > Real(1.0e-10);
+    LatticeReal one = Real(1);
+    LatticeReal lfac = p_sq_max / where(nonzero, p_sq, one);
+    fac = where(nonzero, lfac, LatticeReal(zero));
+
+    /* The inverse transform is not normalized */
+    fac /= Real(vol_gdir);
+  }
+
+  /* The links being fixed, rotated as we go */
+  multi1d<LatticeColorMatrix> v(Nd);
+  for(int mu=0; mu<Nd; ++mu)
+    if( gdir[mu] )
+      v[mu] = u[mu];
+
+  /* Compute initial gauge fixing term: sum(trace(U_spacelike)); */
+  tgf_t = 0;
+  tgf_s = 0;
+  for(int mu=0; mu<Nd; ++mu)
+    if( mu != j_decay )
+    {
+      Double tgf_tmp = sum(real(trace(v[mu])));
+
+      if( mu != tDir() )
+	tgf_s += tgf_tmp;
+      else
+	tgf_t += tgf_tmp;
+    }
+
+  if( tdirp )
+  {
+    tgfold = (xi_sq*tgf_t+tgf_s)/norm;
+    tgf_s = tgf_s/(Double(Layout::vol()*Nc*num_sdir));
+    tgf_t = tgf_t/(Double(Layout::vol()*Nc));
+  }
+  else
+  {
+    tgf_s = tgf_s/(Double(Layout::vol()*Nc*num_sdir));
+    tgfold = tgf_s;
+  }
+
+  // Gauge transf. matrices always start from identity
+  g = 1;
+
+  /* Gauge fix until converged or too many iterations */
+  n_gf = 0;
+  bool wrswitch = true;    /* switch for writing of gauge fixing term */
+  Double conver = 1;        /* convergence criterion */
+
+  while( toBool(conver > GFAccu)  &&  n_gf < GFMax )
+  {
+    n_gf = n_gf + 1;
+    if( GFMax - n_gf < 11 )
+      wrswitch = true;
+
+    /* Gradient of the functional */
+    LatticeColorMatrix delta = zero;
+    for(int mu=0; mu<Nd; ++mu)
+      if( gdir[mu] )
+	delta += wgt[mu] * (shift(v[mu], BACKWARD, mu) - v[mu]);
+
+    taproj(delta);
+
+    /* Precondition in momentum space */
+    fft(delta, -1);
+    delta *= fac;
+    fft(delta, +1);
+
+    taproj(delta);
+
+    /* The gauge transformation of this step: exp(alpha/2 Delta~) with the
+       factor 2 of taproj absorbed */
+    LatticeColorMatrix g_step = alpha * delta;
+    expm12(g_step);
+    reunit(g_step);
+
+    for(int mu=0; mu<Nd; ++mu)
+      if( gdir[mu] )
+      {
+	LatticeColorMatrix u_tmp = g_step * v[mu];
+	v[mu] = u_tmp * shift(adj(g_step), FORWARD, mu);
+      }
+
+    LatticeColorMatrix g_tmp = g_step * g;
+    g = g_tmp;
+
+    /* Reunitarize */
+    reunit(g);
+
+    /* Compute new gauge fixing term: sum(trace(U_spacelike)): */
+    tgf_t = 0;
+    tgf_s = 0;
+    for(int mu=0; mu<Nd; ++mu)
+      if( mu != j_decay )
+      {
+	Double tgf_tmp = sum(real(trace(v[mu])));
+
+	if( mu != tDir() )
+	  tgf_s += tgf_tmp;
+	else
+	  tgf_t += tgf_tmp;
+      }
+
+    if( tdirp )
+    {
+      tgfnew = (xi_sq*tgf_t+tgf_s)/norm;
+      tgf_s = tgf_s/(Double(Layout::vol()*Nc*num_sdir));
+      tgf_t = tgf_t/(Double(Layout::vol()*Nc));
+    }
+    else
+    {
+      tgf_s = tgf_s/(Double(Layout::vol()*Nc*num_sdir));
+      tgfnew = tgf_s;
+    }
+
+    if( wrswitch )
+      QDPIO::cout << "FOURIERGAUGE: iter= " << n_gf
+		  << "  tgfold= " << tgfold
+		  << "  tgfnew= " << tgfnew
+		  << "  tgf_s= " << tgf_s
+		  << "  tgf_t= " << tgf_t << std::endl;
+
+    /* Normalized convergence criterion: */
+    conver = fabs((tgfnew - tgfold) / tgfnew);
+    tgfold = tgfnew;
+  }       /* end while loop */
+
+
+  if( wrswitch )
+    QDPIO::cout << "FOURIERGAUGE: end: iter= " << n_gf
+		<< "  tgfold= " << tgfold
+		<< "  tgf_s= " << tgf_s
+		<< "  tgf_t= " << tgf_t << std::endl;
+
+  // Finally, gauge rotate the original matrices and overwrite them
+  for(int mu = 0; mu < Nd; ++mu)
+  {
+    LatticeColorMatrix u_tmp = g * u[mu];
+    u[mu] = u_tmp * shift(adj(g), FORWARD, mu);
+  }
+
+  END_CODE();
+}
+
+
+}; // Namespace Chroma
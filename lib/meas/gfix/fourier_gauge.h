@@ -0,0 +1,60 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Fourier accelerated Coulomb (and Landau) gauge fixing
+ */
+
+#ifndef __fourier_gauge_h__
+#define __fourier_gauge_h__
+
+namespace Chroma {
+//! Fourier accelerated Coulomb (and Landau) gauge fixing
+/*!
+ * \ingroup gfix
+ *
+ * Steepest descent gauge fixing to Coulomb gauge in slices perpendicular
+ * to the direction "j_decay", with the gradient preconditioned in momentum
+ * space by p^2_max/p^2 (C.T.H. Davies et al, Phys.Rev.D37:1581,1988).
+ * If j_decay >= Nd: fix to Landau gauge.
+ *
+ * The functional and the convergence criterion are those of coulGauge.
+
+ * \param u        (gauge fixed) gauge field ( Modify )
+ * \param g        Gauge transformation matrices (Write)
+ * \param n_gf     number of gauge fixing iterations ( Write )
+ * \param j_decay  direction perpendicular to slices to be gauge fixed ( Read )
+ * \param GFAccu   desired accuracy for gauge fixing ( Read )
+ * \param GFMax    maximal number of gauge fixing iterations ( Read )
+ * \param alpha    step size, about 0.08 ( Read )
+ */
+
+void fourierGauge(multi1d<LatticeColorMatrix>& u,
+		  LatticeColorMatrix& g,
+		  int& n_gf,
+		  int j_decay, const Real& GFAccu, int GFMax,
+		  const Real& alpha);
+
+//! Fourier accelerated Coulomb (and Landau) gauge fixing
+/*!
+ * \ingroup gfix
+ *
+ * Steepest descent gauge fixing to Coulomb gauge in slices perpendicular
+ * to the direction "j_decay", with the gradient preconditioned in momentum
+ * space by p^2_max/p^2.
+ * If j_decay >= Nd: fix to Landau gauge.
+
+ * \param u        (gauge fixed) gauge field ( Modify )
+ * \param n_gf     number of gauge fixing iterations ( Write )
+ * \param j_decay  direction perpendicular to slices to be gauge fixed ( Read )
+ * \param GFAccu   desired accuracy for gauge fixing ( Read )
+ * \param GFMax    maximal number of gauge fixing iterations ( Read )
+ * \param alpha    step size, about 0.08 ( Read )
+ */
+
+void fourierGauge(multi1d<LatticeColorMatrix>& u,
+		  int& n_gf,
+		  int j_decay, const Real& GFAccu, int GFMax,
+		  const Real& alpha);
+
+}; // End namespace
+
+#endif
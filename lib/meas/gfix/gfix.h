@@ -16,7 +16,9 @@
 
 #include "axgauge.h"
 #include "coulgauge.h"
+#include "fourier_gauge.h"
 #include "grelax.h"
+#include "grelax_site.h"
 #include "polar_dec.h"
 #include "rot_colvec.h"
 
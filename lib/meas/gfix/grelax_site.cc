@@ -0,0 +1,298 @@
+/*! \file
+ *  \brief Site-loop gauge fixing relaxation with neighbor tables
+ */
+
+#include "chromabase.h"
+#include "meas/gfix/grelax_site.h"
+#include <cmath>
+
+#ifndef QDP_IS_QDPJIT
+namespace Chroma
+{
+
+  /********************** HACK ******************************/
+  // Primitive way for now to indicate the time direction
+  static int tDir() {return Nd-1;}
+  static Real xi_0() {return 1.0;}
+  static bool anisoP() {return false;}
+  /******************** END HACK ***************************/
+
+
+  //! Site kernels of the gauge fixing relaxation
+  namespace GRelaxSiteEnv
+  {
+    typedef WordType<LatticeColorMatrix>::Type_t  R;
+
+    struct RelaxArgs
+    {
+      LatticeColorMatrix& g;
+      const SiteHaloField<LatticeColorMatrix>& halo;
+      const SiteNeighborTable& table;
+      const multi1d<LatticeColorMatrix>& u;
+      const multi1d<LatticeColorMatrix>& u_back;
+      const int* dirs;
+      const R* wgt;
+      int ndir;
+      const int* su2_i1;
+      const int* su2_i2;
+      int nsu2;
+      const int* sites;
+      bool ordo;
+      R orpara;
+      R fuzz;
+    };
+
+
+    //! Pointer to a site color matrix
+    inline
+    const R* matPtr(const LatticeColorMatrix::Subtype_t& s)
+    {
+      return &(s.elem().elem(0,0).real());
+    }
+
+
+    //! res += w a b^dag   for Nc x Nc complex matrices
+    inline
+    void addMatMatAdj(R* res, const R* a, const R* b, R w)
+    {
+      for(int i=0; i < Nc; ++i)
+	for(int j=0; j < Nc; ++j)
+	{
+	  R re = 0;
+	  R im = 0;
+	  for(int k=0; k < Nc; ++k)
+	  {
+	    const R* aik = a + 2*(Nc*i + k);
+	    const R* bjk = b + 2*(Nc*j + k);
+	    re += aik[0]*bjk[0] + aik[1]*bjk[1];
+	    im += aik[1]*bjk[0] - aik[0]*bjk[1];
+	  }
+	  res[2*(Nc*i+j)]   += w*re;
+	  res[2*(Nc*i+j)+1] += w*im;
+	}
+    }
+
+
+    //! res = a b   for Nc x Nc complex matrices
+    inline
+    void matMat(R* res, const R* a, const R* b)
+    {
+      for(int i=0; i < Nc; ++i)
+	for(int j=0; j < Nc; ++j)
+	{
+	  R re = 0;
+	  R im = 0;
+	  for(int k=0; k < Nc; ++k)
+	  {
+	    const R* aik = a + 2*(Nc*i + k);
+	    const R* bkj = b + 2*(Nc*k + j);
+	    re += aik[0]*bkj[0] - aik[1]*bkj[1];
+	    im += aik[0]*bkj[1] + aik[1]*bkj[0];
+	  }
+	  res[2*(Nc*i+j)]   = re;
+	  res[2*(Nc*i+j)+1] = im;
+	}
+    }
+
+
+    //! Rows i1,i2 of m <- S m, with S = a0 + i sum_k a_k sigma_k in the (i1,i2) block
+    inline
+    void su2Mult(R* m, int i1, int i2, const R* a)
+    {
+      for(int j=0; j < Nc; ++j)
+      {
+	R* m1 = m + 2*(Nc*i1 + j);
+	R* m2 = m + 2*(Nc*i2 + j);
+	R x1r = m1[0], x1i = m1[1];
+	R x2r = m2[0], x2i = m2[1];
+
+	// S11 = (a0, a3), S12 = (a2, a1), S21 = (-a2, a1), S22 = (a0, -a3)
+	m1[0] = a[0]*x1r - a[3]*x1i + a[2]*x2r - a[1]*x2i;
+	m1[1] = a[0]*x1i + a[3]*x1r + a[2]*x2i + a[1]*x2r;
+	m2[0] = -a[2]*x1r - a[1]*x1i + a[0]*x2r + a[3]*x2i;
+	m2[1] = -a[2]*x1i + a[1]*x1r + a[0]*x2i - a[3]*x2r;
+      }
+    }
+
+
+    //! All the SU(2) subgroup hits on a list of sites
+    inline
+    void siteLoop(int lo, int hi, int my_id, RelaxArgs* a)
+    {
+      const SiteNeighborTable& tab = a->table;
+      const int nm = 2*Nc*Nc;
+
+      for(int j=lo; j < hi; ++j)
+      {
+	int site = a->sites[j];
+
+	// The staple of the neighboring gauge transformations
+	R k[2*Nc*Nc];
+	for(int i=0; i < nm; ++i)
+	  k[i] = 0;
+
+	for(int d=0; d < a->ndir; ++d)
+	{
+	  int mu = a->dirs[d];
+	  int f = tab.neighbor(site, tab.hop(mu, +1, 0));
+	  int b = tab.neighbor(site, tab.hop(mu, -1, 0));
+
+	  addMatMatAdj(k, matPtr(a->u[mu].elem(site)), matPtr(a->halo.site(a->g, f)), a->wgt[d]);
+	  addMatMatAdj(k, matPtr(a->u_back[mu].elem(site)), matPtr(a->halo.site(a->g, b)), a->wgt[d]);
+	}
+
+	R* gp = &(a->g.elem(site).elem().elem(0,0).real());
+
+	R gx[2*Nc*Nc];
+	R v[2*Nc*Nc];
+	for(int i=0; i < nm; ++i)
+	  gx[i] = gp[i];
+	matMat(v, gx, k);
+
+	for(int s=0; s < a->nsu2; ++s)
+	{
+	  const int i1 = a->su2_i1[s];
+	  const int i2 = a->su2_i2[s];
+
+	  const R* v11 = v + 2*(Nc*i1 + i1);
+	  const R* v12 = v + 2*(Nc*i1 + i2);
+	  const R* v21 = v + 2*(Nc*i2 + i1);
+	  const R* v22 = v + 2*(Nc*i2 + i2);
+
+	  // Extract the SU(2) components, as su2Extract
+	  R r[4];
+	  r[0] = v11[0] + v22[0];
+	  r[1] = v12[1] + v21[1];
+	  r[2] = v12[0] - v21[0];
+	  r[3] = v11[1] - v22[1];
+
+	  R r_l = std::sqrt(r[0]*r[0] + r[1]*r[1] + r[2]*r[2] + r[3]*r[3]);
+
+	  R su2[4];
+	  if (r_l > a->fuzz)
+	  {
+	    su2[0] =  r[0] / r_l;
+	    su2[1] = -r[1] / r_l;
+	    su2[2] = -r[2] / r_l;
+	    su2[3] = -r[3] / r_l;
+	  }
+	  else
+	  {
+	    su2[0] = 1;
+	    su2[1] = su2[2] = su2[3] = 0;
+	  }
+
+	  // Overrelax, i.e. multiply the angle
+	  if (a->ordo)
+	  {
+	    R c = (su2[0] > 1) ? R(1) : ((su2[0] < -1) ? R(-1) : su2[0]);
+	    R theta_old = std::acos(c);
+	    R oldsin = std::sin(theta_old);
+	    R theta_new = theta_old * a->orpara;
+	    R ratio = (oldsin > a->fuzz) ? std::sin(theta_new) / oldsin : R(0);
+
+	    su2[0] = std::cos(theta_new);
+	    su2[1] *= ratio;
+	    su2[2] *= ratio;
+	    su2[3] *= ratio;
+	  }
+
+	  su2Mult(v, i1, i2, su2);
+	  su2Mult(gx, i1, i2, su2);
+	}
+
+	for(int i=0; i < nm; ++i)
+	  gp[i] = gx[i];
+      }
+    }
+  }
+
+
+  // Set up for the original gauge field and the slice direction
+  GRelaxSite::GRelaxSite(const multi1d<LatticeColorMatrix>& u_, int j_decay) : u(u_)
+  {
+    START_CODE();
+
+    if (Nc < 2)
+    {
+      QDPIO::cerr << __func__ << ": needs Nc > 1" << std::endl;
+      QDP_abort(1);
+    }
+
+    int ndir = 0;
+    for(int mu=0; mu < Nd; ++mu)
+      if (mu != j_decay)
+	++ndir;
+
+    dirs.resize(ndir);
+    wgt.resize(ndir);
+    u_back.resize(Nd);
+
+    for(int mu=0, d=0; mu < Nd; ++mu)
+    {
+      if (mu == j_decay)
+	continue;
+
+      dirs[d] = mu;
+      wgt[d] = (mu == tDir() && anisoP()) ? Real(pow(xi_0(), 2)) : Real(1);
+      ++d;
+
+      // Ub(x) = U^dag(x-mu)
+      u_back[mu] = shift(adj(u[mu]), BACKWARD, mu);
+    }
+
+    // Rows of the SU(2) subgroups, in the order of su2Extract
+    const int nsu2 = Nc*(Nc-1)/2;
+    su2_i1.resize(nsu2);
+    su2_i2.resize(nsu2);
+    int index = 0;
+    for(int del_i=1; del_i < Nc; ++del_i)
+      for(int i1=0; i1 < Nc-del_i; ++i1, ++index)
+      {
+	su2_i1[index] = i1;
+	su2_i2[index] = i1 + del_i;
+      }
+
+    multi1d<int> hops(1);
+    hops[0] = 1;
+    table = new SiteNeighborTable(hops);
+    halo  = new SiteHaloField<LatticeColorMatrix>(*table);
+
+    END_CODE();
+  }
+
+
+  // All the SU(2) subgroup hits on one checkerboard
+  void GRelaxSite::operator()(LatticeColorMatrix& g, int cb, bool ordo, const Real& orpara) const
+  {
+    START_CODE();
+
+    using namespace GRelaxSiteEnv;
+
+    multi1d<R> w(wgt.size());
+    for(int d=0; d < wgt.size(); ++d)
+      w[d] = toDouble(wgt[d]);
+
+    halo->start(g);
+
+    const multi1d<int>& inner = table->innerSites(cb);
+    RelaxArgs inner_arg = {g, *halo, *table, u, u_back,
+			   dirs.slice(), w.slice(), dirs.size(),
+			   su2_i1.slice(), su2_i2.slice(), su2_i1.size(),
+			   inner.slice(), ordo, R(toDouble(orpara)), R(toDouble(fuzz))};
+    dispatch_to_threads(inner.size(), inner_arg, siteLoop);
+
+    halo->finish();
+
+    const multi1d<int>& face = table->faceSites(cb);
+    RelaxArgs face_arg = {g, *halo, *table, u, u_back,
+			  dirs.slice(), w.slice(), dirs.size(),
+			  su2_i1.slice(), su2_i2.slice(), su2_i1.size(),
+			  face.slice(), ordo, R(toDouble(orpara)), R(toDouble(fuzz))};
+    dispatch_to_threads(face.size(), face_arg, siteLoop);
+
+    END_CODE();
+  }
+
+}  // end namespace Chroma
+#endif
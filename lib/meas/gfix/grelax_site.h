@@ -0,0 +1,67 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Site-loop gauge fixing relaxation with neighbor tables
+ */
+
+#ifndef __grelax_site_h__
+#define __grelax_site_h__
+
+#include "chromabase.h"
+#include "handle.h"
+#include "util/gauge/site_neighbor_table.h"
+
+namespace Chroma
+{
+
+  //! Site-loop gauge fixing relaxation with neighbor tables
+  /*!
+   * \ingroup gfix
+   *
+   * Does the same update as grelax() called for every SU(2) subgroup of
+   * one checkerboard, for Nc > 1. On a site x of the checkerboard
+   *
+   *   V(x) = g(x) sum_mu [U_mu(x) g^dag(x+mu) + U^dag_mu(x-mu) g^dag(x-mu)]
+   *
+   * is gathered once, all the SU(2) subgroup (over)relaxation hits are
+   * done on it in registers, and g(x) is written once. The neighbors
+   * g(x+-mu) live on the other checkerboard, so the sites are independent
+   * and the loop is threaded. Only g needs a halo exchange; the links are
+   * those of the original field and their backward copies are made once.
+   *
+   * Not available under QDP-JIT, where coulGauge keeps calling grelax()
+   * per subgroup.
+   */
+  class GRelaxSite
+  {
+  public:
+    //! Set up for the original gauge field and the slice direction
+    /*!
+     * \param u        original gauge field ( Read )
+     * \param j_decay  direction perpendicular to slices to be gauge fixed ( Read )
+     */
+    GRelaxSite(const multi1d<LatticeColorMatrix>& u, int j_decay);
+
+    //! All the SU(2) subgroup hits on one checkerboard
+    /*!
+     * \param g        Current (global) gauge transformation matrices ( Modify )
+     * \param cb       checkerboard index ( Read )
+     * \param ordo     use overrelaxation or not ( Read )
+     * \param orpara   overrelaxation parameter ( Read )
+     */
+    void operator()(LatticeColorMatrix& g, int cb, bool ordo, const Real& orpara) const;
+
+  private:
+    multi1d<LatticeColorMatrix>  u;        /*!< U_mu(x) */
+    multi1d<LatticeColorMatrix>  u_back;   /*!< U^dag_mu(x-mu) */
+    multi1d<int>                 dirs;     /*!< the directions summed */
+    multi1d<Real>                wgt;      /*!< their weights */
+    multi1d<int>                 su2_i1;   /*!< rows of each SU(2) subgroup */
+    multi1d<int>                 su2_i2;
+
+    Handle<SiteNeighborTable>                     table;
+    Handle< SiteHaloField<LatticeColorMatrix> >   halo;
+  };
+
+}  // end namespace Chroma
+
+#endif
@@ -0,0 +1,641 @@
+/*! \file
+ *  \brief Fused field strength, action and topological charge densities
+ */
+
+#include "chromabase.h"
+#include "meas/glue/field_strength_kernel.h"
+#include "meas/glue/mesfield.h"
+#include "util/ft/time_slice_set.h"
+
+#include <vector>
+
+namespace Chroma
+{
+
+  //! Site kernels of the field strength
+  namespace FieldStrengthKernelEnv
+  {
+#ifndef QDP_IS_QDPJIT
+    typedef PColorMatrix<QDP::RComplex<REAL>, Nc>  CMat;
+    typedef SiteHaloField<LatticeColorMatrix>       Halo;
+
+    //! Site color matrix of a lattice field
+    inline
+    const CMat& mat(const LatticeColorMatrix& f, int site)
+    {
+      return f.elem(site).elem();
+    }
+
+    inline
+    CMat& mat(LatticeColorMatrix& f, int site)
+    {
+      return f.elem(site).elem();
+    }
+
+    //! r += c s
+    inline
+    void addScaled(CMat& r, REAL c, const CMat& s)
+    {
+      for(int i=0; i < Nc; ++i)
+	for(int j=0; j < Nc; ++j)
+	{
+	  r.elem(i,j).real() += c * s.elem(i,j).real();
+	  r.elem(i,j).imag() += c * s.elem(i,j).imag();
+	}
+    }
+
+    //! Re Tr a b
+    inline
+    REAL realTraceProd(const CMat& a, const CMat& b)
+    {
+      REAL s = 0;
+      for(int i=0; i < Nc; ++i)
+	for(int k=0; k < Nc; ++k)
+	  s += a.elem(i,k).real() * b.elem(k,i).real() - a.elem(i,k).imag() * b.elem(k,i).imag();
+      return s;
+    }
+
+
+    //! out_i(x) = a_i(x) h(x+hop_i), for up to Nd products gathering the same h
+    struct MulArgs
+    {
+      const LatticeColorMatrix& h;
+      const Halo& halo;
+      const SiteNeighborTable& table;
+      const int* sites;
+      int n;
+      LatticeColorMatrix* out[Nd];
+      const LatticeColorMatrix* a[Nd];
+      int hop[Nd];
+    };
+
+    inline
+    void mulSiteLoop(int lo, int hi, int my_id, MulArgs* a)
+    {
+      for(int ssite=lo; ssite < hi; ++ssite)
+      {
+	int site = a->sites[ssite];
+
+	for(int i=0; i < a->n; ++i)
+	{
+	  int nb = a->table.neighbor(site, a->hop[i]);
+	  mat(*(a->out[i]), site) = mat(*(a->a[i]), site) * a->halo.site(a->h, nb).elem();
+	}
+      }
+    }
+
+
+    //! W = T1 T2^dag,  B = L^dag W L
+    struct LoopArgs
+    {
+      LatticeColorMatrix& w;
+      LatticeColorMatrix& b;
+      const LatticeColorMatrix& t1;
+      const LatticeColorMatrix& t2;
+      const LatticeColorMatrix& l;
+      const int* sites;
+    };
+
+    inline
+    void loopSiteLoop(int lo, int hi, int my_id, LoopArgs* a)
+    {
+      for(int ssite=lo; ssite < hi; ++ssite)
+      {
+	int site = a->sites[ssite];
+
+	const CMat& l = mat(a->l, site);
+	CMat w = mat(a->t1, site) * adj(mat(a->t2, site));
+	CMat t = adj(l) * w;
+
+	mat(a->b, site) = t * l;
+	mat(a->w, site) = w;
+      }
+    }
+
+
+    //! Q = W + B(x-hop),  V = L^dag Q L
+    struct TransportArgs
+    {
+      LatticeColorMatrix& q;
+      LatticeColorMatrix& v;
+      const LatticeColorMatrix& b;
+      const LatticeColorMatrix& l;
+      const Halo& halo;
+      const SiteNeighborTable& table;
+      int hop;
+      const int* sites;
+    };
+
+    inline
+    void transportSiteLoop(int lo, int hi, int my_id, TransportArgs* a)
+    {
+      for(int ssite=lo; ssite < hi; ++ssite)
+      {
+	int site = a->sites[ssite];
+	int n = a->table.neighbor(site, a->hop);
+
+	const CMat& l = mat(a->l, site);
+	CMat& q = mat(a->q, site);
+	q += a->halo.site(a->b, n).elem();
+
+	CMat t = adj(l) * q;
+	mat(a->v, site) = t * l;
+      }
+    }
+
+
+    //! C += c (Q + V(x-hop))
+    struct AccumArgs
+    {
+      LatticeColorMatrix& clov;
+      const LatticeColorMatrix& q;
+      const LatticeColorMatrix& v;
+      const Halo& halo;
+      const SiteNeighborTable& table;
+      int hop;
+      REAL c;
+      const int* sites;
+    };
+
+    inline
+    void accumSiteLoop(int lo, int hi, int my_id, AccumArgs* a)
+    {
+      for(int ssite=lo; ssite < hi; ++ssite)
+      {
+	int site = a->sites[ssite];
+	int n = a->table.neighbor(site, a->hop);
+
+	CMat& r = mat(a->clov, site);
+	addScaled(r, a->c, mat(a->q, site));
+	addScaled(r, a->c, a->halo.site(a->v, n).elem());
+      }
+    }
+
+
+    //! F from the clovers, the densities and their per-thread time slice sums
+    struct FinalArgs
+    {
+      LatticeColorMatrix* f;             // may be null
+      LatticeReal& e_space;
+      LatticeReal& e_time;
+      LatticeReal& q;
+      const LatticeColorMatrix* clov;
+      const bool* in_time;               // does the plane contain the time direction
+      const int* tcoord;
+      int lt;
+      bool traceless;
+      REAL64* partial;                   // [thread][t][e_space, e_time, q]
+      const int* sites;
+    };
+
+    inline
+    void finalSiteLoop(int lo, int hi, int my_id, FinalArgs* a)
+    {
+      const int np = Nd*(Nd-1)/2;
+      const REAL fact = 0.125;
+      const REAL qfact = -1.0 / (toDouble(twopi) * toDouble(twopi));
+
+      for(int ssite=lo; ssite < hi; ++ssite)
+      {
+	int site = a->sites[ssite];
+
+	CMat g[np];
+	REAL es = 0;
+	REAL et = 0;
+
+	for(int p=0; p < np; ++p)
+	{
+	  const CMat& c = mat(a->clov[p], site);
+
+	  // (1/8)(C - C^dag)
+	  for(int i=0; i < Nc; ++i)
+	    for(int j=0; j < Nc; ++j)
+	    {
+	      g[p].elem(i,j).real() = fact * (c.elem(i,j).real() - c.elem(j,i).real());
+	      g[p].elem(i,j).imag() = fact * (c.elem(i,j).imag() + c.elem(j,i).imag());
+	    }
+
+	  if (a->traceless)
+	  {
+	    REAL tr = 0;
+	    for(int i=0; i < Nc; ++i)
+	      tr += g[p].elem(i,i).imag();
+	    tr /= REAL(Nc);
+	    for(int i=0; i < Nc; ++i)
+	      g[p].elem(i,i).imag() -= tr;
+	  }
+
+	  if (a->f != 0)
+	    mat(a->f[p], site) = g[p];
+
+	  REAL e = -realTraceProd(g[p], g[p]);
+	  if (a->in_time[p])
+	    et += e;
+	  else
+	    es += e;
+	}
+
+	// eps_{mu nu rho sigma} with the planes in the order 01 02 03 12 13 23
+	REAL qd = 0;
+	if (Nd == 4)
+	  qd = qfact * (realTraceProd(g[0], g[5]) - realTraceProd(g[1], g[4]) + realTraceProd(g[2], g[3]));
+
+	a->e_space.elem(site).elem().elem().elem() = es;
+	a->e_time.elem(site).elem().elem().elem()  = et;
+	a->q.elem(site).elem().elem().elem()       = qd;
+
+	REAL64* s = a->partial + 3*(my_id*a->lt + a->tcoord[site]);
+	s[0] += es;
+	s[1] += et;
+	s[2] += qd;
+      }
+    }
+
+
+    //! Run a site loop that gathers h, on the inner sites while the halo is in flight
+    template<typename A>
+    void haloSweep(A& arg, const LatticeColorMatrix& h, Halo& halo,
+		   const SiteNeighborTable& table, void (*loop)(int, int, int, A*))
+    {
+      halo.start(h);
+
+      for(int cb=0; cb < 2; ++cb)
+      {
+	const multi1d<int>& inner = table.innerSites(cb);
+	arg.sites = inner.slice();
+	dispatch_to_threads(inner.size(), arg, loop);
+      }
+
+      halo.finish();
+
+      for(int cb=0; cb < 2; ++cb)
+      {
+	const multi1d<int>& face = table.faceSites(cb);
+	arg.sites = face.slice();
+	dispatch_to_threads(face.size(), arg, loop);
+      }
+    }
+
+
+    //! Run a site loop without neighbors
+    template<typename A>
+    void localSweep(A& arg, void (*loop)(int, int, int, A*))
+    {
+      const Subset& s = all;
+      arg.sites = s.siteTable().slice();
+      dispatch_to_threads(s.numSiteTable(), arg, loop);
+    }
+#else
+    //! f(x + n mu), for n of either sign
+    LatticeColorMatrix shiftBy(const LatticeColorMatrix& f, int mu, int n)
+    {
+      LatticeColorMatrix r = f;
+      for(int i=0; i < n; ++i)
+      {
+	LatticeColorMatrix tmp = shift(r, FORWARD, mu);
+	r = tmp;
+      }
+      for(int i=0; i < -n; ++i)
+      {
+	LatticeColorMatrix tmp = shift(r, BACKWARD, mu);
+	r = tmp;
+      }
+      return r;
+    }
+#endif
+  }
+
+
+  // Set up the neighbor tables
+  FieldStrengthKernel::FieldStrengthKernel(Definition def, int j_decay_, bool traceless_) :
+    j_decay(j_decay_), traceless(traceless_)
+  {
+    START_CODE();
+
+    if (j_decay < 0 || j_decay >= Nd)
+    {
+      QDPIO::cerr << __func__ << ": invalid j_decay = " << j_decay << std::endl;
+      QDP_abort(1);
+    }
+
+    switch (def)
+    {
+    case CLOVER:
+      max_len = 1;
+      shape_a.resize(1);
+      shape_b.resize(1);
+      shape_w.resize(1);
+      group.resize(1);
+      shape_a[0] = 1;  shape_b[0] = 1;  shape_w[0] = 1;  group[0] = 0;
+      break;
+
+    case FIVE_LOOP:
+    {
+      // c1 = (19 - 55 c5)/9, c2 = (1 - 64 c5)/9, c3 = (-64 + 640 c5)/45,
+      // c4 = 1/5 - 2 c5, with c5 = 1/20. Each clover is divided by its
+      // area, and by 2 for the average of the m x n and n x m ones.
+      const int    a[7] = {1, 2, 1, 2, 1, 3, 3};
+      const int    b[7] = {1, 2, 2, 1, 3, 1, 3};
+      const int    g[7] = {0, 1, 2, 2, 3, 3, 4};
+      const double w[7] = {65.0/36.0, -11.0/180.0, -8.0/45.0, -8.0/45.0,
+			   1.0/60.0, 1.0/60.0, 1.0/180.0};
+
+      max_len = 3;
+      shape_a.resize(7);
+      shape_b.resize(7);
+      shape_w.resize(7);
+      group.resize(7);
+      for(int s=0; s < 7; ++s)
+      {
+	shape_a[s] = a[s];
+	shape_b[s] = b[s];
+	shape_w[s] = w[s];
+	group[s]   = g[s];
+      }
+    }
+    break;
+
+    default:
+      QDPIO::cerr << __func__ << ": unknown field strength definition" << std::endl;
+      QDP_abort(1);
+    }
+
+    // Hops of length 1 to max_len; hop length l has index l-1
+    multi1d<int> hops(max_len);
+    for(int l=0; l < max_len; ++l)
+      hops[l] = l+1;
+
+#ifndef QDP_IS_QDPJIT
+    table = new SiteNeighborTable(hops);
+    halo  = new SiteHaloField<LatticeColorMatrix>(*table);
+
+    // Time coordinates of the sites on this node
+    const int nsites = Layout::sitesOnNode();
+    tcoord.resize(nsites);
+    for(int site=0; site < nsites; ++site)
+      tcoord[site] = Layout::siteCoords(Layout::nodeNumber(), site)[j_decay];
+#endif
+
+    END_CODE();
+  }
+
+
+  // The densities and their time slice sums
+  void FieldStrengthKernel::operator()(FieldStrengthDensities_t& dens,
+				       const multi1d<LatticeColorMatrix>& u) const
+  {
+    compute(0, dens, u);
+  }
+
+
+  // The field strength and the densities
+  void FieldStrengthKernel::operator()(multi1d<LatticeColorMatrix>& f,
+				       FieldStrengthDensities_t& dens,
+				       const multi1d<LatticeColorMatrix>& u) const
+  {
+    f.resize(Nd*(Nd-1)/2);
+    compute(&f, dens, u);
+  }
+
+
+  // Everything
+  void FieldStrengthKernel::compute(multi1d<LatticeColorMatrix>* f,
+				    FieldStrengthDensities_t& dens,
+				    const multi1d<LatticeColorMatrix>& u) const
+  {
+    START_CODE();
+
+    using namespace FieldStrengthKernelEnv;
+
+    const int np = Nd*(Nd-1)/2;
+
+#ifndef QDP_IS_QDPJIT
+    const SiteNeighborTable& tab = *table;
+    Halo& hal = *halo;
+
+    // Lines L^l_mu(x) = U_mu(x) L^{l-1}_mu(x+mu), stored at (mu, l-1)
+    multi2d<LatticeColorMatrix> lines(Nd, max_len);
+    for(int mu=0; mu < Nd; ++mu)
+    {
+      lines(mu,0) = u[mu];
+      for(int l=1; l < max_len; ++l)
+      {
+	MulArgs arg = {lines(mu,l-1), hal, tab, 0, 1};
+	arg.out[0] = &lines(mu,l);
+	arg.a[0]   = &u[mu];
+	arg.hop[0] = tab.hop(mu, +1, 0);
+	haloSweep(arg, lines(mu,l-1), hal, tab, mulSiteLoop);
+      }
+    }
+
+    // The clover sums of all the planes, in the order of mesField
+    multi1d<LatticeColorMatrix> clov(np);
+    for(int p=0; p < np; ++p)
+      clov[p] = zero;
+
+    LatticeColorMatrix w, b, v;
+
+    for(int g0=0; g0 < group.size(); ++g0)
+    {
+      // The shapes of this group, a shape and its transpose
+      std::vector<int> shapes;
+      for(int s=0; s < group.size(); ++s)
+	if (group[s] == g0)
+	  shapes.push_back(s);
+
+      if (shapes.empty())
+	continue;
+
+      const int ns = shapes.size();
+
+      // Corners T^{ab}_{mu nu}(x) = L^a_mu(x) L^b_nu(x+a mu) of the shapes,
+      // for all ordered pairs mu != nu. The halo of each L^b_nu is
+      // exchanged once for all the mu.
+      multi1d<LatticeColorMatrix> corner(ns*Nd*(Nd-1));
+
+      for(int s=0; s < ns; ++s)
+      {
+	const int la = shape_a[shapes[s]];
+	const int lb = shape_b[shapes[s]];
+
+	for(int nu=0; nu < Nd; ++nu)
+	{
+	  MulArgs arg = {lines(nu,lb-1), hal, tab, 0, 0};
+	  for(int mu=0; mu < Nd; ++mu)
+	  {
+	    if (mu == nu)
+	      continue;
+
+	    arg.out[arg.n] = &corner[(s*Nd + mu)*(Nd-1) + ((nu < mu) ? nu : nu-1)];
+	    arg.a[arg.n]   = &lines(mu,la-1);
+	    arg.hop[arg.n] = tab.hop(mu, +1, la-1);
+	    ++arg.n;
+	  }
+	  haloSweep(arg, lines(nu,lb-1), hal, tab, mulSiteLoop);
+	}
+      }
+
+      // The clovers of every plane
+      int p = 0;
+      for(int mu=0; mu < Nd-1; ++mu)
+      {
+	for(int nu=mu+1; nu < Nd; ++nu, ++p)
+	{
+	  for(int s=0; s < ns; ++s)
+	  {
+	    const int la = shape_a[shapes[s]];
+	    const int lb = shape_b[shapes[s]];
+
+	    // The transposed shape gives T^{ba}_{nu mu}
+	    int st = -1;
+	    for(int r=0; r < ns; ++r)
+	      if (shape_a[shapes[r]] == lb && shape_b[shapes[r]] == la)
+		st = r;
+
+	    if (st < 0)
+	    {
+	      QDPIO::cerr << __func__ << ": no transposed loop shape" << std::endl;
+	      QDP_abort(1);
+	    }
+
+	    const LatticeColorMatrix& t1 = corner[(s*Nd + mu)*(Nd-1) + (nu-1)];
+	    const LatticeColorMatrix& t2 = corner[(st*Nd + nu)*(Nd-1) + mu];
+
+	    LoopArgs larg = {w, b, t1, t2, lines(nu,lb-1), 0};
+	    localSweep(larg, loopSiteLoop);
+
+	    TransportArgs targ = {w, v, b, lines(mu,la-1), hal, tab, tab.hop(nu, -1, lb-1), 0};
+	    haloSweep(targ, b, hal, tab, transportSiteLoop);
+
+	    AccumArgs aarg = {clov[p], w, v, hal, tab, tab.hop(mu, -1, la-1),
+			      REAL(toDouble(shape_w[shapes[s]])), 0};
+	    haloSweep(aarg, v, hal, tab, accumSiteLoop);
+	  }
+	}
+      }
+    }
+
+    // F, the densities and the time slice sums in one sweep
+    multi1d<bool> in_time(np);
+    {
+      int p = 0;
+      for(int mu=0; mu < Nd-1; ++mu)
+	for(int nu=mu+1; nu < Nd; ++nu, ++p)
+	  in_time[p] = (mu == j_decay || nu == j_decay);
+    }
+
+    const int lt = Layout::lattSize()[j_decay];
+    const int nthr = qdpNumThreads();
+    multi1d<REAL64> partial(3*lt*nthr);
+    partial = 0;
+
+    FinalArgs farg = {(f != 0) ? f->slice() : 0, dens.e_space, dens.e_time, dens.q,
+		      clov.slice(), in_time.slice(), tcoord.slice(), lt, traceless,
+		      partial.slice(), 0};
+    localSweep(farg, finalSiteLoop);
+
+    multi1d<REAL64> tsum(3*lt);
+    tsum = 0;
+    for(int t=0; t < nthr; ++t)
+      for(int i=0; i < 3*lt; ++i)
+	tsum[i] += partial[3*lt*t + i];
+
+    QDPInternal::globalSumArray(tsum.slice(), 3*lt);
+
+    dens.e_space_t.resize(lt);
+    dens.e_time_t.resize(lt);
+    dens.q_t.resize(lt);
+    for(int t=0; t < lt; ++t)
+    {
+      dens.e_space_t[t] = tsum[3*t];
+      dens.e_time_t[t]  = tsum[3*t+1];
+      dens.q_t[t]       = tsum[3*t+2];
+    }
+#else
+    // Under QDP-JIT the clovers are made with shifts. The plain clover is mesField()
+    multi1d<LatticeColorMatrix> g;
+
+    if (max_len == 1)
+      mesField(g, u);
+    else
+    {
+      // Lines L^l_mu(x) = U_mu(x) L^{l-1}_mu(x+mu), stored at (mu, l-1)
+      multi2d<LatticeColorMatrix> lines(Nd, max_len);
+      for(int mu=0; mu < Nd; ++mu)
+      {
+	lines(mu,0) = u[mu];
+	for(int l=1; l < max_len; ++l)
+	  lines(mu,l) = u[mu] * shift(lines(mu,l-1), FORWARD, mu);
+      }
+
+      g.resize(np);
+
+      int p = 0;
+      for(int mu=0; mu < Nd-1; ++mu)
+      {
+	for(int nu=mu+1; nu < Nd; ++nu, ++p)
+	{
+	  LatticeColorMatrix clov = zero;
+
+	  for(int s=0; s < shape_a.size(); ++s)
+	  {
+	    const int la = shape_a[s];
+	    const int lb = shape_b[s];
+	    const LatticeColorMatrix& l_mu = lines(mu,la-1);
+	    const LatticeColorMatrix& l_nu = lines(nu,lb-1);
+
+	    LatticeColorMatrix t1 = l_mu * shiftBy(l_nu, mu, la);
+	    LatticeColorMatrix t2 = l_nu * shiftBy(l_mu, nu, lb);
+	    LatticeColorMatrix w = t1 * adj(t2);
+
+	    LatticeColorMatrix q = w + shiftBy(adj(l_nu) * w * l_nu, nu, -lb);
+	    clov += shape_w[s] * (q + shiftBy(adj(l_mu) * q * l_mu, mu, -la));
+	  }
+
+	  g[p] = Real(0.125) * (clov - adj(clov));
+	}
+      }
+    }
+
+    dens.e_space = zero;
+    dens.e_time  = zero;
+
+    int p = 0;
+    for(int mu=0; mu < Nd-1; ++mu)
+    {
+      for(int nu=mu+1; nu < Nd; ++nu, ++p)
+      {
+	if (traceless)
+	{
+	  LatticeReal tr = imag(trace(g[p])) / Real(Nc);
+	  LatticeColorMatrix aux = cmplx(0, tr);
+	  g[p] -= aux;
+	}
+
+	LatticeReal e = -real(trace(g[p] * g[p]));
+	if (mu == j_decay || nu == j_decay)
+	  dens.e_time += e;
+	else
+	  dens.e_space += e;
+      }
+    }
+
+    if (Nd == 4)
+      dens.q = -Real(1) / (Real(twopi)*Real(twopi))
+	* real(trace(g[0]*g[5] - g[1]*g[4] + g[2]*g[3]));
+    else
+      dens.q = zero;
+
+    if (f != 0)
+      *f = g;
+
+    TimeSliceSet ts(j_decay);
+    dens.e_space_t = sumMulti(dens.e_space, ts.getSet());
+    dens.e_time_t  = sumMulti(dens.e_time, ts.getSet());
+    dens.q_t       = sumMulti(dens.q, ts.getSet());
+#endif
+
+    END_CODE();
+  }
+
+}  // end namespace Chroma
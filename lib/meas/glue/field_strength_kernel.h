@@ -0,0 +1,122 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Fused field strength, action and topological charge densities
+ */
+
+#ifndef __field_strength_kernel_h__
+#define __field_strength_kernel_h__
+
+#include "chromabase.h"
+#include "handle.h"
+#include "util/gauge/site_neighbor_table.h"
+
+namespace Chroma
+{
+
+  //! Densities made by the FieldStrengthKernel
+  /*! \ingroup glue */
+  struct FieldStrengthDensities_t
+  {
+    LatticeReal      e_space;     /*!< -sum Re Tr F_ij F_ij over the planes without the time direction */
+    LatticeReal      e_time;      /*!< -sum Re Tr F_i4 F_i4 over the planes with the time direction */
+    LatticeReal      q;           /*!< topological charge density */
+
+    multi1d<Double>  e_space_t;   /*!< time slice sums of e_space */
+    multi1d<Double>  e_time_t;    /*!< time slice sums of e_time */
+    multi1d<Double>  q_t;         /*!< time slice sums of q */
+  };
+
+
+  //! Fused field strength, action and topological charge densities
+  /*!
+   * \ingroup glue
+   *
+   * All six F(mu,nu) are made in one set of site sweeps, and the action
+   * and topological charge densities and their time slice sums in a
+   * final one. With the lines L^a_mu(x) = U_mu(x) ... U_mu(x+(a-1)mu),
+   * the corners
+   *
+   *   T^{ab}_{mu nu}(x) = L^a_mu(x) L^b_nu(x+a mu)
+   *
+   * are made once for all the planes, and the a x b loop at x is
+   *
+   *   W(x) = T^{ab}_{mu nu}(x) T^{ba dag}_{nu mu}(x)
+   *
+   * The other three leaves of the clover are W at x-b nu, x-a mu and
+   * x-a mu-b nu, parallel transported to x. Two transports suffice:
+   *
+   *   Q(x) = W(x) + [L^dag_nu W L_nu](x-b nu)
+   *   C(x) = Q(x) + [L^dag_mu Q L_mu](x-a mu)
+   *
+   * so every loop shape needs two transports per plane, besides the
+   * corners shared by all the planes. Each transport is a SiteHaloField
+   * exchange, which ships all 2 Nd faces of the field at the depth of the
+   * longest loop side. That is more data than the one face shifts of
+   * mesField(); the gain is fewer sweeps and lattice temporaries, with
+   * the inner sites computed while the faces are in flight. As in
+   * mesField(),
+   *
+   *   F(mu,nu) = (1/8) [ C(x) - C^dag(x) ]
+   *
+   * is i times the usual hermitian field strength, optionally made
+   * traceless. The densities are
+   *
+   *   e(x) = - sum_{mu<nu} Re Tr F(mu,nu) F(mu,nu)
+   *   q(x) = - 1/(4 pi^2) Re Tr [F(0,1) F(2,3) - F(0,2) F(1,3) + F(0,3) F(1,2)]
+   *
+   * the latter with the normalization of qactden().
+   *
+   * The FIVE_LOOP definition is the tree level O(a^4) improved
+   * combination of the 1x1, 2x2, 1x2, 1x3 and 3x3 clovers of
+   * de Forcrand, Garcia Perez and Stamatescu, Nucl. Phys. B499 (1997) 409,
+   * with c5 = 1/20. The m x n and n x m clovers are averaged and each is
+   * normalized by 1/(m n).
+   *
+   * Under QDP-JIT the site sweeps are not used: the clovers are made
+   * with shifts, and the plain clover is that of mesField().
+   */
+  class FieldStrengthKernel
+  {
+  public:
+    //! The definitions of the field strength
+    enum Definition {CLOVER, FIVE_LOOP};
+
+    //! Set up the neighbor tables
+    /*!
+     * \param def        definition of the field strength ( Read )
+     * \param j_decay    direction of the time slices ( Read )
+     * \param traceless  remove the trace of F ( Read )
+     */
+    FieldStrengthKernel(Definition def, int j_decay, bool traceless = true);
+
+    //! The densities and their time slice sums
+    void operator()(FieldStrengthDensities_t& dens,
+		    const multi1d<LatticeColorMatrix>& u) const;
+
+    //! The field strength, in the plane order of mesField(), and the densities
+    void operator()(multi1d<LatticeColorMatrix>& f,
+		    FieldStrengthDensities_t& dens,
+		    const multi1d<LatticeColorMatrix>& u) const;
+
+  private:
+    //! Everything, f is written if not null
+    void compute(multi1d<LatticeColorMatrix>* f,
+		 FieldStrengthDensities_t& dens,
+		 const multi1d<LatticeColorMatrix>& u) const;
+
+    int                 j_decay;
+    bool                traceless;
+    int                 max_len;      /*!< longest side of a loop */
+    multi1d<int>        shape_a;      /*!< loop extent in the first direction */
+    multi1d<int>        shape_b;      /*!< loop extent in the second direction */
+    multi1d<Real>       shape_w;      /*!< weight of the clover of each shape */
+    multi1d<int>        group;        /*!< shapes sharing corners have the same group */
+    multi1d<int>        tcoord;       /*!< time coordinate of the sites on this node */
+
+    Handle<SiteNeighborTable>                    table;
+    Handle< SiteHaloField<LatticeColorMatrix> >  halo;
+  };
+
+}  // end namespace Chroma
+
+#endif
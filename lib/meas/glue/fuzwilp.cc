@@ -7,6 +7,7 @@
 #include "chromabase.h"
 #include "meas/smear/ape_smear.h"
 #include "meas/glue/fuzwilp.h"
+#include "meas/glue/wilson_loop_engine.h"
 
 namespace Chroma { 
 //! Calculate ape-fuzzed Wilson loops
@@ -18,8 +19,9 @@ namespace Chroma {
  * This version makes APE-smeared links with no blocking as required
  *          for potential clculations
  *
- * Warning: This version is VERY Slow as it has non-recursive shifting
- *          of some link products
+ * The temporal lines are made once and every space-like segment and
+ *          corner is built incrementally, so each (r,s,t) costs O(1) shifts
+ *
  * Warning: this works only for Nc = 2 and 3 ! (Projection of
  *                                              smeared/blocked links)
  *
@@ -69,8 +71,6 @@ void fuzwilp( const multi1d<LatticeColorMatrix>& u,
   LatticeColorMatrix   up_t;
   LatticeColorMatrix   u_corn;
   LatticeColorMatrix   tmp_1;
-  LatticeColorMatrix   tmp_2;
-  LatticeReal wl_trace;
 
   multi2d<Double> fuz_wlp1(lengthr, lengtht);
   multi2d<Double> fuz_wlp2(lengthrs, lengtht);
@@ -170,103 +170,41 @@ void fuzwilp( const multi1d<LatticeColorMatrix>& u,
 //	  W = Tr[ U1 * U2 * U3+ * U4+ ]
 //
 
-  for(t = 0;t  < ( lengtht); ++t )
+  /* Products of un-fuzzed links in t (j_decay) direction of all lengths */
+  WilsonLoopEngine engine(u[j_decay], j_decay, lengtht);
+  multi1d<Double> w_t;
+
+  multi1d<LatticeColorMatrix> nu_back(lengthr);
+  multi1d<LatticeColorMatrix> nu_fwd(lengthr);
+  multi1d<LatticeColorMatrix> nu_bwd(lengthr);
+  LatticeColorMatrix mu_fs;
+  LatticeColorMatrix mu_bs;
+  LatticeColorMatrix up_f;
+  LatticeColorMatrix up_b;
+
+  mum = -1;
+  for(mu = 0;mu  < ( Nd); ++mu )
   {
+    if( mu == j_decay )
+      continue;
 
-    /* Compute product of un-fuzzed links in t (j_decay) direction */
-   QDPIO::cout << "t= " << t << std::endl;
-    if( t == 0 )
-    {
-	up_t = u[j_decay];
-    }
-    else
-    {
-	tmp_tog = shift(up_t, FORWARD, j_decay);
-	up_t    = u[j_decay] * tmp_tog; 
-//
-//	| U
-//	| U    last Up shifted up one in t direction
-//	| U
-//	| U
-//      ----
-//      | U
-//		use new up_t for U4 
-//
-    }
+    mum = mum + 1;
 
-    mum = -1;
-    for(mu = 0;mu  < ( Nd); ++mu )
+    /* Planar loops */
+    for(r = 0;r  < ( lengthr); ++r )
     {
-      if( mu != j_decay )
-      {
-	mum = mum + 1;
-//   QDPIO::cout << "mu= " << mu << std::endl;
-	for(r = 0;r  < ( lengthr); ++r )
-	{
-	    /* Gather 'time-like' link segment from r-direction */
-
-	    tmp_tog = shift(up_t, FORWARD, mu);
-	    n = r;
-	    while( n > 0 )
-	    {
-	      tmp_1 = shift(tmp_tog, FORWARD, mu);
-	      tmp_tog = tmp_1;
-	      n = n - 1;
-	    }
-	    tmp_1 = tmp_tog;   
-//
-//	.		|
-//	.		^   tmp_1  (Up shifted r+1 in mu direction)
-//	.		|
-//	.		|
-//				use tmp_1 for U2
-
-	    /* Gather 'space-like' link segment from t-direction */
-
-	    tmp_tog = shift(u_prod[mum][r], FORWARD, j_decay);
-	    n = t;
-	    while( n > 0 )
-	    {
-	      tmp_2 = shift( tmp_tog, FORWARD, j_decay);
-	      tmp_tog = tmp_2;
-	      n = n - 1;
-	    }
-//
-//
-//	  tmp_tog (u_prod shifted t+1 in t direction)
-//	-------->--------
-//
-//
-//
-//	.................
-//				use tmp_tog for U3
-//
-//
-	    /* Now complete the planar Wilson loop */
+      /* Time-like link at the end of the space-like segment, x+(r+1)mu */
+      tmp_tog = shift((r == 0) ? u[j_decay] : up_t, FORWARD, mu);
+      up_t = tmp_tog;
 
-	    tmp_2 = tmp_1 * adj(tmp_tog);
-//
-//		U2 * U3+
-//
-	    tmp_1 = tmp_2 * adj(up_t);	
-//
-//		U2 * U3+ * U4+
-//
- 	    tmp_2 = u_prod[mum][r] * tmp_1;
-//
-//		U1 * U2 * U3+ * U4+
-//
-	    wl_trace = real(trace(tmp_2));
-	    fuz_wlp1[r][t] += sum(wl_trace);
-
-//  QDPIO::cout << "t= " << t << "   r= " << r << std::endl;
-//  QDPIO::cout << "fuz_wlp1= "  << 2*fuz_wlp1[r][t]/ 
-//		double((Layout::vol())*(Nd-1)*(Nd-2)*Nc) << std::endl;
+      w_t = engine.loops(u_prod[mum][r], up_t);
+      for(t = 0;t  < ( lengtht); ++t )
+	fuz_wlp1[r][t] += w_t[t];
+    }
 
-	  /* Now do non-planar loops */
+    /* Now do non-planar loops */
 
 //
-//	We are currently inside t, mu, and r loops
 //	   _____________
 //	  /		|
 //	 /		|
@@ -276,251 +214,76 @@ void fuzwilp( const multi1d<LatticeColorMatrix>& u,
 //	^ t (j_decay)	|
 //	|   ____________|
 //	|  /   s (nu)
-//	| /r (mu)	
-//	|/ 
-//
-	  nun = -1;
-	  for(nu = 0;nu  < ( Nd); ++nu )
-	  {
-	    if ( nu != j_decay && nu == mu )
-	      /* advance nun, since next "if" is not satisfied! */
-	      nun = nun + 1;
-
-	    if ( nu != j_decay && nu != mu )
-	    {
-	      nun = nun + 1;
-//   QDPIO::cout << "nu= " << nu << std::endl;
-	      for(s = 0;s  <= ( r); ++s )
-	      {
-		/* Construct the 'forward' space-like segments */
-
-		  /* Gather 'nu link segment' from r-direction */
-
-		  tmp_tog = shift(u_prod[nun][s], FORWARD, mu);
-
-		  n = r;
-		  while( n > 0 )
-		  {
-		    tmp_1 = shift( tmp_tog, FORWARD, mu);
-		    tmp_tog = tmp_1;
-		    n = n - 1;
-		  }
-		  u_corn = u_prod[mum][r] * tmp_tog;
-//
-//	   ___________
-//	  /     s (nu)
-//	 / r (mu)  		1st u_corn contribution  
-//	/
+//	| /r (mu)
+//	|/
 //
+    nun = -1;
+    for(nu = 0;nu  < ( Nd); ++nu )
+    {
+      if( nu == j_decay )
+	continue;
 
-		  /* Gather 'mu link segment' from s-direction */
-
-		  tmp_tog = shift(u_prod[mum][r], FORWARD, nu);
-		  n = s;
-		  while( n > 0 )
-		  {
-		    tmp_1 = shift(tmp_tog, FORWARD, nu);
-		    tmp_tog = tmp_1;
-		    n = n -1;
-		  }
-		  u_corn += u_prod[nun][s] * tmp_tog;
-//
-//	              /  
-//	             / r (mu)  	2nd u_corn contribution
-//	____________/
-//	   s (nu)
-
-		/* Now collect to construct the Wilson loop */
-
-		  /* Gather 'time-like' link segment from r-direction first */
-
-		  tmp_tog = shift(up_t, FORWARD, mu);
-		  n = r;
-		  while( n > 0 )
-		  {
-		    tmp_1 = shift(tmp_tog, FORWARD, mu);
-		    tmp_tog = tmp_1;
-		    n = n - 1;
-		  }
-		  tmp_1 = tmp_tog;
-
-		  /* Gather 'time-like' link segment from s-direction next */
-
-		  tmp_tog = shift(tmp_1, FORWARD, nu);
-		  n = s;
-		  while( n > 0 )
-		  {
-		    tmp_2 = shift(tmp_tog, FORWARD, nu);
-		    tmp_tog = tmp_2;
-		    n = n - 1;
-		  }
-		  tmp_1 = tmp_tog;
-//
-//  		.	|
-//		.	|
-//	.	.	|
-//    	.	.	^   tmp_1 is now Up shifted by s,t in mu,nu 
-//    	.	.	|
-//    	.	.	|
-//    	.	. . . . |
-//    	.   .
-//	.
-//
+      nun = nun + 1;
+      if( nu == mu )
+	continue;
 
-		  /* Gather 'space-like' link segment from t-direction */
+      /* nu_back[s](x) = u_prod[nun][s](x-(s+1)nu), built like u_prod */
+      tmp_1 = shift(u_smear[nu], BACKWARD, nu);
+      nu_back[0] = tmp_1;
+      for(s = 1;s  < ( lengthr); ++s )
+      {
+	tmp_tog = shift(tmp_1, BACKWARD, nu);
+	tmp_1 = tmp_tog;
+	nu_back[s] = tmp_1 * nu_back[s-1];
+      }
 
-		  tmp_tog = shift(u_corn, FORWARD, j_decay);
-		  n = t;
-		  while( n > 0 )
-		  {
-		    tmp_2 = shift(tmp_tog, FORWARD, j_decay);
-		    tmp_tog = tmp_2;
-		    n = n - 1;
-         	  }
-//
-//	   _____________
-//	  /		.
-//	 /		.
-//	/		.
-//			.	tmp_tog is u_corn shifted by t+1
-//	.		.
-//	.       	.
-//	.   .............
-//	.  .   s (nu)
-//	. . r (mu)	
-//	.. 
-//
-		  /* Now complete the 'forward' non-planar Wilson loop */
-
-		  tmp_2 = tmp_1 * adj(tmp_tog);
-		  tmp_1 = tmp_2 * adj(up_t);
-		  tmp_2 = u_corn * tmp_1;
-
-
-//			U3 (tmp_tog)
-//		   _____________
-//		  /		|
-//		 /		|
-//		/		|
-//		|		| U2 (tmp_1)
-//		|		|
-// U4 (Up)	|		|
-//		|   ____________|
-//		|  /   
-//		| /   U1 (u_corn)	
-//		|/ 
-//
-//    so W = Tr [ U1 * U2 * U3+ * U4+ ]
-//
-		  wl_trace = real(trace(tmp_2));
-		  n = r * (r+1) / 2 + s;
-		  fuz_wlp2[n][t] += sum(wl_trace);
-
-		/* Construct the 'backward' space-like segments */
-
-		  /* Gather 'nu link segment' from r-direction */
-
-		  tmp_tog = shift(u_prod[nun][s], FORWARD, mu);
-
-		  n = r;
-		  while( n > 0 )
- 		  {
-		    tmp_1 = shift(tmp_tog, FORWARD, mu);
-		    tmp_tog = tmp_1;
-		    n = n - 1;
-		  }
-		  tmp_1 = tmp_tog;
-
-		  /* Now fetch this from backward s-direction */
-
-		  tmp_tog = shift(tmp_1, BACKWARD, nu);
-		  n = s;
-		  while( n > 0 )
-		  {
-		    tmp_2 = shift(tmp_tog, BACKWARD, nu);
-                    tmp_tog = tmp_2;
-		    n = n - 1;
-		  }
-		  u_corn = u_prod[mum][r] * adj(tmp_tog);
-
-		  /* Gather 'mu link segment' from s-direction */
-
-		  tmp_tog = shift(u_prod[mum][r], BACKWARD, nu);
-		  n = s;
-		  while( n > 0 )
-		  {
-		   tmp_1 = shift(tmp_tog, BACKWARD, nu);
-		   tmp_tog = tmp_1;
-		    n = n - 1;
-		  }
-		  tmp_1 = tmp_tog;
-
-		  /* Gather 'nu link segment' from backward s-direction */
-
-		  tmp_tog = shift(u_prod[nun][s], BACKWARD, nu);
-		  n = s;
-		  while( n > 0 )
-		  {
-		    tmp_2 = shift(tmp_tog, BACKWARD, nu);
-		    tmp_tog = tmp_2;
-		    n = n - 1;
-		  }
-		  u_corn += adj(tmp_tog) * tmp_1;
-
-
-		/* Now collect to construct the Wilson loop */
-
-		  /* Gather 'time-like' link segment from r-direction first */
-
-		  tmp_tog = shift(up_t, FORWARD, mu);
-		  n = r;
-		  while( n > 0 )
-		  {
-		    tmp_1 = shift(tmp_tog, FORWARD, mu);
-		    tmp_tog = tmp_1;
-		    n = n - 1;
-		  }
-		  tmp_1 = tmp_tog;
-
-		  /* Gather 'time-like' link segment from backward s-direction next */
-
-		  tmp_tog = shift(tmp_1, BACKWARD, nu);
-		  n = s;
-		  while( n > 0 )
-		  {
-		    tmp_2 = shift(tmp_tog, BACKWARD, nu);
-		    tmp_tog = tmp_2;
-		    n = n - 1;
-		  }
-		  tmp_1 = tmp_tog;
-
-		  /* Gather 'space-like' link segment from t-direction */
-
-		  tmp_tog = shift(u_corn, FORWARD, j_decay);
-		  n = t;
-		  while( n > 0 )
-		  {
-		    tmp_2 = shift(tmp_tog, FORWARD, j_decay);
-		    tmp_tog = tmp_2;
-		    n = n - 1 ;
-		  }
-
-		  /* Now complete the 'backward' non-planar Wilson loop */
-
-		  tmp_2 = tmp_1 * adj(tmp_tog);
-		  tmp_1 = tmp_2 * adj(up_t);
-		  tmp_2 = u_corn * tmp_1;
-		  wl_trace = real(trace(tmp_2));
-		  n = r * (r+1) / 2 + s;
-		  fuz_wlp2[n][t] += sum(wl_trace);
-
-	      }    /* end s loop */
-	    }      /* end nu != j_decay & nu != mu */
-	  }        /* end nu loop */
-	}          /* end r loop */
-      }            /* end mu != j_decay */
-    }              /* end mu loop */
-  }                /* end t loop */
+      for(r = 0;r  < ( lengthr); ++r )
+      {
+	/* Move the nu segments to the end of the mu segment, x+(r+1)mu */
+	for(s = 0;s  < ( lengthr); ++s )
+	{
+	  tmp_tog = shift((r == 0) ? u_prod[nun][s] : nu_fwd[s], FORWARD, mu);
+	  nu_fwd[s] = tmp_tog;
+	  tmp_tog = shift((r == 0) ? nu_back[s] : nu_bwd[s], FORWARD, mu);
+	  nu_bwd[s] = tmp_tog;
+	}
+
+	tmp_tog = shift((r == 0) ? u[j_decay] : up_t, FORWARD, mu);
+	up_t = tmp_tog;
+
+	for(s = 0;s  <= ( r); ++s )
+	{
+	  /* The mu segment and the time-like link moved by +-(s+1)nu */
+	  tmp_tog = shift((s == 0) ? u_prod[mum][r] : mu_fs, FORWARD, nu);
+	  mu_fs = tmp_tog;
+	  tmp_tog = shift((s == 0) ? u_prod[mum][r] : mu_bs, BACKWARD, nu);
+	  mu_bs = tmp_tog;
+	  tmp_tog = shift((s == 0) ? up_t : up_f, FORWARD, nu);
+	  up_f = tmp_tog;
+	  tmp_tog = shift((s == 0) ? up_t : up_b, BACKWARD, nu);
+	  up_b = tmp_tog;
+
+	  n = r * (r+1) / 2 + s;
+
+	  /* 'forward' corner: r (mu) then s (nu), plus s (nu) then r (mu) */
+	  u_corn = u_prod[mum][r] * nu_fwd[s];
+	  u_corn += u_prod[nun][s] * mu_fs;
+
+	  w_t = engine.loops(u_corn, up_f);
+	  for(t = 0;t  < ( lengtht); ++t )
+	    fuz_wlp2[n][t] += w_t[t];
+
+	  /* 'backward' corner: r (mu) then s (-nu), plus s (-nu) then r (mu) */
+	  u_corn = u_prod[mum][r] * adj(nu_bwd[s]);
+	  u_corn += adj(nu_back[s]) * mu_bs;
+
+	  w_t = engine.loops(u_corn, up_b);
+	  for(t = 0;t  < ( lengtht); ++t )
+	    fuz_wlp2[n][t] += w_t[t];
+	}    /* end s loop */
+      }      /* end r loop */
+    }        /* end nu loop */
+  }          /* end mu loop */
 
   ddummy = 1.0 / double (Layout::vol()*Nc*(Nd-1)) ;
 
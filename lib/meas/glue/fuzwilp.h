@@ -17,10 +17,9 @@ namespace Chroma {
  * This version makes APE-smeared links with no blocking as required
  *          for potential clculations
  *
- * Warning: This version is VERY Slow as it has non-recursive shifting
- *          of some link products
- *          Search for 'cap' on loop values to control no of loops
- * 	    calculated
+ * The temporal lines are made once and every space-like segment and
+ *          corner is built incrementally, so each (r,s,t) costs O(1) shifts
+ *
  * Warning: this works only for Nc = 2 and 3 ! (Projection of
  *                                              smeared/blocked links)
  *
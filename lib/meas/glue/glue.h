@@ -20,7 +20,9 @@
 #include "polylp.h"
 #include "fuzwilp.h" 
 #include "wilslp.h" 
+#include "wilson_loop_engine.h"
 #include "wloop.h"
 #include "mesfield.h"
+#include "field_strength_kernel.h"
 
 #endif
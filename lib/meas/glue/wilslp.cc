@@ -5,6 +5,8 @@
 #include "chromabase.h"
 #include "meas/glue/wilslp.h"
 #include "meas/gfix/axgauge.h"
+#include "meas/glue/wilson_loop_engine.h"
+#include "handle.h"
 
 namespace Chroma 
 {
@@ -233,10 +235,14 @@ namespace Chroma
 
     }           /* end of option "space-like planar Wilson loops" */
 
-    /* Fix to axial gauge */
+    /* The time-like loops carry their temporal lines, so need no gauge fixing */
     ug = u;
-    axGauge (ug, j_decay);
-    t_coord = Layout::latticeCoordinate(j_decay);
+
+    /* Temporal lines of all lengths, shared by all the time-like loops */
+    Handle<WilsonLoopEngine> engine;
+    multi1d<Double> w_t;
+    if ( (kind & 6) != 0 )
+      engine = new WilsonLoopEngine(ug[j_decay], j_decay, lengtht);
 
     /* Compute "time-like" planar Wilson loops, if desired */
     if ( (kind & 2) != 0 )
@@ -269,30 +275,10 @@ namespace Chroma
 	    u_space = tmp_3;
 	  }
 
+	  /* Loops of all time extents for this space-link */
+	  w_t = engine->loops(u_space, u_t);
 	  for(t = 0;t  < ( lengtht); ++t )
-	  {
-	    /* Gather space-link from t-direction (i.e. j_decay) */
-
-	    if ( t == 0 )
-	    {
-	      u_tmp = shift(u_space, FORWARD, j_decay);
-	    }
-	    else
-	    {
-	      tmp_2 = shift(u_tmp, FORWARD, j_decay);
-	      u_tmp = tmp_2;
-	    }
-	    tt = lsizet - t - 1;
-	    btmp = t_coord < tt;
-
-	    tmp_2 = ug[j_decay] * u_tmp;
-	    tmp_3 = tmp_2 * adj(u_t);
-	    copymask(tmp_3, btmp, u_tmp);
-	    tmp_2 = tmp_3 * adj(u_space);
-	    wl_trace = real(trace(tmp_2));
-	    wils_loop2[t][r] += sum(wl_trace);
-
-	  }    /* end t loop */
+	    wils_loop2[t][r] += w_t[t];
 	}      /* end r loop */
       }        /* end i loop (for mu) */
 
@@ -386,28 +372,10 @@ namespace Chroma
 	      u_space = u_diag * tmp_3;
 	    }
 
+	    /* Loops of all time extents for this space-link */
+	    w_t = engine->loops(u_space, u_t);
 	    for(t = 0;t  < ( lengtht); ++t )
-	    {
-	      /* Gather space-link from t-direction (i.e. j_decay) */
-	      if ( t == 0 )
-	      {
-		u_tmp = shift(u_space, FORWARD, j_decay);
-	      }
-	      else
-	      {
-		tmp_2 = shift(u_tmp, FORWARD, j_decay);
-		u_tmp = tmp_2;
-	      }
-
-	      tt = lsizet - t - 1;
-	      btmp = t_coord < tt;
-	      tmp_2 = ug[j_decay] * u_tmp;
-	      tmp_3 = tmp_2 * adj(u_t);
-	      copymask(tmp_3, btmp, u_tmp);
-	      tmp_2 = tmp_3 * adj(u_space);
-	      wl_trace = real(trace(tmp_2));
-	      wils_loop3[t][r] += sum(wl_trace);
-	    }        /* end t loop */
+	      wils_loop3[t][r] += w_t[t];
 	  }          /* end r loop */
 
 	  /*+ */
@@ -443,29 +411,10 @@ namespace Chroma
 	      u_space = u_diag * tmp_3;
 	    }
 
+	    /* Loops of all time extents for this space-link */
+	    w_t = engine->loops(u_space, u_t);
 	    for(t = 0;t  < ( lengtht); ++t )
-	    {
-	      /* Gather space-link from t-direction (i.e. j_decay) */
-	      if ( t == 0 )
-	      {
-		u_tmp = shift(u_space, FORWARD, j_decay);
-	      }
-	      else
-	      {
-		tmp_2 = shift(u_tmp, FORWARD, j_decay);
-		u_tmp = tmp_2;
-	      }
-
-	      tt = lsizet - t - 1;
-	      btmp = t_coord < tt;
-	      tmp_2 = ug[j_decay] * u_tmp;
-	      tmp_3 = tmp_2 * adj(u_t);
-	      copymask(tmp_3, btmp, u_tmp);
-	      tmp_2 = tmp_3 * adj(u_space);
-	      wl_trace = real(trace(tmp_2));
-	      wils_loop3[t][r] += sum(wl_trace);
-
-	    }        /* end t loop */
+	      wils_loop3[t][r] += w_t[t];
 	  }          /* end r loop */
 
 	  /*+ */
@@ -514,29 +463,10 @@ namespace Chroma
 	      u_space = u_tmp;
 	    }
 
+	    /* Loops of all time extents for this space-link */
+	    w_t = engine->loops(u_space, u_t);
 	    for(t = 0;t  < ( lengtht); ++t )
-	    {
-	      /* Gather space-link from t-direction (i.e. j_decay) */
-	      if ( t == 0 )
-	      {
-		u_tmp = shift(u_space, FORWARD, j_decay);
-	      }
-	      else
-	      {
-		tmp_2 = shift(u_tmp, FORWARD, j_decay);
-		u_tmp = tmp_2;
-	      }
-
-	      tt = lsizet - t - 1;
-	      btmp = t_coord < tt;
-	      tmp_2 = ug[j_decay] * u_tmp;
-	      tmp_3 = tmp_2 * adj(u_t);
-	      copymask(tmp_3, btmp, u_tmp);
-	      tmp_2 = tmp_3 * adj(u_space);
-	      wl_trace = real(trace(tmp_2));
-	      wils_loop3[t][r_off+r] += sum(wl_trace);
-
-	    }        /* end t loop */
+	      wils_loop3[t][r_off+r] += w_t[t];
 	  }          /* end r loop */
 
 	  /*+ */
@@ -585,30 +515,10 @@ namespace Chroma
 	      u_space = u_tmp;
 	    }
 
+	    /* Loops of all time extents for this space-link */
+	    w_t = engine->loops(u_space, u_t);
 	    for(t = 0;t  < ( lengtht); ++t )
-	    {
-	      /* Gather space-link from t-direction (i.e. j_decay) */
-	      if ( t == 0 )
-	      {
-		u_tmp = shift(u_space, FORWARD, j_decay);
-	      }
-	      else
-	      {
-		tmp_2 = shift(u_tmp, FORWARD, j_decay);
-		u_tmp = tmp_2;
-	      }
-
-
-	      tt = lsizet - t - 1;
-	      btmp = t_coord < tt;
-
-	      tmp_2 = ug[j_decay] * u_tmp;
-	      tmp_3 = tmp_2 * adj(u_t);
-	      copymask(tmp_3, btmp, u_tmp);
-	      tmp_2 = tmp_3 * adj(u_space);
-	      wl_trace = real(trace(tmp_2));
-	      wils_loop3[t][r_off+r] += sum(wl_trace);
-	    }        /* end t loop */
+	      wils_loop3[t][r_off+r] += w_t[t];
 	  }          /* end r loop */
 
 
@@ -657,29 +567,10 @@ namespace Chroma
 	      u_space = u_tmp;
 	    }
 
+	    /* Loops of all time extents for this space-link */
+	    w_t = engine->loops(u_space, u_t);
 	    for(t = 0;t  < ( lengtht); ++t )
-	    {
-	      /* Gather space-link from t-direction (i.e. j_decay) */
-	      if ( t == 0 )
-	      {
-		u_tmp = shift(u_space, FORWARD, j_decay);
-	      }
-	      else
-	      {
-		tmp_2 = shift(u_tmp, FORWARD, j_decay);
-		u_tmp = tmp_2;
-	      }
-
-	      tt = lsizet - t - 1;
-	      btmp = t_coord < tt;
-
-	      tmp_2 = ug[j_decay] * u_tmp;
-	      tmp_3 = tmp_2 * adj(u_t);
-	      copymask(tmp_3, btmp, u_tmp);
-	      tmp_2 = tmp_3 * adj(u_space);
-	      wl_trace = real(trace(tmp_2));
-	      wils_loop3[t][r_off+r] += sum(wl_trace);
-	    }        /* end t loop */
+	      wils_loop3[t][r_off+r] += w_t[t];
 	  }          /* end r loop */
 
 
@@ -728,30 +619,10 @@ namespace Chroma
 	      u_space = u_tmp;
 	    }
 
+	    /* Loops of all time extents for this space-link */
+	    w_t = engine->loops(u_space, u_t);
 	    for(t = 0;t  < ( lengtht); ++t )
-	    {
-	      /* Gather space-link from t-direction (i.e. j_decay) */
-	      if ( t == 0 )
-	      {
-		u_tmp = shift(u_space, FORWARD, j_decay);
-	      }
-	      else
-	      {
-		tmp_2 = shift(u_tmp, FORWARD, j_decay);
-		u_tmp = tmp_2;
-	      }
-
-	      tt = lsizet - t - 1;
-	      btmp = t_coord < tt;
-
-	      tmp_2 = ug[j_decay] * u_tmp;
-	      tmp_3 = tmp_2 * adj(u_t);
-	      copymask(tmp_3, btmp, u_tmp);
-	      tmp_2 = tmp_3 * adj(u_space);
-	      wl_trace = real(trace(tmp_2));
-	      wils_loop3[t][r_off+r] += sum(wl_trace);
-
-	    }        /* end t loop */
+	      wils_loop3[t][r_off+r] += w_t[t];
 	  }          /* end r loop */
 	}            /* end i loop (for mu) */
       }              /* end j loop (for nu) */
@@ -848,29 +719,10 @@ namespace Chroma
 		  u_space = u_tmp;
 		}
 
+		/* Loops of all time extents for this space-link */
+		w_t = engine->loops(u_space, u_t);
 		for(t = 0;t  < ( lengtht); ++t )
-		{
-		  /* Gather space-link from t-direction (i.e. j_decay) */
-		  if ( t == 0 )
-		  {
-		    u_tmp = shift(u_space, FORWARD, j_decay);
-		  }
-		  else
-		  {
-		    tmp_2 = shift(u_tmp, FORWARD, j_decay);
-		    u_tmp = tmp_2;  
-		  }
-
-		  tt = lsizet - t - 1;
-		  btmp = t_coord < tt;
-
-		  tmp_2 = ug[j_decay] * u_tmp;
-		  tmp_3 = tmp_2 * adj(u_t);
-		  copymask(tmp_3, btmp, u_tmp);
-		  tmp_2 = tmp_3 * adj(u_space);
-		  wl_trace = real(trace(tmp_2));
-		  wils_loop3[t][r_off+r] += sum(wl_trace);
-		}    /* end t loop */
+		  wils_loop3[t][r_off+r] += w_t[t];
 	      }      /* end r loop */
 
 	      /*+ */
@@ -936,30 +788,10 @@ namespace Chroma
 		  u_space = u_tmp;
 		}
 
+		/* Loops of all time extents for this space-link */
+		w_t = engine->loops(u_space, u_t);
 		for(t = 0;t  < ( lengtht); ++t )
-		{
-		  /* Gather space-link from t-direction (i.e. j_decay) */
-		  if ( t == 0 )
-		  {
-		    u_tmp = shift(u_space, FORWARD, j_decay);
-		  }
-		  else
-		  {
-		    tmp_2 = shift(u_tmp, FORWARD, j_decay);
-		    u_tmp = tmp_2;
-		  }
-
-		  tt = lsizet - t - 1;
-		  btmp = t_coord < tt;
-
-		  tmp_2 = ug[j_decay] * u_tmp;
-		  tmp_3 = tmp_2 * adj(u_t);
-		  copymask(tmp_3, btmp, u_tmp);
-		  tmp_2 = tmp_3 * adj(u_space);
-		  wl_trace = real(trace(tmp_2));
-		  wils_loop3[t][r_off+r] += sum(wl_trace);
-
-		}    /* end t loop */
+		  wils_loop3[t][r_off+r] += w_t[t];
 	      }      /* end r loop */
 
 	      /*+ */
@@ -1025,30 +857,10 @@ namespace Chroma
 		  u_space = u_tmp;
 		}
 
+		/* Loops of all time extents for this space-link */
+		w_t = engine->loops(u_space, u_t);
 		for(t = 0;t  < ( lengtht); ++t )
-		{
-		  /* Gather space-link from t-direction (i.e. j_decay) */
-		  if ( t == 0 )
-		  {
-		    u_tmp = shift(u_space, FORWARD, j_decay);
-		  }
-		  else
-		  {
-		    tmp_2 = shift(u_tmp, FORWARD, j_decay);
-		    u_tmp = tmp_2;
-		  }
-
-		  tt = lsizet - t - 1;
-		  btmp = t_coord < tt;
-
-		  tmp_2 = ug[j_decay] * u_tmp;
-		  tmp_3 = tmp_2 * adj(u_t);
-		  copymask(tmp_3, btmp, u_tmp);
-		  tmp_2 = tmp_3 * adj(u_space);
-		  wl_trace = real(trace(tmp_2));
-		  wils_loop3[t][r_off+r] += sum(wl_trace);
-
-		}    /* end t loop */
+		  wils_loop3[t][r_off+r] += w_t[t];
 	      }      /* end r loop */
 
 	      /*+ */
@@ -1119,30 +931,10 @@ namespace Chroma
 		  u_space = u_tmp;
 		}
 
+		/* Loops of all time extents for this space-link */
+		w_t = engine->loops(u_space, u_t);
 		for(t = 0;t  < ( lengtht); ++t )
-		{
-		  /* Gather space-link from t-direction (i.e. j_decay) */
-		  if ( t == 0 )
-		  {
-		    u_tmp = shift(u_space, FORWARD, j_decay);
-		  }
-		  else
-		  {
-		    tmp_2 = shift(u_tmp, FORWARD, j_decay);
-		    u_tmp = tmp_2;
-		  }
-
-		  tt = lsizet - t - 1;
-		  btmp = t_coord < tt;
-
-		  tmp_2 = ug[j_decay] * u_tmp;
-		  tmp_3 = tmp_2 * adj(u_t);
-		  copymask(tmp_3, btmp, u_tmp);
-		  tmp_2 = tmp_3 * adj(u_space);
-		  wl_trace = real(trace(tmp_2));
-		  wils_loop3[t][r_off+r] += sum(wl_trace);
-
-		}    /* end t loop */
+		  wils_loop3[t][r_off+r] += w_t[t];
 	      }      /* end r loop */
 	    }        /* end i loop (for mu) */
 	  }          /* end j loop (for nu) */
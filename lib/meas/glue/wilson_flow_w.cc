@@ -29,7 +29,6 @@
  */
 
 #include "meas/glue/wilson_flow_w.h"
-#include "meas/glue/mesfield.h"
 #include "util/gauge/stout_utils.h"
 #include "util/gauge/expmat.h"
 #include "util/gauge/taproj.h"
@@ -45,53 +44,27 @@ namespace Chroma
    **/
 
 
-  void measure_wilson_gauge(multi1d<LatticeColorMatrix> & u,
-			    Real & gspace, Real & gtime,
-			    int jomit)
+  //! Space-like and time-like action densities, summed over the lattice, and the charge
+  void measure_wilson_gauge(const FieldStrengthKernel& fs,
+			    const multi1d<LatticeColorMatrix> & u,
+			    Real & gspace, Real & gtime, Real & qtop)
   {
+    FieldStrengthDensities_t dens;
+    fs(dens, u);
 
-    multi1d<LatticeColorMatrix> field_st(10) ;
-    LatticeColorMatrix tmp ; 
-
-    mesField( field_st,u); 
-
-    int offset = 0;
-
-    gtime  = 0.0 ;
-    gspace = 0.0 ;
-
-    Double tr ; 
-
-    //  for(int mu=0; mu < Nd-1; ++mu)
-
-    for(int mu=0; mu < Nd; ++mu)
+    Double es = zero;
+    Double et = zero;
+    Double q  = zero;
+    for(int t=0; t < dens.q_t.size(); ++t)
     {
-      for(int nu=mu+1; nu < Nd; ++nu)
-      {
-	//	  tr = real(sum(trace(field_st[offset]))) ;
-	//	  tr = imag(sum(trace(field_st[offset]))) ;
-	tmp = field_st[offset] * field_st[offset] ;
-	tr = real(sum(trace(tmp))) ; 
-
-	// Real tt = 2.0 * tr ; 
-	//	  std::cout << "DEBUG " << mu << " " << nu  << " " << tt << std::endl ;
-
-	if (nu==jomit)
-	{
-	  gtime += 2.0*(tr);
-	}
-	else
-	{
-	  gspace += 2.0*(tr);
-	}
-
-	++offset  ; 
-      }
+      es += dens.e_space_t[t];
+      et += dens.e_time_t[t];
+      q  += dens.q_t[t];
     }
 
-    gspace /= -2.0*Layout::vol() ;
-    gtime /= -2.0*Layout::vol() ;
-
+    gspace = es / Double(Layout::vol());
+    gtime  = et / Double(Layout::vol());
+    qtop   = q;
   }
 
 
@@ -185,19 +158,23 @@ namespace Chroma
 
   void wilson_flow(XMLWriter& xml,
 		   multi1d<LatticeColorMatrix> & u, int nstep, 
-		   Real  wflow_eps, int jomit)
+		   Real  wflow_eps, int jomit,
+		   FieldStrengthKernel::Definition fs_def)
   {
-    Real gact4i, gactij;
+    Real gact4i, gactij, qtop;
     int dim = nstep + 1 ;
     multi1d<Real> gact4i_vec(dim);
     multi1d<Real> gactij_vec(dim);
+    multi1d<Real> qtop_vec(dim);
     multi1d<Real> step_vec(dim);
 
+    // The field strength is not made traceless, as in mesField
+    FieldStrengthKernel fs(fs_def, jomit, false);
 
-
-    measure_wilson_gauge(u,gactij,gact4i,jomit) ;
+    measure_wilson_gauge(fs,u,gactij,gact4i,qtop) ;
     gact4i_vec[0] = gact4i ;
     gactij_vec[0] = gactij ;
+    qtop_vec[0] = qtop ;
     step_vec[0] = 0.0 ;
 
     //  QDPIO::cout << "WFLOW " << 0.0 << " " << gact4i << " " << gactij <<  std::endl ; 
@@ -209,9 +186,10 @@ namespace Chroma
     {
       wilson_flow_one_step(u,wflow_eps) ;
 
-      measure_wilson_gauge(u,gactij,gact4i,jomit) ;
+      measure_wilson_gauge(fs,u,gactij,gact4i,qtop) ;
       gact4i_vec[i+1] = gact4i ;
       gactij_vec[i+1] = gactij ;
+      qtop_vec[i+1] = qtop ;
 
 
       Real xx = (i + 1) * wflow_eps ;
@@ -226,6 +204,7 @@ namespace Chroma
     write(xml,"wflow_step",step_vec) ; 
     write(xml,"wflow_gact4i",gact4i_vec) ; 
     write(xml,"wflow_gactij",gactij_vec) ; 
+    write(xml,"wflow_qtop",qtop_vec) ; 
     pop(xml);  // elem
 
   }
@@ -3,6 +3,7 @@
 #define __wilson_flow_w_h__
 
 #include "chromabase.h"
+#include "meas/glue/field_strength_kernel.h"
 
 namespace Chroma 
 {
@@ -17,12 +18,14 @@ namespace Chroma
    * \param nstep  number of steps  (Read)
    * \param wflow_eps  size of step (Read)
    * \param time direction (Read)
+   * \param fs_def  definition of the field strength (Read)
 
    */
 
   void wilson_flow(XMLWriter& xml,
 		   multi1d<LatticeColorMatrix> & u, int nstep, 
-		   Real  wflow_eps, int jomit)  ;
+		   Real  wflow_eps, int jomit,
+		   FieldStrengthKernel::Definition fs_def = FieldStrengthKernel::CLOVER)  ;
 
 
 }  // end namespace Chroma
@@ -0,0 +1,65 @@
+/*! \file
+ *  \brief Time-like Wilson loops of all time extents for a spatial path
+ */
+
+#include "chromabase.h"
+#include "meas/glue/wilson_loop_engine.h"
+
+namespace Chroma
+{
+
+  // Make the temporal lines
+  WilsonLoopEngine::WilsonLoopEngine(const LatticeColorMatrix& u_t, int j_decay_, int tmax) :
+    j_decay(j_decay_)
+  {
+    START_CODE();
+
+    if (tmax < 1)
+    {
+      QDPIO::cerr << __func__ << ": invalid tmax = " << tmax << std::endl;
+      QDP_abort(1);
+    }
+
+    // L_t(x) = U(x) L_{t-1}(x+1), kept as the adjoint used by the contraction
+    lines.resize(tmax);
+
+    LatticeColorMatrix l = u_t;
+    lines[0] = adj(l);
+    for(int t = 1; t < tmax; ++t)
+    {
+      LatticeColorMatrix tmp = u_t * shift(l, FORWARD, j_decay);
+      l = tmp;
+      lines[t] = adj(l);
+    }
+
+    END_CODE();
+  }
+
+
+  // Sum over the lattice of the loops with 1 to tmax time links
+  multi1d<Double> WilsonLoopEngine::loops(const LatticeColorMatrix& s_line,
+					  const LatticeColorMatrix& u_t_end) const
+  {
+    START_CODE();
+
+    multi1d<Double> w(lines.size());
+
+    LatticeColorMatrix p = u_t_end * shift(adj(s_line), FORWARD, j_decay);
+    for(int t = 0; t < lines.size(); ++t)
+    {
+      if (t > 0)
+      {
+	LatticeColorMatrix tmp = u_t_end * shift(p, FORWARD, j_decay);
+	p = tmp;
+      }
+
+      LatticeColorMatrix lp = lines[t] * s_line;
+      w[t] = sum(real(trace(lp * p)));
+    }
+
+    END_CODE();
+
+    return w;
+  }
+
+}  // end namespace Chroma
@@ -0,0 +1,61 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Time-like Wilson loops of all time extents for a spatial path
+ */
+
+#ifndef __wilson_loop_engine_h__
+#define __wilson_loop_engine_h__
+
+#include "chromabase.h"
+
+namespace Chroma
+{
+
+  //! Time-like Wilson loops of all time extents for a spatial path
+  /*!
+   * \ingroup glue
+   *
+   * The temporal lines L_t(x) = U(x) U(x+1) ... U(x+t), with t+1 links
+   * in the direction j_decay, are made once for t < tmax. Every spatial
+   * path then gives the loops of all time extents in one sweep. With the
+   * spatial line S(x) from x to x+d and the time link U_d(x) = U(x+d),
+   *
+   *   P_0(x) = U_d(x) S^dag(x+1)
+   *   P_t(x) = U_d(x) P_{t-1}(x+1)  =  L_t(x+d) S^dag(x+t+1)
+   *
+   *   W(t) = sum_x Re Tr[ S(x) P_t(x) L^dag_t(x) ]
+   *
+   * so each time extent costs one shift of P. The caller builds S and
+   * U_d incrementally as the path grows, so the loops of all (r,t) need
+   * only O(1) shifts each.
+   */
+  class WilsonLoopEngine
+  {
+  public:
+    //! Make the temporal lines
+    /*!
+     * \param u_t      the links in the direction j_decay ( Read )
+     * \param j_decay  the time direction ( Read )
+     * \param tmax     number of time extents, 1 to tmax links ( Read )
+     */
+    WilsonLoopEngine(const LatticeColorMatrix& u_t, int j_decay, int tmax);
+
+    //! Number of time extents
+    int numTimes() const {return lines.size();}
+
+    //! Sum over the lattice of the loops with 1 to tmax time links
+    /*!
+     * \param s_line   spatial line from x to x+d ( Read )
+     * \param u_t_end  the time link at x+d ( Read )
+     */
+    multi1d<Double> loops(const LatticeColorMatrix& s_line,
+			  const LatticeColorMatrix& u_t_end) const;
+
+  private:
+    int j_decay;
+    multi1d<LatticeColorMatrix> lines;    /*!< adj(L_t) */
+  };
+
+}  // end namespace Chroma
+
+#endif
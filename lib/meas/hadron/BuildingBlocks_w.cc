@@ -30,6 +30,7 @@
 
 #include "chromabase.h"
 #include "util/ft/sftmom.h"
+#include "handle.h"
 #include "meas/hadron/BuildingBlocks_w.h"
 
 #include <iostream>
@@ -59,45 +60,176 @@ void CVSBuildingBlocks( TextWriter & Out )
   Out << "CVSBuildingBlocks_cc = " << CVSBuildingBlocks_cc << "\n";
 }
 
+//###################################################################################//
+// buffered building blocks writer                                                   //
+//###################################################################################//
+
+// A building blocks file is many small records.  They are collected in memory and
+// handed to the file in large blocks.  The bytes, and so the checksum, are the same
+// as when each record is written to the file directly.
+
+class BBBufferedWriter
+{
+public:
+  BBBufferedWriter() : Buffer( new BinaryBufferWriter ), NBytes( 0 ) {}
+
+  ~BBBufferedWriter() { close(); }
+
+  void open( const std::string & FileName ) { File.open( FileName ); }
+
+  template< typename T >
+  void write( const T & Value )
+  {
+    Buffer->write( Value );
+    NBytes += sizeof( T );
+
+    if( NBytes >= MaxBytes ) flush();
+  }
+
+  void writeArray( const char * Data, size_t Size, size_t NMemb )
+  {
+    Buffer->writeArray( Data, Size, NMemb );
+    NBytes += Size * NMemb;
+
+    if( NBytes >= MaxBytes ) flush();
+  }
+
+  // checksum of everything written so far
+  QDPUtil::n_uint32_t getChecksum() { flush(); return File.getChecksum(); }
+
+  void flush()
+  {
+    if( NBytes == 0 ) return;
+
+    std::string Bytes = Buffer->str();
+    File.writeArray( Bytes.data(), 1, Bytes.size() );
+
+    Buffer = new BinaryBufferWriter;
+    NBytes = 0;
+  }
+
+  void close()
+  {
+    if( ! File.is_open() ) return;
+
+    flush();
+    File.close();
+  }
+
+private:
+  static const size_t MaxBytes = 1 << 22;
+
+  BinaryFileWriter File;
+  Handle< BinaryBufferWriter > Buffer;
+  size_t NBytes;
+};
+
+//###################################################################################//
+// link path cache                                                                   //
+//###################################################################################//
+
+// The link paths form a trie: each path is its prefix plus one link.  The products
+// of the links with the forward propagator are kept for every prefix of the path
+// being walked, one per depth, so each node of the trie costs a single shift shared
+// by all flavors, gamma matrices and momenta, and no temporaries are made per node.
+
+class BBPathCache
+{
+public:
+  BBPathCache( const LatticePropagator &             F,
+               const multi1d< LatticeColorMatrix > & U_,
+               const unsigned short int              MaxNLinks ) :
+    U( U_ ), Products( MaxNLinks + 1 ), ShiftCalls( 0 ), ShiftTime( 0.0 )
+  {
+    Products[ 0 ] = F;
+  }
+
+  // product of the links of the current path of length Depth with F
+  const LatticePropagator & get( const int Depth ) const { return Products[ Depth ]; }
+
+  // extend the path of length Depth by the link Dir: mu forward or mu + Nd backward
+  void extend( const int Depth, const unsigned short int Dir )
+  {
+    StopWatch Timer;
+    Timer.reset();
+    Timer.start();
+
+    if( Dir < Nd )
+    {
+      const int mu = Dir;
+      Products[ Depth + 1 ] = shift( adj( U[ mu ] ) * Products[ Depth ], BACKWARD, mu );
+    }
+    else
+    {
+      const int mu = Dir - Nd;
+      Products[ Depth + 1 ] = U[ mu ] * shift( Products[ Depth ], FORWARD, mu );
+    }
+
+    Timer.stop();
+    ShiftTime += Timer.getTimeInSeconds();
+    ShiftCalls += 1;
+  }
+
+  int getShiftCalls() const { return ShiftCalls; }
+  double getShiftTime() const { return ShiftTime; }
+
+private:
+  const multi1d< LatticeColorMatrix > & U;
+  multi1d< LatticePropagator > Products;
+  int ShiftCalls;
+  double ShiftTime;
+};
+
+//###################################################################################//
+// backward propagator times adjoint of the insertion                                //
+//###################################################################################//
+
+// Tr[ B^dag G_i F G_g ] = Tr[ (B G_g^dag)^dag G_i F ], so the insertion is put on the
+// backward propagator once instead of on every link path.  G_g is a product of k
+// distinct hermitian, anticommuting gammas, so G_g^dag = (-1)^(k(k-1)/2) G_g.
+
+LatticePropagator BkwdInsertion( const LatticePropagator & B,
+                                 const int                 GammaInsertion )
+{
+  int k = 0;
+  for( int mu = 0; mu < Nd; mu ++ )
+    if( ( GammaInsertion >> mu ) & 1 ) k ++;
+
+  LatticePropagator BG = B * Gamma( GammaInsertion );
+
+  if( ( ( k * ( k - 1 ) ) / 2 ) % 2 == 1 ) BG *= -1;
+
+  return BG;
+}
+
 //###################################################################################//
 // backward forward trace                                                            //
 //###################################################################################//
 
-void BkwdFrwdTr( const LatticePropagator &             B,
+void BkwdFrwdTr( const multi1d< LatticePropagator > &  BG,
                  const LatticePropagator &             F,
-		 int                                   GammaInsertion,
                  const SftMom &                        Phases,
                  const SftMom &                        PhasesCanonical,
-                 multi2d< BinaryFileWriter > &         BinaryWriters,
+                 multi2d< BBBufferedWriter > &         BinaryWriters,
 		 multi1d< int > &                      GBB_NLinkPatterns,
 		 multi2d< int > &                      GBB_NMomPerms,
-                 const int                             f,
                  const multi1d< unsigned short int > & LinkDirs,
                  const signed short int                T1, 
                  const signed short int                T2,	
 		 const signed short int                Tsrc,
 		 const signed short int                Tsnk,
 		 const bool                            TimeReverse,
-		 const bool                            ShiftFlag )
+		 const bool                            ShiftFlag,
+		 double &                              GFTime,
+		 double &                              IPTime,
+		 double &                              FTTime,
+		 double &                              IOTime )
 {
-  StopWatch TotalTime;
-  TotalTime.reset();
-  TotalTime.start();
-
   StopWatch Timer;
 
-  int TRCalls = 0;
-  int FTCalls = 0;
-  int GFGCalls = 0;
-  int IPCalls = 0;
-  double TRTime = 0.0;
-  double FTTime = 0.0;
-  double GFGTime = 0.0;
-  double IPTime = 0.0;
-  double IOTime = 0.0;
-
   const unsigned short int NLinks = LinkDirs.size();
   unsigned short int Link;
+  const int NF   = BG.size();
   const int NumQ = Phases.numMom();
   const int NumO = BinaryWriters.size1();
   const int NT   = Phases.numSubsets();  // Length of lattice in decay direction
@@ -109,175 +241,177 @@ void BkwdFrwdTr( const LatticePropagator &             B,
   Timer.reset();
   Timer.start();
 
-  for( int o = 0; o < NumO; o ++ )
+  for( int f = 0; f < NF; f ++ )
   {
-    BinaryWriters(f,o).write( NLinks );
-
-    #if _DEBUG_BB_C_ == 1
+    for( int o = 0; o < NumO; o ++ )
     {
-      QDPIO::cout << "DEBUG: " << __FILE__ << " " << __LINE__ << "\n";
-      QDPIO::cout << "q = " << o << "\n";
-      QDPIO::cout << "f = " << f << "\n";
-      QDPIO::cout << "NLinks = " << NLinks << "\n";
-    }
-    #endif
+      BinaryWriters(f,o).write( NLinks );
 
-    for( Link = 0; Link < NLinks; Link ++ )
-    {
-      // This interchanges the +t direction (3) and -t direction (7): (3+4)%8=7 and (7+4)%8=3.
-      if( ( TimeReverse == true ) & ( ( LinkDirs[ Link ] == 3 ) || ( LinkDirs[ Link ] == 7 ) ) )
-      {
-	BinaryWriters(f,o).write( (unsigned short int)(( LinkDirs[ Link ] + 4 ) % 8) );
-      }
-      else
+      #if _DEBUG_BB_C_ == 1
       {
-        BinaryWriters(f,o).write( LinkDirs[ Link ] );
+	QDPIO::cout << "DEBUG: " << __FILE__ << " " << __LINE__ << "\n";
+	QDPIO::cout << "q = " << o << "\n";
+	QDPIO::cout << "f = " << f << "\n";
+	QDPIO::cout << "NLinks = " << NLinks << "\n";
       }
+      #endif
 
-      #if _DEBUG_BB_C_ == 1
+      for( Link = 0; Link < NLinks; Link ++ )
       {
-        QDPIO::cout << "Link = " << Link << "\n";
-        QDPIO::cout << "LinkDirs[ Link ] = " << LinkDirs[ Link ] << "\n";
+	// This interchanges the +t direction (3) and -t direction (7): (3+4)%8=7 and (7+4)%8=3.
+	if( ( TimeReverse == true ) & ( ( LinkDirs[ Link ] == 3 ) || ( LinkDirs[ Link ] == 7 ) ) )
+	{
+	  BinaryWriters(f,o).write( (unsigned short int)(( LinkDirs[ Link ] + 4 ) % 8) );
+	}
+	else
+	{
+	  BinaryWriters(f,o).write( LinkDirs[ Link ] );
+	}
       }
-      #endif
-    }
 
-     // counts number of link patterns per flavor
-    GBB_NLinkPatterns[f] ++;
+      // counts number of link patterns per flavor
+      GBB_NLinkPatterns[f] ++;
+    }
   }
 
   Timer.stop();
   IOTime += Timer.getTimeInSeconds();
 
+  //#################################################################################//
+  // traces of all flavors and gamma matrices                                        //
+  //#################################################################################//
+
+  multi1d< LatticeComplex > Traces( NF * Ns * Ns );
+
   for( int i = 0; i < Ns * Ns; i ++ )
   {
     Timer.reset();
     Timer.start();
 
-    // assumes any Gamma5 matrices have already been absorbed
-    LatticePropagator GFG = Gamma(i) * F * Gamma( GammaInsertion );
-
-    // There is an overall minus sign from interchanging the initial and final states for baryons.  This
-    // might not be present for mesons, so we should think about this carefully.
-    // It seems there should be another sign for conjugating the operator, but it appears to be absent.
-    // There is a minus sign for all Dirac structures with a gamma_t.  In the current scheme this is all
-    // gamma_i with i = 8, ..., 15.  If the gamma basis changes, then this must change.
-    if( ( TimeReverse == true ) & ( i < 8 ) ) GFG *= -1;
+    // shared by all flavors; assumes any Gamma5 matrices have already been absorbed
+    LatticePropagator GF = Gamma(i) * F;
 
     Timer.stop();
-    GFGCalls += 1;
-    GFGTime += Timer.getTimeInSeconds();
+    GFTime += Timer.getTimeInSeconds();
     Timer.reset();
     Timer.start();
 
-    LatticeComplex Trace = localInnerProduct( B, GFG );
+    for( int f = 0; f < NF; f ++ )
+    {
+      Traces[ f * Ns * Ns + i ] = localInnerProduct( BG[ f ], GF );
+
+      // There is an overall minus sign from interchanging the initial and final states for baryons.  This
+      // might not be present for mesons, so we should think about this carefully.
+      // It seems there should be another sign for conjugating the operator, but it appears to be absent.
+      // There is a minus sign for all Dirac structures with a gamma_t.  In the current scheme this is all
+      // gamma_i with i = 8, ..., 15.  If the gamma basis changes, then this must change.
+      if( ( TimeReverse == true ) & ( i < 8 ) ) Traces[ f * Ns * Ns + i ] *= -1;
+    }
 
     Timer.stop();
-    IPCalls += 1;
     IPTime += Timer.getTimeInSeconds();
-    Timer.reset();
-    Timer.start();
+  }
 
-    multi2d< DComplex > Projections = Phases.sft( Trace );
+  //#################################################################################//
+  // project all of them onto all momenta in one pass                                //
+  //#################################################################################//
 
-    Timer.stop();
-    FTTime += Timer.getTimeInSeconds();
-    FTCalls += 1;
+  Timer.reset();
+  Timer.start();
 
-    Timer.reset();
-    Timer.start();
+  multi1d< multi2d< DComplex > > Projections = Phases.sft( Traces );
 
-    for( int q = 0; q < NumQ; q ++ )
-    {
-      multi1d< DComplex > Projection = Projections[ q ];
-      multi1d< int > Q = Phases.numToMom( q );
+  Timer.stop();
+  FTTime += Timer.getTimeInSeconds();
 
-      int o = PhasesCanonical.momToNum( Q );
-      if (o == -1)
-      {
-	QDPIO::cerr << __func__ << ": internal error: failed to find index of ordered momentum" << std::endl;
-	QDP_abort(1);
-      }
-      
-      const signed short int QX = Q[0];
-      const signed short int QY = Q[1];
-      const signed short int QZ = Q[2];
-      BinaryWriters(f,o).write( QX );
-      BinaryWriters(f,o).write( QY );
-      BinaryWriters(f,o).write( QZ );
+  Timer.reset();
+  Timer.start();
 
-      // counts number of momenta permutations per canonical ordering
-      GBB_NMomPerms(f,o) ++;
+  multi1d< float > real_part( T2 - T1 + 1 );
+  multi1d< float > imag_part( T2 - T1 + 1 );
 
-      float real_part[ T2 - T1 + 1 ];
-      float imag_part[ T2 - T1 + 1 ];
+  for( int f = 0; f < NF; f ++ )
+  {
+    for( int i = 0; i < Ns * Ns; i ++ )
+    {
+      const multi2d< DComplex > & Projection_i = Projections[ f * Ns * Ns + i ];
 
-      // Fill correlator
-      for( int t = T1; t <= T2; t ++ )
+      for( int q = 0; q < NumQ; q ++ )
       {
-        float r = toFloat( real( Projection[ t ] ) );
-        float i = toFloat( imag( Projection[ t ] ) );
-
-        int t_prime = t;
-
-        if( TimeReverse == true ){
-	  //QDPIO::cout<<"TimeReversing: " ;
-	  //shift the time origin to the source
-	  int t_shifted = (t - Tsrc + NT )%NT ;
-	  //time reverse around the source
-	  int t_reversed = (NT - t_shifted)%NT; 
-	  //undo the shift to put time back where it was.
-	  //we may not want to do this. it may be better to just shift
-	  //the time origin to Tsrc as we do in the spectrum
-	  if(ShiftFlag==false) 
-	    t_prime = (t_reversed + Tsrc)%NT ;
-	  else
-	    t_prime = t_reversed ;
-	  
-	  //QDPIO::cout<<t<<" "<<t_prime<<" [Tsrc="<<Tsrc<<",NT="<<NT<<",tsh="<<t_shifted<<"]"<<std::endl ;
+	multi1d< DComplex > Projection = Projection_i[ q ];
+	multi1d< int > Q = Phases.numToMom( q );
+
+	int o = PhasesCanonical.momToNum( Q );
+	if (o == -1)
+	{
+	  QDPIO::cerr << __func__ << ": internal error: failed to find index of ordered momentum" << std::endl;
+	  QDP_abort(1);
+	}
+      
+	const signed short int QX = Q[0];
+	const signed short int QY = Q[1];
+	const signed short int QZ = Q[2];
+	BinaryWriters(f,o).write( QX );
+	BinaryWriters(f,o).write( QY );
+	BinaryWriters(f,o).write( QZ );
+
+	// counts number of momenta permutations per canonical ordering
+	GBB_NMomPerms(f,o) ++;
+
+	// Fill correlator
+	for( int t = T1; t <= T2; t ++ )
+	{
+	  float r = toFloat( real( Projection[ t ] ) );
+	  float i = toFloat( imag( Projection[ t ] ) );
+
+	  int t_prime = t;
+
+	  if( TimeReverse == true ){
+	    //shift the time origin to the source
+	    int t_shifted = (t - Tsrc + NT )%NT ;
+	    //time reverse around the source
+	    int t_reversed = (NT - t_shifted)%NT; 
+	    //undo the shift to put time back where it was.
+	    //we may not want to do this. it may be better to just shift
+	    //the time origin to Tsrc as we do in the spectrum
+	    if(ShiftFlag==false) 
+	      t_prime = (t_reversed + Tsrc)%NT ;
+	    else
+	      t_prime = t_reversed ;
+	  }
+
+	  //when TimeReverse is on shifting is done differently
+	  if((ShiftFlag==true)&&(TimeReverse==false))
+	    t_prime = (t - Tsrc + NT )%NT ;
+
+	  real_part[ t_prime ] = r;
+	  imag_part[ t_prime ] = i;
+
+	  #if _DEBUG_BB_C_ == 1
+	  {
+	    QDPIO::cout << "DEBUG: " << __FILE__ << " " << __LINE__ << "\n";
+	    QDPIO::cout << "q = " << q << "\n";
+	    QDPIO::cout << "o = " << o << "\n";
+	    QDPIO::cout << "f = " << f << "\n";
+	    QDPIO::cout << "t = " << t << "\n";
+	    QDPIO::cout << "r = " << r << "\n";
+	    QDPIO::cout << "i = " << i << "\n";
+	  }
+	  #endif
 	}
 
-	//when TimeReverse is on shifting is done differently
-	if((ShiftFlag==true)&&(TimeReverse==false))
-	  t_prime = (t - Tsrc + NT )%NT ;
-	
-	//if(TimeReverse==false)
-	// QDPIO::cout<<t<<" "<<t_prime<<" [Tsrc="<<Tsrc<<",NT="<<NT<<"]"<<std::endl;
-
-        real_part[ t_prime ] = r;
-        imag_part[ t_prime ] = i;
-
-        #if _DEBUG_BB_C_ == 1
-        {
-          QDPIO::cout << "DEBUG: " << __FILE__ << " " << __LINE__ << "\n";
-          QDPIO::cout << "q = " << q << "\n";
-          QDPIO::cout << "o = " << o << "\n";
-          QDPIO::cout << "f = " << f << "\n";
-          QDPIO::cout << "t = " << t << "\n";
-          QDPIO::cout << "r = " << r << "\n";
-          QDPIO::cout << "i = " << i << "\n";
-        }
-        #endif
-      }
-
-      // Write correlator
-      for( int t = 0; t < (T2-T1+1); t ++ )
-      {
-        BinaryWriters(f,o).write( real_part[t] );
-        BinaryWriters(f,o).write( imag_part[t] );
+	// Write correlator
+	for( int t = 0; t < (T2-T1+1); t ++ )
+	{
+	  BinaryWriters(f,o).write( real_part[t] );
+	  BinaryWriters(f,o).write( imag_part[t] );
+	}
       }
     }
-
-    Timer.stop();
-    IOTime += Timer.getTimeInSeconds();
   }
 
-  QDPIO::cout << __func__ << ":  io time = " << IOTime << " seconds" << std::endl;
-  QDPIO::cout << __func__ << ": gfg time = " << GFGTime / (double) GFGCalls << " seconds" << std::endl;
-  QDPIO::cout << __func__ << ":  ip time = " << IPTime / (double) IPCalls << " seconds" << std::endl;
-  QDPIO::cout << __func__ << ":  ft time = " << FTTime / (double) FTCalls << " seconds" << std::endl;
-  TotalTime.stop();
-  QDPIO::cout << __func__ << ": total time = " << TotalTime.getTimeInSeconds() << " seconds" << std::endl;
+  Timer.stop();
+  IOTime += Timer.getTimeInSeconds();
 
   return;
 }
@@ -286,10 +420,8 @@ void BkwdFrwdTr( const LatticePropagator &             B,
 // accumulate link operators                                                         //
 //###################################################################################//
 
-void AddLinks( const multi1d< LatticePropagator > &  B,
-               const LatticePropagator &             F,
-               const multi1d< LatticeColorMatrix > & U,
-	       const multi1d< int > &                GammaInsertions,
+void AddLinks( const multi1d< LatticePropagator > &  BG,
+               BBPathCache &                         Paths,
                const SftMom &                        Phases,
 	       const SftMom &                        PhasesCanonical,
                multi1d< unsigned short int > &       LinkDirs,
@@ -297,7 +429,7 @@ void AddLinks( const multi1d< LatticePropagator > &  B,
                BBLinkPattern                         LinkPattern,
                const short int                       PreviousDir,
                const short int                       PreviousMu,
-               multi2d< BinaryFileWriter > &         BinaryWriters,
+               multi2d< BBBufferedWriter > &         BinaryWriters,
 	       multi1d< int > &                      GBB_NLinkPatterns,
 	       multi2d< int > &                      GBB_NMomPerms,
                const signed short int                T1, 
@@ -305,12 +437,12 @@ void AddLinks( const multi1d< LatticePropagator > &  B,
 	       const signed short int                Tsrc,
 	       const signed short int                Tsnk,
 	       const bool                            TimeReverse,
-	       const bool                            ShiftFlag )
+	       const bool                            ShiftFlag,
+	       double &                              GFTime,
+	       double &                              IPTime,
+	       double &                              FTTime,
+	       double &                              IOTime )
 {
-  StopWatch Timer;
-  int ShiftCalls = 0;
-  double ShiftTime = 0.0;
-
   const unsigned short int NLinks = LinkDirs.size();
 
   if( NLinks == MaxNLinks )
@@ -318,8 +450,6 @@ void AddLinks( const multi1d< LatticePropagator > &  B,
     return;
   }
 
-  LatticePropagator F_mu;
-  const int NF = B.size();
   multi1d< unsigned short int > NextLinkDirs( NLinks + 1 );
   int Link;
 
@@ -328,109 +458,53 @@ void AddLinks( const multi1d< LatticePropagator > &  B,
     NextLinkDirs[ Link ] = LinkDirs[ Link ];
   }
 
-  // add link in forward mu direction
-  for( int mu = 0; mu < Nd; mu ++ )
+  // add link in forward mu direction, then in backward mu direction
+  for( int Dir = 0; Dir < 2 * Nd; Dir ++ )
   {
+    const int mu = Dir % Nd;
+    const short int ThisDir = ( Dir < Nd ) ? 1 : -1;
+
     // skip the double back
-    if( ( PreviousDir != -1 ) || ( PreviousMu != mu ) )
+    if( ( PreviousDir == - ThisDir ) && ( PreviousMu == mu ) )
     {
-      bool DoThisPattern = true;
-      bool DoFurtherPatterns = true;
-
-      NextLinkDirs[ NLinks ] = mu;
+      continue;
+    }
 
-      LinkPattern( DoThisPattern, DoFurtherPatterns, NextLinkDirs );
+    bool DoThisPattern = true;
+    bool DoFurtherPatterns = true;
 
-      if( DoFurtherPatterns == true )
-      {
-        Timer.reset();
-        Timer.start();
+    NextLinkDirs[ NLinks ] = Dir;
 
-        // accumulate product of link fields
-        F_mu = shift( adj( U[ mu ] ) * F, BACKWARD, mu );
+    LinkPattern( DoThisPattern, DoFurtherPatterns, NextLinkDirs );
 
-        Timer.stop();
-        ShiftTime += Timer.getTimeInSeconds();
-        ShiftCalls += 1;
-      }
+    if( ( DoThisPattern == false ) && ( DoFurtherPatterns == false ) )
+    {
+      continue;
+    }
 
-      if( DoThisPattern == true )
-      {
-        // form correlation functions
-        for( int f = 0; f < NF; f ++ )
-        {
-          BkwdFrwdTr( B[ f ], F_mu, GammaInsertions[ f ], Phases, PhasesCanonical,
-		      BinaryWriters, GBB_NLinkPatterns, GBB_NMomPerms,
-		      f, NextLinkDirs, T1, T2, Tsrc, Tsnk, TimeReverse, ShiftFlag );
-        }
-      }
+    // accumulate product of link fields
+    Paths.extend( NLinks, Dir );
 
-      if( DoFurtherPatterns == true )
-      {
-        // add another link
-        AddLinks( B, F_mu, U, GammaInsertions, 
-		  Phases, PhasesCanonical,
-		  NextLinkDirs, MaxNLinks, LinkPattern, 1, mu, 
+    if( DoThisPattern == true )
+    {
+      // form correlation functions
+      BkwdFrwdTr( BG, Paths.get( NLinks + 1 ), Phases, PhasesCanonical,
 		  BinaryWriters, GBB_NLinkPatterns, GBB_NMomPerms,
-		  T1, T2, Tsrc, Tsnk, TimeReverse, ShiftFlag );
-      }
+		  NextLinkDirs, T1, T2, Tsrc, Tsnk, TimeReverse, ShiftFlag,
+		  GFTime, IPTime, FTTime, IOTime );
     }
-  }
 
-  // add link in backward mu direction
-  for( int mu = 0; mu < Nd; mu ++ )
-  {
-    // skip the double back
-    if( ( PreviousDir != 1 ) || ( PreviousMu != mu ) )
+    if( DoFurtherPatterns == true )
     {
-      bool DoThisPattern = true;
-      bool DoFurtherPatterns = true;
-
-      NextLinkDirs[ NLinks ] = mu + Nd;
-
-      LinkPattern( DoThisPattern, DoFurtherPatterns, NextLinkDirs );
-
-      if( DoFurtherPatterns == true )
-      {
-        Timer.reset();
-        Timer.start();
-
-        // accumulate product of link fields
-        F_mu = U[ mu ] * shift( F, FORWARD, mu );
-
-        Timer.stop();
-        ShiftTime += Timer.getTimeInSeconds();
-        ShiftCalls += 1;
-      }
-
-      if( DoThisPattern == true )
-      {
-        // form correlation functions
-        for( int f = 0; f < NF; f ++ )
-        {
-          BkwdFrwdTr( B[ f ], F_mu, GammaInsertions[ f ], Phases, PhasesCanonical,
-		      BinaryWriters, GBB_NLinkPatterns, GBB_NMomPerms,
-		      f, NextLinkDirs, T1, T2, Tsrc, Tsnk, TimeReverse, ShiftFlag );
-        }
-      }
-
-      if( DoFurtherPatterns == true )
-      {
-        // add another link
-        AddLinks( B, F_mu, U, GammaInsertions, Phases, PhasesCanonical,
-		  NextLinkDirs, MaxNLinks, LinkPattern, -1, mu, BinaryWriters, 
-		  GBB_NLinkPatterns, GBB_NMomPerms,
-		  T1, T2, Tsrc, Tsnk, TimeReverse, ShiftFlag );
-      }
+      // add another link
+      AddLinks( BG, Paths, Phases, PhasesCanonical,
+		NextLinkDirs, MaxNLinks, LinkPattern, ThisDir, mu, 
+		BinaryWriters, GBB_NLinkPatterns, GBB_NMomPerms,
+		T1, T2, Tsrc, Tsnk, TimeReverse, ShiftFlag,
+		GFTime, IPTime, FTTime, IOTime );
     }
   }
 
-  QDPIO::cout << __func__ << ": shift time = "
-	      << ShiftTime
-	      << " seconds with shift calls = "
-              << ShiftCalls 
-	      << std::endl;
-
   return;
 }
 
@@ -480,7 +554,7 @@ void BuildingBlocks( const multi1d< LatticePropagator > &  B,
 
   const int NumF = B.size();
   const int NumO = BinaryDataFileNames.size1();
-  multi2d< BinaryFileWriter > BinaryWriters( NumF, NumO );
+  multi2d< BBBufferedWriter > BinaryWriters( NumF, NumO );
   multi1d< int > GBB_NLinkPatterns( NumF );
   multi2d< int > GBB_NMomPerms( NumF, NumO );
 
@@ -506,18 +580,37 @@ void BuildingBlocks( const multi1d< LatticePropagator > &  B,
   Timer.reset();
   Timer.start();
 
+  multi1d< LatticePropagator > BG( NumF );
+
+  for( int f = 0; f < NumF; f ++ )
+  {
+    BG[ f ] = BkwdInsertion( B[ f ], GammaInsertions[ f ] );
+  }
+
+  BBPathCache Paths( F, U, MaxNLinks );
+
+  double GFTime = 0.0;
+  double IPTime = 0.0;
+  double FTTime = 0.0;
+  double IOTime = 0.0;
+
+  Timer.stop();
+  QDPIO::cout << __func__ << ": time to set up = "
+	      << Timer.getTimeInSeconds() 
+	      << " seconds" << std::endl;
+
+  Timer.reset();
+  Timer.start();
+
   QDPIO::cout << __func__ << ": start BkwdFrwdTr" << std::endl;
 
   const unsigned short int NLinks = 0;
   multi1d< unsigned short int > LinkDirs( 0 );
 
-  for( int f = 0; f < NumF; f ++ )
-  {
-    BkwdFrwdTr( B[ f ], F, GammaInsertions[ f ], Phases, PhasesCanonical,
-		BinaryWriters, GBB_NLinkPatterns, GBB_NMomPerms, f, LinkDirs, 
-		T1, T2, Tsrc, Tsnk,
-		TimeReverse, ShiftFlag );
-  }
+  BkwdFrwdTr( BG, Paths.get( NLinks ), Phases, PhasesCanonical,
+	      BinaryWriters, GBB_NLinkPatterns, GBB_NMomPerms, LinkDirs, 
+	      T1, T2, Tsrc, Tsnk, TimeReverse, ShiftFlag,
+	      GFTime, IPTime, FTTime, IOTime );
 
   Timer.stop();
   QDPIO::cout << __func__ << ": total time for 0 links (single BkwdFrwdTr call) = "
@@ -529,17 +622,24 @@ void BuildingBlocks( const multi1d< LatticePropagator > &  B,
 
   QDPIO::cout << __func__ << ": start AddLinks" << std::endl;
 
-  AddLinks( B, F, U, GammaInsertions, 
-	    Phases, PhasesCanonical,
+  AddLinks( BG, Paths, Phases, PhasesCanonical,
 	    LinkDirs, MaxNLinks, LinkPattern, 0, -1, 
 	    BinaryWriters, GBB_NLinkPatterns, GBB_NMomPerms,
-	    T1, T2, Tsrc, Tsnk, TimeReverse, ShiftFlag );
+	    T1, T2, Tsrc, Tsnk, TimeReverse, ShiftFlag,
+	    GFTime, IPTime, FTTime, IOTime );
 
   Timer.stop();
   QDPIO::cout << __func__ << ": total time for remaining links (outermost AddLinks call) = "
 	      << Timer.getTimeInSeconds() 
 	      << " seconds" << std::endl;
 
+  QDPIO::cout << __func__ << ": shift time = " << Paths.getShiftTime()
+	      << " seconds with shift calls = " << Paths.getShiftCalls() << std::endl;
+  QDPIO::cout << __func__ << ":  gf time = " << GFTime << " seconds" << std::endl;
+  QDPIO::cout << __func__ << ":  ip time = " << IPTime << " seconds" << std::endl;
+  QDPIO::cout << __func__ << ":  ft time = " << FTTime << " seconds" << std::endl;
+  QDPIO::cout << __func__ << ":  io time = " << IOTime << " seconds" << std::endl;
+
   //#################################################################################//
   // add footer and close files                                                      //
   //#################################################################################//
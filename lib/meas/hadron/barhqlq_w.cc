@@ -5,6 +5,7 @@
 
 #include "meas/hadron/barhqlq_w.h"
 #include "meas/hadron/barspinmat_w.h"
+#include "meas/hadron/baryon_contract_batch_w.h"
 
 namespace Chroma 
 {
@@ -141,6 +142,59 @@ namespace Chroma
   }  // namespace  Baryon2PtContractions
 
 
+  //! The heavy-light contractions as terms of a batched contraction
+  /*!
+   * \ingroup hadron
+   *
+   * Flavor 0 is quark_propagator_1 and flavor 1 is quark_propagator_2.
+   * Each function adds factor times the corresponding function of
+   * Baryon2PtContractions to correlator corr.
+   */
+  namespace BarhqlqEnv
+  {
+    const int f1 = 0;
+    const int f2 = 1;
+
+    //! Sigma 2-pt
+    void sigma2pt(BaryonContractBatch& bar, int corr,
+		  const SpinMatrix& T, const SpinMatrix& sp, const Real& factor = Real(1))
+    {
+      bar.addTerm(corr, T, sp, f1, f2, f2, factor, factor);
+    }
+
+    //! Cascade 2-pt
+    void xi2pt(BaryonContractBatch& bar, int corr,
+	       const SpinMatrix& T, const SpinMatrix& sp, const Real& factor = Real(1))
+    {
+      bar.addTerm(corr, T, sp, f1, f2, f1, factor, factor);
+    }
+
+    //! Lambda 2-pt
+    void lambda2pt(BaryonContractBatch& bar, int corr,
+		   const SpinMatrix& T, const SpinMatrix& sp, const Real& factor = Real(1))
+    {
+      bar.addTerm(corr, T, sp, f2, f2, f1, factor, factor);
+      bar.addTerm(corr, T, sp, f2, f1, f2, Real(0), factor);
+    }
+
+    //! Naive Lambda 2-pt
+    void lambdaNaive2pt(BaryonContractBatch& bar, int corr,
+			const SpinMatrix& T, const SpinMatrix& sp, const Real& factor = Real(1))
+    {
+      bar.addTerm(corr, T, sp, f2, f2, f1, factor, Real(0));
+    }
+
+    //! Sigma^* 2-pt
+    void sigmast2pt(BaryonContractBatch& bar, int corr,
+		    const SpinMatrix& T, const SpinMatrix& sp, const Real& factor = Real(1))
+    {
+      bar.addTerm(corr, T, sp, f1, f2, f2, Real(2)*factor, Real(2)*factor);
+      bar.addTerm(corr, T, sp, f2, f1, f2, Real(0), Real(2)*factor);
+      bar.addTerm(corr, T, sp, f2, f2, f1, factor, Real(2)*factor);
+    }
+  }
+
+
   //! Heavy-light baryon 2-pt functions
   /*!
    * \ingroup hadron
@@ -373,12 +427,15 @@ namespace Chroma
     // C g_5 NR = (1/2)*C gamma_5 * ( 1 + g_4 )
     SpinMatrix Cg5NR = BaryonSpinMats::Cg5NR();
 
-    LatticeComplex b_prop;
+    // The diquarks are shared between the baryons
+    BaryonContractBatch bar;
+    bar.addFlavor(quark_propagator_1);
+    bar.addFlavor(quark_propagator_2);
 
-    // Loop over baryons
+    // Register the terms of every baryon
     for(int baryons = 0; baryons < num_baryons; ++baryons)
     {
-      LatticePropagator di_quark;
+      bar.addCorr();
 
       switch (baryons)
       {
@@ -389,8 +446,7 @@ namespace Chroma
 	// Polarized:
 	// T_mixed = T = (1 + \Sigma_3)*(1 + gamma_4) / 2 
 	//             = (1 + Gamma(8) - i G(3) - i G(11)) / 2
-	b_prop = Baryon2PtContractions::sigma2pt(quark_propagator_1, quark_propagator_2, 
-						 T_mixed, Cg5);
+	BarhqlqEnv::sigma2pt(bar, baryons, T_mixed, Cg5);
 	break;
 
       case 1:
@@ -401,8 +457,7 @@ namespace Chroma
 	// Polarized:
 	// T_mixed = T = (1 + \Sigma_3)*(1 + gamma_4) / 2 
 	//             = (1 + Gamma(8) - i G(3) - i G(11)) / 2
-	b_prop = Baryon2PtContractions::lambda2pt(quark_propagator_1, quark_propagator_2, 
-						  T_mixed, Cg5);
+	BarhqlqEnv::lambda2pt(bar, baryons, T_mixed, Cg5);
 	break;
 
       case 2:
@@ -411,8 +466,7 @@ namespace Chroma
 	// Polarized:
 	// T_mixed = T = (1 + \Sigma_3)*(1 + gamma_4) / 2 
 	//             = (1 + Gamma(8) - i G(3) - i G(11)) / 2
-	b_prop = Baryon2PtContractions::sigmast2pt(quark_propagator_1, quark_propagator_2, 
-						   T_mixed, BaryonSpinMats::Cgm());
+	BarhqlqEnv::sigmast2pt(bar, baryons, T_mixed, BaryonSpinMats::Cgm());
 	break;
 
       case 3:
@@ -422,8 +476,7 @@ namespace Chroma
 	// Polarized:
 	// T_mixed = T = (1 + \Sigma_3)*(1 + gamma_4) / 2 
 	//             = (1 + Gamma(8) - i G(3) - i G(11)) / 2
-	b_prop = Baryon2PtContractions::sigma2pt(quark_propagator_1, quark_propagator_2, 
-						 T_mixed, Cg5g4);
+	BarhqlqEnv::sigma2pt(bar, baryons, T_mixed, Cg5g4);
 	break;
 
       case 4:
@@ -434,8 +487,7 @@ namespace Chroma
 	// Polarized:
 	// T_mixed = T = (1 + \Sigma_3)*(1 + gamma_4) / 2 
 	//             = (1 + Gamma(8) - i G(3) - i G(11)) / 2
-	b_prop = Baryon2PtContractions::lambda2pt(quark_propagator_1, quark_propagator_2, 
-						  T_mixed, Cg5g4);
+	BarhqlqEnv::lambda2pt(bar, baryons, T_mixed, Cg5g4);
 	break;
 
       case 5:
@@ -444,8 +496,7 @@ namespace Chroma
 	// Polarized:
 	// T_mixed = T = (1 + \Sigma_3)*(1 + gamma_4) / 2 
 	//             = (1 + Gamma(8) - i G(3) - i G(11)) / 2
-	b_prop = Baryon2PtContractions::sigmast2pt(quark_propagator_1, quark_propagator_2, 
-						   T_mixed, BaryonSpinMats::Cg4m());
+	BarhqlqEnv::sigmast2pt(bar, baryons, T_mixed, BaryonSpinMats::Cg4m());
 	break;
 
       case 6:
@@ -455,8 +506,7 @@ namespace Chroma
 	// Polarized:
 	// T_mixed = T = (1 + \Sigma_3)*(1 + gamma_4) / 2 
 	//             = (1 + Gamma(8) - i G(3) - i G(11)) / 2
-	b_prop = Baryon2PtContractions::sigma2pt(quark_propagator_1, quark_propagator_2, 
-						 T_mixed, Cg5NR);
+	BarhqlqEnv::sigma2pt(bar, baryons, T_mixed, Cg5NR);
 	break;
 
       case 7:
@@ -467,8 +517,7 @@ namespace Chroma
 	// Polarized:
 	// T_mixed = T = (1 + \Sigma_3)*(1 + gamma_4) / 2 
 	//             = (1 + Gamma(8) - i G(3) - i G(11)) / 2
-	b_prop = Baryon2PtContractions::lambda2pt(quark_propagator_1, quark_propagator_2, 
-						  T_mixed, Cg5NR);
+	BarhqlqEnv::lambda2pt(bar, baryons, T_mixed, Cg5NR);
 	break;
 
       case 8:
@@ -479,15 +528,12 @@ namespace Chroma
 	// T_mixed = T = (1 + \Sigma_3)*(1 + gamma_4) / 2 
 	//             = (1 + Gamma(8) - i G(3) - i G(11)) / 2
 	// Arrgh, goofy CgmNR normalization again from szin code. 
-	b_prop = Baryon2PtContractions::sigmast2pt(quark_propagator_1, quark_propagator_2, 
-						   T_mixed, BaryonSpinMats::CgmNR());
-
 	// Agghh, we have a goofy factor of 4 normalization factor here. The
 	// ancient szin way didn't care about norms, so it happily made it
 	// 4 times too big. There is a missing 0.5 in the NR normalization
 	// in the old szin code.
 	// So, we compensate to keep the same normalization
-	b_prop *= 4.0;
+	BarhqlqEnv::sigmast2pt(bar, baryons, T_mixed, BaryonSpinMats::CgmNR(), Real(4));
 	break;
 
 
@@ -497,8 +543,7 @@ namespace Chroma
 	// C gamma_5 = Gamma(5)
 	// Unpolarized:
 	// T_unpol = T = (1/2)(1 + gamma_4)
-	b_prop = Baryon2PtContractions::sigma2pt(quark_propagator_1, quark_propagator_2, 
-						 T_unpol, Cg5);
+	BarhqlqEnv::sigma2pt(bar, baryons, T_unpol, Cg5);
 	break;
 
       case 10:
@@ -507,8 +552,7 @@ namespace Chroma
 	// C gamma_5 gamma_4 = - Gamma(13)
 	// Unpolarized:
 	// T_unpol = T = (1/2)(1 + gamma_4)
-	b_prop = Baryon2PtContractions::sigma2pt(quark_propagator_1, quark_propagator_2, 
-						 T_unpol, Cg5g4);
+	BarhqlqEnv::sigma2pt(bar, baryons, T_unpol, Cg5g4);
 	break;
     
       case 11:
@@ -517,8 +561,7 @@ namespace Chroma
 	// C gamma_5 = Gamma(5)
 	// Unpolarized:
 	// T_unpol = T = (1/2)(1 + gamma_4)
-	b_prop = Baryon2PtContractions::sigma2pt(quark_propagator_1, quark_propagator_2, 
-						 T_unpol, Cg5NR);
+	BarhqlqEnv::sigma2pt(bar, baryons, T_unpol, Cg5NR);
 	break;
 
       case 12:
@@ -527,8 +570,7 @@ namespace Chroma
 	// C gamma_5 = Gamma(5)
 	// UnPolarized:
 	// T_unpol = T = (1/2)(1 + gamma_4)
-	b_prop = Baryon2PtContractions::lambdaNaive2pt(quark_propagator_1, quark_propagator_2, 
-						       T_unpol, Cg5);
+	BarhqlqEnv::lambdaNaive2pt(bar, baryons, T_unpol, Cg5);
 	break;
       
       case 13:
@@ -537,8 +579,7 @@ namespace Chroma
 	// C gamma_5 = Gamma(5)
 	// UnPolarized:
 	// T_unpol = T = (1/2)(1 + gamma_4)
-	b_prop = Baryon2PtContractions::xi2pt(quark_propagator_1, quark_propagator_2, 
-					      T_unpol, Cg5);
+	BarhqlqEnv::xi2pt(bar, baryons, T_unpol, Cg5);
 	break;
 
       case 14:
@@ -548,8 +589,7 @@ namespace Chroma
 	// UnPolarized: 
 	// T_mixed = T = (1 + \Sigma_3)*(1 + gamma_4) / 2 
 	//             = (1 + Gamma(8) - i G(3) - i G(11)) / 2
-	b_prop = Baryon2PtContractions::lambdaNaive2pt(quark_propagator_1, quark_propagator_2, 
-						       T_unpol, Cg5);
+	BarhqlqEnv::lambdaNaive2pt(bar, baryons, T_unpol, Cg5);
 	break;
       
       case 15:
@@ -559,8 +599,7 @@ namespace Chroma
 	// UnPolarized:
 	// T_mixed = T = (1 + \Sigma_3)*(1 + gamma_4) / 2 
 	//             = (1 + Gamma(8) - i G(3) - i G(11)) / 2
-	b_prop = Baryon2PtContractions::xi2pt(quark_propagator_1, quark_propagator_2, 
-					      T_mixed, Cg5);
+	BarhqlqEnv::xi2pt(bar, baryons, T_mixed, Cg5);
 	break;
 
       case 16:
@@ -569,28 +608,20 @@ namespace Chroma
 	// C g_5 NR negpar = (1/2)*C gamma_5 * ( 1 - g_4 )
 	// T = (1 + \Sigma_3)*(1 - gamma_4) / 2 
 	//   = (1 - Gamma(8) + i G(3) - i G(11)) / 2
-	b_prop = Baryon2PtContractions::sigma2pt(quark_propagator_1, quark_propagator_2, 
-						 BaryonSpinMats::TmixedNegPar(), 
-						 BaryonSpinMats::Cg5NRnegPar());
+	BarhqlqEnv::sigma2pt(bar, baryons, 
+			     BaryonSpinMats::TmixedNegPar(), BaryonSpinMats::Cg5NRnegPar());
 	break;
 		  
       default:
 	QDP_error_exit("Unknown baryon", baryons);
       }
-                        
-      // Project onto zero and if desired non-zero momentum
-      multi2d<DComplex> hsum;
-      hsum = phases.sft(b_prop);
-
-      for(int sink_mom_num=0; sink_mom_num < num_mom; ++sink_mom_num) 
-	for(int t = 0; t < length; ++t)
-	{
-	  // NOTE: there is NO  1/2  multiplying hsum
-	  barprop[baryons][sink_mom_num][t] = hsum[sink_mom_num][t];
-	}
-
     } // end loop over baryons
 
+    // One site pass for all the baryons, then project all of them onto
+    // zero and if desired non-zero momentum
+    // NOTE: there is NO  1/2  multiplying the sums
+    bar.project(barprop, phases);
+
     END_CODE();
   }
 
@@ -0,0 +1,339 @@
+/*! \file
+ *  \brief Batched baryon contractions sharing the diquarks
+ */
+
+#include "meas/hadron/baryon_contract_batch_w.h"
+
+namespace Chroma
+{
+
+#if QDP_NC == 3 && ! defined(QDP_IS_QDPJIT)
+  //! Site kernel of the batched baryon contractions
+  namespace BaryonContractBatchEnv
+  {
+    //! Number of spin-spin entries of a spin matrix
+    const int ns2 = Ns*Ns;
+
+    struct ContractArgs
+    {
+      LatticeComplex* corr;
+      const LatticePropagator* const* flavor;
+      const SpinMatrix* dq_sp;
+      const int* dq_l;
+      const int* dq_r;
+      const int* con_order;    // contractions ordered by diquark
+      const int* con_dq;
+      const int* con_o;
+      int ncon;
+      int ncorr;
+      const int* term_off;     // terms of correlator p are term_list[term_off[p] .. term_off[p+1])
+      const int* term_list;
+      const int* term_con;
+      const REAL64* term_t;
+      const int* tab;
+    };
+
+
+    //! Accumulate  trace(A * X)  for a complex Ns x Ns matrix A
+    template<typename R>
+    inline
+    void addTrace(REAL64& re, REAL64& im, const REAL64* A, const R* X)
+    {
+      for(int i=0; i < Ns; ++i)
+	for(int j=0; j < Ns; ++j)
+	{
+	  const REAL64* aij = A + 2*(i*Ns + j);
+	  const R* xji = X + 2*(j*Ns + i);
+	  re += aij[0]*xji[0] - aij[1]*xji[1];
+	  im += aij[0]*xji[1] + aij[1]*xji[0];
+	}
+    }
+
+
+    //! All the diquarks and correlators over a block of sites
+    inline
+    void contractSiteLoop(int lo, int hi, int my_id, ContractArgs* a)
+    {
+      typedef LatticePropagator::Subtype_t   Prop_s;
+      typedef LatticeColorMatrix::Subtype_t  ColorMat_s;
+      typedef LatticeSpinMatrix::Subtype_t   SpinMat_s;
+
+      // The color traced spin matrices of each contraction at the current site
+      std::vector<SpinMat_s> xs(a->ncon);
+      std::vector<SpinMat_s> xd(a->ncon);
+
+      for(int ssite=lo; ssite < hi; ++ssite)
+      {
+	int site = a->tab[ssite];
+
+	Prop_s di;
+	ColorMat_s di_s;
+	int d_cur = -1;
+
+	for(int k=0; k < a->ncon; ++k)
+	{
+	  int c = a->con_order[k];
+	  int d = a->con_dq[c];
+
+	  // Build each diquark once per site
+	  if (d != d_cur)
+	  {
+	    const SpinMatrix::Subtype_t& sp = a->dq_sp[d].elem();
+	    const Prop_s& q_l = a->flavor[a->dq_l[d]]->elem(site);
+	    const Prop_s& q_r = a->flavor[a->dq_r[d]]->elem(site);
+
+	    Prop_s q_l_sp = q_l * sp;
+	    Prop_s sp_q_r = sp * q_r;
+	    di   = quarkContract13(q_l_sp, sp_q_r);
+	    di_s = traceSpin(di);
+	    d_cur = d;
+	  }
+
+	  const Prop_s& q_o = a->flavor[a->con_o[c]]->elem(site);
+	  xs[c] = traceColor(q_o * di_s);
+	  xd[c] = traceColor(q_o * di);
+	}
+
+	for(int p=0; p < a->ncorr; ++p)
+	{
+	  REAL64 re = 0;
+	  REAL64 im = 0;
+
+	  for(int k=a->term_off[p]; k < a->term_off[p+1]; ++k)
+	  {
+	    int t = a->term_list[k];
+	    int c = a->term_con[t];
+	    const REAL64* Ts = a->term_t + 4*ns2*t;
+	    const REAL64* Td = Ts + 2*ns2;
+
+	    addTrace(re, im, Ts, &(xs[c].elem(0,0).elem().real()));
+	    addTrace(re, im, Td, &(xd[c].elem(0,0).elem().real()));
+	  }
+
+	  REAL* out = (REAL *)&(a->corr[p].elem(site).elem().elem().real());
+	  out[0] = re;
+	  out[1] = im;
+	}
+      }
+    }
+  }
+#endif
+
+
+  // Register a quark propagator
+  int BaryonContractBatch::addFlavor(const LatticePropagator& quark_propagator)
+  {
+    flavor.push_back(&quark_propagator);
+    return flavor.size() - 1;
+  }
+
+
+  // Start a new correlator
+  int BaryonContractBatch::addCorr()
+  {
+    return ncorr++;
+  }
+
+
+  // Table index of the diquark (sp, f_l, f_r)
+  int BaryonContractBatch::findDiquark(const SpinMatrix& sp, int f_l, int f_r)
+  {
+    for(int d=0; d < dq_sp.size(); ++d)
+      if (dq_l[d] == f_l && dq_r[d] == f_r && toDouble(norm2(dq_sp[d] - sp)) == 0.0)
+	return d;
+
+    dq_sp.push_back(sp);
+    dq_l.push_back(f_l);
+    dq_r.push_back(f_r);
+
+    return dq_sp.size() - 1;
+  }
+
+
+  // Table index of the contraction of diquark d with flavor f_o
+  int BaryonContractBatch::findContraction(int d, int f_o)
+  {
+    for(int c=0; c < con_dq.size(); ++c)
+      if (con_dq[c] == d && con_o[c] == f_o)
+	return c;
+
+    con_dq.push_back(d);
+    con_o.push_back(f_o);
+
+    return con_dq.size() - 1;
+  }
+
+
+  // Add a term to a correlator
+  void BaryonContractBatch::addTerm(int corr, const SpinMatrix& T, const SpinMatrix& sp,
+				    int f_l, int f_r, int f_o,
+				    const Real& c_spin, const Real& c_full)
+  {
+    const int nf = flavor.size();
+    if (corr < 0 || corr >= ncorr ||
+	f_l < 0 || f_l >= nf || f_r < 0 || f_r >= nf || f_o < 0 || f_o >= nf)
+    {
+      QDPIO::cerr << __func__ << ": invalid correlator or flavor id" << std::endl;
+      QDP_abort(1);
+    }
+
+    int c = findContraction(findDiquark(sp, f_l, f_r), f_o);
+
+    term_corr.push_back(corr);
+    term_con.push_back(c);
+
+    const REAL64 cs = toDouble(c_spin);
+    const REAL64 cd = toDouble(c_full);
+    const int off = term_t.size();
+    term_t.resize(off + 4*Ns*Ns);
+
+    for(int i=0; i < Ns; ++i)
+      for(int j=0; j < Ns; ++j)
+      {
+	const int ij = 2*(i*Ns + j);
+	const REAL64 re = toDouble(real(peekSpin(T,i,j)));
+	const REAL64 im = toDouble(imag(peekSpin(T,i,j)));
+
+	term_t[off + ij]     = cs*re;
+	term_t[off + ij + 1] = cs*im;
+	term_t[off + 2*Ns*Ns + ij]     = cd*re;
+	term_t[off + 2*Ns*Ns + ij + 1] = cd*im;
+      }
+  }
+
+
+  // Compute all the correlators as lattice fields
+  void BaryonContractBatch::evaluate(multi1d<LatticeComplex>& corr) const
+  {
+    START_CODE();
+
+    corr.resize(ncorr);
+    if (ncorr == 0)
+    {
+      END_CODE();
+      return;
+    }
+
+    if (Nc != 3)
+    {
+      QDPIO::cerr << __func__ << ": baryon contractions are specific to Nc=3" << std::endl;
+      QDP_abort(1);
+    }
+
+#if QDP_NC == 3
+#ifndef QDP_IS_QDPJIT
+    using namespace BaryonContractBatchEnv;
+
+    // Contractions ordered by diquark
+    const int ncon = con_dq.size();
+    std::vector<int> con_order;
+    for(int d=0; d < dq_sp.size(); ++d)
+      for(int c=0; c < ncon; ++c)
+	if (con_dq[c] == d)
+	  con_order.push_back(c);
+
+    // Terms ordered by correlator
+    std::vector<int> term_off(ncorr+1, 0);
+    std::vector<int> term_list;
+    for(int p=0; p < ncorr; ++p)
+    {
+      for(int t=0; t < term_corr.size(); ++t)
+	if (term_corr[t] == p)
+	  term_list.push_back(t);
+
+      term_off[p+1] = term_list.size();
+    }
+
+    // Keep the pointers valid with no terms at all
+    con_order.push_back(0);
+    term_list.push_back(0);
+
+    const Subset& s = all;
+    ContractArgs arg = {corr.slice(),
+			(flavor.empty()) ? 0 : &(flavor[0]),
+			(dq_sp.empty()) ? 0 : &(dq_sp[0]),
+			(dq_l.empty()) ? 0 : &(dq_l[0]),
+			(dq_r.empty()) ? 0 : &(dq_r[0]),
+			&(con_order[0]),
+			(con_dq.empty()) ? 0 : &(con_dq[0]),
+			(con_o.empty()) ? 0 : &(con_o[0]),
+			ncon, ncorr,
+			&(term_off[0]), &(term_list[0]),
+			(term_con.empty()) ? 0 : &(term_con[0]),
+			(term_t.empty()) ? 0 : &(term_t[0]),
+			s.siteTable().slice()};
+
+    dispatch_to_threads(s.numSiteTable(), arg, contractSiteLoop);
+#else
+    // One diquark at a time as a lattice field
+    for(int p=0; p < ncorr; ++p)
+      corr[p] = zero;
+
+    for(int d=0; d < dq_sp.size(); ++d)
+    {
+      const SpinMatrix& sp = dq_sp[d];
+      LatticePropagator di_quark = quarkContract13(*(flavor[dq_l[d]]) * sp,
+						   sp * *(flavor[dq_r[d]]));
+      LatticeColorMatrix di_quark_s = traceSpin(di_quark);
+
+      for(int c=0; c < con_dq.size(); ++c)
+      {
+	if (con_dq[c] != d)
+	  continue;
+
+	const LatticePropagator& q_o = *(flavor[con_o[c]]);
+	LatticeSpinMatrix xs = traceColor(q_o * di_quark_s);
+	LatticeSpinMatrix xd = traceColor(q_o * di_quark);
+
+	for(int t=0; t < term_con.size(); ++t)
+	{
+	  if (term_con[t] != c)
+	    continue;
+
+	  // The scaled projectors of the term
+	  SpinMatrix Ts = zero;
+	  SpinMatrix Td = zero;
+	  const REAL64* tt = &(term_t[4*Ns*Ns*t]);
+	  for(int i=0; i < Ns; ++i)
+	    for(int j=0; j < Ns; ++j)
+	    {
+	      const int ij = 2*(i*Ns + j);
+	      pokeSpin(Ts, cmplx(Real(tt[ij]), Real(tt[ij+1])), i, j);
+	      pokeSpin(Td, cmplx(Real(tt[2*Ns*Ns + ij]), Real(tt[2*Ns*Ns + ij+1])), i, j);
+	    }
+
+	  corr[term_corr[t]] += trace(Ts * xs) + trace(Td * xd);
+	}
+      }
+    }
+#endif
+#endif
+
+    END_CODE();
+  }
+
+
+  // Compute all the correlators and project them
+  void BaryonContractBatch::project(multi3d<DComplex>& barprop, const SftMom& phases) const
+  {
+    START_CODE();
+
+    multi1d<LatticeComplex> corr;
+    evaluate(corr);
+
+    int num_mom = phases.numMom();
+    int length  = phases.numSubsets();
+    barprop.resize(ncorr, num_mom, length);
+
+    // All the correlators in one projection
+    multi1d< multi2d<DComplex> > hsum = phases.sft(corr);
+
+    for(int p=0; p < ncorr; ++p)
+      for(int sink_mom_num=0; sink_mom_num < num_mom; ++sink_mom_num)
+	for(int t=0; t < length; ++t)
+	  barprop[p][sink_mom_num][t] = hsum[p][sink_mom_num][t];
+
+    END_CODE();
+  }
+
+}  // end namespace Chroma
@@ -0,0 +1,111 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Batched baryon contractions sharing the diquarks
+ */
+
+#ifndef __baryon_contract_batch_w_h__
+#define __baryon_contract_batch_w_h__
+
+#include "chromabase.h"
+#include "util/ft/sftmom.h"
+#include <vector>
+
+namespace Chroma
+{
+
+  //! Batched baryon 2-pt contractions
+  /*!
+   * \ingroup hadron
+   *
+   * This routine is specific to Wilson fermions!
+   *
+   * All the usual baryon 2-pt functions (see baryon_w.cc and barhqlq_w.cc)
+   * are sums of terms
+   *
+   *   c_s * trace( T * traceColor( Q_o * traceSpin(D) ) )
+   * + c_d * trace( T * traceColor( Q_o * D ) )
+   *
+   * with the diquark   D = quarkContract13( Q_l * sp, sp * Q_r ).
+   *
+   * The terms of all the correlators are registered first. Each distinct
+   * diquark, identified by the source spin matrix sp and the flavors
+   * (l, r), is entered once in a table, and each distinct outer flavor o
+   * of a diquark once below it. evaluate() then makes a single threaded
+   * pass over the sites: per site every diquark is built once, the two
+   * color traced spin matrices are formed for each of its outer flavors,
+   * and every projector T of every correlator is read off those. No
+   * lattice wide propagator temporaries are made, and project() Fourier
+   * transforms all the correlators at once.
+   *
+   * The contractions are specific to Nc=3 and evaluate() aborts otherwise.
+   * Under QDP-JIT the diquarks are made one at a time as lattice fields.
+   *
+   * Flavors are held by reference and must outlive the evaluation.
+   */
+  class BaryonContractBatch
+  {
+  public:
+    //! Empty set of correlators
+    BaryonContractBatch() : ncorr(0) {}
+
+    //! Register a quark propagator, returns its flavor id
+    int addFlavor(const LatticePropagator& quark_propagator);
+
+    //! Start a new correlator, returns its id
+    int addCorr();
+
+    //! Add a term to correlator corr
+    /*!
+     * \param corr      correlator id ( Read )
+     * \param T         projector ( Read )
+     * \param sp        diquark spin matrix ( Read )
+     * \param f_l       flavor of the left quark of the diquark ( Read )
+     * \param f_r       flavor of the right quark of the diquark ( Read )
+     * \param f_o       flavor of the third quark ( Read )
+     * \param c_spin    coefficient of the spin traced diquark term ( Read )
+     * \param c_full    coefficient of the full diquark term ( Read )
+     */
+    void addTerm(int corr, const SpinMatrix& T, const SpinMatrix& sp,
+		 int f_l, int f_r, int f_o,
+		 const Real& c_spin, const Real& c_full);
+
+    //! Number of correlators
+    int numCorrs() const {return ncorr;}
+
+    //! Number of distinct diquarks
+    int numDiquarks() const {return dq_sp.size();}
+
+    //! Compute all the correlators as lattice fields
+    void evaluate(multi1d<LatticeComplex>& corr) const;
+
+    //! Compute all the correlators and project them, barprop[corr][mom][t]
+    void project(multi3d<DComplex>& barprop, const SftMom& phases) const;
+
+  private:
+    //! Table index of the diquark (sp, f_l, f_r), entered if new
+    int findDiquark(const SpinMatrix& sp, int f_l, int f_r);
+
+    //! Table index of the contraction of diquark d with flavor f_o, entered if new
+    int findContraction(int d, int f_o);
+
+    std::vector<const LatticePropagator*> flavor;
+
+    // Diquarks
+    std::vector<SpinMatrix> dq_sp;
+    std::vector<int> dq_l;
+    std::vector<int> dq_r;
+
+    // Contractions, one per (diquark, third flavor)
+    std::vector<int> con_dq;
+    std::vector<int> con_o;
+
+    // Terms in the order they were added
+    int ncorr;
+    std::vector<int> term_corr;
+    std::vector<int> term_con;
+    std::vector<REAL64> term_t;    // c_spin*T then c_full*T, 4*Ns*Ns reals per term
+  };
+
+}  // end namespace Chroma
+
+#endif
@@ -6,6 +6,7 @@
 #include "util/ft/sftmom.h"
 #include "meas/hadron/baryon_w.h"
 #include "meas/hadron/barspinmat_w.h"
+#include "meas/hadron/baryon_contract_batch_w.h"
 
 namespace Chroma 
 {
@@ -136,42 +137,31 @@ namespace Chroma
 
 
   //! Nucleon 2-pt
-  /*! \ingroup hadron */
-  LatticeComplex nucl2pt(const LatticePropagator& quark_propagator,
-			 const SpinMatrix& T, const SpinMatrix& sp) 
+  /*!
+   * \ingroup hadron
+   *
+   * Adds  factor * [ trace(T * traceColor(q * traceSpin(di_quark)))
+   *                  + trace(T * traceColor(q * di_quark)) ]
+   *
+   * with di_quark = quarkContract13(q * sp, sp * q) to correlator corr.
+   */
+  void nucl2pt(BaryonContractBatch& bar, int corr,
+	       const SpinMatrix& T, const SpinMatrix& sp, const Real& factor)
   {
-#if QDP_NC == 3
-
-    LatticePropagator di_quark = quarkContract13(quark_propagator * sp,
-						 sp * quark_propagator);
-    return LatticeComplex(trace(T * traceColor(quark_propagator * traceSpin(di_quark)))
-                        + trace(T * traceColor(quark_propagator * di_quark)));
-#else
-    LatticeComplex a ; 
-    a = zero ;
-    return a ;
-#endif
+    bar.addTerm(corr, T, sp, 0, 0, 0, factor, factor);
   }
 	      
 
   //! Delta 2-pt
-  /*! \ingroup hadron */
-  LatticeComplex delta2pt(const LatticePropagator& quark_propagator,
-			  const SpinMatrix& T, const SpinMatrix& sp) 
+  /*!
+   * \ingroup hadron
+   *
+   * As nucl2pt, but with a factor 2 on the second term.
+   */
+  void delta2pt(BaryonContractBatch& bar, int corr,
+		const SpinMatrix& T, const SpinMatrix& sp, const Real& factor)
   {
-#if QDP_NC == 3
-    LatticePropagator di_quark = quarkContract13(quark_propagator * sp,
-						 sp * quark_propagator);
-    return LatticeComplex(trace(T * traceColor(quark_propagator * traceSpin(di_quark)))
-		      + 2*trace(T * traceColor(quark_propagator * di_quark)));
-
-#else
-    LatticeComplex a ; 
-    a = zero ;
-    return a ;
-#endif
-
-
+    bar.addTerm(corr, T, sp, 0, 0, 0, factor, Real(2)*factor);
   }
 
 
@@ -262,11 +252,15 @@ namespace Chroma
     // C = Gamma(10)
     SpinMatrix C = BaryonSpinMats::C();
 
-    LatticeComplex b_prop;
+    // All the baryons share the diquarks of the one quark flavor
+    BaryonContractBatch bar;
+    bar.addFlavor(quark_propagator);
 
-    // Loop over baryons
+    // Register the terms of every baryon
     for(int baryons = 0; baryons < num_baryons; ++baryons)
     {
+      bar.addCorr();
+
       switch (baryons)
       {
       case 0:
@@ -276,7 +270,7 @@ namespace Chroma
 	// Polarized:
 	// T_mixed = T = (1 + \Sigma_3)*(1 + gamma_4) / 2 
 	//             = (1 + Gamma(8) - i G(3) - i G(11)) / 2
-	b_prop = nucl2pt(quark_propagator, T_mixed, Cg5);
+	nucl2pt(bar, baryons, T_mixed, Cg5, Real(1));
 	break;
 		  
       case 1:
@@ -287,7 +281,7 @@ namespace Chroma
 	// Polarized:
 	// T_mixed = T = (1 + \Sigma_3)*(1 + gamma_4) / 2 
 	//             = (1 + Gamma(8) - i G(3) - i G(11)) / 2
-	b_prop *= 3.0;
+	nucl2pt(bar, baryons, T_mixed, Cg5, Real(3));
 	break;
 
       case 2:
@@ -297,7 +291,7 @@ namespace Chroma
 	// T_mixed = T = (1 + \Sigma_3)*(1 + gamma_4) / 2 
 	//             = (1 + Gamma(8) - i G(3) - i G(11)) / 2
 	// Multiply by 3 for compatibility with heavy-light routine
-	b_prop = 3.0 * delta2pt(quark_propagator, T_mixed, BaryonSpinMats::Cgm());
+	delta2pt(bar, baryons, T_mixed, BaryonSpinMats::Cgm(), Real(3));
 	break;
 
       case 3:
@@ -307,7 +301,7 @@ namespace Chroma
 	// Polarized:
 	// T_mixed = T = (1 + \Sigma_3)*(1 + gamma_4) / 2 
 	//             = (1 + Gamma(8) - i G(3) - i G(11)) / 2
-	b_prop = nucl2pt(quark_propagator, T_mixed, Cg5g4);
+	nucl2pt(bar, baryons, T_mixed, Cg5g4, Real(1));
 	break;
 
       case 4:
@@ -318,7 +312,7 @@ namespace Chroma
 	// Polarized:
 	// T_mixed = T = (1 + \Sigma_3)*(1 + gamma_4) / 2 
 	//             = (1 + Gamma(8) - i G(3) - i G(11)) / 2
-	b_prop *= 3.0;
+	nucl2pt(bar, baryons, T_mixed, Cg5g4, Real(3));
 	break;
 
       case 5:
@@ -329,7 +323,7 @@ namespace Chroma
 	// T_mixed = T = (1 + \Sigma_3)*(1 + gamma_4) / 2 
 	//            = (1 + Gamma(8) - i G(3) - i G(11)) / 2
 	// Multiply by 3 for compatibility with heavy-light routine
-	b_prop = 3.0 * delta2pt(quark_propagator, T_mixed, BaryonSpinMats::Cg4m());
+	delta2pt(bar, baryons, T_mixed, BaryonSpinMats::Cg4m(), Real(3));
 	break;
 
       case 6:
@@ -339,7 +333,7 @@ namespace Chroma
 	// Polarized:
 	// T_mixed = T = (1 + \Sigma_3)*(1 + gamma_4) / 2 
 	//             = (1 + Gamma(8) - i G(3) - i G(11)) / 2
-	b_prop = nucl2pt(quark_propagator, T_mixed, Cg5NR);
+	nucl2pt(bar, baryons, T_mixed, Cg5NR, Real(1));
 	break;
 
       case 7:
@@ -350,7 +344,7 @@ namespace Chroma
 	// Polarized:
 	// T_mixed = T = (1 + \Sigma_3)*(1 + gamma_4) / 2 
 	//             = (1 + Gamma(8) - i G(3) - i G(11)) / 2
-	b_prop *= 3.0;
+	nucl2pt(bar, baryons, T_mixed, Cg5NR, Real(3));
 	break;
 
       case 8:
@@ -361,14 +355,12 @@ namespace Chroma
 	// T_mixed = T = (1 + \Sigma_3)*(1 + gamma_4) / 2 
 	//             = (1 + Gamma(8) - i G(3) - i G(11)) / 2
 	// Multiply by 3 for compatibility with heavy-light routine
-	b_prop = 3.0 * delta2pt(quark_propagator, T_mixed, BaryonSpinMats::CgmNR());
-
 	// Agghh, we have a goofy factor of 4 normalization factor here. The
 	// ancient szin way didn't care about norms, so it happily made it
 	// 4 times too big. There is a missing 0.5 in the NR normalization
 	// in the old szin code.
 	// So, we compensate to keep the same normalization
-	b_prop *= 4.0;
+	delta2pt(bar, baryons, T_mixed, BaryonSpinMats::CgmNR(), Real(3*4));
 	break;
 
       case 9:
@@ -377,7 +369,7 @@ namespace Chroma
 	// C gamma_5 = Gamma(5)
 	// Unpolarized:
 	// T_unpol = T = (1/2)(1 + gamma_4)
-	b_prop = nucl2pt(quark_propagator, T_unpol, Cg5);
+	nucl2pt(bar, baryons, T_unpol, Cg5, Real(1));
 	break;
 
       case 10:
@@ -386,7 +378,7 @@ namespace Chroma
 	// C gamma_5 gamma_4 = - Gamma(13)
 	// Unpolarized:
 	// T_unpol = T = (1/2)(1 + gamma_4)
-	b_prop = nucl2pt(quark_propagator, T_mixed, Cg5g4);
+	nucl2pt(bar, baryons, T_mixed, Cg5g4, Real(1));
 	break;
     
       case 11:
@@ -395,7 +387,7 @@ namespace Chroma
 	// C gamma_5 = Gamma(5)
 	// Unpolarized:
 	// T_unpol = T = (1/2)(1 + gamma_4)
-	b_prop = nucl2pt(quark_propagator, T_unpol, Cg5NR);
+	nucl2pt(bar, baryons, T_unpol, Cg5NR, Real(1));
 	break;
 
       case 12:
@@ -405,7 +397,7 @@ namespace Chroma
 	// Unpolarized:
 	// T_unpol = T = (1/2)(1 + gamma_4)
 	// Multiply by 3 for compatibility with heavy-light routine
-	b_prop = 3.0 * delta2pt(quark_propagator, T_unpol, BaryonSpinMats::Cgk(1));
+	delta2pt(bar, baryons, T_unpol, BaryonSpinMats::Cgk(1), Real(3));
 	break;
 
       case 13:
@@ -415,7 +407,7 @@ namespace Chroma
 	// Unpolarized:
 	// T_unpol = T = (1/2)(1 + gamma_4)
 	// Multiply by 3 for compatibility with heavy-light routine
-	b_prop = 3.0 * delta2pt(quark_propagator, T_unpol, BaryonSpinMats::Cgk(2));
+	delta2pt(bar, baryons, T_unpol, BaryonSpinMats::Cgk(2), Real(3));
 	break;
 
       case 14:
@@ -425,7 +417,7 @@ namespace Chroma
 	// Unpolarized:
 	// T_unpol = T = (1/2)(1 + gamma_4)
 	// Multiply by 3 for compatibility with heavy-light routine
-	b_prop = 3.0 * delta2pt(quark_propagator, T_unpol, BaryonSpinMats::Cgk(3));
+	delta2pt(bar, baryons, T_unpol, BaryonSpinMats::Cgk(3), Real(3));
 	break;
 
       case 15:
@@ -435,7 +427,7 @@ namespace Chroma
 	// Unpolarized:
 	// T_unpol = T = (1/2)(1 + gamma_4)
 	// Multiply by 3 for compatibility with heavy-light routine
-	b_prop = 3.0 * delta2pt(quark_propagator, T_unpol, BaryonSpinMats::Cg4gk(1));
+	delta2pt(bar, baryons, T_unpol, BaryonSpinMats::Cg4gk(1), Real(3));
 	break;
 
       case 16:
@@ -445,7 +437,7 @@ namespace Chroma
 	// Unpolarized:
 	// T_unpol = T = (1/2)(1 + gamma_4)
 	// Multiply by 3 for compatibility with heavy-light routine
-	b_prop = 3.0 * delta2pt(quark_propagator, T_unpol, BaryonSpinMats::Cg4gk(2));
+	delta2pt(bar, baryons, T_unpol, BaryonSpinMats::Cg4gk(2), Real(3));
 	break;
 
       case 17:
@@ -455,7 +447,7 @@ namespace Chroma
 	// Unpolarized:
 	// T_unpol = T = (1/2)(1 + gamma_4)
 	// Multiply by 3 for compatibility with heavy-light routine
-	b_prop = 3.0 * delta2pt(quark_propagator, T_unpol, BaryonSpinMats::Cg4gk(3));
+	delta2pt(bar, baryons, T_unpol, BaryonSpinMats::Cg4gk(3), Real(3));
 	break;
 
       case 18:
@@ -465,7 +457,7 @@ namespace Chroma
 	// Unpolarized:
 	// T_unpol = T = (1/2)(1 + gamma_4)
 	// Multiply by 3 for compatibility with heavy-light routine
-	b_prop = 3.0 * delta2pt(quark_propagator, T_unpol, BaryonSpinMats::CgkNR(1));
+	delta2pt(bar, baryons, T_unpol, BaryonSpinMats::CgkNR(1), Real(3));
 	break;
 
       case 19:
@@ -475,7 +467,7 @@ namespace Chroma
 	// Unpolarized:
 	// T_unpol = T = (1/2)(1 + gamma_4)
 	// Multiply by 3 for compatibility with heavy-light routine
-	b_prop = 3.0 * delta2pt(quark_propagator, T_unpol, BaryonSpinMats::CgkNR(2));
+	delta2pt(bar, baryons, T_unpol, BaryonSpinMats::CgkNR(2), Real(3));
 	break;
 
       case 20:
@@ -485,7 +477,7 @@ namespace Chroma
 	// Unpolarized:
 	// T_unpol = T = (1/2)(1 + gamma_4)
 	// Multiply by 3 for compatibility with heavy-light routine
-	b_prop = 3.0 * delta2pt(quark_propagator, T_unpol, BaryonSpinMats::CgkNR(3));
+	delta2pt(bar, baryons, T_unpol, BaryonSpinMats::CgkNR(3), Real(3));
 	break;
 
       case 21:
@@ -494,27 +486,20 @@ namespace Chroma
 	// C g_5 NR negpar = (1/2)*C gamma_5 * ( 1 - g_4 )
 	// T = (1 + \Sigma_3)*(1 - gamma_4) / 2 
 	//   = (1 - Gamma(8) + i G(3) - i G(11)) / 2
-	b_prop = nucl2pt(quark_propagator, 
-			 BaryonSpinMats::TmixedNegPar(), BaryonSpinMats::Cg5NRnegPar());
+	nucl2pt(bar, baryons, 
+		BaryonSpinMats::TmixedNegPar(), BaryonSpinMats::Cg5NRnegPar(), Real(1));
 	break;
 		  
       default:
 	QDP_error_exit("Unknown baryon: baryons=%d",baryons);
       }
-
-      // Project onto zero and if desired non-zero momentum
-      multi2d<DComplex> hsum;
-      hsum = phases.sft(b_prop);
-
-      for(int sink_mom_num=0; sink_mom_num < num_mom; ++sink_mom_num) 
-	for(int t = 0; t < length; ++t)
-	{
-	  // NOTE: there is NO  1/2  multiplying hsum
-	  barprop[baryons][sink_mom_num][t] = hsum[sink_mom_num][t];
-	}
-
     } // end loop over baryons
 
+    // One site pass for all the baryons, then project all of them onto
+    // zero and if desired non-zero momentum
+    // NOTE: there is NO  1/2  multiplying the sums
+    bar.project(barprop, phases);
+
     END_CODE();
   }
 
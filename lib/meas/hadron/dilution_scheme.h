@@ -34,6 +34,18 @@ namespace Chroma
     virtual int getDilSize(int t0) const = 0 ;
 
     virtual int getNumTimeSlices() const = 0;
+
+    //! Number of nested levels of the dilution
+    /*! Hierarchical schemes are refined by adding dilutions: level lev
+     *  is made of the first getLevelDilSize(t0,lev) dilutions, the last
+     *  level of all of them. Plain schemes have a single level. */
+    virtual int getNumLevels() const {return 1;}
+
+    //! Number of the first dilutions of time slice t0 making up level lev
+    virtual int getLevelDilSize(int t0, int lev) const {return getDilSize(t0);}
+
+    //! Weight of the contributions of the dilutions of level lev
+    virtual Real getLevelWeight(int t0, int lev) const {return Real(1);}
 	
     virtual Real getKappa() const = 0;
 
@@ -4,6 +4,7 @@
 
 #include "meas/hadron/dilution_scheme_aggregate.h"
 #include "meas/hadron/dilution_quark_source_const_w.h"
+#include "meas/hadron/dilution_scheme_probing_w.h"
 
 namespace Chroma
 {
@@ -25,6 +26,7 @@ namespace Chroma
       {
 	// Hadron
 	success &= DilutionQuarkSourceConstEnv::registerAll();
+	success &= DilutionSchemeProbingEnv::registerAll();
 
 	registered = true;
       }
@@ -0,0 +1,405 @@
+/*! \file
+ * \brief Hierarchical probing dilution scheme
+ *
+ * Z(N) noise times nested Hadamard (Walsh) probing vectors, with the
+ * solutions computed on the fly
+ */
+
+#include "fermact.h"
+#include "meas/hadron/dilution_scheme_probing_w.h"
+#include "meas/hadron/dilution_scheme_factory.h"
+#include "meas/inline/io/named_objmap.h"
+#include "meas/sources/zN_src.h"
+#include "actions/ferm/fermacts/fermact_factory_w.h"
+#include "actions/ferm/fermacts/fermacts_aggregate_w.h"
+#include "io/param_io.h"
+
+
+namespace Chroma
+{
+
+  // Read parameters
+  void read(XMLReader& xml, const std::string& path, DilutionSchemeProbingEnv::Params& param)
+  {
+    DilutionSchemeProbingEnv::Params tmp(xml, path);
+    param = tmp;
+  }
+
+
+  // Writer
+  void write(XMLWriter& xml, const std::string& path, const DilutionSchemeProbingEnv::Params& param)
+  {
+    param.writeXML(xml, path);
+  }
+
+
+  /*!
+   * \ingroup hadron
+   */
+  namespace DilutionSchemeProbingEnv
+  {
+    //! Initialize
+    Params::Params()
+    {
+      N = 4;
+      decay_dir = Nd-1;
+      probing_bits = 0;
+      spin_dilute = false;
+      color_dilute = false;
+    }
+
+
+    //! Read parameters
+    Params::Params(XMLReader& xml, const std::string& path)
+    {
+      XMLReader paramtop(xml, path);
+
+      int version;
+      read(paramtop, "version", version);
+
+      switch (version)
+      {
+      case 1:
+	/**************************************************************************/
+	break;
+
+      default :
+	/**************************************************************************/
+
+	QDPIO::cerr << "Input parameter version " << version << " unsupported." << std::endl;
+	QDP_abort(1);
+      }
+
+      read(paramtop, "gauge_id", gauge_id);
+      read(paramtop, "Propagator", prop);
+      read(paramtop, "ran_seed", ran_seed);
+      read(paramtop, "N", N);
+      read(paramtop, "decay_dir", decay_dir);
+      read(paramtop, "t_sources", t_sources);
+      read(paramtop, "probing_bits", probing_bits);
+
+      spin_dilute = false;
+      if (paramtop.count("spin_dilute") != 0)
+	read(paramtop, "spin_dilute", spin_dilute);
+
+      color_dilute = false;
+      if (paramtop.count("color_dilute") != 0)
+	read(paramtop, "color_dilute", color_dilute);
+    }
+
+
+    // Writer
+    void Params::writeXML(XMLWriter& xml, const std::string& path) const
+    {
+      push(xml, path);
+
+      int version = 1;
+      write(xml, "version", version);
+      write(xml, "gauge_id", gauge_id);
+      write(xml, "Propagator", prop);
+      write(xml, "ran_seed", ran_seed);
+      write(xml, "N", N);
+      write(xml, "decay_dir", decay_dir);
+      write(xml, "t_sources", t_sources);
+      write(xml, "probing_bits", probing_bits);
+      write(xml, "spin_dilute", spin_dilute);
+      write(xml, "color_dilute", color_dilute);
+
+      pop(xml);
+    }
+
+
+    // Anonymous namespace for registration
+    namespace
+    {
+      DilutionScheme<LatticeFermion>* createScheme(XMLReader& xml_in,
+						   const std::string& path)
+      {
+	return new ProbingDilutionScheme(Params(xml_in, path));
+      }
+
+      //! Local registration flag
+      bool registered = false;
+    }
+
+    const std::string name = "HIERARCHICAL_PROBING_FERM";
+
+    //! Register all the factories
+    bool registerAll()
+    {
+      bool success = true;
+
+      if (! registered)
+      {
+	success &= WilsonTypeFermActsEnv::registerAll();
+	success &= TheFermDilutionSchemeFactory::Instance().registerObject(name, createScheme);
+	registered = true;
+      }
+      return success;
+    }
+
+
+    //! Coloring bit b of every site
+    /*!
+     * At scale s = b / (Nd-1) the first bit is the parity of the sum of the
+     * spatial coordinates divided by 2^s, the others are bit s of all but
+     * the last spatial coordinate
+     */
+    LatticeInteger coloringBit(int b, int decay_dir)
+    {
+      multi1d<int> sdir(Nd-1);
+      for(int mu=0, j=0; mu < Nd; ++mu)
+	if (mu != decay_dir)
+	  sdir[j++] = mu;
+
+      const int s = b / (Nd-1);
+      const int k = b % (Nd-1);
+      const int scale = 1 << s;
+
+      if (k == 0)
+      {
+	LatticeInteger sum = zero;
+	for(int j=0; j < sdir.size(); ++j)
+	  sum += Layout::latticeCoordinate(sdir[j]) / scale;
+
+	return sum % 2;
+      }
+
+      LatticeInteger bit = (Layout::latticeCoordinate(sdir[k-1]) / scale) % 2;
+      return bit;
+    }
+
+
+    // Full constructor
+    ProbingDilutionScheme::ProbingDilutionScheme(const Params& p) : params(p), last_t0(-1), last_dil(-1)
+    {
+      START_CODE();
+
+      //
+      // Sanity checks
+      //
+      if (params.decay_dir < 0 || params.decay_dir >= Nd)
+      {
+	QDPIO::cerr << name << ": invalid decay_dir = " << params.decay_dir << std::endl;
+	QDP_abort(1);
+      }
+
+      for(int i=0; i < params.t_sources.size(); ++i)
+      {
+	if (params.t_sources[i] < 0 || params.t_sources[i] >= Layout::lattSize()[params.decay_dir])
+	{
+	  QDPIO::cerr << name << ": invalid t_source = " << params.t_sources[i] << std::endl;
+	  QDP_abort(1);
+	}
+      }
+
+      if (params.probing_bits < 0 || params.probing_bits > 8*sizeof(int)-2)
+      {
+	QDPIO::cerr << name << ": invalid probing_bits = " << params.probing_bits << std::endl;
+	QDP_abort(1);
+      }
+
+      // The coloring of the largest scale must be periodic
+      if (params.probing_bits > 0)
+      {
+	const int period = 2 << ((params.probing_bits-1) / (Nd-1));
+	for(int mu=0; mu < Nd; ++mu)
+	{
+	  if (mu != params.decay_dir && Layout::lattSize()[mu] % period != 0)
+	  {
+	    QDPIO::cerr << name << ": probing_bits = " << params.probing_bits
+			<< " needs spatial extents divisible by " << period << std::endl;
+	    QDP_abort(1);
+	  }
+	}
+      }
+
+      //
+      // The gauge field and its config info
+      //
+      XMLBufferWriter gauge_xml;
+      try
+      {
+	TheNamedObjMap::Instance().getData< multi1d<LatticeColorMatrix> >(params.gauge_id);
+	TheNamedObjMap::Instance().get(params.gauge_id).getRecordXML(gauge_xml);
+      }
+      catch( std::bad_cast )
+      {
+	QDPIO::cerr << name << ": caught dynamic cast error" << std::endl;
+	QDP_abort(1);
+      }
+      catch (const std::string& e)
+      {
+	QDPIO::cerr << name << ": std::map call failed: " << e << std::endl;
+	QDP_abort(1);
+      }
+      const multi1d<LatticeColorMatrix>& u =
+	TheNamedObjMap::Instance().getData< multi1d<LatticeColorMatrix> >(params.gauge_id);
+
+      // Same form as the measurements compare against
+      {
+	XMLBufferWriter top;
+	write(top, "Config_info", gauge_xml);
+	XMLReader from(top);
+	XMLReader from2(from, "/Config_info");
+	std::ostringstream os;
+	from2.print(os);
+
+	cfgInfo = os.str();
+      }
+
+      //
+      // The inverter
+      //
+      try
+      {
+	typedef LatticeFermion               T;
+	typedef multi1d<LatticeColorMatrix>  P;
+	typedef multi1d<LatticeColorMatrix>  Q;
+
+	std::istringstream  xml_s(params.prop.fermact.xml);
+	XMLReader  fermacttop(xml_s);
+	QDPIO::cout << name << ": FermAct = " << params.prop.fermact.id << std::endl;
+
+	Handle< FermionAction<T,P,Q> >
+	  S_f(TheFermionActionFactory::Instance().createObject(params.prop.fermact.id,
+							       fermacttop,
+							       params.prop.fermact.path));
+
+	Handle< FermState<T,P,Q> > state(S_f->createState(u));
+
+	PP = S_f->qprop(state, params.prop.invParam);
+      }
+      catch (const std::string& e)
+      {
+	QDPIO::cerr << name << ": caught exception creating the inverter: " << e << std::endl;
+	QDP_abort(1);
+      }
+
+      QDPIO::cout << name << ": " << numProbes(params.probing_bits) << " probing vectors and "
+		  << spinColorSize() << " spin-color dilutions on each of "
+		  << params.t_sources.size() << " time slices" << std::endl;
+
+      END_CODE();
+    }
+
+
+    // The kappa parameter in the wilson action
+    Real ProbingDilutionScheme::getKappa() const
+    {
+      Real kappa;
+      std::istringstream  xml_k(params.prop.fermact.xml);
+
+      XMLReader  proptop(xml_k);
+      if ( toBool(proptop.count("/FermionAction/Kappa") != 0) )
+      {
+	read(proptop, "/FermionAction/Kappa", kappa);
+      }
+      else
+      {
+	Real mass;
+	read(proptop, "/FermionAction/Mass", mass);
+	kappa = massToKappa(mass);
+      }
+
+      return kappa;
+    }
+
+
+    // returns the source header for a given dilution
+    std::string ProbingDilutionScheme::getSourceHeader(int t0, int dil) const
+    {
+      XMLBufferWriter xml;
+
+      push(xml, "Source");
+      write(xml, "SourceType", name);
+      params.writeXML(xml, "Params");
+      write(xml, "t_source", getT0(t0));
+      write(xml, "dilution", dil);
+      pop(xml);
+
+      return xml.str();
+    }
+
+
+    // Return the diluted source std::vector
+    LatticeFermion ProbingDilutionScheme::dilutedSource(int t0, int dil) const
+    {
+      if (t0 < 0 || t0 >= getNumTimeSlices() || dil < 0 || dil >= getDilSize(t0))
+      {
+	QDPIO::cerr << name << ": invalid time slice or dilution: " << t0 << " " << dil << std::endl;
+	QDP_abort(1);
+      }
+
+      const int nc = (params.color_dilute) ? Nc : 1;
+      const int ns = (params.spin_dilute) ? Ns : 1;
+      const int j  = dil / (ns*nc);
+      const int s  = (dil / nc) % ns;
+      const int c  = dil % nc;
+
+      // The noise on the whole lattice
+      LatticeFermion noise;
+      zN_src(noise, params.N, params.ran_seed, 0);
+
+      // Filter over spin and color
+      LatticeFermion quark_source = zero;
+
+      for(int spin=0; spin < Ns; ++spin)
+      {
+	if (params.spin_dilute && spin != s)
+	  continue;
+
+	LatticeColorVector colvec = peekSpin(noise, spin);
+
+	if (params.color_dilute)
+	{
+	  LatticeColorVector dest = zero;
+	  pokeColor(dest, peekColor(colvec, c), c);
+	  colvec = dest;
+	}
+
+	pokeSpin(quark_source, colvec, spin);
+      }
+
+      // Filter over the time slice
+      LatticeBoolean mask = Layout::latticeCoordinate(params.decay_dir) == getT0(t0);
+      quark_source = where(mask, quark_source, LatticeFermion(zero));
+
+      // Sign of the probing vector
+      if (j > 0)
+      {
+	LatticeInteger flips = zero;
+	for(int b=0; b < params.probing_bits; ++b)
+	  if ((j >> b) & 1)
+	    flips += coloringBit(b, params.decay_dir);
+
+	LatticeFermion neg = -quark_source;
+	quark_source = where((flips % 2) == 1, neg, quark_source);
+      }
+
+      return quark_source;
+    }
+
+
+    // Return the solution std::vector corresponding to the diluted source
+    LatticeFermion ProbingDilutionScheme::dilutedSolution(int t0, int dil) const
+    {
+      if (t0 == last_t0 && dil == last_dil)
+	return last_soln;
+
+      LatticeFermion chi = dilutedSource(t0, dil);
+
+      last_soln = zero;
+      SystemSolverResults_t res = (*PP)(last_soln, chi);
+      last_t0  = t0;
+      last_dil = dil;
+
+      QDPIO::cout << name << ": t0 = " << getT0(t0) << "  dil = " << dil
+		  << "  ncg = " << res.n_count << std::endl;
+
+      return last_soln;
+    }
+
+  } // namespace DilutionSchemeProbingEnv
+
+} // namespace Chroma
@@ -0,0 +1,168 @@
+// -*- C++ -*-
+/*! \file
+ * \brief Hierarchical probing dilution scheme
+ *
+ * Z(N) noise times nested Hadamard (Walsh) probing vectors, with the
+ * solutions computed on the fly
+ */
+
+#ifndef __dilution_scheme_probing_w_h__
+#define __dilution_scheme_probing_w_h__
+
+#include "chromabase.h"
+#include "handle.h"
+#include "syssolver.h"
+#include "meas/hadron/dilution_scheme.h"
+#include "io/qprop_io.h"
+
+namespace Chroma
+{
+  /*! \ingroup hadron */
+  namespace DilutionSchemeProbingEnv
+  {
+    extern const std::string name;
+    bool registerAll();
+
+    //! Parameter structure
+    /*! \ingroup hadron */
+    struct Params
+    {
+      Params();
+      Params(XMLReader& xml_in, const std::string& path);
+      void writeXML(XMLWriter& xml_out, const std::string& path) const;
+
+      std::string   gauge_id;         /*!< gauge field the solutions are computed on */
+      ChromaProp_t  prop;             /*!< fermion action and inverter */
+
+      Seed          ran_seed;         /*!< seed of the noise, identifies this quark */
+      int           N;                /*!< the N in Z(N) */
+      int           decay_dir;        /*!< decay direction */
+      multi1d<int>  t_sources;        /*!< time slices that are diluted */
+
+      int           probing_bits;     /*!< 2^probing_bits probing vectors per time slice */
+      bool          spin_dilute;      /*!< dilute fully in spin */
+      bool          color_dilute;     /*!< dilute fully in color */
+    };
+
+
+    //! Hierarchical probing dilution scheme
+    /*!
+     * \ingroup hadron
+     *
+     * On each time slice t0 the sources are
+     *
+     *   eta_{j,s,c}(x) = w_j(x) * P_{s,c} eta(x)
+     *
+     * with eta one Z(N) noise vector, P_{s,c} the (optional) spin and color
+     * projectors and w_j, j < 2^probing_bits, the Walsh functions
+     *
+     *   w_j(x) = prod_b (-1)^{ j_b * beta_b(x) }
+     *
+     * of a hierarchy of coloring bits beta_b(x) of the spatial site. At
+     * each scale s = 0, 1, ... the Nd-1 bits are the parity of the sum of
+     * the coordinates x_i / 2^s followed by the bits s of all but the last
+     * spatial coordinate. The first bit is the red-black coloring; the
+     * first Nd-1 bits at scale s fix x mod 2^(s+1) in every direction.
+     *
+     * Since the Walsh functions of the first 2^k indices span the functions
+     * of the first k coloring bits, the first 2^k probing vectors give the
+     * same estimate as dilution in the 2^k colors, up to the factor 2^k
+     * returned by getLevelWeight(). Every prefix of 2^k vectors is a probing
+     * level, so a cheap level is refined by adding vectors and all its
+     * solutions are kept. Dilutions are ordered probing vector first:
+     *   dil = (j * ns + s) * nc + c.
+     *
+     * The noise is counter based, so it is made again from the seed for
+     * every source rather than stored. The solutions are computed when
+     * asked for; the last one is kept.
+     */
+    class ProbingDilutionScheme : public DilutionScheme<LatticeFermion>
+    {
+    public:
+      //! Virtual destructor to help with cleanup;
+      ~ProbingDilutionScheme() {}
+
+      //! Full constructor
+      ProbingDilutionScheme(const Params& p);
+
+      //! The decay direction
+      int getDecayDir() const {return params.decay_dir;}
+
+      //! The seed identifies this quark
+      const Seed& getSeed() const {return params.ran_seed;}
+
+      //! The actual t0 corresponding to this time dilution element
+      int getT0(int t0) const {return params.t_sources[t0];}
+
+      //! The number of dilutions per timeslice
+      int getDilSize(int t0) const {return numProbes(params.probing_bits) * spinColorSize();}
+
+      //! The number of dilution timeslices included
+      int getNumTimeSlices() const {return params.t_sources.size();}
+
+      //! The probing levels are 1, 2, 4, ... 2^probing_bits vectors
+      int getNumLevels() const {return params.probing_bits + 1;}
+
+      //! The first dilutions of timeslice t0 making up level lev
+      int getLevelDilSize(int t0, int lev) const {return numProbes(lev) * spinColorSize();}
+
+      //! Weight of the dilutions of level lev
+      Real getLevelWeight(int t0, int lev) const {return Real(1) / Real(numProbes(lev));}
+
+      //! The kappa parameter in the wilson action
+      Real getKappa() const;
+
+      //! The info from the cfg on which the inversions are performed
+      std::string getCfgInfo() const {return cfgInfo;}
+
+      //! returns the prop header for a given dilution
+      std::string getPropHeader(int t0, int dil) const {return params.prop.fermact.xml;}
+
+      //! returns the source header for a given dilution
+      std::string getSourceHeader(int t0, int dil) const;
+
+      //! Return the diluted source std::vector
+      LatticeFermion dilutedSource(int t0, int dil) const;
+
+      //! Return the solution std::vector corresponding to the diluted source
+      LatticeFermion dilutedSolution(int t0, int dil) const;
+
+    protected:
+      //! Hide partial constructor
+      ProbingDilutionScheme() {}
+
+      //! Number of probing vectors of a level
+      int numProbes(int lev) const {return 1 << lev;}
+
+      //! Number of spin-color dilutions
+      int spinColorSize() const
+	{
+	  return ((params.spin_dilute) ? Ns : 1) * ((params.color_dilute) ? Nc : 1);
+	}
+
+    private:
+      Params params;
+      std::string cfgInfo;
+
+      Handle< SystemSolver<LatticeFermion> > PP;   /*!< the inverter */
+
+      // The last solution
+      mutable int last_t0;
+      mutable int last_dil;
+      mutable LatticeFermion last_soln;
+    };
+
+  } // namespace DilutionSchemeProbingEnv
+
+
+  //! Reader
+  /*! @ingroup hadron */
+  void read(XMLReader& xml, const std::string& path, DilutionSchemeProbingEnv::Params& param);
+
+  //! Writer
+  /*! @ingroup hadron */
+  void write(XMLWriter& xml, const std::string& path, const DilutionSchemeProbingEnv::Params& param);
+
+} // namespace Chroma
+
+#endif
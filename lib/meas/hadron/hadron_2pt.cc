@@ -39,13 +39,26 @@ namespace Chroma
 
     int length = phases.numSubsets();
 
+    // Fourier transform all the correlators in one pass
+    multi1d<LatticeComplex> latt_corrs(had_list.size());
+    int n = 0;
+    for(std::list< Handle<Hadron2PtContract_t> >::const_iterator had_ptr= had_list.begin(); 
+	had_ptr != had_list.end(); 
+	++had_ptr)
+    {
+      latt_corrs[n++] = (*had_ptr)->corr;
+    }
+
+    multi1d< multi2d<DComplex> > hsum_all(phases.sft(latt_corrs));
+
     // Run over the input list, 
+    n = 0;
     for(std::list< Handle<Hadron2PtContract_t> >::const_iterator had_ptr= had_list.begin(); 
 	had_ptr != had_list.end(); 
 	++had_ptr)
     {
       const Hadron2PtContract_t& had_cont = **had_ptr;
-      multi2d<DComplex> hsum(phases.sft(had_cont.corr));   // slow fourier-transform
+      const multi2d<DComplex>& hsum = hsum_all[n++];
 
       // Copy onto output structure
       Hadron2PtCorrs_t  had_corrs;
@@ -0,0 +1,241 @@
+/*! \file
+ *  \brief Batched meson contractions over all gamma insertions
+ */
+
+#include "meas/hadron/meson_contract_batch_w.h"
+#include "util/ferm/spin_rep.h"
+
+namespace Chroma 
+{
+
+#ifndef QDP_IS_QDPJIT
+  //! Site kernel of the batched meson contractions
+  namespace MesonContractBatchEnv
+  {
+    //! Number of spin-spin entries of a propagator
+    const int ns2 = Ns*Ns;
+
+    struct ContractArgs
+    {
+      LatticeComplex* corr;
+      const LatticePropagator& q1;
+      const LatticePropagator& q2;
+      const int* tab;
+      int npair;
+      const int* term_off;     // terms of pair p are [term_off[p], term_off[p+1])
+      const int* term_o;       // index into the outer product
+      const REAL64* term_c;    // complex coefficient of the term
+    };
+
+    //! Outer product and all the correlators over a block of sites
+    /*!
+     *   O(i,k) = sum_{a,b} conj(Q2_i^{ab}) Q1_k^{ab}
+     *
+     * for all the spin pairs i of quark_prop_2 and k of quark_prop_1,
+     * then corr[p] = sum over the terms of p of  c * O.
+     */
+    inline
+    void contractSiteLoop(int lo, int hi, int my_id, ContractArgs* a)
+    {
+      const int nc2 = Nc*Nc;
+      REAL64 O[2*ns2*ns2];
+
+      for(int ssite=lo; ssite < hi; ++ssite)
+      {
+	int site = a->tab[ssite];
+	const REAL* p1 = (const REAL *)&(a->q1.elem(site).elem(0,0).elem(0,0).real());
+	const REAL* p2 = (const REAL *)&(a->q2.elem(site).elem(0,0).elem(0,0).real());
+
+	for(int i=0; i < ns2; ++i)
+	{
+	  const REAL* x = p2 + 2*nc2*i;
+
+	  for(int k=0; k < ns2; ++k)
+	  {
+	    const REAL* y = p1 + 2*nc2*k;
+
+	    REAL64 re = 0;
+	    REAL64 im = 0;
+	    for(int c=0; c < 2*nc2; c+=2)
+	    {
+	      re += x[c]*y[c]   + x[c+1]*y[c+1];
+	      im += x[c]*y[c+1] - x[c+1]*y[c];
+	    }
+	    O[2*(i*ns2 + k)]   = re;
+	    O[2*(i*ns2 + k)+1] = im;
+	  }
+	}
+
+	for(int p=0; p < a->npair; ++p)
+	{
+	  REAL64 re = 0;
+	  REAL64 im = 0;
+	  for(int t=a->term_off[p]; t < a->term_off[p+1]; ++t)
+	  {
+	    const REAL64* o = O + 2*a->term_o[t];
+	    const REAL64 cr = a->term_c[2*t];
+	    const REAL64 ci = a->term_c[2*t+1];
+	    re += cr*o[0] - ci*o[1];
+	    im += cr*o[1] + ci*o[0];
+	  }
+
+	  REAL* out = (REAL *)&(a->corr[p].elem(site).elem().elem().real());
+	  out[0] = re;
+	  out[1] = im;
+	}
+      }
+    }
+
+
+    //! A gamma matrix as one (column, value) per row
+    struct SparseGamma
+    {
+      int    col[Ns];
+      REAL64 re[Ns];
+      REAL64 im[Ns];
+    };
+
+    //! Sparse form of Gamma(gamma) in the DeGrand-Rossi basis
+    SparseGamma sparseGamma(int gamma)
+    {
+      std::vector<MatrixSpinRep_t> rep = convertTwoQuarkSpinDR(gamma);
+
+      if (rep.size() != Ns)
+      {
+	QDPIO::cerr << __func__ << ": Gamma(" << gamma << ") is not a signed permutation" << std::endl;
+	QDP_abort(1);
+      }
+
+      SparseGamma g;
+      for(int i=0; i < rep.size(); ++i)
+      {
+	g.col[rep[i].left] = rep[i].right;
+	g.re[rep[i].left]  = toDouble(real(rep[i].op));
+	g.im[rep[i].left]  = toDouble(imag(rep[i].op));
+      }
+
+      return g;
+    }
+  }
+#endif
+
+
+  // Meson correlators for a list of sink and source gamma insertions
+  void mesonCorrs(multi1d<LatticeComplex>& corr,
+		  const LatticePropagator& quark_prop_1,
+		  const LatticePropagator& quark_prop_2,
+		  const multi1d<int>& gamma_snk,
+		  const multi1d<int>& gamma_src)
+  {
+    START_CODE();
+
+    if (gamma_snk.size() != gamma_src.size())
+    {
+      QDPIO::cerr << __func__ << ": sink and source gamma lists differ in length" << std::endl;
+      QDP_abort(1);
+    }
+
+    const int npair = gamma_snk.size();
+    corr.resize(npair);
+
+#ifndef QDP_IS_QDPJIT
+    using namespace MesonContractBatchEnv;
+
+    // The G5 conjugation of quark_prop_2 goes into the coefficients:
+    //   conj(A_{alpha,beta}) = conj(g5(alpha) g5(nu)) conj(Q2_{col5(alpha),nu}),
+    // nu being the row of G5 whose nonzero is in column beta.
+    SparseGamma g5 = sparseGamma(Ns*Ns-1);
+    int g5_row[Ns];
+    for(int i=0; i < Ns; ++i)
+      g5_row[g5.col[i]] = i;
+
+    // corr = sum  snk(alpha,gamma) src(delta,beta) conj(A_{alpha,beta}) Q1_{gamma,delta}
+    const int nterm = Ns*Ns;
+    multi1d<int>    term_off(npair+1);
+    multi1d<int>    term_o(npair*nterm);
+    multi1d<REAL64> term_c(2*npair*nterm);
+
+    int t = 0;
+    for(int p=0; p < npair; ++p)
+    {
+      term_off[p] = t;
+      SparseGamma snk = sparseGamma(gamma_snk[p]);
+      SparseGamma src = sparseGamma(gamma_src[p]);
+
+      for(int alpha=0; alpha < Ns; ++alpha)
+      {
+	for(int delta=0; delta < Ns; ++delta)
+	{
+	  const int gamma = snk.col[alpha];
+	  const int beta  = src.col[delta];
+	  const int mu    = g5.col[alpha];
+	  const int nu    = g5_row[beta];
+
+	  // snk * src
+	  REAL64 ar = snk.re[alpha]*src.re[delta] - snk.im[alpha]*src.im[delta];
+	  REAL64 ai = snk.re[alpha]*src.im[delta] + snk.im[alpha]*src.re[delta];
+
+	  // conj(g5(alpha) g5(nu))
+	  REAL64 br =   g5.re[alpha]*g5.re[nu] - g5.im[alpha]*g5.im[nu];
+	  REAL64 bi = -(g5.re[alpha]*g5.im[nu] + g5.im[alpha]*g5.re[nu]);
+
+	  term_o[t] = (mu*Ns + nu)*ns2 + gamma*Ns + delta;
+	  term_c[2*t]   = ar*br - ai*bi;
+	  term_c[2*t+1] = ar*bi + ai*br;
+	  ++t;
+	}
+      }
+    }
+    term_off[npair] = t;
+
+    const Subset& s = all;
+    ContractArgs arg = {corr.slice(), quark_prop_1, quark_prop_2, 
+			s.siteTable().slice(), npair,
+			term_off.slice(), term_o.slice(), term_c.slice()};
+    dispatch_to_threads(s.numSiteTable(), arg, contractSiteLoop);
+#else
+    // Construct the anti-quark propagator from quark_prop_2
+    int G5 = Ns*Ns-1;
+    LatticePropagator anti_quark_prop = Gamma(G5) * quark_prop_2 * Gamma(G5);
+
+    for(int p=0; p < npair; ++p)
+      corr[p] = trace(adj(anti_quark_prop) * (Gamma(gamma_snk[p]) * quark_prop_1 * Gamma(gamma_src[p])));
+#endif
+
+    END_CODE();
+  }
+
+
+  // The Ns*Ns correlators with the same gamma at source and sink
+  void mesonCorrsDiagGamma(multi1d<LatticeComplex>& corr,
+			   const LatticePropagator& quark_prop_1,
+			   const LatticePropagator& quark_prop_2)
+  {
+    multi1d<int> gammas(Ns*Ns);
+    for(int g=0; g < Ns*Ns; ++g)
+      gammas[g] = g;
+
+    mesonCorrs(corr, quark_prop_1, quark_prop_2, gammas, gammas);
+  }
+
+
+  // All (Ns*Ns)^2 correlators
+  void mesonCorrsAllGamma(multi1d<LatticeComplex>& corr,
+			  const LatticePropagator& quark_prop_1,
+			  const LatticePropagator& quark_prop_2)
+  {
+    multi1d<int> gamma_snk(Ns*Ns*Ns*Ns);
+    multi1d<int> gamma_src(Ns*Ns*Ns*Ns);
+    for(int g_snk=0; g_snk < Ns*Ns; ++g_snk)
+    {
+      for(int g_src=0; g_src < Ns*Ns; ++g_src)
+      {
+	gamma_snk[g_snk*Ns*Ns + g_src] = g_snk;
+	gamma_src[g_snk*Ns*Ns + g_src] = g_src;
+      }
+    }
+
+    mesonCorrs(corr, quark_prop_1, quark_prop_2, gamma_snk, gamma_src);
+  }
+
+}  // end namespace Chroma
@@ -0,0 +1,59 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Batched meson contractions over all gamma insertions
+ */
+
+#ifndef __meson_contract_batch_w_h__
+#define __meson_contract_batch_w_h__
+
+#include "chromabase.h"
+
+namespace Chroma 
+{
+
+  //! Meson correlators for a list of sink and source gamma insertions
+  /*!
+   * \ingroup hadron
+   *
+   * This routine is specific to Wilson fermions!
+   *
+   * For each pair p of the lists
+   *
+   *   corr[p] = trace( adj(anti_quark_prop) * Gamma(gamma_snk[p]) 
+   *                    * quark_prop_1 * Gamma(gamma_src[p]) )
+   *
+   * with anti_quark_prop = Gamma(G5) * quark_prop_2 * Gamma(G5).
+   *
+   * In one sweep over the sites the color-traced spin outer product
+   * of the two propagators is formed, and every correlator is read off
+   * it with the sparse (one entry per row) gamma matrices. No
+   * propagator-sized temporaries are made. Project all the results at
+   * once with SftMom::sft(const multi1d<LatticeComplex>&).
+   *
+   * \param corr          correlators, one per pair ( Write )
+   * \param quark_prop_1  first quark propagator ( Read )
+   * \param quark_prop_2  second (anti-) quark propagator ( Read )
+   * \param gamma_snk     sink gamma insertions ( Read )
+   * \param gamma_src     source gamma insertions ( Read )
+   */
+  void mesonCorrs(multi1d<LatticeComplex>& corr,
+		  const LatticePropagator& quark_prop_1,
+		  const LatticePropagator& quark_prop_2,
+		  const multi1d<int>& gamma_snk,
+		  const multi1d<int>& gamma_src);
+
+  //! The Ns*Ns correlators with the same gamma at source and sink, as in mesons()
+  /*! \ingroup hadron */
+  void mesonCorrsDiagGamma(multi1d<LatticeComplex>& corr,
+			   const LatticePropagator& quark_prop_1,
+			   const LatticePropagator& quark_prop_2);
+
+  //! All (Ns*Ns)^2 correlators, corr[gamma_snk*Ns*Ns + gamma_src]
+  /*! \ingroup hadron */
+  void mesonCorrsAllGamma(multi1d<LatticeComplex>& corr,
+			  const LatticePropagator& quark_prop_1,
+			  const LatticePropagator& quark_prop_2);
+
+}  // end namespace Chroma
+
+#endif
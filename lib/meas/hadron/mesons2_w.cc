@@ -79,6 +79,7 @@
 #include "chromabase.h"
 #include "util/ft/sftmom.h"
 #include "meas/hadron/mesons_w.h"
+#include "meas/hadron/meson_contract_batch_w.h"
 
 namespace Chroma {
 
@@ -116,16 +117,12 @@ void mesons2(const LatticePropagator& quark_prop_1,
   // Length of lattice in decay direction
   int length = phases.numSubsets();
 
-  // Construct the anti-quark propagator from quark_prop_2
-  int G5 = Ns*Ns-1;
-  LatticePropagator anti_quark_prop =  Gamma(G5) * quark_prop_2 * Gamma(G5);
+  // All the gamma insertions in one sweep over the sites, then
+  // the Fourier transforms of all of them in one pass through SftMom
+  multi1d<LatticeComplex> corr_fn;
+  mesonCorrsDiagGamma(corr_fn, quark_prop_1, quark_prop_2);
 
-  // This variant uses the function SftMom::sft() to do all the work
-  // computing the Fourier transform of the meson correlation function
-  // inside the class SftMom where all the of the Fourier phases and
-  // momenta are stored.  It's primary disadvantage is that it
-  // requires more memory because it does all of the Fourier transforms
-  // at the same time.
+  multi1d< multi2d<DComplex> > hsum_all = phases.sft(corr_fn);
 
   // Loop over gamma matrix insertions
   XMLArrayWriter xml_gamma(xml,Ns*Ns);
@@ -136,13 +133,7 @@ void mesons2(const LatticePropagator& quark_prop_1,
     push(xml_gamma);     // next array element
     write(xml_gamma, "gamma_value", gamma_value);
 
-    // Construct the meson correlation function
-    LatticeComplex corr_fn;
-    corr_fn = trace(adj(anti_quark_prop) * (Gamma(gamma_value) *
-                    quark_prop_1 * Gamma(gamma_value)));
-
-    multi2d<DComplex> hsum;
-    hsum = phases.sft(corr_fn);
+    const multi2d<DComplex>& hsum = hsum_all[gamma_value];
 
     // Loop over sink momenta
     XMLArrayWriter xml_sink_mom(xml_gamma,phases.numMom());
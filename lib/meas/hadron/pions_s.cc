@@ -12,6 +12,7 @@
 
 #include "meas/hadron/pions_s.h"
 #include "util/gauge/stag_phases_s.h"
+#include "util/ft/sftmom.h"
 
 namespace Chroma {
 
@@ -101,12 +102,12 @@ namespace Chroma {
     // resize output array appropriately
     corr_fn.resize(NUM_STAG_PIONS, latt_size[Nd-1]);
 
-    // Correlation functions before spatial sum
-    LatticeComplex latt_corr_fn;
+    // Correlation functions before spatial sum. All of them are
+    // summed over the time slices in one pass at the end.
+    multi1d<LatticeComplex> latt_corrs(NUM_STAG_PIONS);
 
-    // Machinery to do timeslice sums with 
-    Set timeslice;
-    timeslice.make(TimeSliceFunc(Nd-1));
+    // The local trace is shared by the zero-link correlators
+    LatticeComplex local_trace = trace(adj(quark_props[0])*quark_props[0]);
 
     // Phases
     //multi1d<LatticeInteger> alpha(Nd); // KS Phases
@@ -121,10 +122,8 @@ namespace Chroma {
     int mu, nu, rho;  
 
     // Goldstone Pion
-    latt_corr_fn = trace(adj(quark_props[0])*quark_props[0]);
+    latt_corrs[ pion_index ] = local_trace;
 
-    // Slice Sum
-    corr_fn[ pion_index ] = sumMulti(latt_corr_fn, timeslice);
     tag_names[pion_index] = "gamma5_CROSS_gamma5" ; 
 
     pion_index++;
@@ -141,17 +140,15 @@ namespace Chroma {
       delta = 0;
       delta[mu] = 1;
       
-      latt_corr_fn =  beta(mu)*trace(shift_deltaProp(delta,quark_props[0])
+      latt_corrs[ pion_index ] =  beta(mu)*trace(shift_deltaProp(delta,quark_props[0])
 				     *adj(quark_props[ deltaToPropIndex(delta) ]));
     
-      corr_fn[ pion_index ] = sumMulti(latt_corr_fn, timeslice);
       pion_index++;
     }
     
     // ------------------------------
     tag_names[pion_index]   = "gamma3_gamma5_CROSS_gamma3_gamma5" ; 
-    latt_corr_fn = -  alpha(Nd-1)*trace(adj(quark_props[0])*quark_props[0]);
-    corr_fn[ pion_index ] = sumMulti(latt_corr_fn, timeslice);
+    latt_corrs[ pion_index ] = -  alpha(Nd-1)*local_trace;
     pion_index++;
 
     // -----------------------------
@@ -165,11 +162,10 @@ namespace Chroma {
 	delta[mu] = 1;
 	delta[nu] = 1;
 
-	latt_corr_fn = - beta(mu)* beta(nu)
+	latt_corrs[ pion_index ] = - beta(mu)* beta(nu)
 	  *trace(adj(shift_deltaProp(delta,quark_props[0]))
 		 *quark_props[ deltaToPropIndex(delta) ]);
     
-	corr_fn[ pion_index ] = sumMulti(latt_corr_fn, timeslice);
 	pion_index++;
       }
     }
@@ -184,11 +180,10 @@ namespace Chroma {
       delta = 0;
       delta[mu] = 1;
     
-      latt_corr_fn = - beta(mu)*  alpha(Nd-1)
+      latt_corrs[ pion_index ] = - beta(mu)*  alpha(Nd-1)
 	*trace(adj(shift_deltaProp(delta,quark_props[0]))
 	       *quark_props[ deltaToPropIndex(delta) ]);
     
-      corr_fn[ pion_index ] = sumMulti(latt_corr_fn, timeslice);
       pion_index++;
     }
 
@@ -205,11 +200,10 @@ namespace Chroma {
 	  delta[rho] = 1;
 
 	
-	  latt_corr_fn = - beta(mu) * beta(nu)* beta(rho)
+	  latt_corrs[ pion_index ] = - beta(mu) * beta(nu)* beta(rho)
 	    *trace(adj(shift_deltaProp(delta,quark_props[0]))
 		   *quark_props[ deltaToPropIndex(delta) ]);
 	
-	  corr_fn[ pion_index ] = sumMulti(latt_corr_fn, timeslice);
 	  pion_index++;
 	}
       }
@@ -227,11 +221,10 @@ namespace Chroma {
 	delta[mu] = 1;
 	delta[nu] = 1;
 
-	latt_corr_fn =  beta(mu)* beta(nu)*  alpha(Nd-1)
+	latt_corrs[ pion_index ] =  beta(mu)* beta(nu)*  alpha(Nd-1)
 	  *trace(adj(shift_deltaProp(delta,quark_props[0]))
 		 *quark_props[ deltaToPropIndex(delta) ]);
 	
-	corr_fn[ pion_index ] = sumMulti(latt_corr_fn, timeslice);
 	pion_index++;
       }
     }
@@ -241,13 +234,18 @@ namespace Chroma {
 
     delta = 0;
     delta[0] = delta[1] = delta[2] = 1;
-    latt_corr_fn = - alpha(3)* beta(0)* beta(1) * beta(2)
+    latt_corrs[ pion_index ] = - alpha(3)* beta(0)* beta(1) * beta(2)
       *trace(adj(shift_deltaProp(delta, quark_props[0]))
 	     *quark_props[ deltaToPropIndex(delta) ] );
   
-    corr_fn[ pion_index ] = sumMulti(latt_corr_fn, timeslice);
     pion_index++;
 
+    // Time slice sums of all the correlators
+    SftMom phases(0, false, Nd-1);
+    multi1d< multi2d<DComplex> > hsum = phases.sft(latt_corrs);
+    for(i=0; i < NUM_STAG_PIONS; i++)
+      corr_fn[i] = hsum[i][0];
+
     if( pion_index != NUM_STAG_PIONS) { 
       QDPIO::cerr << "Panic! Panic! Something has gone horribly wrong" << std::endl;
       QDP_abort(1);
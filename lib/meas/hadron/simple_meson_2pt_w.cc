@@ -4,6 +4,7 @@
 
 #include "meas/hadron/simple_meson_2pt_w.h"
 #include "meas/hadron/hadron_contract_factory.h"
+#include "meas/hadron/meson_contract_batch_w.h"
 
 #include "meas/inline/io/named_objmap.h"
 
@@ -35,20 +36,6 @@ namespace Chroma
     //! Anonymous namespace
     namespace
     {
-      //! Construct the correlator
-      LatticeComplex mesXCorr(const LatticePropagator& quark_prop_1,
-			      const LatticePropagator& quark_prop_2, 
-			      int gamma_value)
-      {
-	// Construct the anti-quark propagator from quark_prop_2
-	int G5 = Ns*Ns-1;
-	LatticePropagator anti_quark_prop =  Gamma(G5) * quark_prop_2 * Gamma(G5);
-
-	return LatticeComplex(trace(adj(anti_quark_prop) * (Gamma(gamma_value) *
-							    quark_prop_1 * Gamma(gamma_value))));
-      }
-
-
       //-------------------- callback functions ---------------------------------------
 
       //! Construct pion correlator
@@ -150,6 +137,10 @@ namespace Chroma
 
       std::list< Handle<Hadron2PtContract_t> > hadron;   // holds the contract lattice correlator
 
+      // All the gammas in one sweep over the sites
+      multi1d<LatticeComplex> corrs;
+      mesonCorrsDiagGamma(corrs, quark_prop1, quark_prop2);
+
       for(int gamma_value=0; gamma_value < Ns*Ns; ++gamma_value)
       {
 	Handle<Hadron2PtContract_t> had(new Hadron2PtContract_t);
@@ -160,7 +151,7 @@ namespace Chroma
 	write(had->xml, "PropHeaders", forward_headers);
 	pop(had->xml);
 
-	had->corr = mesXCorr(quark_prop1, quark_prop2, gamma_value);
+	had->corr = corrs[gamma_value];
 
 	hadron.push_back(had);  // push onto end of list
       }
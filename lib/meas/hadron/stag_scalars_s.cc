@@ -16,6 +16,7 @@
 #include "meas/hadron/stag_propShift_s.h"
 #include "meas/hadron/stag_scalars_s.h"
 #include "util/gauge/stag_phases_s.h"
+#include "util/ft/sftmom.h"
 
 namespace Chroma {
 
@@ -104,12 +105,12 @@ namespace Chroma {
     // resize output array appropriately
     corr_fn.resize(NUM_STAG_PIONS, latt_size[Nd-1]);
 
-    // Correlation functions before spatial sum
-    LatticeComplex corr_fn_s;
+    // Correlation functions before spatial sum. All of them are
+    // summed over the time slices in one pass at the end.
+    multi1d<LatticeComplex> latt_corrs(NUM_STAG_PIONS);
 
-    // Machinery to do timeslice sums with 
-    Set timeslice;
-    timeslice.make(TimeSliceFunc(Nd-1));
+    // The local trace is shared by the zero-link correlators
+    LatticeComplex local_trace = trace(adj(quark_props[0])*quark_props[0]);
 
     // Phases
     //multi1d<LatticeInteger> alpha(Nd); // KS Phases
@@ -125,10 +126,8 @@ namespace Chroma {
 
     // Taste singlet scalar (connected correlator)
     //  1x1
-    corr_fn_s = - StagPhases::alpha(1)*StagPhases::beta(0)*trace(adj(quark_props[0])*quark_props[0]);
+    latt_corrs[ sca_index ] = - StagPhases::alpha(1)*StagPhases::beta(0)*local_trace;
 
-    // Slice Sum
-    corr_fn[ sca_index ] = sumMulti(corr_fn_s, timeslice);
 
     sca_index++;
 
@@ -144,18 +143,16 @@ namespace Chroma {
       delta = 0;
       delta[mu] = 1;
       
-      corr_fn_s =  StagPhases::alpha(mu+1)*trace(shift_deltaProp(delta,quark_props[0])
+      latt_corrs[ sca_index ] =  StagPhases::alpha(mu+1)*trace(shift_deltaProp(delta,quark_props[0])
 				     *adj(quark_props[ deltaToPropIndex(delta) ]));
 
-      corr_fn[ sca_index ] = sumMulti(corr_fn_s, timeslice);
       sca_index++;
     }
     
     // zero link gamma3 operator
     // gamma3xgamma3
 
-    corr_fn_s = -  StagPhases::beta(0)*StagPhases::alpha(1)*StagPhases::alpha(3)*trace(adj(quark_props[0])*quark_props[0]);
-    corr_fn[ sca_index ] = sumMulti(corr_fn_s, timeslice);
+    latt_corrs[ sca_index ] = -  StagPhases::beta(0)*StagPhases::alpha(1)*StagPhases::alpha(3)*local_trace;
 
     sca_index++;
 
@@ -168,11 +165,10 @@ namespace Chroma {
 	delta[mu] = 1;
 	delta[nu] = 1;
 
-	corr_fn_s = StagPhases::beta(mu)* StagPhases::alpha(nu+1)
+	latt_corrs[ sca_index ] = StagPhases::beta(mu)* StagPhases::alpha(nu+1)
 	  *trace(adj(shift_deltaProp(delta,quark_props[0]))
 		 *quark_props[ deltaToPropIndex(delta) ]);
 
-	corr_fn[ sca_index ] = sumMulti(corr_fn_s, timeslice);
 	sca_index++;
       }
     }
@@ -183,12 +179,11 @@ namespace Chroma {
       delta = 0;
       delta[mu] = 1;
     
-      corr_fn_s = - StagPhases::beta(mu)*  StagPhases::beta(2)
+      latt_corrs[ sca_index ] = - StagPhases::beta(mu)*  StagPhases::beta(2)
 	*trace(adj(shift_deltaProp(delta,quark_props[0]))
 	       *quark_props[ deltaToPropIndex(delta) ]);
 
     
-      corr_fn[ sca_index ] = sumMulti(corr_fn_s, timeslice);
       sca_index++;
     }
 
@@ -205,11 +200,10 @@ namespace Chroma {
 	  delta[nu] = 1;
 	  delta[rho] = 1;
 
-	  corr_fn_s = - StagPhases::alpha(mu+1) * StagPhases::alpha(nu+1)* StagPhases::alpha(rho+1)
+	  latt_corrs[ sca_index ] = - StagPhases::alpha(mu+1) * StagPhases::alpha(nu+1)* StagPhases::alpha(rho+1)
 	    *trace(adj(shift_deltaProp(delta,quark_props[0]))
 		   *quark_props[ deltaToPropIndex(delta) ]);
 
-	  corr_fn[ sca_index ] = sumMulti(corr_fn_s, timeslice);
 	  sca_index++;
 	}
       }
@@ -225,11 +219,10 @@ namespace Chroma {
 	delta[mu] = 1;
 	delta[nu] = 1;
 
-	corr_fn_s =  StagPhases::beta(mu)* StagPhases::beta(nu)*  StagPhases::beta(2)
+	latt_corrs[ sca_index ] =  StagPhases::beta(mu)* StagPhases::beta(nu)*  StagPhases::beta(2)
           *trace(adj(shift_deltaProp(delta,quark_props[0]))
                  *quark_props[ deltaToPropIndex(delta) ]);
 
-	corr_fn[ sca_index ] = sumMulti(corr_fn_s, timeslice);
 	sca_index++;
       }
     }
@@ -240,13 +233,18 @@ namespace Chroma {
     delta = 0;
     delta[0] = delta[1] = delta[2] = 1;
 
-    corr_fn_s = StagPhases::beta(0)* StagPhases::beta(1)
+    latt_corrs[ sca_index ] = StagPhases::beta(0)* StagPhases::beta(1)
       *trace(adj(shift_deltaProp(delta, quark_props[0]))
 	     *quark_props[ deltaToPropIndex(delta) ] );
 
-    corr_fn[ sca_index ] = sumMulti(corr_fn_s, timeslice);
     sca_index++;
 
+    // Time slice sums of all the correlators
+    SftMom phases(0, false, Nd-1);
+    multi1d< multi2d<DComplex> > hsum = phases.sft(latt_corrs);
+    for(i=0; i < NUM_STAG_PIONS; i++)
+      corr_fn[i] = hsum[i][0];
+
     if( sca_index != NUM_STAG_PIONS) { 
       QDPIO::cerr << "Panic! Panic! Something has gone horribly wrong" << std::endl;
       QDP_abort(1);
@@ -7,6 +7,8 @@
 #define __abs_inline_measurement_h__
 
 #include "chromabase.h"
+#include <vector>
+#include <string>
 
 namespace Chroma 
 { 
@@ -24,6 +26,18 @@ namespace Chroma
     //! Do the measurement
     virtual void operator()(unsigned long update_no,
 			    XMLWriter& xml_out) = 0;
+
+    //! Declare the named objects the measurement reads and writes
+    /*!
+     * The InlineMeasurementRunner keeps these objects in memory while
+     * the measurement runs. Files may be declared as ids "file:<name>".
+     * Creating, modifying or erasing an object counts as writing it.
+     *
+     * \return false if the measurement does not declare its objects,
+     *         which is the default.
+     */
+    virtual bool namedObjectIds(std::vector<std::string>& read_ids,
+				std::vector<std::string>& write_ids) const {return false;}
   };
 
 } // End namespace
@@ -5,6 +5,7 @@
 #include "meas/inline/gfix/inline_coulgauge.h"
 #include "meas/inline/abs_inline_measurement_factory.h"
 #include "meas/gfix/coulgauge.h"
+#include "meas/gfix/fourier_gauge.h"
 #include "meas/glue/mesplq.h"
 #include "util/info/proginfo.h"
 #include "util/gauge/unit_check.h"
@@ -36,6 +37,20 @@ namespace Chroma
     read(paramtop, "GFMax", param.GFMax);
     read(paramtop, "OrDo", param.OrDo);
     read(paramtop, "OrPara", param.OrPara);
+
+    param.GFMethod = "RELAX";
+    if (paramtop.count("GFMethod") != 0)
+      read(paramtop, "GFMethod", param.GFMethod);
+
+    param.FAAlpha = 0.08;
+    if (paramtop.count("FAAlpha") != 0)
+      read(paramtop, "FAAlpha", param.FAAlpha);
+
+    if (param.GFMethod != "RELAX" && param.GFMethod != "FOURIER")
+    {
+      QDPIO::cerr << "Unknown GFMethod = " << param.GFMethod << std::endl;
+      QDP_abort(1);
+    }
   }
 
   //! Parameters for running code
@@ -50,6 +65,11 @@ namespace Chroma
     write(xml, "OrDo", param.OrDo);
     write(xml, "OrPara", param.OrPara);
     write(xml, "j_decay", param.j_decay);
+    if (param.GFMethod != "RELAX")
+    {
+      write(xml, "GFMethod", param.GFMethod);
+      write(xml, "FAAlpha", param.FAAlpha);
+    }
 
     pop(xml);
   }
@@ -194,8 +214,12 @@ namespace Chroma
       LatticeColorMatrix g;  // the gauge rotation fields
 
       int n_gf;
-      coulGauge(u_gfix, g, n_gf, params.param.j_decay, params.param.GFAccu, params.param.GFMax,
-		params.param.OrDo, params.param. OrPara);
+      if (params.param.GFMethod == "FOURIER")
+	fourierGauge(u_gfix, g, n_gf, params.param.j_decay, params.param.GFAccu, params.param.GFMax,
+		     params.param.FAAlpha);
+      else
+	coulGauge(u_gfix, g, n_gf, params.param.j_decay, params.param.GFAccu, params.param.GFMax,
+		  params.param.OrDo, params.param. OrPara);
     
       // Write out what is done
       push(xml_out,"Gauge_fixing_parameters");
@@ -34,6 +34,8 @@ namespace Chroma
 	bool OrDo;        /*!< use overrelaxation or not */
 	Real OrPara;      /*!< overrelaxation parameter */
 	int  j_decay;     /*!< direction perpendicular to slices to be gauge fixed */
+	std::string GFMethod;  /*!< RELAX (default) or FOURIER accelerated steepest descent */
+	Real FAAlpha;     /*!< step size of the FOURIER method */
       } param;
 
       struct NamedObject_t
@@ -50,6 +50,16 @@ namespace Chroma
 
       unsigned long getFrequency(void) const {return params.frequency;}
 
+      //! Reads only the gauge field
+      bool namedObjectIds(std::vector<std::string>& read_ids,
+			  std::vector<std::string>& write_ids) const
+      {
+	read_ids.push_back(params.named_obj.gauge_id);
+	if (params.xml_file != "")
+	  write_ids.push_back("file:" + params.xml_file);
+	return true;
+      }
+
       void operator()(unsigned long update_no,
 		      XMLWriter& xml_out); 
 
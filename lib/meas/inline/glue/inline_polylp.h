@@ -49,6 +49,14 @@ namespace Chroma
 
       unsigned long getFrequency(void) const {return params.frequency;}
 
+      //! Reads only the gauge field
+      bool namedObjectIds(std::vector<std::string>& read_ids,
+			  std::vector<std::string>& write_ids) const
+      {
+	read_ids.push_back(params.named_obj.gauge_id);
+	return true;
+      }
+
       void operator()(unsigned long update_no,
 		      XMLWriter& xml_out); 
 
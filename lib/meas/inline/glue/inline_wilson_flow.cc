@@ -51,6 +51,10 @@ namespace Chroma
       read(inputtop, "wtime", input.wtime);
       read(inputtop, "t_dir",input.t_dir);
 
+      // CLOVER or FIVE_LOOP
+      input.field_strength = "CLOVER";
+      if (inputtop.count("field_strength") != 0)
+	read(inputtop, "field_strength", input.field_strength);
     }
 
     //! write output
@@ -62,6 +66,7 @@ namespace Chroma
       write(xml, "nstep", input.nstep);
       write(xml, "wtime", input.wtime);
       write(xml, "t_dir",input.t_dir);
+      write(xml, "field_strength", input.field_strength);
 
       pop(xml);
     }
@@ -238,7 +243,16 @@ namespace Chroma
       multi1d<LatticeColorMatrix> wf_u = u ; 
       Real eps  = params.param.wtime/params.param.nstep ;
 
-      wilson_flow(xml_out, wf_u, params.param.nstep,eps ,params.param.t_dir) ;
+      FieldStrengthKernel::Definition fs_def = FieldStrengthKernel::CLOVER;
+      if (params.param.field_strength == "FIVE_LOOP")
+	fs_def = FieldStrengthKernel::FIVE_LOOP;
+      else if (params.param.field_strength != "CLOVER")
+      {
+	QDPIO::cerr << name << ": unknown field_strength = " << params.param.field_strength << std::endl;
+	QDP_abort(1);
+      }
+
+      wilson_flow(xml_out, wf_u, params.param.nstep,eps ,params.param.t_dir, fs_def) ;
 
 
       // Calculate some gauge invariant observables just for info.
@@ -35,6 +35,7 @@ namespace Chroma
 	int nstep ;
 	Real  wtime ;
 	int t_dir ; // the time direction of measurements 
+	std::string field_strength ; // CLOVER or FIVE_LOOP
       } param;
 
       struct NamedObject_t
@@ -573,7 +573,10 @@ namespace Chroma
       DispColorVectorMap smrd_disp_vecs(params.param.use_derivP,
 					params.param.displacement_length,
 					u_smr,
-					eigen_source);
+					eigen_source,
+					DispVectorCacheEnv::objectTag(params.named_obj.colorvec_id),
+					DispVectorCacheEnv::objectTag(params.named_obj.gauge_id) + ":" 
+					+ DispVectorCacheEnv::hashTag(params.param.link_smearing.xml));
 
       //
       // DB storage
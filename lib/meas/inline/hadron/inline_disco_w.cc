@@ -26,6 +26,7 @@
 #include "meas/inline/make_xml_file.h"
 #include "util/info/unique_id.h"
 #include "util/ferm/transf.h"
+#include "util/ferm/eigeninfo.h"
 #include "meas/inline/io/named_objmap.h"
 
 #include "util/ferm/key_val_db.h"
@@ -75,6 +76,9 @@ namespace Chroma{
 	  read(paramtop,"p2_max",param.p2_max);
 	  read(paramtop,"mass_label",param.mass_label);
 	  param.chi = readXMLArrayGroup(paramtop, "Quarks", "DilutionType");
+	  param.all_levels = false;
+	  if (paramtop.count("all_levels") != 0)
+	    read(paramtop,"all_levels",param.all_levels);
 	  
 	  break;
 	  
@@ -100,6 +104,7 @@ namespace Chroma{
       write(xml,"max_path_length",param.max_path_length);
       write(xml,"p2_max",param.p2_max);
       write(xml,"mass_label",param.mass_label);
+      write(xml,"all_levels",param.all_levels);
 
       push(xml,"Quarks");
       for( int t(0);t<param.chi.size();t++){
@@ -120,6 +125,12 @@ namespace Chroma{
       
       read(inputtop, "gauge_id", input.gauge_id);
       read(inputtop, "op_db_file", input.op_db_file);
+
+      // No eigenvectors turns off the exact low mode part
+      if (inputtop.count("evecs_id") != 0)
+	read(inputtop, "evecs_id", input.evecs_id);
+      else
+	input.evecs_id = "";
     }
     
     //! Gauge field parameters
@@ -128,6 +139,8 @@ namespace Chroma{
       
       write(xml, "gauge_id", input.gauge_id);
       write(xml, "op_db_file", input.op_db_file);
+      if (input.evecs_id != "")
+	write(xml, "evecs_id", input.evecs_id);
       pop(xml);
     }
     
@@ -135,6 +148,7 @@ namespace Chroma{
     // Param stuff
     Params::Params(){ 
       frequency = 0;
+      param.all_levels = false;
     }
     
     Params::Params(XMLReader& xml_in, const std::string& path) 
@@ -359,6 +373,67 @@ namespace Chroma{
       
     }// do_disco
 
+    //! Add w times the entries of src to db
+    void add_disco(std::map< KeyOperator_t, ValOperator_t >& db,
+		   const std::map< KeyOperator_t, ValOperator_t >& src,
+		   const Real& w){
+      Double wd = toDouble(w) ;
+      std::map< KeyOperator_t, ValOperator_t >::const_iterator it;
+      for(it=src.begin();it!=src.end();it++){
+	std::pair<KeyOperator_t, ValOperator_t> kv ;
+	kv.first = it->first ;
+	for(int i(0);i<it->second.op.size();i++)
+	  kv.second.op[i] = wd*it->second.op[i] ;
+
+	std::pair<std::map< KeyOperator_t, ValOperator_t >::iterator, bool> itbo;
+	itbo = db.insert(kv);
+	if( !itbo.second ){ // key already exists, so add result
+	  for(int i(0);i<kv.second.op.size();i++)
+	    itbo.first->second.op[i] += kv.second.op[i] ;
+	}
+      }
+    }
+
+    //! Write the operators to a data base
+    void write_disco_db(const std::string& db_file,
+			const std::map< KeyOperator_t, ValOperator_t >& data,
+			const Params& params,
+			XMLBufferWriter& gauge_xml,
+			int decay_dir){
+      // DB storage          
+      BinaryStoreDB<SerialDBKey<KeyOperator_t>,SerialDBData<ValOperator_t> > qdp_db;
+
+      // Open the file, and write the meta-data and the binary for this operator
+      {
+	XMLBufferWriter file_xml;
+
+	push(file_xml, "DBMetaData");
+	write(file_xml, "id", std::string("eigElemOp"));
+	write(file_xml, "lattSize", QDP::Layout::lattSize());
+	write(file_xml, "decay_dir", decay_dir);
+	write(file_xml, "Params", params.param);
+	write(file_xml, "Config_info", gauge_xml);
+	pop(file_xml);
+
+	std::string file_str(file_xml.str());
+	qdp_db.setMaxUserInfoLen(file_str.size());
+
+	qdp_db.open(db_file, O_RDWR | O_CREAT, 0664);
+
+	qdp_db.insertUserdata(file_str);
+      }
+
+      // Write the data
+      SerialDBKey <KeyOperator_t> key ;
+      SerialDBData<ValOperator_t> val ;
+      std::map< KeyOperator_t, ValOperator_t >::const_iterator it;
+      for(it=data.begin();it!=data.end();it++){
+	key.key()  = it->first  ;
+	val.data().op = it->second.op ;
+	qdp_db.insert(key,val) ;
+      }
+    }
+
 
   //--------------------------------------------------------------
   // Function call
@@ -536,7 +611,47 @@ namespace Chroma{
 	}
       }
 
-      std::map< KeyOperator_t, ValOperator_t > data ;
+      // Dilution levels: hierarchical schemes are refined level by level,
+      // all the quarks must have the same levels
+      int N_levels = quarks[0]->getNumLevels();
+      for(int n = 1 ; n < quarks.size(); ++n){
+	if(quarks[n]->getNumLevels() != N_levels){
+	  QDPIO::cerr<<name<< ": error, quark dilution levels do not match" <<std::endl;
+	  QDP_abort(1);
+	}
+      }
+
+      // The low modes of H = gamma_5 M, if any
+      multi1d<LatticeFermion> evecs ;
+      multi1d<LatticeFermion> g5evecs ;
+      multi1d<Real> evals ;
+      if(params.named_obj.evecs_id != ""){
+	try{
+	  const EigenInfo<LatticeFermion>& eigen = 
+	    TheNamedObjMap::Instance().getData< EigenInfo<LatticeFermion> >(params.named_obj.evecs_id);
+	  evecs = eigen.getEvectors();
+	  evals = eigen.getEvalues();
+	}
+	catch( std::bad_cast ){
+	  QDPIO::cerr << name << ": caught dynamic cast error reading evecs" << std::endl;
+	  QDP_abort(1);
+	}
+	catch (const std::string& e){
+	  QDPIO::cerr << name << ": std::map call failed: " << e << std::endl;
+	  QDP_abort(1);
+	}
+
+	g5evecs.resize(evecs.size());
+	for(int k(0);k<evecs.size();k++)
+	  g5evecs[k] = Gamma(Ns*Ns-1)*evecs[k];
+
+	QDPIO::cout<<name<<": exact contribution of "<<evecs.size()
+		   <<" low modes"<<std::endl ;
+      }
+
+      // The estimate of each level. Level lev gets the dilutions that are 
+      // part of it, so the solutions of coarse levels are used by all finer ones
+      multi1d< std::map< KeyOperator_t, ValOperator_t > > data(N_levels) ;
       
       for(int n(0);n<quarks.size();n++){
 	for (int it(0) ; it < quarks[n]->getNumTimeSlices() ; ++it){
@@ -544,13 +659,24 @@ namespace Chroma{
 	  QDPIO::cout<<" Doing quark: "<<n <<std::endl ;
 	  QDPIO::cout<<"   quark: "<<n <<" has "<<quarks[n]->getDilSize(it);
 	  QDPIO::cout<<" dilutions on time slice "<<t<<std::endl ;
+	  int lev = 0 ;
 	  for(int i = 0 ; i <  quarks[n]->getDilSize(it) ; ++i){
 	    QDPIO::cout<<"   Doing dilution : "<<i<<std::endl ;
+	    while(i >= quarks[n]->getLevelDilSize(it,lev))
+	      lev++ ;
 	    multi1d<short int> d ;
 	    LatticeFermion qbar  = quarks[n]->dilutedSource(it,i);
 	    LatticeFermion q     = quarks[n]->dilutedSolution(it,i);
+	    // Remove the low modes:  M^-1 = sum_k v_k (gamma_5 v_k)^dag / lambda_k + rest
+	    for(int k(0);k<evecs.size();k++){
+	      Complex ip = innerProduct(g5evecs[k],qbar) ;
+	      q -= (ip/evals[k])*evecs[k] ;
+	    }
 	    QDPIO::cout<<"   Starting recursion "<<std::endl ;
-	    do_disco(data, qbar, q, phases, t, d, params.param.max_path_length);
+	    std::map< KeyOperator_t, ValOperator_t > dil_data ;
+	    do_disco(dil_data, qbar, q, phases, t, d, params.param.max_path_length);
+	    for(int l(lev);l<N_levels;l++)
+	      add_disco(data[l], dil_data, quarks[n]->getLevelWeight(it,l));
 	    QDPIO::cout<<" done with recursion! "
 		       <<"  The length of the path is: "<<d.size()<<std::endl ;
 	  }
@@ -558,40 +684,31 @@ namespace Chroma{
 	}
       }
 
-      // DB storage          
-      BinaryStoreDB<SerialDBKey<KeyOperator_t>,SerialDBData<ValOperator_t> > qdp_db;
-
-      // Open the file, and write the meta-data and the binary for this operator
-      {
-	XMLBufferWriter file_xml;
-
-	push(file_xml, "DBMetaData");
-	write(file_xml, "id", std::string("eigElemOp"));
-	write(file_xml, "lattSize", QDP::Layout::lattSize());
-	write(file_xml, "decay_dir", decay_dir);
-	write(file_xml, "Params", params.param);
-	write(file_xml, "Config_info", gauge_xml);
-	pop(file_xml);
-
-	std::string file_str(file_xml.str());
-	qdp_db.setMaxUserInfoLen(file_str.size());
-
-	qdp_db.open(params.named_obj.op_db_file, O_RDWR | O_CREAT, 0664);
-
-	qdp_db.insertUserdata(file_str);
+      // The exact low mode part, on the time slices of the first quark
+      std::map< KeyOperator_t, ValOperator_t > low_data ;
+      for(int k(0);k<evecs.size();k++){
+	LatticeFermion v = evecs[k]/evals[k] ;
+	for (int it(0) ; it < quarks[0]->getNumTimeSlices() ; ++it){
+	  multi1d<short int> d ;
+	  int t = quarks[0]->getT0(it) ;
+	  QDPIO::cout<<"   Low mode "<<k<<" on time slice "<<t<<std::endl ;
+	  do_disco(low_data, g5evecs[k], v, phases, t, d, params.param.max_path_length);
+	}
       }
 
-      // Write the data
-      SerialDBKey <KeyOperator_t> key ;
-      SerialDBData<ValOperator_t> val ;
-      std::map< KeyOperator_t, ValOperator_t >::iterator it;
-      for(it=data.begin();it!=data.end();it++){
-	key.key()  = it->first  ;
-	val.data().op.resize(it->second.op.size()) ;
-	// normalize to number of quarks 
-	for(int i(0);i<it->second.op.size();i++)
-          val.data().op[i] = it->second.op[i]/toDouble(quarks.size());
-	qdp_db.insert(key,val) ;
+      // normalize to number of quarks, then add the low modes
+      for(int l(0);l<N_levels;l++){
+	std::map< KeyOperator_t, ValOperator_t > out ;
+	add_disco(out, data[l], Real(1)/Real(quarks.size()));
+	add_disco(out, low_data, Real(1));
+
+	if(l == N_levels-1)
+	  write_disco_db(params.named_obj.op_db_file, out, params, gauge_xml, decay_dir);
+	else if(params.param.all_levels){
+	  std::ostringstream file ;
+	  file<<params.named_obj.op_db_file<<".level"<<l ;
+	  write_disco_db(file.str(), out, params, gauge_xml, decay_dir);
+	}
       }
 
       // Close the namelist output file XMLDAT
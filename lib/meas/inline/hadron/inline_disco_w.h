@@ -37,12 +37,14 @@ namespace Chroma
 	int p2_max ; /*! maximum p2  */
 	multi1d<GroupXML_t> chi ;     /*! dilutions */
 	std::string mass_label ; /*! a std::string flag maybe used in analysis*/
+	bool all_levels ; /*! also write the estimate of every coarser dilution level */
       } param;
     
       struct NamedObject_t
       {
 	std::string         gauge_id;
 	std::string         op_db_file;
+	std::string         evecs_id;   /*! optional eigenpairs of gamma_5 M for the exact low modes */
       } named_obj;
       
       std::string xml_file;  // Alternate XML file pattern
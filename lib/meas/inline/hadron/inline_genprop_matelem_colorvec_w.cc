@@ -10,6 +10,7 @@
 #include "meas/smear/link_smearing_aggregate.h"
 #include "meas/smear/link_smearing_factory.h"
 #include "meas/smear/displace.h"
+#include "meas/smear/disp_vector_cache.h"
 #include "meas/glue/mesplq.h"
 #include "qdp_map_obj.h"
 #include "util/ferm/key_val_db.h"
@@ -192,6 +193,51 @@ namespace Chroma
 
 	return os;
       }
+
+
+      //! The source propagator vectors of one time source and spin
+      class DispPropSource : public DispVectorSource<LatticeFermion>
+      {
+      public:
+	DispPropSource(const QDP::MapObject<KeyPropColorVec_t,LatticeFermion>& ferm_map_,
+		       const multi1d<LatticeColorMatrix>& u_smr,
+		       int disp_length, int t_source_, int spin_src_, const std::string& prop_id)
+	  : ferm_map(ferm_map_), u(u_smr), displacement_length(disp_length), 
+	    t_source(t_source_), spin_src(spin_src_)
+	  {
+	    std::ostringstream os;
+	    os << "genprop:" << prop_id << ":" << displacement_length << ":" << t_source << ":" << spin_src;
+	    id = os.str();
+	  }
+
+	std::string getId() const {return id;}
+
+	LatticeFermion getVector(int vec) const
+	  {
+	    KeyPropColorVec_t key;
+	    key.t_source     = t_source;
+	    key.colorvec_src = vec;
+	    key.spin_src     = spin_src;
+		  
+	    LatticeFermion tmpvec; ferm_map.get(key, tmpvec);
+	    return tmpvec;
+	  }
+
+	LatticeFermion displace(const LatticeFermion& psi, int d) const
+	  {
+	    multi1d<int> path(1);
+	    path[0] = d;
+	    return Chroma::displace(u, psi, displacement_length, path);
+	  }
+
+      private:
+	const QDP::MapObject<KeyPropColorVec_t,LatticeFermion>& ferm_map;
+	const multi1d<LatticeColorMatrix>& u;
+	int displacement_length;
+	int t_source;
+	int spin_src;
+	std::string id;
+      };
     }
 
 
@@ -590,6 +636,17 @@ namespace Chroma
 	t_end   = phases.numSubsets() - 1;
       }
 
+      // With the shared cache on, the displaced source propagators are
+      // shared with other tasks on the same propagators and smeared gauge field
+      std::string disp_prop_id = DispVectorCacheEnv::objectTag(params.named_obj.source_prop_id) + ":" 
+	+ DispVectorCacheEnv::objectTag(params.named_obj.gauge_id) + ":" 
+	+ DispVectorCacheEnv::hashTag(params.param.link_smearing.xml);
+
+      // Otherwise they are displaced as needed
+      DispVectorCache<LatticeFermion> no_cache;
+      DispVectorCache<LatticeFermion>& disp_cache = (TheDispFermionCache::Instance().enabled()) 
+	? TheDispFermionCache::Instance() : no_cache;
+
       // Loop over each operator 
       for(int l=0; l < params.param.disp_gamma_list.size(); ++l)
       {
@@ -619,6 +676,9 @@ namespace Chroma
 	  {
 	    QDPIO::cout << "spin_r = " << spin_r << std::endl; 
 
+	    DispPropSource disp_src(source_ferm_map, u_smr, params.param.displacement_length, 
+				    t_source, spin_r, disp_prop_id);
+
 	    for(int spin_l=0; spin_l < Ns; ++spin_l)
 	    {
 	      QDPIO::cout << "spin_l = " << spin_l << std::endl; 
@@ -646,22 +706,9 @@ namespace Chroma
 
 	      for(int j = 0; j < params.param.num_vecs; ++j)
 	      {
-		KeyPropColorVec_t key_r;
-		key_r.t_source     = t_source;
-		key_r.colorvec_src = j;
-		key_r.spin_src     = spin_r;
-		  
 		// Displace the right std::vector and multiply by the momentum phase
-
-		LatticeFermion shift_ferm;
-		{
-		  LatticeFermion tmpvec; source_ferm_map.get(key_r, tmpvec);
-
-		  shift_ferm = Gamma(gamma_tmp) * displace(u_smr, 
-							   tmpvec,
-							   params.param.displacement_length, 
-							   disp);
-		}
+		LatticeFermion shift_ferm = 
+		  Gamma(gamma_tmp) * disp_cache.getDispVector(disp_src, j, disp);
 
 		for(int i = 0; i < params.param.num_vecs; ++i)
 		{
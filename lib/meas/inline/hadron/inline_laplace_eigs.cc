@@ -13,10 +13,13 @@
 #include "util/ferm/subset_vectors.h"
 #include "util/ferm/map_obj/map_obj_aggregate_w.h"
 #include "util/ferm/map_obj/map_obj_factory_w.h"
+#include "util/ferm/key_timeslice_colorvec.h"
+#include "util/ferm/timeslice_field.h"
 #include "util/ft/sftmom.h"
 #include "util/info/proginfo.h"
 #include "meas/inline/make_xml_file.h"
 #include "actions/boson/operator/klein_gord.h"
+#include "qdp_map_obj_disk.h"
 #include <qdp-lapack.h>
 
 #include "meas/inline/io/named_objmap.h"
@@ -36,6 +39,10 @@ namespace Chroma
 
       // User Specified MapObject tags
       input.colorvec_obj = readXMLGroup(inputtop, "ColorVecMapObject", "MapObjType");
+
+      // Optional time sliced copy on disk
+      if (inputtop.count("colorvec_file") > 0)
+	read(inputtop, "colorvec_file", input.colorvec_file);
     }
 
     //! Propagator output
@@ -46,6 +53,8 @@ namespace Chroma
       write(xml, "gauge_id", input.gauge_id);
       write(xml, "colorvec_id", input.colorvec_id);
       xml << input.colorvec_obj.xml;
+      if (input.colorvec_file != "")
+	write(xml, "colorvec_file", input.colorvec_file);
 
       pop(xml);
     }
@@ -770,6 +779,45 @@ namespace Chroma
 	color_vecs.insert(n, ev_pairs[n]);
       }
       color_vecs.flush();
+
+      // The time sliced copy, one record per time slice and vector as
+      // read by the distillation tasks
+      if (params.named_obj.colorvec_file != "")
+      {
+	const int decay_dir = params.param.decay_dir;
+	if (decay_dir != Nd-1)
+	{
+	  QDPIO::cerr << name << ": time sliced colorvec_file needs decay_dir = Nd-1" << std::endl;
+	  QDP_abort(1);
+	}
+
+	XMLBufferWriter file_xml;
+
+	push(file_xml, "MODMetaData");
+	write(file_xml, "id", std::string("eigenVecsTimeSlice"));
+	write(file_xml, "lattSize", QDP::Layout::lattSize());
+	write(file_xml, "decay_dir", decay_dir);
+	write(file_xml, "num_vecs", num_vecs);
+	proginfo(file_xml);    // Print out basic program info
+	write(file_xml, "Weights", getEigenValues(color_vecs, num_vecs));
+	pop(file_xml);
+
+	QDP::MapObjectDisk<KeyTimeSliceColorVec_t,TimeSliceColorVector> output_obj;
+
+	output_obj.insertUserdata(file_xml.str());
+	output_obj.open(params.named_obj.colorvec_file, std::ios_base::in | std::ios_base::out | std::ios_base::trunc);
+
+	for(int n=0; n < num_vecs; n++)
+	{
+	  for(int t=0; t < nt; t++)
+	  {
+	    KeyTimeSliceColorVec_t time_key(t, n);
+	    output_obj.insert(time_key, TimeSliceColorVector(ev_pairs[n].eigenVector, t, decay_dir));
+	  }
+	}
+
+	output_obj.flush();
+      }
       
       //pop(xml_out);
       
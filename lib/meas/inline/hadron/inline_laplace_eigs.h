@@ -43,6 +43,7 @@ namespace Chroma
 	std::string     gauge_id;      /*!< Gauge field */
 	std::string     colorvec_id;   /*!< Id for color vectors */
 	GroupXML_t      colorvec_obj;  /*!< Output colorvecs */
+	std::string     colorvec_file; /*!< Optional time sliced copy of the colorvecs on disk */
       };
 
       Param_t        param;      /*!< Parameters */
@@ -10,6 +10,7 @@
 #include "meas/smear/link_smearing_aggregate.h"
 #include "meas/smear/link_smearing_factory.h"
 #include "meas/smear/displace.h"
+#include "meas/smear/disp_colvec_map.h"
 #include "meas/glue/mesplq.h"
 #include "util/ferm/subset_vectors.h"
 #include "util/ferm/key_val_db.h"
@@ -550,6 +551,17 @@ namespace Chroma
       }
 
 
+      //
+      // The displaced color vectors, shared with the other tasks
+      //
+      DispColorVectorMap smrd_disp_vecs(false,
+					params.param.displacement_length,
+					u_smr,
+					eigen_source,
+					DispVectorCacheEnv::objectTag(params.named_obj.colorvec_id),
+					DispVectorCacheEnv::objectTag(params.named_obj.gauge_id) + ":" 
+					+ DispVectorCacheEnv::hashTag(params.param.link_smearing.xml));
+
       // Keep track of no displacements and zero momentum
       multi1d<int> no_displacement;
       multi1d<int> zero_mom(3); zero_mom = 0;
@@ -615,11 +627,11 @@ namespace Chroma
 	  for(int j = 0 ; j < params.param.num_vecs; ++j)
 	  {
 	    // Displace the right std::vector and multiply by the momentum phase
-	    EVPair<LatticeColorVector> tmpvec; eigen_source.get(j,tmpvec);
-	    LatticeColorVector shift_vec = phases[mom_num] * displace(u_smr, 
-								      tmpvec.eigenVector, 
-								      params.param.displacement_length, 
-								      disp);
+	    KeyDispColorVector_t key_disp;
+	    key_disp.colvec       = j;
+	    key_disp.displacement = disp;
+
+	    LatticeColorVector shift_vec = phases[mom_num] * smrd_disp_vecs.getDispVector(key_disp);
 
 	    for(int i = 0 ; i <  params.param.num_vecs; ++i)
 	    {
@@ -16,6 +16,7 @@
 #include "util/ferm/subset_vectors.h"
 #include "util/ferm/key_prop_distillation.h"
 #include "util/ferm/key_timeslice_colorvec.h"
+#include "util/ferm/timeslice_field.h"
 #include "util/ferm/key_prop_colorvec.h"
 #include "util/ferm/key_prop_matelem.h"
 #include "util/ferm/key_val_db.h"
@@ -175,10 +176,10 @@ namespace Chroma
     typedef QDP::MapObjectDisk<KeyTimeSliceColorVec_t, TimeSliceIO<LatticeColorVectorF> > MOD_t;
 
     // Convenience type
-    typedef QDP::MapObjectDiskMultiple<KeyTimeSliceColorVec_t, TimeSliceIO<LatticeColorVectorF> > MODS_t;
+    typedef QDP::MapObjectDiskMultiple<KeyTimeSliceColorVec_t, TimeSliceColorVectorF> MODS_t;
 
     // Convenience type
-    typedef QDP::MapObjectMemory<KeyTimeSliceColorVec_t, SubLatticeColorVectorF> SUB_MOD_t;
+    typedef QDP::MapObjectMemory<KeyTimeSliceColorVec_t, TimeSliceColorVectorF> SUB_MOD_t;
 
     // Anonymous namespace
     namespace
@@ -192,7 +193,7 @@ namespace Chroma
 	SubEigenMap(MODS_t& eigen_source_, int decay_dir) : eigen_source(eigen_source_), time_slice_set(decay_dir) {}
 
 	//! Getter
-	const SubLatticeColorVectorF& getVec(int t_source, int colorvec_src) const;
+	const TimeSliceColorVectorF& getVec(int t_source, int colorvec_src) const;
 
 	//! The set to be used in sumMulti
 	const Set& getSet() const {return time_slice_set.getSet();}
@@ -212,7 +213,7 @@ namespace Chroma
 
       //----------------------------------------------------------------------------
       //! Getter
-      const SubLatticeColorVectorF& SubEigenMap::getVec(int t_source, int colorvec_src) const
+      const TimeSliceColorVectorF& SubEigenMap::getVec(int t_source, int colorvec_src) const
       {
 	// The key
 	KeyTimeSliceColorVec_t src_key(t_source, colorvec_src);
@@ -221,12 +222,9 @@ namespace Chroma
 	{
 	  QDPIO::cout << __func__ << ": on t_source= " << t_source << "  colorvec_src= " << colorvec_src << std::endl;
 
-	  LatticeColorVectorF vec_srce = zero;
-
-	  TimeSliceIO<LatticeColorVectorF> time_slice_io(vec_srce, t_source);
-	  eigen_source.get(src_key, time_slice_io);
-
-	  SubLatticeColorVectorF tmp(getSet()[t_source], vec_srce);
+	  // Only the time slice is held
+	  TimeSliceColorVectorF tmp(t_source, time_slice_set.getDir());
+	  eigen_source.get(src_key, tmp);
 
 	  sub_eigen.insert(src_key, tmp);
 	}
@@ -657,7 +655,7 @@ namespace Chroma
 
 	      // Get the source std::vector
 	      LatticeColorVector vec_srce = zero;
-	      vec_srce = sub_eigen_map.getVec(t_source, colorvec_src);
+	      sub_eigen_map.getVec(t_source, colorvec_src).scatter(vec_srce);
 
 	      //
 	      // Loop over each spin source and invert. 
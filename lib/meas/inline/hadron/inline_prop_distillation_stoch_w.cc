@@ -12,6 +12,7 @@
 #include "qdp_map_obj_disk.h"
 #include "qdp_disk_map_slice.h"
 #include "util/ferm/key_prop_distillation.h"
+#include "util/ferm/distillution_noise.h"
 #include "util/ferm/transf.h"
 #include "util/ferm/spin_rep.h"
 #include "util/ferm/diractodr.h"
@@ -55,9 +56,21 @@ namespace Chroma
       XMLReader inputtop(xml, path);
 
       read(inputtop, "gauge_id", input.gauge_id);
-      read(inputtop, "src_file", input.src_file);
-      read(inputtop, "soln_file", input.soln_file);
       read(inputtop, "prop_file", input.prop_file);
+
+      // With a noise object the stochastic sources are regenerated, and
+      // the files are only needed for the traces of the distillation sources
+      input.distillution_id = "";
+      if (inputtop.count("distillution_id") != 0)
+	read(inputtop, "distillution_id", input.distillution_id);
+
+      input.src_file = "";
+      input.soln_file = "";
+      if (input.distillution_id == "" || inputtop.count("src_file") != 0)
+      {
+	read(inputtop, "src_file", input.src_file);
+	read(inputtop, "soln_file", input.soln_file);
+      }
     }
 
     //! Propagator output
@@ -69,6 +82,8 @@ namespace Chroma
       write(xml, "src_file", input.src_file);
       write(xml, "soln_file", input.soln_file);
       write(xml, "prop_file", input.prop_file);
+      if (input.distillution_id != "")
+	write(xml, "distillution_id", input.distillution_id);
 
       pop(xml);
     }
@@ -86,6 +101,10 @@ namespace Chroma
       read(inputtop, "Nt_backward", input.Nt_backward);
       read(inputtop, "mass_label", input.mass_label);
       read(inputtop, "spatial_mask_size", input.spatial_mask_size);
+
+      input.quark_line = 0;
+      if (inputtop.count("quark_line") != 0)
+	read(inputtop, "quark_line", input.quark_line);
     }
 
     //! Propagator output
@@ -100,6 +119,7 @@ namespace Chroma
       write(xml, "Nt_backward", input.Nt_backward);
       write(xml, "mass_label", input.mass_label);
       write(xml, "spatial_mask_size", input.spatial_mask_size);
+      write(xml, "quark_line", input.quark_line);
 
       pop(xml);
     }
@@ -591,25 +611,71 @@ namespace Chroma
       }
 
 
+      //
+      // The noise object, if the stochastic sources are regenerated.
+      // The noise is then keyed by (ensemble, sequence, quark_line) and
+      // counted by (t_source, dilution). It is both the source inverted and
+      // the one traced against, so a contraction can make it again from the
+      // metadata of the prop file instead of reading it. These propagators
+      // are not those of a src_file with modified sources.
+      //
+      const bool regen_noise = (params.named_obj.distillution_id != "");
+      Handle<DistillutionNoise> dist_noise;
+      DistQuarkLines_t quark_info;
+
+      if (regen_noise)
+      {
+	try
+	{
+	  dist_noise = TheNamedObjMap::Instance().getData< Handle<DistillutionNoise> >(params.named_obj.distillution_id);
+	}
+	catch( std::bad_cast ) 
+	{
+	  QDPIO::cerr << name << ": caught dynamic cast error" << std::endl;
+	  QDP_abort(1);
+	}
+	catch (const std::string& e) 
+	{
+	  QDPIO::cerr << name << ": std::map call failed: " << e << std::endl;
+	  QDP_abort(1);
+	}
+
+	quark_info.num_vecs   = params.param.contract.num_vecs;
+	quark_info.quark_line = params.param.contract.quark_line;
+	quark_info.annih      = false;
+	quark_info.mass       = params.param.contract.mass_label;
+
+	QDPIO::cout << name << ": regenerate the noise from ensemble= " << dist_noise->getEnsemble()
+		    << "  sequence= " << dist_noise->getSequence()
+		    << "  quark_line= " << quark_info.quark_line << std::endl;
+      }
+
+      // The files are only needed for the distillation sources
+      const bool use_src_file = (! regen_noise || params.named_obj.src_file != "");
+
+
       //
       // Map-object-disk storage of the source file
       //
       QDP::MapObjectDisk<KeyPropDistillation_t, TimeSliceIO<LatticeColorVectorF> > source_obj;
       source_obj.setDebug(0);
 
-      QDPIO::cout << "Open source file" << std::endl;
-
-      if (! source_obj.fileExists(params.named_obj.src_file))
-      {
-	QDPIO::cerr << name << ": source file does not exist: src_file= " << params.named_obj.src_file << std::endl;
-	QDP_abort(1);
-      }
-      else
+      if (use_src_file)
       {
-	source_obj.open(params.named_obj.src_file, std::ios_base::in);
-      }
+	QDPIO::cout << "Open source file" << std::endl;
+
+	if (! source_obj.fileExists(params.named_obj.src_file))
+	{
+	  QDPIO::cerr << name << ": source file does not exist: src_file= " << params.named_obj.src_file << std::endl;
+	  QDP_abort(1);
+	}
+	else
+	{
+	  source_obj.open(params.named_obj.src_file, std::ios_base::in);
+	}
 
-      QDPIO::cout << "Finished opening solution file" << std::endl;
+	QDPIO::cout << "Finished opening solution file" << std::endl;
+      }
 
 
       //
@@ -618,19 +684,22 @@ namespace Chroma
       QDP::MapObjectDisk<KeyPropDistillation_t, TimeSliceIO<LatticeColorVectorF> > soln_obj;
       soln_obj.setDebug(0);
 
-      QDPIO::cout << "Open solution file" << std::endl;
-
-      if (! soln_obj.fileExists(params.named_obj.soln_file))
+      if (use_src_file)
       {
-	QDPIO::cerr << name << ": soln file does not exist: soln_file= " << params.named_obj.soln_file << std::endl;
-	QDP_abort(1);
-      }
-      else
-      {
-	soln_obj.open(params.named_obj.soln_file, std::ios_base::in);
-      }
+	QDPIO::cout << "Open solution file" << std::endl;
+
+	if (! soln_obj.fileExists(params.named_obj.soln_file))
+	{
+	  QDPIO::cerr << name << ": soln file does not exist: soln_file= " << params.named_obj.soln_file << std::endl;
+	  QDP_abort(1);
+	}
+	else
+	{
+	  soln_obj.open(params.named_obj.soln_file, std::ios_base::in);
+	}
       
-      QDPIO::cout << "Finished opening solution file" << std::endl;
+	QDPIO::cout << "Finished opening solution file" << std::endl;
+      }
 
 
       //
@@ -653,6 +722,13 @@ namespace Chroma
 	write(file_xml, "Nt_backward", params.param.contract.Nt_backward);
 	write(file_xml, "Nt_backward", params.param.contract.Nt_backward);
 	write(file_xml, "mass_label", params.param.contract.mass_label);
+	if (regen_noise)
+	{
+	  // Enough to regenerate the noise downstream
+	  write(file_xml, "ensemble", dist_noise->getEnsemble());
+	  write(file_xml, "sequence", dist_noise->getSequence());
+	  write(file_xml, "quark_line", quark_info.quark_line);
+	}
 	proginfo(file_xml);    // Print out basic program info
 	write(file_xml, "Params", params.param);
 	write(file_xml, "Config_info", gauge_xml);
@@ -740,7 +816,7 @@ namespace Chroma
 	  QDPIO::cout << "t_source = " << t_source << std::endl; 
 
 #if 1
-	  if (1)
+	  if (use_src_file)
 	  {
 	    for(int colorvec_src = 0; colorvec_src < num_vecs; ++colorvec_src)
 	    {
@@ -769,8 +845,13 @@ namespace Chroma
 	    sniss1.start();
 	    QDPIO::cout << "colorvec_src = " << colorvec_src << std::endl; 
 
-	    // Get the source std::vector
-	    LatticeColorVector vec_srce = getSrc(source_obj, t_source, colorvec_src);
+	    // Get the source std::vector, the stochastic ones are numbered -1, -2, ...
+	    LatticeColorVector vec_srce;
+	    if (regen_noise && colorvec_src < 0)
+	      vec_srce = dist_noise->getSpatialNoise(quark_info, t_source, -colorvec_src-1,
+						     params.param.contract.spatial_mask_size);
+	    else
+	      vec_srce = getSrc(source_obj, t_source, colorvec_src);
 
 	    // Check
 	    if (1)
@@ -857,8 +938,8 @@ namespace Chroma
 	    //
 	    if (1)
 	    {
-	      // Get the source std::vector
-	      if (colorvec_src < 0)
+	      // Get the source std::vector. A regenerated noise is traced against itself
+	      if (colorvec_src < 0 && ! regen_noise)
 	      {
 		int orig_vec = (-colorvec_src) | (1 << 15);
 		vec_srce = getSrc(source_obj, t_source, -orig_vec);
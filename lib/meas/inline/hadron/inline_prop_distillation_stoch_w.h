@@ -40,6 +40,7 @@ namespace Chroma
 	  int           Nt_backward;        /*!< Time-slices in the backward direction */
 	  std::string   mass_label;         /*!< Some kind of mass label */
 	  multi1d<int>  spatial_mask_size;  /*!< Array of time slice sources for props */
+	  int           quark_line;         /*!< Quark line of the regenerated noise */
 	};
 
 	ChromaProp_t    prop;
@@ -52,6 +53,7 @@ namespace Chroma
 	std::string     src_file;           /*!< File output propagator sources */
 	std::string     soln_file;          /*!< File output propagator solutions */
 	std::string     prop_file;          /*!< File output propagator solutions */
+	std::string     distillution_id;    /*!< Optional noise object; regenerate the stochastic sources */
       };
 
       Param_t           param;
@@ -16,6 +16,7 @@
 #include "meas/inline/make_xml_file.h"
 
 #include "meas/inline/io/named_objmap.h"
+#include "actions/ferm/fermstates/stag_link_cache_s.h"
 
 namespace Chroma 
 { 
@@ -176,6 +177,11 @@ namespace Chroma
       const multi1d<LatticeColorMatrix>& u = 
 	TheNamedObjMap::Instance().getData< multi1d<LatticeColorMatrix> >(params.named_obj.gauge_id);
 
+      // Staggered links made on this gauge field may be reused
+      std::ostringstream link_tag;
+      link_tag << params.named_obj.gauge_id << ":" << TheNamedObjMap::Instance().serial(params.named_obj.gauge_id);
+      StagLinkCacheEnv::GaugeScope link_scope(link_tag.str());
+
       push(xml_out, "propagator_stag");
       write(xml_out, "update_no", update_no);
 
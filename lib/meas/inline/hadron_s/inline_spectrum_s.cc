@@ -22,6 +22,7 @@
 #include "actions/ferm/fermacts/fermacts_s.h"
 
 #include "meas/inline/io/named_objmap.h"
+#include "actions/ferm/fermstates/stag_link_cache_s.h"
 
 #include "util/ferm/transf.h"
 #include "meas/hadron/ks_local_loops.h"
@@ -1110,6 +1111,11 @@ namespace Chroma {
     const multi1d<LatticeColorMatrix>& u = 
       TheNamedObjMap::Instance().getData< multi1d<LatticeColorMatrix> >(params.named_obj.gauge_id);
 
+    // Staggered links made on this gauge field may be reused
+    std::ostringstream link_tag;
+    link_tag << params.named_obj.gauge_id << ":" << TheNamedObjMap::Instance().serial(params.named_obj.gauge_id);
+    StagLinkCacheEnv::GaugeScope link_scope(link_tag.str());
+
     QDPIO::cout << InlineStaggeredSpectrumEnv::name << ": Spectroscopy for Staggered-like fermions" 
 		<< std::endl;
     QDPIO::cout << "Gauge group: SU(" << Nc << ")" << std::endl;
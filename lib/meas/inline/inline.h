@@ -18,6 +18,7 @@
 #include "meas/inline/abs_inline_measurement.h"
 #include "meas/inline/abs_inline_measurement_factory.h"
 #include "meas/inline/inline_aggregate.h"
+#include "meas/inline/inline_measurement_runner.h"
 #include "meas/inline/glue/glue.h"
 #include "meas/inline/eig/eig.h"
 #include "meas/inline/hadron/hadron.h"
@@ -0,0 +1,84 @@
+/*! \file
+ * \brief Run a list of inline measurements in program order
+ */
+
+#include "chroma_config.h"
+#include "meas/inline/inline_measurement_runner.h"
+#include "meas/inline/io/named_objmap.h"
+#include "meas/smear/disp_vector_cache.h"
+#include "meas/smear/fused_smear_kernel.h"
+#include "util/info/region_profiler.h"
+#include <sstream>
+
+namespace Chroma
+{
+
+  // Run the given measurements
+  InlineMeasurementRunner::InlineMeasurementRunner(const multi1d< Handle<AbsInlineMeasurement> >& meas_,
+						   const multi1d<std::string>& names_) :
+    meas(meas_), names(names_)
+  {
+  }
+
+
+  // Pin or unpin the declared objects of measurement m
+  void InlineMeasurementRunner::pinIds(int m, bool pin)
+  {
+    std::vector<std::string> ids, write_ids;
+    if (! meas[m]->namedObjectIds(ids, write_ids))
+      return;
+
+    ids.insert(ids.end(), write_ids.begin(), write_ids.end());
+
+    NamedObjectMap& map = TheNamedObjMap::Instance();
+    for(int k=0; k < ids.size(); ++k)
+    {
+      if (pin)
+	map.pin(ids[k]);
+      else
+	map.unpin(ids[k]);
+    }
+  }
+
+
+  // Do all the measurements due at update_no
+  void InlineMeasurementRunner::operator()(unsigned long update_no, XMLWriter& xml_out)
+  {
+    START_CODE();
+
+    for(int m=0; m < meas.size(); ++m)
+    {
+      if (update_no % meas[m]->getFrequency() != 0)
+	continue;
+
+      TheNamedObjMap::Instance().beginEpoch();
+      pinIds(m, true);
+
+      {
+#ifdef BUILD_REGION_PROFILER
+	std::ostringstream name;
+	name << "inline[" << m << "]";
+	if (m < names.size())
+	  name << " " << names[m];
+
+	CHROMA_REGION(name.str());
+#endif
+
+	// Caller writes elem rule
+	push(xml_out, "elem");
+	(*meas[m])(update_no, xml_out);
+	pop(xml_out);
+      }
+
+      pinIds(m, false);
+      xml_out.flush();
+    }
+
+    // Nothing outlives the list
+    DispVectorCacheEnv::clear();
+    FusedSmearKernelEnv::clear();
+
+    END_CODE();
+  }
+
+} // End namespace
@@ -0,0 +1,60 @@
+// -*- C++ -*-
+/*! \file
+ * \brief Run a list of inline measurements in program order
+ */
+
+#ifndef __inline_measurement_runner_h__
+#define __inline_measurement_runner_h__
+
+#include "chromabase.h"
+#include "handle.h"
+#include "meas/inline/abs_inline_measurement.h"
+#include <vector>
+#include <string>
+
+namespace Chroma
+{
+
+  //! Run a list of inline measurements
+  /*! \ingroup inline
+   *
+   * Measurements run one after the other on the main thread, in program
+   * order. QIO, map object disk I/O and the compute measurements all do
+   * collective communications on the same communicator, so none of them
+   * may run concurrently with another.
+   *
+   * Each measurement starts a new epoch of the named object map, and the
+   * objects it declares (see AbsInlineMeasurement::namedObjectIds) are
+   * pinned while it runs, so they are not spilled before it gets to
+   * them. The shared displaced vector caches are cleared at the end of
+   * the list.
+   */
+  class InlineMeasurementRunner
+  {
+  public:
+    //! Run the given measurements
+    /*!
+     * \param meas_   the measurements ( Read )
+     * \param names_  their names, for the region profiler; may be empty ( Read )
+     */
+    InlineMeasurementRunner(const multi1d< Handle<AbsInlineMeasurement> >& meas_,
+			    const multi1d<std::string>& names_ = multi1d<std::string>());
+
+    //! Destructor
+    ~InlineMeasurementRunner() {}
+
+    //! Do all the measurements due at update_no
+    /*! Each writes an "elem" group to xml_out */
+    void operator()(unsigned long update_no, XMLWriter& xml_out);
+
+  private:
+    //! Pin or unpin the declared objects of measurement m
+    void pinIds(int m, bool pin);
+
+    multi1d< Handle<AbsInlineMeasurement> > meas;
+    multi1d<std::string> names;
+  };
+
+} // End namespace
+
+#endif
@@ -52,6 +52,16 @@ namespace Chroma
 
       unsigned long getFrequency(void) const {return params.frequency;}
 
+      //! Reads the files, creates the object
+      bool namedObjectIds(std::vector<std::string>& read_ids,
+			  std::vector<std::string>& write_ids) const
+      {
+	for(int i=0; i < params.file.file_names.size(); ++i)
+	  read_ids.push_back("file:" + params.file.file_names[i]);
+	write_ids.push_back(params.named_obj.object_id);
+	return true;
+      }
+
       //! Do the writing
       void operator()(const unsigned long update_no,
 		      XMLWriter& xml_out); 
@@ -45,6 +45,14 @@ namespace Chroma
 
       unsigned long getFrequency(void) const {return params.frequency;}
 
+      //! Erasing the object counts as writing it
+      bool namedObjectIds(std::vector<std::string>& read_ids,
+			  std::vector<std::string>& write_ids) const
+      {
+	write_ids.push_back(params.named_obj.object_id);
+	return true;
+      }
+
       //! Do the writing
       void operator()(const unsigned long update_no,
 		      XMLWriter& xml_out); 
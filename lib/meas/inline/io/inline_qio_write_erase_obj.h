@@ -30,6 +30,15 @@ namespace Chroma
 
       unsigned long getFrequency(void) const {return params.frequency;}
 
+      //! Writes the file and erases the object
+      bool namedObjectIds(std::vector<std::string>& read_ids,
+			  std::vector<std::string>& write_ids) const
+      {
+	write_ids.push_back(params.named_obj.object_id);
+	write_ids.push_back("file:" + params.file.file_name);
+	return true;
+      }
+
       //! Do the writing
       void operator()(const unsigned long update_no,
 		      XMLWriter& xml_out); 
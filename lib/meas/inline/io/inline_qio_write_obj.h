@@ -53,6 +53,15 @@ namespace Chroma
 
       unsigned long getFrequency(void) const {return params.frequency;}
 
+      //! Reads the object, writes the file
+      bool namedObjectIds(std::vector<std::string>& read_ids,
+			  std::vector<std::string>& write_ids) const
+      {
+	read_ids.push_back(params.named_obj.object_id);
+	write_ids.push_back("file:" + params.file.file_name);
+	return true;
+      }
+
       //! Do the writing
       void operator()(const unsigned long update_no,
 		      XMLWriter& xml_out); 
@@ -6,6 +6,7 @@
 #include "meas/smear/disp_colvec_map.h"
 #include "meas/smear/displacement.h"
 #include "meas/smear/displace.h"
+#include <limits>
 
 namespace Chroma 
 { 
@@ -24,97 +25,86 @@ namespace Chroma
   }
 
 
-  // Constructor from smeared std::map 
-  DispColorVectorMap::DispColorVectorMap(bool use_derivP_,
-					 int disp_length,
-					 const multi1d<LatticeColorMatrix>& u_smr,
-					 const MapObject<int,EVPair<LatticeColorVector> >& eigen_vec)
-    : use_derivP(use_derivP_), displacement_length(disp_length), u(u_smr), eigen_source(eigen_vec)
+  // Constructor
+  DispColorVectorSource::DispColorVectorSource(bool use_derivP_,
+					       int disp_length,
+					       const multi1d<LatticeColorMatrix>& u_smr,
+					       const MapObject<int,EVPair<LatticeColorVector> >& eigen_vec,
+					       const std::string& vec_tag,
+					       const std::string& gauge_tag)
+    : eigen_source(eigen_vec), u(u_smr), use_derivP(use_derivP_), displacement_length(disp_length)
   {
+    std::ostringstream os;
+    os << "colorvec:" << vec_tag << ":" << gauge_tag
+       << ":" << use_derivP << ":" << displacement_length;
+    id = os.str();
   }
 
 
-  //! Accessor
-  const LatticeColorVector
-  DispColorVectorMap::getDispVector(const KeyDispColorVector_t& key)
+  // The undisplaced vector
+  LatticeColorVector DispColorVectorSource::getVector(int vec) const
   {
-    //Check if any displacement is needed
-    if (displacement_length == 0) 
-    {
-      EVPair<LatticeColorVector> tmpvec; 
-      eigen_source.get(key.colvec, tmpvec);
-      return tmpvec.eigenVector;
-    }
-    else
-    {
-      return displaceObject(key);
-    }
+    EVPair<LatticeColorVector> tmpvec; 
+    eigen_source.get(vec, tmpvec);
+    return tmpvec.eigenVector;
   }
 
 
-  //! Accessor
-  const LatticeColorVector&
-  DispColorVectorMap::displaceObject(const KeyDispColorVector_t& key)
+  // One displacement
+  LatticeColorVector DispColorVectorSource::displace(const LatticeColorVector& psi, int d) const
   {
-    // If no entry, then create a displaced version of the quark
-    if (disp_src_map.find(key) == disp_src_map.end())
+    LatticeColorVector disp_q = psi;
+
+    if (d > 0)
     {
-      // Insert an empty entry and then modify it. This saves on
-      // copying the data around
+      int disp_dir = d - 1;
+      int disp_len = displacement_length;
+      if (use_derivP)
+	disp_q = rightNabla(disp_q, u, disp_dir, disp_len);
+      else
+	displacement(u, disp_q, disp_len, disp_dir);
+    }
+    else if (d < 0)
+    {
+      if (use_derivP)
       {
-	ValDispColorVector_t disp_empty;
-
-	disp_src_map.insert(std::make_pair(key, disp_empty));
-
-	// Sanity check - the entry better be there
-	if (disp_src_map.find(key) == disp_src_map.end())
-	{
-	  QDPIO::cerr << __func__ 
-		      << ": internal error - could not insert empty key in std::map"
-		      << std::endl;
-	  QDP_abort(1);
-	}		      
+	QDPIO::cerr << __func__ << ": do not support (rather do not want to support) negative displacements for rightNabla\n";
+	QDP_abort(1);
       }
 
-      // Modify the previous empty entry
-      ValDispColorVector_t& disp_q = disp_src_map.find(key)->second;
-      {
-	EVPair<LatticeColorVector> tmpvec; 
-	eigen_source.get(key.colvec, tmpvec);
-	disp_q.vec = tmpvec.eigenVector;
-      }
+      int disp_dir = -d - 1;
+      int disp_len = -displacement_length;
+      displacement(u, disp_q, disp_len, disp_dir);
+    }
 
-      for(int i=0; i < key.displacement.size(); ++i)
-      {
-	if (key.displacement[i] > 0)
-	{
-	  int disp_dir = key.displacement[i] - 1;
-	  int disp_len = displacement_length;
-	  if (use_derivP)
-	    disp_q.vec = rightNabla(disp_q.vec, u, disp_dir, disp_len);
-	  else
-	    displacement(u, disp_q.vec, disp_len, disp_dir);
-	}
-	else if (key.displacement[i] < 0)
-	{
-	  if (use_derivP)
-	  {
-	    QDPIO::cerr << __func__ << ": do not support (rather do not want to support) negative displacements for rightNabla\n";
-	    QDP_abort(1);
-	  }
-
-	  int disp_dir = -key.displacement[i] - 1;
-	  int disp_len = -displacement_length;
-	  displacement(u, disp_q.vec, disp_len, disp_dir);
-	}
-      }
+    return disp_q;
+  }
+
+
+  // Constructor from smeared std::map 
+  DispColorVectorMap::DispColorVectorMap(bool use_derivP,
+					 int disp_length,
+					 const multi1d<LatticeColorMatrix>& u_smr,
+					 const MapObject<int,EVPair<LatticeColorVector> >& eigen_vec,
+					 const std::string& vec_tag,
+					 const std::string& gauge_tag)
+    : src(use_derivP, disp_length, u_smr, eigen_vec, vec_tag, gauge_tag),
+      local(std::numeric_limits<size_t>::max()),
+      cache((vec_tag != "" && gauge_tag != "" && TheDispColorVectorCache::Instance().enabled()) 
+	    ? TheDispColorVectorCache::Instance() : local)
+  {
+  }
 
-    } // if find in std::map
 
-    // The key now must exist in the std::map, so return the std::vector
-    ValDispColorVector_t& disp_q = disp_src_map.find(key)->second;
+  //! Accessor
+  const LatticeColorVector
+  DispColorVectorMap::getDispVector(const KeyDispColorVector_t& key)
+  {
+    //Check if any displacement is needed
+    if (src.getDisplacementLength() == 0) 
+      return src.getVector(key.colvec);
 
-    return disp_q.vec;
+    return cache.getDispVector(src, key.colvec, key.displacement);
   }
 
   /*! @} */  // end of group smear
@@ -8,6 +8,7 @@
 
 #include "chromabase.h"
 #include "util/ferm/subset_ev_pair.h"
+#include "meas/smear/disp_vector_cache.h"
 #include "qdp_map_obj.h"
 #include <map>
 
@@ -38,16 +39,64 @@ namespace Chroma
   };
 
 
+  //----------------------------------------------------------------------------
+  //! Color vectors displaced by a gauge field
+  class DispColorVectorSource : public DispVectorSource<LatticeColorVector>
+  {
+  public:
+    //! Constructor
+    /*! The tags identify the vectors and the smeared gauge field */
+    DispColorVectorSource(bool use_derivP, 
+			  int disp_length,
+			  const multi1d<LatticeColorMatrix>& u_smr,
+			  const QDP::MapObject<int,EVPair<LatticeColorVector> >& eigen_source,
+			  const std::string& vec_tag,
+			  const std::string& gauge_tag);
+
+    //! Identifies the vectors, the gauge field and the kind of displacement
+    std::string getId() const {return id;}
+
+    //! The undisplaced vector
+    LatticeColorVector getVector(int vec) const;
+
+    //! One displacement
+    LatticeColorVector displace(const LatticeColorVector& psi, int d) const;
+
+    //! Displacement length
+    int getDisplacementLength() const {return displacement_length;}
+
+  private:
+    const QDP::MapObject<int,EVPair<LatticeColorVector> >& eigen_source;
+    const multi1d<LatticeColorMatrix>& u;
+    bool use_derivP;
+    int displacement_length;
+    std::string id;
+  };
+
+
   //----------------------------------------------------------------------------
   //! The displaced objects
+  /*!
+   * With the shared cache on and both tags given, the displaced vectors
+   * are held in the shared cache, so other tasks with the same vectors
+   * and smeared gauge field reuse them. Otherwise they are held by the
+   * map and dropped with it.
+   */
   class DispColorVectorMap
   {
   public:
     //! Constructor for displaced std::map 
+    /*!
+     * The vec_tag identifies the vectors and the gauge_tag the smeared
+     * gauge field, see DispVectorCacheEnv::objectTag. Without them
+     * nothing is shared with other maps.
+     */
     DispColorVectorMap(bool use_derivP, 
 		       int disp_length,
 		       const multi1d<LatticeColorMatrix>& u_smr,
-		       const QDP::MapObject<int,EVPair<LatticeColorVector> >& eigen_source);
+		       const QDP::MapObject<int,EVPair<LatticeColorVector> >& eigen_source,
+		       const std::string& vec_tag = "",
+		       const std::string& gauge_tag = "");
 
     //! Destructor
     ~DispColorVectorMap() {}
@@ -55,25 +104,15 @@ namespace Chroma
     //! Accessor
     const LatticeColorVector getDispVector(const KeyDispColorVector_t& key);
 
-  protected:
-    //! Displace an object
-    const LatticeColorVector& displaceObject(const KeyDispColorVector_t& key);
-			
   private:
-    //! Lattice color vectors
-    const QDP::MapObject<int,EVPair<LatticeColorVector> >& eigen_source;
+    //! Lattice color vectors and their displacement
+    DispColorVectorSource src;
 
-    //! Gauge field 
-    const multi1d<LatticeColorMatrix>& u;
-			
-    //! Displacements or derivatives?
-    int use_derivP;
-			
-    //! Displacement length
-    int displacement_length;
-			
-    //! Maps of displaced color vectors 
-    std::map<KeyDispColorVector_t, ValDispColorVector_t> disp_src_map;
+    //! The vectors of this map, if not shared
+    DispVectorCache<LatticeColorVector> local;
+
+    //! Where the vectors are held
+    DispVectorCache<LatticeColorVector>& cache;
   };
 
   /*! @} */  // end of group smear
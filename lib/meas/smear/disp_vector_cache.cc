@@ -0,0 +1,55 @@
+/*! \file
+ * \brief Bounded shared cache of displaced vectors
+ */
+
+#include "meas/smear/disp_vector_cache.h"
+#include "meas/inline/io/named_objmap.h"
+#include "util/ferm/crc48.h"
+#include <iomanip>
+
+namespace Chroma
+{
+  namespace DispVectorCacheEnv
+  {
+    // Short hash of a long tag
+    std::string hashTag(const std::string& tag)
+    {
+      CRC48::CRC48_t crc;
+      CRC48::initCRC48(crc);
+      CRC48::calcCRC48(crc, tag.c_str(), tag.length());
+
+      std::ostringstream os;
+      os << std::hex << std::setfill('0');
+      for(int i=0; i < 6; ++i)
+	os << std::setw(2) << ((unsigned int)(crc.crc[i]) & 0xff);
+
+      return os.str();
+    }
+
+
+    // Tag of a named object
+    std::string objectTag(const std::string& id)
+    {
+      std::ostringstream os;
+      os << id << "#" << TheNamedObjMap::Instance().serial(id);
+      return os.str();
+    }
+
+
+    // Bound of the bytes held by each shared cache on this node
+    void setMaxBytes(size_t max_bytes)
+    {
+      TheDispColorVectorCache::Instance().setMaxBytes(max_bytes);
+      TheDispFermionCache::Instance().setMaxBytes(max_bytes);
+    }
+
+
+    // Drop the vectors of the shared caches
+    void clear()
+    {
+      TheDispColorVectorCache::Instance().clear();
+      TheDispFermionCache::Instance().clear();
+    }
+  }
+
+} // namespace Chroma
@@ -0,0 +1,236 @@
+// -*- C++ -*-
+/*! \file
+ * \brief Bounded shared cache of displaced vectors
+ */
+
+#ifndef __disp_vector_cache_h__
+#define __disp_vector_cache_h__
+
+#include "chromabase.h"
+#include "singleton.h"
+#include "named_obj.h"
+#include <map>
+#include <list>
+#include <vector>
+
+namespace Chroma
+{
+  /*!
+   * \ingroup smear
+   *
+   * @{
+   */
+  //----------------------------------------------------------------------------
+  //! Where the vectors of a displacement cache come from
+  template<typename T>
+  class DispVectorSource
+  {
+  public:
+    //! Virtual destructor
+    virtual ~DispVectorSource() {}
+
+    //! Identifies the vectors, the gauge field and the kind of displacement
+    /*! Sources with the same id share the cached vectors */
+    virtual std::string getId() const = 0;
+
+    //! The undisplaced vector
+    virtual T getVector(int vec) const = 0;
+
+    //! One displacement d, plus/minus 1-based direction
+    virtual T displace(const T& psi, int d) const = 0;
+  };
+
+
+  //----------------------------------------------------------------------------
+  //! Bounded cache of displaced vectors keyed by (source id, vector, path)
+  /*!
+   * A path is applied in order, so a vector displaced along a path is the
+   * last displacement of the vector displaced along the path without its
+   * last entry. Missing prefixes are made and cached on the way, and
+   * the paths of an operator basis share most of them.
+   *
+   * When the vectors held exceed the byte bound, the least recently used
+   * are dropped. A bound of 0 holds nothing, every lookup displaces the
+   * vector. Vectors are returned by value, so a dropped entry is never
+   * referenced.
+   *
+   * The shared caches below let the tasks of one measurement list reuse
+   * each other's vectors. They are off unless given a bound, and are
+   * cleared at the end of the list. Ids must then identify the vectors
+   * and the gauge field, see DispVectorCacheEnv::objectTag.
+   */
+  template<typename T>
+  class DispVectorCache
+  {
+  public:
+    //! Empty cache, holding at most max_bytes_ on this node
+    DispVectorCache(size_t max_bytes_ = 0) : bytes(0), max_bytes(max_bytes_), hits(0), misses(0) {}
+
+    //! Destructor
+    ~DispVectorCache() {}
+
+    //! The displaced vector
+    T getDispVector(const DispVectorSource<T>& src, int vec, const multi1d<int>& path)
+    {
+      std::vector<int> p(path.size());
+      for(int i=0; i < path.size(); ++i)
+	p[i] = path[i];
+
+      return displaceObject(src, src.getId(), vec, p);
+    }
+
+    //! Bound of the bytes held on this node
+    void setMaxBytes(size_t max_bytes_)
+    {
+      max_bytes = max_bytes_;
+      evict();
+    }
+
+    //! Bound of the bytes held on this node
+    size_t getMaxBytes() const {return max_bytes;}
+
+    //! Does the cache hold anything
+    bool enabled() const {return max_bytes > 0;}
+
+    //! Bytes held on this node
+    size_t getBytes() const {return bytes;}
+
+    //! Lookups found in the cache
+    unsigned long getHits() const {return hits;}
+
+    //! Lookups that displaced a vector
+    unsigned long getMisses() const {return misses;}
+
+    //! Drop everything
+    void clear()
+    {
+      entries.clear();
+      lru.clear();
+      bytes = 0;
+    }
+
+  private:
+    //! Key of a displaced vector
+    struct Key_t
+    {
+      std::string       id;
+      int               vec;
+      std::vector<int>  path;
+
+      bool operator<(const Key_t& b) const
+      {
+	if (vec != b.vec)
+	  return vec < b.vec;
+	if (path != b.path)
+	  return path < b.path;
+	return id < b.id;
+      }
+    };
+
+    //! A cached vector and its place in the use order
+    struct Entry_t
+    {
+      T                                  vec;
+      typename std::list<Key_t>::iterator  use;
+    };
+
+    typedef typename std::map<Key_t, Entry_t>::iterator Iter_t;
+
+    //! Find or make a displaced vector
+    T displaceObject(const DispVectorSource<T>& src, const std::string& id, int vec,
+		     const std::vector<int>& path)
+    {
+      // The vectors themselves are held by the source
+      if (path.size() == 0)
+	return src.getVector(vec);
+
+      Key_t key;
+      key.id   = id;
+      key.vec  = vec;
+      key.path = path;
+
+      Iter_t it = entries.find(key);
+      if (it != entries.end())
+      {
+	++hits;
+	lru.splice(lru.end(), lru, it->second.use);
+	return it->second.vec;
+      }
+
+      ++misses;
+
+      // Displace the prefix by the last entry
+      std::vector<int> prefix(path.begin(), path.end()-1);
+      T disp_q = src.displace(displaceObject(src, id, vec, prefix), path.back());
+
+      if (max_bytes == 0)
+	return disp_q;
+
+      // Insert an empty entry and then modify it, saves copying
+      it = entries.insert(std::make_pair(key, Entry_t())).first;
+      it->second.vec = disp_q;
+      it->second.use = lru.insert(lru.end(), key);
+      bytes += NamedObjectStorage<T>::bytes(disp_q);
+
+      evict();
+
+      return disp_q;
+    }
+
+    //! Drop the least recently used vectors until within the bound
+    void evict()
+    {
+      while(bytes > max_bytes && ! lru.empty())
+      {
+	Iter_t it = entries.find(lru.front());
+	bytes -= NamedObjectStorage<T>::bytes(it->second.vec);
+	entries.erase(it);
+	lru.pop_front();
+      }
+    }
+
+    std::map<Key_t, Entry_t>  entries;
+    std::list<Key_t>          lru;       /*!< least recently used first */
+    size_t                    bytes;
+    size_t                    max_bytes;
+    unsigned long             hits;
+    unsigned long             misses;
+  };
+
+
+  //----------------------------------------------------------------------------
+  //! The displaced color vectors of a run
+  typedef SingletonHolder<DispVectorCache<LatticeColorVector>,
+			  QDP::CreateUsingNew,
+			  QDP::NoDestroy,
+			  QDP::SingleThreaded> TheDispColorVectorCache;
+
+  //! The displaced fermions of a run
+  typedef SingletonHolder<DispVectorCache<LatticeFermion>,
+			  QDP::CreateUsingNew,
+			  QDP::NoDestroy,
+			  QDP::SingleThreaded> TheDispFermionCache;
+
+
+  //----------------------------------------------------------------------------
+  //! Support for the ids of displacement sources
+  namespace DispVectorCacheEnv
+  {
+    //! Short hash of a long tag, e.g. a record xml
+    std::string hashTag(const std::string& tag);
+
+    //! Tag of a named object, changes when it is erased and created again
+    std::string objectTag(const std::string& id);
+
+    //! Bound of the bytes held by each shared cache on this node, 0 for off
+    void setMaxBytes(size_t max_bytes);
+
+    //! Drop the vectors of the shared caches
+    void clear();
+  }
+
+  /*! @} */  // end of group smear
+
+} // namespace Chroma
+
+#endif
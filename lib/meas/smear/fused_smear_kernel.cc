@@ -0,0 +1,625 @@
+/*! \file
+ *  \brief Fused quark smearing iterations with a deep halo
+ */
+
+#include "chromabase.h"
+#include "handle.h"
+#include "meas/smear/fused_smear_kernel.h"
+#include <cstring>
+
+namespace Chroma
+{
+
+  //! Site kernels and halo exchange of the fused smearing
+  namespace FusedSmearKernelEnv
+  {
+#ifndef QDP_IS_QDPJIT
+    //! Anonymous namespace
+    namespace
+    {
+      //! Distance in color of the components a link multiplies
+      /*! 1 for vectors, Nc for the columns of a color matrix */
+      inline int colorStride(const LatticeColorVector&)          {return 1;}
+      inline int colorStride(const LatticeFermion&)              {return 1;}
+      inline int colorStride(const LatticeStaggeredPropagator&)  {return Nc;}
+      inline int colorStride(const LatticePropagator&)           {return Nc;}
+
+
+      //! Fill the halo of an extended field, one direction after the other
+      /*!
+       * Each exchange sends the full extent of the other directions, so
+       * the halo received in an earlier direction is passed on and fills
+       * the corners.
+       */
+      template<typename S>
+      void exchange(multi1d<S>& f,
+		    const multi1d<int>& comm_dim,
+		    const multi1d< multi1d<int> >& send_lo,
+		    const multi1d< multi1d<int> >& send_hi,
+		    const multi1d< multi1d<int> >& recv_lo,
+		    const multi1d< multi1d<int> >& recv_hi)
+      {
+#if defined(ARCH_PARSCALAR)
+	for(int e=0; e < comm_dim.size(); ++e)
+	{
+	  const int mu = comm_dim[e];
+	  const int n  = send_lo[e].size();
+	  const int nbytes = n*sizeof(S);
+
+	  multi1d<S> buf_send_lo(n), buf_send_hi(n), buf_recv_lo(n), buf_recv_hi(n);
+	  for(int i=0; i < n; ++i)
+	  {
+	    std::memcpy(&(buf_send_lo[i]), &(f[send_lo[e][i]]), sizeof(S));
+	    std::memcpy(&(buf_send_hi[i]), &(f[send_hi[e][i]]), sizeof(S));
+	  }
+
+	  // Same declaration order as SiteHaloField, so that with two
+	  // nodes in a direction the messages cannot be mismatched
+	  QMP_msgmem_t msg[4];
+	  QMP_msghandle_t mh_a[4];
+
+	  msg[0] = QMP_declare_msgmem(buf_recv_hi.slice(), nbytes);
+	  mh_a[0] = QMP_declare_receive_relative(msg[0], mu, +1, 0);
+	  msg[1] = QMP_declare_msgmem(buf_send_lo.slice(), nbytes);
+	  mh_a[1] = QMP_declare_send_relative(msg[1], mu, -1, 0);
+	  msg[2] = QMP_declare_msgmem(buf_recv_lo.slice(), nbytes);
+	  mh_a[2] = QMP_declare_receive_relative(msg[2], mu, -1, 0);
+	  msg[3] = QMP_declare_msgmem(buf_send_hi.slice(), nbytes);
+	  mh_a[3] = QMP_declare_send_relative(msg[3], mu, +1, 0);
+
+	  for(int i=0; i < 4; ++i)
+	    if (mh_a[i] == (QMP_msghandle_t)NULL)
+	      QDP_error_exit("FusedSmearKernel: QMP_declare_relative failed");
+
+	  QMP_msghandle_t mh = QMP_declare_multiple(mh_a, 4);
+	  if (mh == (QMP_msghandle_t)NULL)
+	    QDP_error_exit("FusedSmearKernel: QMP_declare_multiple failed");
+
+	  QMP_status_t err;
+	  if ((err = QMP_start(mh)) != QMP_SUCCESS)
+	    QDP_error_exit(QMP_error_string(err));
+	  if ((err = QMP_wait(mh)) != QMP_SUCCESS)
+	    QDP_error_exit(QMP_error_string(err));
+
+	  QMP_free_msghandle(mh);
+	  for(int i=0; i < 4; ++i)
+	    QMP_free_msgmem(msg[i]);
+
+	  for(int i=0; i < n; ++i)
+	  {
+	    std::memcpy(&(f[recv_lo[e][i]]), &(buf_recv_lo[i]), sizeof(S));
+	    std::memcpy(&(f[recv_hi[e][i]]), &(buf_recv_hi[i]), sizeof(S));
+	  }
+	}
+#endif
+      }
+
+
+      //! res += s * U v  on every color column of a site
+      /*!
+       * The site holds nouter blocks of Nc x stride complex numbers, the
+       * color index the link multiplies having stride stride.
+       */
+      template<typename R>
+      inline
+      void addMatVecs(R* res, const R* u, const R* v, R s, int nouter, int stride)
+      {
+	const int block = 2*Nc*stride;
+	for(int o=0; o < nouter; ++o)
+	{
+	  R* ro = res + o*block;
+	  const R* vo = v + o*block;
+	  for(int j=0; j < stride; ++j)
+	  {
+	    for(int i=0; i < Nc; ++i)
+	    {
+	      R re = 0;
+	      R im = 0;
+	      for(int k=0; k < Nc; ++k)
+	      {
+		const R* uik = u + 2*(Nc*i + k);
+		const R* vk  = vo + 2*(stride*k + j);
+		re += uik[0]*vk[0] - uik[1]*vk[1];
+		im += uik[0]*vk[1] + uik[1]*vk[0];
+	      }
+	      ro[2*(stride*i + j)]   += s*re;
+	      ro[2*(stride*i + j)+1] += s*im;
+	    }
+	  }
+	}
+      }
+
+
+      template<typename R>
+      struct IterArgs
+      {
+	R*              out;          // the new field
+	const R*        in;           // the old field
+	const R*        in0;          // the starting field, 0 if c = 0
+	const int*      sites;
+	int             site_words;
+	int             nouter;
+	int             stride;
+	int             ndirs;
+	int             n_ext;
+	const int*      fwd;
+	const int*      bwd;
+	const R* const* u;            // U_mu(x) per direction
+	const R* const* u_back;       // U^dag_mu(x-mu) per direction
+	int             link_words;
+	R               a;
+	R               b;
+	R               c;
+      };
+
+
+      //! One iteration  out = a in + b H in + c in0  on a list of sites
+      template<typename R>
+      inline
+      void iterSiteLoop(int lo, int hi, int my_id, IterArgs<R>* arg)
+      {
+	const int nw = arg->site_words;
+
+	for(int j=lo; j < hi; ++j)
+	{
+	  const int x = arg->sites[j];
+	  R* res = arg->out + x*nw;
+	  const R* v = arg->in + x*nw;
+
+	  if (arg->in0)
+	  {
+	    const R* v0 = arg->in0 + x*nw;
+	    for(int w=0; w < nw; ++w)
+	      res[w] = arg->a*v[w] + arg->c*v0[w];
+	  }
+	  else
+	  {
+	    for(int w=0; w < nw; ++w)
+	      res[w] = arg->a*v[w];
+	  }
+
+	  for(int d=0; d < arg->ndirs; ++d)
+	  {
+	    const int xf = arg->fwd[d*arg->n_ext + x];
+	    const int xb = arg->bwd[d*arg->n_ext + x];
+
+	    addMatVecs(res, arg->u[d] + x*arg->link_words, arg->in + xf*nw,
+		       arg->b, arg->nouter, arg->stride);
+	    addMatVecs(res, arg->u_back[d] + x*arg->link_words, arg->in + xb*nw,
+		       arg->b, arg->nouter, arg->stride);
+	  }
+	}
+      }
+
+
+      //! Sites of the sub-lattice grown by l in the split directions
+      double grownVolume(const multi1d<int>& sub_size, const multi1d<bool>& split, int l)
+      {
+	double v = 1;
+	for(int mu=0; mu < Nd; ++mu)
+	  v *= sub_size[mu] + (split[mu] ? 2*l : 0);
+	return v;
+      }
+
+
+      //! The kept kernel
+      Handle<FusedSmearKernel>  kept;
+
+    } // anonymous namespace
+
+
+    // Iterations per halo exchange with the lowest modelled cost per iteration
+    /*
+     * A sweep of k iterations costs the site updates of the shrinking
+     * regions, sum_{l<k} V(l), plus one exchange per split direction and
+     * the V(k) - V(0) halo sites it moves, V(l) being the sub-lattice
+     * grown by l. The exchange costs are rough estimates in units of one
+     * site update: deep halos only pay off when the messages are
+     * expensive compared with the local work, i.e. at strong scaling.
+     */
+    int chooseDepth(const multi1d<int>& sub_size, const multi1d<bool>& split)
+    {
+      const double message_cost   = 200;   // one exchange in one direction
+      const double halo_site_cost = 0.5;   // packing and moving one halo site
+
+      int n_split = 0;
+      int max_depth = 0;
+      for(int mu=0; mu < Nd; ++mu)
+	if (split[mu])
+	{
+	  if (n_split == 0 || sub_size[mu] < max_depth)
+	    max_depth = sub_size[mu];
+	  ++n_split;
+	}
+
+      if (n_split == 0)
+	return 1;
+
+      const double v0 = grownVolume(sub_size, split, 0);
+
+      int best_k = 1;
+      double best_cost = 0;
+      double work = 0;
+      for(int k=1; k <= max_depth; ++k)
+      {
+	work += grownVolume(sub_size, split, k-1);
+	double halo = grownVolume(sub_size, split, k) - v0;
+	double cost = (work + n_split*message_cost + halo*halo_site_cost) / k;
+
+	if (k == 1 || cost < best_cost)
+	{
+	  best_k = k;
+	  best_cost = cost;
+	}
+      }
+
+      return best_k;
+    }
+
+
+    // The kernel for a gauge field, set up again only if the field changed
+    const FusedSmearKernel& getKernel(const multi1d<LatticeColorMatrix>& u, int j_decay, int halo_depth)
+    {
+      if (kept.operator->() == 0 || ! kept->sameSetup(u, j_decay, halo_depth))
+      {
+	kept = 0;
+	kept = new FusedSmearKernel(u, j_decay, halo_depth);
+      }
+
+      return *kept;
+    }
+#endif
+
+
+    // Drop the kept kernel
+    void clear()
+    {
+#ifndef QDP_IS_QDPJIT
+      kept = 0;
+#endif
+    }
+
+  } // namespace FusedSmearKernelEnv
+
+
+#ifndef QDP_IS_QDPJIT
+
+
+  // Set up the halo geometry and the links with their halo
+  FusedSmearKernel::FusedSmearKernel(const multi1d<LatticeColorMatrix>& u, int j_decay, int halo_depth)
+  {
+    START_CODE();
+
+    const multi1d<int>& sub_size   = Layout::subgridLattSize();
+    const multi1d<int>& node_size  = Layout::logicalSize();
+    const multi1d<int>& node_coord = Layout::nodeCoord();
+    const int me = Layout::nodeNumber();
+    const int nsites = Layout::sitesOnNode();
+
+    // The smeared directions, and the depth the sub-lattice allows
+    int nd = 0;
+    for(int mu=0; mu < Nd; ++mu)
+      if (mu != j_decay)
+	++nd;
+
+    dirs.resize(nd);
+    nd = 0;
+    for(int mu=0; mu < Nd; ++mu)
+      if (mu != j_decay)
+	dirs[nd++] = mu;
+
+    decay_dir = j_decay;
+    req_depth = halo_depth;
+
+    multi1d<bool> split(Nd);
+    comms = false;
+    for(int mu=0; mu < Nd; ++mu)
+    {
+      split[mu] = (mu != j_decay && node_size[mu] > 1);
+      if (split[mu])
+	comms = true;
+    }
+
+    depth = (halo_depth > 0) ? halo_depth : FusedSmearKernelEnv::chooseDepth(sub_size, split);
+    for(int mu=0; mu < Nd; ++mu)
+      if (split[mu] && sub_size[mu] < depth)
+	depth = sub_size[mu];
+
+    multi1d<int> pad(Nd);
+    multi1d<int> ext_size(Nd);
+    n_ext = 1;
+    for(int mu=0; mu < Nd; ++mu)
+    {
+      pad[mu] = (mu != j_decay && node_size[mu] > 1) ? depth : 0;
+      ext_size[mu] = sub_size[mu] + 2*pad[mu];
+      n_ext *= ext_size[mu];
+    }
+
+    // Extended coordinates of every extended index, mu = 0 fastest
+    multi2d<int> ec(n_ext, Nd);
+    multi1d<int> level(n_ext);
+    for(int e=0; e < n_ext; ++e)
+    {
+      int r = e;
+      level[e] = 0;
+      for(int mu=0; mu < Nd; ++mu)
+      {
+	ec(e,mu) = r % ext_size[mu];
+	r /= ext_size[mu];
+
+	int l = 0;
+	if (ec(e,mu) < pad[mu])
+	  l = pad[mu] - ec(e,mu);
+	else if (ec(e,mu) >= pad[mu] + sub_size[mu])
+	  l = ec(e,mu) - pad[mu] - sub_size[mu] + 1;
+	if (l > level[e])
+	  level[e] = l;
+      }
+    }
+
+    // Where the sites of this node sit in the extended field
+    ext_site.resize(nsites);
+    for(int site=0; site < nsites; ++site)
+    {
+      multi1d<int> x = Layout::siteCoords(me, site);
+      int e = 0;
+      for(int mu=Nd-1; mu >= 0; --mu)
+	e = e*ext_size[mu] + (x[mu] - node_coord[mu]*sub_size[mu] + pad[mu]);
+      ext_site[site] = e;
+    }
+
+    // Neighbors. Directions on one node wrap around.
+    fwd.resize(dirs.size()*n_ext);
+    bwd.resize(dirs.size()*n_ext);
+    for(int d=0; d < dirs.size(); ++d)
+    {
+      int mu = dirs[d];
+      int step = 1;
+      for(int nu=0; nu < mu; ++nu)
+	step *= ext_size[nu];
+
+      for(int e=0; e < n_ext; ++e)
+      {
+	int c = ec(e,mu);
+	int cf = c + 1;
+	int cb = c - 1;
+	if (pad[mu] == 0)
+	{
+	  cf = cf % ext_size[mu];
+	  cb = (cb + ext_size[mu]) % ext_size[mu];
+	}
+
+	fwd[d*n_ext + e] = (cf < ext_size[mu]) ? e + (cf - c)*step : -1;
+	bwd[d*n_ext + e] = (cb >= 0) ? e + (cb - c)*step : -1;
+      }
+    }
+
+    // The sites updated by each iteration of a sweep
+    int max_level = comms ? depth : 0;
+    upto.resize(max_level+1);
+    for(int l=0; l <= max_level; ++l)
+    {
+      int n = 0;
+      for(int e=0; e < n_ext; ++e)
+	if (level[e] <= l)
+	  ++n;
+
+      upto[l].resize(n);
+      n = 0;
+      for(int e=0; e < n_ext; ++e)
+	if (level[e] <= l)
+	  upto[l][n++] = e;
+    }
+
+    // The layers exchanged, in extended index order on every node
+    int n_comm = 0;
+    for(int mu=0; mu < Nd; ++mu)
+      if (pad[mu] > 0)
+	++n_comm;
+
+    comm_dim.resize(n_comm);
+    send_lo.resize(n_comm);
+    send_hi.resize(n_comm);
+    recv_lo.resize(n_comm);
+    recv_hi.resize(n_comm);
+
+    n_comm = 0;
+    for(int mu=0; mu < Nd; ++mu)
+    {
+      if (pad[mu] == 0)
+	continue;
+
+      const int p = pad[mu];
+      const int s = sub_size[mu];
+      const int n = n_ext / ext_size[mu] * p;
+
+      comm_dim[n_comm] = mu;
+      send_lo[n_comm].resize(n);
+      send_hi[n_comm].resize(n);
+      recv_lo[n_comm].resize(n);
+      recv_hi[n_comm].resize(n);
+
+      int i_sl = 0, i_sh = 0, i_rl = 0, i_rh = 0;
+      for(int e=0; e < n_ext; ++e)
+      {
+	int c = ec(e,mu);
+	if (c < p)
+	  recv_lo[n_comm][i_rl++] = e;
+	if (c >= p && c < 2*p)
+	  send_lo[n_comm][i_sl++] = e;
+	if (c >= s && c < s + p)
+	  send_hi[n_comm][i_sh++] = e;
+	if (c >= s + p)
+	  recv_hi[n_comm][i_rh++] = e;
+      }
+
+      ++n_comm;
+    }
+
+    // The links and the backward links with their halo
+    u_ext.resize(dirs.size());
+    u_back_ext.resize(dirs.size());
+    for(int d=0; d < dirs.size(); ++d)
+    {
+      int mu = dirs[d];
+      LatticeColorMatrix u_back = shift(adj(u[mu]), BACKWARD, mu);
+
+      u_ext[d].resize(n_ext);
+      u_back_ext[d].resize(n_ext);
+      for(int site=0; site < nsites; ++site)
+      {
+	u_ext[d][ext_site[site]] = u[mu].elem(site);
+	u_back_ext[d][ext_site[site]] = u_back.elem(site);
+      }
+
+      FusedSmearKernelEnv::exchange(u_ext[d], comm_dim, send_lo, send_hi, recv_lo, recv_hi);
+      FusedSmearKernelEnv::exchange(u_back_ext[d], comm_dim, send_lo, send_hi, recv_lo, recv_hi);
+    }
+
+    END_CODE();
+  }
+
+
+  // Was the kernel set up with exactly these arguments
+  bool FusedSmearKernel::sameSetup(const multi1d<LatticeColorMatrix>& u, int j_decay, int halo_depth) const
+  {
+    if (j_decay != decay_dir || halo_depth != req_depth)
+      return false;
+
+    const int nsites = Layout::sitesOnNode();
+
+    double differ = 0;
+    for(int d=0; d < dirs.size() && differ == 0; ++d)
+      for(int site=0; site < nsites; ++site)
+	if (std::memcmp(&(u[dirs[d]].elem(site)), &(u_ext[d][ext_site[site]]), sizeof(Link_t)) != 0)
+	{
+	  differ = 1;
+	  break;
+	}
+
+    QDPInternal::globalSumArray(&differ, 1);
+    return differ == 0;
+  }
+
+
+  // The iterations on any of the field types
+  template<typename T>
+  void FusedSmearKernel::apply(T& chi, const Real& a, const Real& b, const Real& c, int iter) const
+  {
+    START_CODE();
+
+    typedef typename T::Subtype_t         Site_t;
+    typedef typename WordType<T>::Type_t  R;
+
+    if (iter <= 0)
+      return;
+
+    const int nsites = Layout::sitesOnNode();
+    const int site_words = sizeof(Site_t) / sizeof(R);
+    const int stride = FusedSmearKernelEnv::colorStride(chi);
+    const bool with_start = toBool(c != Real(0));
+
+    // The two work fields and the starting field, with the halo
+    multi1d<Site_t> f0(n_ext), f1(n_ext), start;
+    for(int site=0; site < nsites; ++site)
+      f0[ext_site[site]] = chi.elem(site);
+
+    FusedSmearKernelEnv::exchange(f0, comm_dim, send_lo, send_hi, recv_lo, recv_hi);
+    if (with_start)
+    {
+      start.resize(n_ext);
+      start = f0;
+    }
+
+    multi1d<const R*> u_p(dirs.size()), u_back_p(dirs.size());
+    for(int d=0; d < dirs.size(); ++d)
+    {
+      u_p[d] = reinterpret_cast<const R*>(u_ext[d].slice());
+      u_back_p[d] = reinterpret_cast<const R*>(u_back_ext[d].slice());
+    }
+
+    multi1d<Site_t>* cur = &f0;
+    multi1d<Site_t>* nxt = &f1;
+
+    int done = 0;
+    while (done < iter)
+    {
+      // Iterations until the halo is used up
+      int n = iter - done;
+      if (comms && n > depth)
+	n = depth;
+
+      if (done > 0)
+	FusedSmearKernelEnv::exchange(*cur, comm_dim, send_lo, send_hi, recv_lo, recv_hi);
+
+      for(int i=1; i <= n; ++i)
+      {
+	const multi1d<int>& sites = comms ? upto[n-i] : upto[0];
+
+	FusedSmearKernelEnv::IterArgs<R> arg;
+	arg.out        = reinterpret_cast<R*>(nxt->slice());
+	arg.in         = reinterpret_cast<const R*>(cur->slice());
+	arg.in0        = with_start ? reinterpret_cast<const R*>(start.slice()) : 0;
+	arg.sites      = sites.slice();
+	arg.site_words = site_words;
+	arg.nouter     = site_words / (2*Nc*stride);
+	arg.stride     = stride;
+	arg.ndirs      = dirs.size();
+	arg.n_ext      = n_ext;
+	arg.fwd        = fwd.slice();
+	arg.bwd        = bwd.slice();
+	arg.u          = u_p.slice();
+	arg.u_back     = u_back_p.slice();
+	arg.link_words = sizeof(Link_t) / sizeof(R);
+	arg.a          = toDouble(a);
+	arg.b          = toDouble(b);
+	arg.c          = toDouble(c);
+
+	dispatch_to_threads(sites.size(), arg, FusedSmearKernelEnv::iterSiteLoop<R>);
+
+	multi1d<Site_t>* tmp = cur;
+	cur = nxt;
+	nxt = tmp;
+      }
+
+      done += n;
+    }
+
+    for(int site=0; site < nsites; ++site)
+      chi.elem(site) = (*cur)[ext_site[site]];
+
+    END_CODE();
+  }
+
+
+  // The iterations on a color vector
+  void FusedSmearKernel::operator()(LatticeColorVector& chi,
+				    const Real& a, const Real& b, const Real& c, int iter) const
+  {
+    apply(chi, a, b, c, iter);
+  }
+
+  // The iterations on a fermion
+  void FusedSmearKernel::operator()(LatticeFermion& chi,
+				    const Real& a, const Real& b, const Real& c, int iter) const
+  {
+    apply(chi, a, b, c, iter);
+  }
+
+  // The iterations on a staggered propagator
+  void FusedSmearKernel::operator()(LatticeStaggeredPropagator& chi,
+				    const Real& a, const Real& b, const Real& c, int iter) const
+  {
+    apply(chi, a, b, c, iter);
+  }
+
+  // The iterations on a propagator
+  void FusedSmearKernel::operator()(LatticePropagator& chi,
+				    const Real& a, const Real& b, const Real& c, int iter) const
+  {
+    apply(chi, a, b, c, iter);
+  }
+
+#endif
+
+}  // end namespace Chroma
@@ -0,0 +1,147 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Fused quark smearing iterations with a deep halo
+ */
+
+#ifndef __fused_smear_kernel_h__
+#define __fused_smear_kernel_h__
+
+#include "chromabase.h"
+
+namespace Chroma
+{
+
+  //! Fused quark smearing iterations with a deep halo
+  /*!
+   * \ingroup smear
+   *
+   * Does n iterations of
+   *
+   *   chi <- a chi + b H chi + c chi_0
+   *
+   *   H chi(x) = sum_{mu != j_decay} [ U_mu(x) chi(x+mu) + U^dag_mu(x-mu) chi(x-mu) ]
+   *
+   * with chi_0 the starting field. Jacobi smearing is a = 0, b = kappa,
+   * c = 1 and Gaussian smearing a = 1 + 2 d w, b = -w, c = 0, where d
+   * is the number of smeared directions and w = -width^2/(4n).
+   *
+   * The node's sites are held with a halo of depth k in every smeared
+   * direction that is split over nodes, corners included. One exchange
+   * then serves k iterations: iteration i updates the sites up to k-i
+   * away from the node's sub-lattice, so the halo does not need to be
+   * refreshed in between. Directions on a single node wrap around and
+   * need no halo; without any split direction all the iterations run
+   * without communication.
+   *
+   * A deeper halo means fewer messages but more sites updated twice on
+   * neighboring nodes and longer messages. Unless asked for a depth, the
+   * kernel takes the one with the lowest modelled cost per iteration for
+   * the local extents, see FusedSmearKernelEnv::chooseDepth.
+   *
+   * All the spin and color columns of a site are updated together, so a
+   * propagator is smeared in one pass instead of twelve, and the two
+   * work fields are allocated once per call instead of per iteration.
+   *
+   * The kernel is not built under QDP-JIT, where the smearing keeps its
+   * shift based iterations.
+   */
+  class FusedSmearKernel
+  {
+  public:
+    //! Set up the halo geometry and the links with their halo
+    /*!
+     * \param u           gauge field ( Read )
+     * \param j_decay     direction not smeared, none if >= Nd ( Read )
+     * \param halo_depth  iterations per halo exchange, chosen if <= 0 ( Read )
+     */
+    FusedSmearKernel(const multi1d<LatticeColorMatrix>& u, int j_decay, int halo_depth = 0);
+
+    //! Number of smeared directions
+    int numDirs() const {return dirs.size();}
+
+    //! Iterations per halo exchange
+    int haloDepth() const {return depth;}
+
+    //! Was the kernel set up with exactly these arguments
+    /*! The links are compared bit for bit on every node */
+    bool sameSetup(const multi1d<LatticeColorMatrix>& u, int j_decay, int halo_depth) const;
+
+    //! The iterations on a color vector
+    /*!
+     * \param chi   field to smear ( Modify )
+     * \param a     coefficient of chi ( Read )
+     * \param b     coefficient of H chi ( Read )
+     * \param c     coefficient of the starting field ( Read )
+     * \param iter  number of iterations ( Read )
+     */
+    void operator()(LatticeColorVector& chi,
+		    const Real& a, const Real& b, const Real& c, int iter) const;
+
+    //! The iterations on a fermion
+    void operator()(LatticeFermion& chi,
+		    const Real& a, const Real& b, const Real& c, int iter) const;
+
+    //! The iterations on a staggered propagator
+    void operator()(LatticeStaggeredPropagator& chi,
+		    const Real& a, const Real& b, const Real& c, int iter) const;
+
+    //! The iterations on a propagator
+    void operator()(LatticePropagator& chi,
+		    const Real& a, const Real& b, const Real& c, int iter) const;
+
+  private:
+    //! The iterations on any of the field types
+    template<typename T>
+    void apply(T& chi, const Real& a, const Real& b, const Real& c, int iter) const;
+
+    typedef LatticeColorMatrix::Subtype_t  Link_t;
+
+    int                       decay_dir;   /*!< direction not smeared */
+    int                       req_depth;   /*!< halo depth asked for */
+    int                       depth;       /*!< halo depth, iterations per exchange */
+    bool                      comms;       /*!< is any smeared direction split over nodes */
+    multi1d<int>              dirs;        /*!< the smeared directions */
+    int                       n_ext;       /*!< sites with the halo */
+    multi1d<int>              ext_site;    /*!< extended index of each site of the node */
+    multi1d<int>              fwd;         /*!< extended index of x+mu, -1 outside */
+    multi1d<int>              bwd;         /*!< extended index of x-mu, -1 outside */
+    multi1d< multi1d<int> >   upto;        /*!< extended sites up to l away from the node */
+    multi1d< multi1d<int> >   send_lo;     /*!< lowest layers sent to the node at -mu */
+    multi1d< multi1d<int> >   send_hi;     /*!< highest layers sent to the node at +mu */
+    multi1d< multi1d<int> >   recv_lo;     /*!< halo filled from the node at -mu */
+    multi1d< multi1d<int> >   recv_hi;     /*!< halo filled from the node at +mu */
+    multi1d<int>              comm_dim;    /*!< direction of each exchange */
+    multi1d< multi1d<Link_t> >  u_ext;       /*!< U_mu(x) with the halo */
+    multi1d< multi1d<Link_t> >  u_back_ext;  /*!< U^dag_mu(x-mu) with the halo */
+  };
+
+
+  //! Fused smearing kernel support
+  /*! \ingroup smear */
+  namespace FusedSmearKernelEnv
+  {
+    //! Iterations per halo exchange with the lowest modelled cost per iteration
+    /*!
+     * \param sub_size   extents of the node's sub-lattice ( Read )
+     * \param split      is the direction smeared and split over nodes ( Read )
+     */
+    int chooseDepth(const multi1d<int>& sub_size, const multi1d<bool>& split);
+
+    //! The kernel for a gauge field, set up again only if the field changed
+    /*!
+     * The last kernel is kept, so repeated smearing with one gauge field
+     * does not rebuild the halo geometry and the links each time.
+     *
+     * \param u           gauge field ( Read )
+     * \param j_decay     direction not smeared, none if >= Nd ( Read )
+     * \param halo_depth  iterations per halo exchange, chosen if <= 0 ( Read )
+     */
+    const FusedSmearKernel& getKernel(const multi1d<LatticeColorMatrix>& u, int j_decay, int halo_depth = 0);
+
+    //! Drop the kept kernel
+    void clear();
+  }
+
+}  // end namespace Chroma
+
+#endif
@@ -4,6 +4,7 @@
 
 #include "chromabase.h"
 #include "meas/smear/gaus_smear.h"
+#include "meas/smear/fused_smear_kernel.h"
 #include "actions/boson/operator/klein_gord.h"
 
 namespace Chroma 
@@ -18,17 +19,28 @@ namespace Chroma
    *  \param width    width of "shell" wave function ( Read )
    *  \param ItrGaus  number of iterations to approximate Gaussian ( Read )
    *  \param j_decay  direction of decay ( Read )
+   *  \param halo_depth iterations per halo exchange, chosen if <= 0 ( Read )
    */
 
   template<typename T>
   void gausSmear(const multi1d<LatticeColorMatrix>& u, 
 		 T& chi, 
-		 const Real& width, int ItrGaus, int j_decay)
+		 const Real& width, int ItrGaus, int j_decay, int halo_depth)
   {
-    T psi;
+    if (ItrGaus <= 0)
+      return;
 
     Real ftmp = - (width*width) / Real(4*ItrGaus);
     /* The Klein-Gordon operator is (Lapl + mass_sq), where Lapl = -d^2/dx^2.. */
+#ifndef QDP_IS_QDPJIT
+    const FusedSmearKernel& smear = FusedSmearKernelEnv::getKernel(u, j_decay, halo_depth);
+
+    /* Each iteration is chi <- (1 + ftmp * Lapl) chi = (1 + 2 d ftmp) chi - ftmp H chi */
+    /* with d the number of smeared directions */
+    smear(chi, Real(1) + Real(2*smear.numDirs())*ftmp, -ftmp, Real(0), ItrGaus);
+#else
+    T psi;
+
     /* We want (1 + ftmp * Lapl ) = (Lapl + 1/ftmp)*ftmp */
     Real ftmpi = Real(1) / ftmp;
   
@@ -37,6 +49,7 @@ namespace Chroma
       psi = chi * ftmp;
       klein_gord(u, psi, chi, ftmpi, j_decay);
     }
+#endif
   }
 
 
@@ -52,13 +65,14 @@ namespace Chroma
    *  \param width    width of "shell" wave function ( Read )
    *  \param ItrGaus  number of iterations to approximate Gaussian ( Read )
    *  \param j_decay  direction of decay ( Read )
+   *  \param halo_depth iterations per halo exchange, chosen if <= 0 ( Read )
    */
 
   void gausSmear(const multi1d<LatticeColorMatrix>& u, 
 		 LatticeColorVector& chi, 
-		 const Real& width, int ItrGaus, int j_decay)
+		 const Real& width, int ItrGaus, int j_decay, int halo_depth)
   {
-    gausSmear<LatticeColorVector>(u, chi, width, ItrGaus, j_decay);
+    gausSmear<LatticeColorVector>(u, chi, width, ItrGaus, j_decay, halo_depth);
   }
 
 
@@ -74,13 +88,14 @@ namespace Chroma
    *  \param width    width of "shell" wave function ( Read )
    *  \param ItrGaus  number of iterations to approximate Gaussian ( Read )
    *  \param j_decay  direction of decay ( Read )
+   *  \param halo_depth iterations per halo exchange, chosen if <= 0 ( Read )
    */
 
   void gausSmear(const multi1d<LatticeColorMatrix>& u, 
 		 LatticeFermion& chi, 
-		 const Real& width, int ItrGaus, int j_decay)
+		 const Real& width, int ItrGaus, int j_decay, int halo_depth)
   {
-    gausSmear<LatticeFermion>(u, chi, width, ItrGaus, j_decay);
+    gausSmear<LatticeFermion>(u, chi, width, ItrGaus, j_decay, halo_depth);
   }
 
 
@@ -96,13 +111,14 @@ namespace Chroma
    *  \param width    width of "shell" wave function ( Read )
    *  \param ItrGaus  number of iterations to approximate Gaussian ( Read )
    *  \param j_decay  direction of decay ( Read )
+   *  \param halo_depth iterations per halo exchange, chosen if <= 0 ( Read )
    */
 
   void gausSmear(const multi1d<LatticeColorMatrix>& u, 
 		 LatticeStaggeredPropagator& chi, 
-		 const Real& width, int ItrGaus, int j_decay)
+		 const Real& width, int ItrGaus, int j_decay, int halo_depth)
   {
-    gausSmear<LatticeStaggeredPropagator>(u, chi, width, ItrGaus, j_decay);
+    gausSmear<LatticeStaggeredPropagator>(u, chi, width, ItrGaus, j_decay, halo_depth);
   }
 
 
@@ -118,13 +134,14 @@ namespace Chroma
    *  \param width    width of "shell" wave function ( Read )
    *  \param ItrGaus  number of iterations to approximate Gaussian ( Read )
    *  \param j_decay  direction of decay ( Read )
+   *  \param halo_depth iterations per halo exchange, chosen if <= 0 ( Read )
    */
 
   void gausSmear(const multi1d<LatticeColorMatrix>& u, 
 		 LatticePropagator& chi, 
-		 const Real& width, int ItrGaus, int j_decay)
+		 const Real& width, int ItrGaus, int j_decay, int halo_depth)
   {
-    gausSmear<LatticePropagator>(u, chi, width, ItrGaus, j_decay);
+    gausSmear<LatticePropagator>(u, chi, width, ItrGaus, j_decay, halo_depth);
   }
 
 
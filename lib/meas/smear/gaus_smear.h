@@ -21,10 +21,11 @@ namespace Chroma
    *  \param width    width of "shell" wave function ( Read )
    *  \param ItrGaus  number of iterations to approximate Gaussian ( Read )
    *  \param j_decay  direction of decay ( Read )
+   *  \param halo_depth iterations per halo exchange, chosen if <= 0 ( Read )
    */
   void gausSmear(const multi1d<LatticeColorMatrix>& u, 
 		 LatticeColorVector& chi, 
-		 const Real& width, int ItrGaus, int j_decay);
+		 const Real& width, int ItrGaus, int j_decay, int halo_depth = 0);
 
 
   //! Do a covariant Gaussian smearing of a lattice fermion field
@@ -39,10 +40,11 @@ namespace Chroma
    *  \param width    width of "shell" wave function ( Read )
    *  \param ItrGaus  number of iterations to approximate Gaussian ( Read )
    *  \param j_decay  direction of decay ( Read )
+   *  \param halo_depth iterations per halo exchange, chosen if <= 0 ( Read )
    */
   void gausSmear(const multi1d<LatticeColorMatrix>& u, 
 		 LatticeFermion& chi, 
-		 const Real& width, int ItrGaus, int j_decay);
+		 const Real& width, int ItrGaus, int j_decay, int halo_depth = 0);
 
 
   //! Do a covariant Gaussian smearing of a lattice propagator field
@@ -57,10 +59,11 @@ namespace Chroma
    *  \param width    width of "shell" wave function ( Read )
    *  \param ItrGaus  number of iterations to approximate Gaussian ( Read )
    *  \param j_decay  direction of decay ( Read )
+   *  \param halo_depth iterations per halo exchange, chosen if <= 0 ( Read )
    */
   void gausSmear(const multi1d<LatticeColorMatrix>& u, 
 		 LatticeStaggeredPropagator& chi, 
-		 const Real& width, int ItrGaus, int j_decay);
+		 const Real& width, int ItrGaus, int j_decay, int halo_depth = 0);
 
 
   //! Do a covariant Gaussian smearing of a lattice propagator field
@@ -75,10 +78,11 @@ namespace Chroma
    *  \param width    width of "shell" wave function ( Read )
    *  \param ItrGaus  number of iterations to approximate Gaussian ( Read )
    *  \param j_decay  direction of decay ( Read )
+   *  \param halo_depth iterations per halo exchange, chosen if <= 0 ( Read )
    */
   void gausSmear(const multi1d<LatticeColorMatrix>& u, 
 		 LatticePropagator& chi, 
-		 const Real& width, int ItrGaus, int j_decay);
+		 const Real& width, int ItrGaus, int j_decay, int halo_depth = 0);
 
 }  // end namespace Chroma
 
@@ -92,6 +92,10 @@ namespace Chroma
       read(paramtop, "wvf_param", kappa);
       read(paramtop, "wvfIntPar", iter);
       read(paramtop, "no_smear_dir", no_smear_dir);
+
+      halo_depth = 0;
+      if (paramtop.count("halo_depth") != 0)
+	read(paramtop, "halo_depth", halo_depth);
     }
 
 
@@ -104,6 +108,8 @@ namespace Chroma
       write(xml, "wvf_param", kappa);
       write(xml, "wvfIntPar", iter);
       write(xml, "no_smear_dir", no_smear_dir);
+      if (halo_depth > 0)
+	write(xml, "halo_depth", halo_depth);
 
       pop(xml);
     }
@@ -115,7 +121,7 @@ namespace Chroma
     QuarkSmear<LatticePropagator>::operator()(LatticePropagator& quark,
 					      const multi1d<LatticeColorMatrix>& u) const
     {
-      jacobiSmear(u, quark, params.kappa, params.iter, params.no_smear_dir);
+      jacobiSmear(u, quark, params.kappa, params.iter, params.no_smear_dir, params.halo_depth);
     }
 
     //! Smear the quark
@@ -124,7 +130,7 @@ namespace Chroma
     QuarkSmear<LatticeStaggeredPropagator>::operator()(LatticeStaggeredPropagator& quark,
 						       const multi1d<LatticeColorMatrix>& u) const
     {
-      jacobiSmear(u, quark, params.kappa, params.iter, params.no_smear_dir);
+      jacobiSmear(u, quark, params.kappa, params.iter, params.no_smear_dir, params.halo_depth);
     }
 
     //! Smear the quark
@@ -133,7 +139,7 @@ namespace Chroma
     QuarkSmear<LatticeFermion>::operator()(LatticeFermion& quark,
 					   const multi1d<LatticeColorMatrix>& u) const
     {
-      jacobiSmear(u, quark, params.kappa, params.iter, params.no_smear_dir);
+      jacobiSmear(u, quark, params.kappa, params.iter, params.no_smear_dir, params.halo_depth);
     }
 
     //! Smear the color-std::vector
@@ -142,7 +148,7 @@ namespace Chroma
     QuarkSmear<LatticeColorVector>::operator()(LatticeColorVector& quark,
 					       const multi1d<LatticeColorMatrix>& u) const
     {
-      jacobiSmear(u, quark, params.kappa, params.iter, params.no_smear_dir);
+      jacobiSmear(u, quark, params.kappa, params.iter, params.no_smear_dir, params.halo_depth);
     }
 
   }  // end namespace
@@ -23,13 +23,14 @@ namespace Chroma
     /*! @ingroup smear */
     struct Params
     {
-      Params() {}
+      Params() : halo_depth(0) {}
       Params(XMLReader& in, const std::string& path);
       void writeXML(XMLWriter& in, const std::string& path) const;
     
       Real kappa;			/*!< Hopping parameter */
       int  iter;			/*!< Number of smearing hits */
       int  no_smear_dir;		/*!< No smearing in this direction */
+      int  halo_depth;		/*!< Iterations per halo exchange, chosen if <= 0 */
     };
 
 
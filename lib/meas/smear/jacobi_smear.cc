@@ -4,6 +4,7 @@
 
 #include "chromabase.h"
 #include "meas/smear/jacobi_smear.h"
+#include "meas/smear/fused_smear_kernel.h"
 
 namespace Chroma 
 {
@@ -17,15 +18,20 @@ namespace Chroma
      *  \param kappa         hopping parameter ( Read )
      *  \param iter          number of iterations ( Read )
      *  \param no_smear_dir  no smearing in this direction ( Read )
+     *  \param halo_depth    iterations per halo exchange, chosen if <= 0 ( Read )
      */
 
     template<typename T>
     void jacobiSmear(const multi1d<LatticeColorMatrix>& u, 
 		     T& chi, 
-		     const Real& kappa, int iter, int no_smear_dir)
+		     const Real& kappa, int iter, int no_smear_dir, int halo_depth)
     {
+#ifndef QDP_IS_QDPJIT
+	// chi <- s_0 + kappa * H chi, all the iterations in one kernel
+	const FusedSmearKernel& smear = FusedSmearKernelEnv::getKernel(u, no_smear_dir, halo_depth);
+	smear(chi, Real(0), kappa, Real(1), iter);
+#else
 	T psi;
-	Real norm;
 
 	T s_0,h_smear;
 	s_0 = chi;
@@ -46,6 +52,7 @@ namespace Chroma
 			}
 		chi = s_0 + kappa * h_smear;
 	    }
+#endif
     }
 
 
@@ -61,13 +68,14 @@ namespace Chroma
      *  \param kappa         hopping parameter ( Read )
      *  \param iter          number of iterations ( Read )
      *  \param no_smear_dir  no smearing in this direction ( Read )
+     *  \param halo_depth    iterations per halo exchange, chosen if <= 0 ( Read )
      */
 
     void jacobiSmear(const multi1d<LatticeColorMatrix>& u, 
 		     LatticeColorVector& chi, 
-		     const Real& kappa, int iter, int no_smear_dir)
+		     const Real& kappa, int iter, int no_smear_dir, int halo_depth)
     {
-	jacobiSmear<LatticeColorVector>(u, chi, kappa, iter, no_smear_dir);
+	jacobiSmear<LatticeColorVector>(u, chi, kappa, iter, no_smear_dir, halo_depth);
     }
 
 
@@ -83,13 +91,14 @@ namespace Chroma
      *  \param kappa         hopping parameter ( Read )
      *  \param iter          number of iterations ( Read )
      *  \param no_smear_dir  no smearing in this direction ( Read )
+     *  \param halo_depth    iterations per halo exchange, chosen if <= 0 ( Read )
      */
 
     void jacobiSmear(const multi1d<LatticeColorMatrix>& u, 
 		     LatticeFermion& chi, 
-		     const Real& kappa, int iter, int no_smear_dir)
+		     const Real& kappa, int iter, int no_smear_dir, int halo_depth)
     {
-	jacobiSmear<LatticeFermion>(u, chi, kappa, iter, no_smear_dir);
+	jacobiSmear<LatticeFermion>(u, chi, kappa, iter, no_smear_dir, halo_depth);
     }
 
 
@@ -105,13 +114,14 @@ namespace Chroma
      *  \param kappa         hopping parameter ( Read )
      *  \param iter          number of iterations ( Read )
      *  \param no_smear_dir  no smearing in this direction ( Read )
+     *  \param halo_depth    iterations per halo exchange, chosen if <= 0 ( Read )
      */
 
     void jacobiSmear(const multi1d<LatticeColorMatrix>& u, 
 		     LatticeStaggeredPropagator& chi, 
-		     const Real& kappa, int iter, int no_smear_dir)
+		     const Real& kappa, int iter, int no_smear_dir, int halo_depth)
     {
-	jacobiSmear<LatticeStaggeredPropagator>(u, chi, kappa, iter, no_smear_dir);
+	jacobiSmear<LatticeStaggeredPropagator>(u, chi, kappa, iter, no_smear_dir, halo_depth);
     }
 
 
@@ -127,13 +137,14 @@ namespace Chroma
      *  \param kappa         hopping parameter ( Read )
      *  \param iter          number of iterations ( Read )
      *  \param no_smear_dir  no smearing in this direction ( Read )
+     *  \param halo_depth    iterations per halo exchange, chosen if <= 0 ( Read )
      */
 
     void jacobiSmear(const multi1d<LatticeColorMatrix>& u, 
 		     LatticePropagator& chi, 
-		     const Real& kappa, int iter, int no_smear_dir)
+		     const Real& kappa, int iter, int no_smear_dir, int halo_depth)
     {
-	jacobiSmear<LatticePropagator>(u, chi, kappa, iter, no_smear_dir);
+	jacobiSmear<LatticePropagator>(u, chi, kappa, iter, no_smear_dir, halo_depth);
     }
 
 
@@ -21,10 +21,11 @@ namespace Chroma
    *  \param kappa         hopping parameter ( Read )
    *  \param iter          number of iterations ( Read )
    *  \param no_smear_dir  no smearing in this direction ( Read )
+   *  \param halo_depth    iterations per halo exchange, chosen if <= 0 ( Read )
    */
   void jacobiSmear(const multi1d<LatticeColorMatrix>& u, 
 		 LatticeColorVector& chi, 
-		 const Real& kappa, int iter, int no_smear_dir);
+		 const Real& kappa, int iter, int no_smear_dir, int halo_depth = 0);
 
 
   //! Do a covariant Jacobi smearing of a lattice fermion field
@@ -39,10 +40,11 @@ namespace Chroma
    *  \param kappa         hopping parameter ( Read )
    *  \param iter          number of iterations ( Read )
    *  \param no_smear_dir  no smearing in this direction ( Read )
+   *  \param halo_depth    iterations per halo exchange, chosen if <= 0 ( Read )
    */
   void jacobiSmear(const multi1d<LatticeColorMatrix>& u, 
 		 LatticeFermion& chi, 
-		 const Real& kappa, int iter, int no_smear_dir);
+		 const Real& kappa, int iter, int no_smear_dir, int halo_depth = 0);
 
 
   //! Do a covariant Jacobi smearing of a lattice propagator field
@@ -57,10 +59,11 @@ namespace Chroma
    *  \param kappa         hopping parameter ( Read )
    *  \param iter          number of iterations ( Read )
    *  \param no_smear_dir  no smearing in this direction ( Read )
+   *  \param halo_depth    iterations per halo exchange, chosen if <= 0 ( Read )
    */
   void jacobiSmear(const multi1d<LatticeColorMatrix>& u, 
 		 LatticeStaggeredPropagator& chi, 
-		 const Real& kappa, int iter, int no_smear_dir);
+		 const Real& kappa, int iter, int no_smear_dir, int halo_depth = 0);
 
 
   //! Do a covariant Jacobi smearing of a lattice propagator field
@@ -75,10 +78,11 @@ namespace Chroma
    *  \param kappa         hopping parameter ( Read )
    *  \param iter          number of iterations ( Read )
    *  \param no_smear_dir  no smearing in this direction ( Read )
+   *  \param halo_depth    iterations per halo exchange, chosen if <= 0 ( Read )
    */
   void jacobiSmear(const multi1d<LatticeColorMatrix>& u, 
 		 LatticePropagator& chi, 
-		 const Real& kappa, int iter, int no_smear_dir);
+		 const Real& kappa, int iter, int no_smear_dir, int halo_depth = 0);
 
 }  // end namespace Chroma
 
@@ -16,11 +16,13 @@
 #define __smear_h__
 
 #include "gaus_smear.h"
+#include "fused_smear_kernel.h"
 #include "laplacian.h"
 #include "hyp_smear.h"
 #include "hyp_smear3d.h"
 #include "ape_smear.h"
 #include "displacement.h"
+#include "disp_vector_cache.h"
 
 #include "quark_smearing.h"
 #include "quark_source_sink.h"
@@ -4,6 +4,7 @@
 
 #include "chromabase.h"
 #include "meas/sources/z2_src.h"
+#include "util/rng/counter_rng.h"
 
 namespace Chroma {
 
@@ -93,5 +94,34 @@ namespace Chroma {
     a = where(Layout::latticeCoordinate(mu) == slice, tmp, LatticeFermion(zero));
   }
 
+
+  //! Volume source of complex Z2 noise made again from (seed, stream)
+  /*!
+   * \ingroup sources
+   *
+   * With --enable-counter-rng the noise is counter based. Otherwise the
+   * QDP generator is started from the seed and the noise is its draw
+   * number stream. The global random number state is restored.
+   *
+   * \param a      Source fermion
+   * \param seed   Seed of the noise
+   * \param stream Stream of the noise
+   */
+  void z2_src(LatticeFermion& a, const Seed& seed, int stream)
+  {
+#if defined(BUILD_COUNTER_RNG) && ! defined(QDP_IS_QDPJIT)
+    CounterRNG::z2(a, CounterRNG::makeKey(seed), stream);
+#else
+    Seed ran_seed;
+    QDP::RNG::savern(ran_seed);
+    QDP::RNG::setrn(seed);
+
+    for(int i=0; i <= stream; ++i)
+      z2_src(a);
+
+    QDP::RNG::setrn(ran_seed);
+#endif
+  }
+
 }  // end namespace Chroma
 
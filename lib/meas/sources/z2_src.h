@@ -20,6 +20,14 @@ namespace Chroma
   /*! @ingroup sources */
   void z2_src(LatticeFermion& a, int slice, int mu);
 
+  //! Z2-source made again from (seed, stream)
+  /*! @ingroup sources
+   *
+   *  Does not touch the global random number state. With
+   *  --enable-counter-rng it is also independent of the layout
+   */
+  void z2_src(LatticeFermion& a, const Seed& seed, int stream);
+
 }  // end namespace Chroma
 
 #endif
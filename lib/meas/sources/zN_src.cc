@@ -4,6 +4,7 @@
 
 #include "chromabase.h"
 #include "meas/sources/zN_src.h"
+#include "util/rng/counter_rng.h"
 
 namespace Chroma 
 {
@@ -61,5 +62,35 @@ namespace Chroma
   }
 
 
+  //! Volume source of Z(N) noise made again from (seed, stream)
+  /*!
+   * \ingroup sources
+   *
+   * With --enable-counter-rng the noise is counter based. Otherwise the
+   * QDP generator is started from the seed and the noise is its draw
+   * number stream. The global random number state is restored.
+   *
+   * \param a      Source fermion
+   * \param N      The N in Z(N)
+   * \param seed   Seed of the noise
+   * \param stream Stream of the noise
+   */
+  void zN_src(LatticeFermion& a, int N, const Seed& seed, int stream)
+  {
+#if defined(BUILD_COUNTER_RNG) && ! defined(QDP_IS_QDPJIT)
+    CounterRNG::zN(a, N, CounterRNG::makeKey(seed), stream);
+#else
+    Seed ran_seed;
+    QDP::RNG::savern(ran_seed);
+    QDP::RNG::setrn(seed);
+
+    for(int i=0; i <= stream; ++i)
+      zN_src(a, N);
+
+    QDP::RNG::setrn(ran_seed);
+#endif
+  }
+
+
 }  // end namespace Chroma
 
@@ -16,6 +16,14 @@ namespace Chroma
   /*! @ingroup sources */
   void zN_src(LatticeFermion& a, int N);
 
+  //! Z(N)-source made again from (seed, stream)
+  /*! @ingroup sources
+   *
+   *  Does not touch the global random number state. With
+   *  --enable-counter-rng it is also independent of the layout
+   */
+  void zN_src(LatticeFermion& a, int N, const Seed& seed, int stream);
+
 }  // end namespace Chroma
 
 #endif
@@ -0,0 +1,281 @@
+/*! @file
+ * @brief Named object support
+ */
+
+#include "named_obj.h"
+#include <climits>
+#include <cctype>
+
+namespace Chroma
+{
+
+  // Destruction: erase all elements of the std::map
+  NamedObjectMap::~NamedObjectMap()
+  {
+    typedef std::map<std::string, NamedObjectBase*>::iterator I;
+    while( ! the_map.empty() )
+    {
+      I iter = the_map.begin();
+
+      delete iter->second;
+
+      the_map.erase(iter);
+    }
+
+    // Remove any spill files left
+    typedef std::map<std::string, Use_t>::iterator U;
+    for(U u = the_use.begin(); u != the_use.end(); ++u)
+      if (! u->second.spill_file.empty())
+	std::remove(u->second.spill_file.c_str());
+  }
+
+
+  // Delete an item that we no longer neeed
+  void NamedObjectMap::erase(const std::string& id)
+  {
+    // Do a lookup
+    MapType_t::iterator iter = the_map.find(id);
+
+    // If found then delete it.
+    if( iter != the_map.end() )
+    {
+      // Delete the data.of the record
+      delete iter->second;
+
+      // Delete the record
+      the_map.erase(iter);
+
+      // And its spill file
+      std::map<std::string, Use_t>::iterator u = the_use.find(id);
+      if (u != the_use.end())
+      {
+	if (! u->second.spill_file.empty())
+	  std::remove(u->second.spill_file.c_str());
+
+	the_use.erase(u);
+      }
+
+      uncounted_warned.erase(id);
+    }
+    else
+    {
+      // We attempt to erase something non existent
+      std::ostringstream error_stream;
+      error_stream << "NamedObjectMap::erase : erasing unknown id = " << id << std::endl;
+      throw error_stream.str();
+    }
+  }
+
+
+  // Dump out all objects
+  void NamedObjectMap::dump() const
+  {
+    QDPIO::cout << "Available Keys are : " << std::endl;
+    for(MapType_t::const_iterator j = the_map.begin(); j != the_map.end(); j++)
+    {
+      QDPIO::cout << j->first;
+      if (j->second->spilled())
+	QDPIO::cout << "  (spilled)";
+      else if (j->second->bytes() > 0)
+	QDPIO::cout << "  (" << j->second->bytes() << " bytes/node)";
+      else if (! j->second->counted())
+	QDPIO::cout << "  (not counted)";
+      QDPIO::cout << std::endl;
+    }
+
+    QDPIO::cout << "Total in memory = " << residentBytes() << " bytes/node";
+    if (max_bytes > 0)
+      QDPIO::cout << ", budget = " << max_bytes << " bytes/node";
+    QDPIO::cout << std::endl;
+  }
+
+
+  // Look something up and return a NamedObjectBase reference
+  NamedObjectBase& NamedObjectMap::get(const std::string& id) const
+  {
+    // Find it
+    MapType_t::const_iterator iter = the_map.find(id);
+    if (iter == the_map.end())
+    {
+      // Not found -- lookup exception
+      std::ostringstream error_stream;
+      error_stream << "NamedObjectMap::get : unknown id = " << id << std::endl;
+      throw error_stream.str();
+    }
+
+    // Found, bring it back if needed and return the reference
+    touch(id, *(iter->second));
+
+    return *(iter->second);
+  }
+
+
+  // Set the memory budget
+  void NamedObjectMap::setBudget(size_t max_bytes_, const std::string& scratch_dir_)
+  {
+    max_bytes   = max_bytes_;
+    scratch_dir = scratch_dir_;
+    warned      = false;
+
+    enforceBudget();
+  }
+
+
+  // Creation number of an id
+  unsigned long NamedObjectMap::serial(const std::string& id) const
+  {
+    if (the_map.find(id) == the_map.end())
+      return 0;
+
+    std::map<std::string, Use_t>::const_iterator u = the_use.find(id);
+    return (u != the_use.end()) ? u->second.serial : 0;
+  }
+
+
+  // Bytes of all the objects in memory
+  size_t NamedObjectMap::bytes() const
+  {
+    return residentBytes();
+  }
+
+
+  // Start a new epoch
+  void NamedObjectMap::beginEpoch()
+  {
+    ++cur_epoch;
+    enforceBudget();
+  }
+
+
+  // Never spill id
+  void NamedObjectMap::pin(const std::string& id)
+  {
+    ++pins[id];
+  }
+
+
+  // Undo one pin
+  void NamedObjectMap::unpin(const std::string& id)
+  {
+    std::map<std::string, int>::iterator p = pins.find(id);
+    if (p != pins.end() && --(p->second) <= 0)
+      pins.erase(p);
+  }
+
+
+  // Record a use of id, reading it back if spilled
+  void NamedObjectMap::touch(const std::string& id, NamedObjectBase& obj) const
+  {
+    Use_t& u = the_use[id];
+    u.last_use = ++use_clock;
+    u.epoch    = cur_epoch;
+
+    if (! obj.spilled())
+      return;
+
+    obj.reload(u.spill_file);
+    std::remove(u.spill_file.c_str());
+    u.spill_file = "";
+
+    QDPIO::cout << "NamedObjectMap: reloaded id = " << id << std::endl;
+
+    // Make room for it
+    enforceBudget();
+  }
+
+
+  // Bytes in memory
+  size_t NamedObjectMap::residentBytes() const
+  {
+    size_t total = 0;
+    for(MapType_t::const_iterator j = the_map.begin(); j != the_map.end(); j++)
+      total += j->second->bytes();
+
+    return total;
+  }
+
+
+  // Spill least recently used objects until within budget
+  void NamedObjectMap::enforceBudget() const
+  {
+    if (max_bytes == 0)
+      return;
+
+    warnUncounted();
+
+    size_t total = residentBytes();
+
+    while(total > max_bytes)
+    {
+      // The least recently used object that may go
+      MapType_t::const_iterator victim = the_map.end();
+      unsigned long oldest = ULONG_MAX;
+
+      for(MapType_t::const_iterator j = the_map.begin(); j != the_map.end(); j++)
+      {
+	const NamedObjectBase& obj = *(j->second);
+	if (! obj.spillable() || obj.spilled() || obj.bytes() == 0)
+	  continue;
+
+	if (pins.find(j->first) != pins.end())
+	  continue;
+
+	const Use_t& u = the_use[j->first];
+	if (u.epoch >= cur_epoch)
+	  continue;
+
+	if (u.last_use < oldest)
+	{
+	  oldest = u.last_use;
+	  victim = j;
+	}
+      }
+
+      if (victim == the_map.end())
+      {
+	if (! warned)
+	{
+	  QDPIO::cout << "NamedObjectMap: " << total << " bytes/node in memory exceed the budget of "
+		      << max_bytes << ", but nothing more can be spilled" << std::endl;
+	  warned = true;
+	}
+	break;
+      }
+
+      // A file per node and spill
+      std::ostringstream file;
+      file << scratch_dir << "/named_obj_" << use_clock << "_";
+      for(int i=0; i < victim->first.size(); ++i)
+      {
+	char c = victim->first[i];
+	file << ((isalnum(c) || c == '.' || c == '-') ? c : '_');
+      }
+      file << ".node" << Layout::nodeNumber();
+
+      size_t b = victim->second->bytes();
+      victim->second->spill(file.str());
+      the_use[victim->first].spill_file = file.str();
+      total -= b;
+      ++use_clock;
+
+      QDPIO::cout << "NamedObjectMap: spilled id = " << victim->first
+		  << " (" << b << " bytes/node) to " << file.str() << std::endl;
+    }
+  }
+
+
+  // Warn once about each object the budget does not count
+  void NamedObjectMap::warnUncounted() const
+  {
+    for(MapType_t::const_iterator j = the_map.begin(); j != the_map.end(); j++)
+    {
+      if (j->second->counted() || uncounted_warned.count(j->first) > 0)
+	continue;
+
+      QDPIO::cout << "NamedObjectMap: the memory of id = " << j->first
+		  << " is of a type the budget does not count" << std::endl;
+      uncounted_warned.insert(j->first);
+    }
+  }
+
+}
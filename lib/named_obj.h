@@ -15,11 +15,149 @@
 
 #include "chromabase.h"
 #include "handle.h"
+#include "qdp_map_obj_memory.h"
+#include "util/ferm/subset_ev_pair.h"
 #include <map>
+#include <set>
 #include <string>
+#include <fstream>
+#include <cstdio>
 
 namespace Chroma
 {
+  //--------------------------------------------------------------------------------------
+  //! Memory use and spilling of a named object type
+  /*! @ingroup support
+   *
+   * The default knows nothing about the type: the object is not counted
+   * against the memory budget and is never spilled.
+   */
+  template<typename T>
+  struct NamedObjectStorage
+  {
+    //! Does bytes() account for the memory of the type
+    static bool counted() {return false;}
+
+    //! Bytes held on this node
+    static size_t bytes(const T& x) {return 0;}
+
+    //! Can the object be written out and read back
+    static bool spillable() {return false;}
+
+    //! Write the node local data
+    static void write(std::ostream& os, const T& x) {}
+
+    //! Read the node local data
+    static void read(std::istream& is, T& x) {}
+  };
+
+
+  //! Lattice fields, the sites on this node
+  /*! @ingroup support */
+  template<typename T>
+  struct NamedObjectStorage< OLattice<T> >
+  {
+    static bool counted() {return true;}
+
+    static size_t bytes(const OLattice<T>& x) {return sizeof(T)*Layout::sitesOnNode();}
+
+    static bool spillable() {return true;}
+
+    static void write(std::ostream& os, const OLattice<T>& x)
+    {
+      os.write((const char*)&(x.elem(0)), bytes(x));
+    }
+
+    static void read(std::istream& is, OLattice<T>& x)
+    {
+      is.read((char*)&(x.elem(0)), bytes(x));
+    }
+  };
+
+
+  //! Arrays of lattice fields
+  /*! @ingroup support */
+  template<typename T>
+  struct NamedObjectStorage< multi1d< OLattice<T> > >
+  {
+    static bool counted() {return true;}
+
+    static size_t bytes(const multi1d< OLattice<T> >& x) 
+    {
+      return x.size()*sizeof(T)*Layout::sitesOnNode();
+    }
+
+    static bool spillable() {return true;}
+
+    static void write(std::ostream& os, const multi1d< OLattice<T> >& x)
+    {
+      int n = x.size();
+      os.write((const char*)&n, sizeof(int));
+      for(int i=0; i < n; ++i)
+	NamedObjectStorage< OLattice<T> >::write(os, x[i]);
+    }
+
+    static void read(std::istream& is, multi1d< OLattice<T> >& x)
+    {
+      int n;
+      is.read((char*)&n, sizeof(int));
+      x.resize(n);
+      for(int i=0; i < n; ++i)
+	NamedObjectStorage< OLattice<T> >::read(is, x[i]);
+    }
+  };
+
+
+  //! Eigenvector and weight pairs, counted but not spilled
+  /*! @ingroup support */
+  template<typename T>
+  struct NamedObjectStorage< EVPair<T> >
+  {
+    static bool counted() {return NamedObjectStorage<T>::counted();}
+
+    static size_t bytes(const EVPair<T>& x)
+    {
+      return NamedObjectStorage<T>::bytes(x.eigenVector) + x.eigenValue.weights.size()*sizeof(Real);
+    }
+
+    static bool spillable() {return false;}
+
+    static void write(std::ostream& os, const EVPair<T>& x) {}
+
+    static void read(std::istream& is, EVPair<T>& x) {}
+  };
+
+
+  //! Map objects, counted but not spilled
+  /*! @ingroup support
+   *
+   * A MapObjectMemory holds its values on every node; other maps, e.g.
+   * on disk, hold nothing worth counting. All the values of a map have
+   * the size of a default constructed one.
+   */
+  template<typename K, typename V>
+  struct NamedObjectStorage< Handle< QDP::MapObject<K,V> > >
+  {
+    static bool counted() {return NamedObjectStorage<V>::counted();}
+
+    static size_t bytes(const Handle< QDP::MapObject<K,V> >& x)
+    {
+      const QDP::MapObjectMemory<K,V>* m = dynamic_cast<const QDP::MapObjectMemory<K,V>*>(x.operator->());
+      if (m == 0 || m->size() == 0)
+	return 0;
+
+      static const size_t value_bytes = NamedObjectStorage<V>::bytes(V());
+      return m->size()*value_bytes;
+    }
+
+    static bool spillable() {return false;}
+
+    static void write(std::ostream& os, const Handle< QDP::MapObject<K,V> >& x) {}
+
+    static void read(std::istream& is, Handle< QDP::MapObject<K,V> >& x) {}
+  };
+
+
   //--------------------------------------------------------------------------------------
   //! Typeinfo Hiding Base Clase
   /*! @ingroup support
@@ -53,6 +191,24 @@ namespace Chroma
     //! Getter
     virtual void getRecordXML(XMLBufferWriter& xml) const = 0;
 
+    //! Bytes held in memory on this node, 0 if unknown or spilled
+    virtual size_t bytes() const = 0;
+
+    //! Is the memory of the type known
+    virtual bool counted() const = 0;
+
+    //! Can the data be spilled to disk
+    virtual bool spillable() const = 0;
+
+    //! Is the data on disk
+    virtual bool spilled() const = 0;
+
+    //! Write the node local data to a file and release it
+    virtual void spill(const std::string& file_name) = 0;
+
+    //! Read the data back from a file
+    virtual void reload(const std::string& file_name) = 0;
+
     // This is key for cleanup
     virtual ~NamedObjectBase() {}
   };
@@ -67,10 +223,10 @@ namespace Chroma
   {
   public:
     //! Constructor
-    NamedObject() : data(new T) {}
+    NamedObject() : data(new T), is_spilled(false) {}
   
     template<typename P1>
-    NamedObject(const P1& p1) : data(new T(p1)) {}
+    NamedObject(const P1& p1) : data(new T(p1)), is_spilled(false) {}
  
     //! Destructor
     ~NamedObject() {}
@@ -139,8 +295,60 @@ namespace Chroma
       return *data;
     }
 
+    //! Bytes held in memory on this node
+    size_t bytes() const 
+    {
+      return (is_spilled) ? 0 : NamedObjectStorage<T>::bytes(*data);
+    }
+
+    //! Is the memory of the type known
+    bool counted() const {return NamedObjectStorage<T>::counted();}
+
+    //! Can the data be spilled to disk
+    bool spillable() const {return NamedObjectStorage<T>::spillable();}
+
+    //! Is the data on disk
+    bool spilled() const {return is_spilled;}
+
+    //! Write the node local data to a file and release it
+    void spill(const std::string& file_name)
+    {
+      std::ofstream os(file_name.c_str(), std::ios::binary);
+      NamedObjectStorage<T>::write(os, *data);
+      os.close();
+
+      if (os.fail())
+      {
+	std::ostringstream error_stream;
+        error_stream << "NamedObject::spill : error writing " << file_name << std::endl;
+        throw error_stream.str();
+      }
+
+      data = Handle<T>();
+      is_spilled = true;
+    }
+
+    //! Read the data back from a file
+    void reload(const std::string& file_name)
+    {
+      std::ifstream is(file_name.c_str(), std::ios::binary);
+      Handle<T> tmp(new T);
+      NamedObjectStorage<T>::read(is, *tmp);
+
+      if (is.fail())
+      {
+	std::ostringstream error_stream;
+        error_stream << "NamedObject::reload : error reading " << file_name << std::endl;
+        throw error_stream.str();
+      }
+
+      data = tmp;
+      is_spilled = false;
+    }
+
   private:
     Handle<T>   data;
+    bool        is_spilled;
     std::string file_xml;
     std::string record_xml;
   };
@@ -149,28 +357,29 @@ namespace Chroma
   //--------------------------------------------------------------------------------------
   //! The Map Itself
   /*! @ingroup support
+   *
+   * The map keeps the bytes of every object whose type it knows (see
+   * NamedObjectStorage); with a budget set, it warns once about each
+   * object of any other type, whose memory the budget cannot see. With a memory budget set, the least recently
+   * used objects are spilled to files in a scratch directory once the
+   * objects in memory exceed the budget, and are read back on the next
+   * lookup. Each node writes its own sites, so no communication is done.
+   *
+   * Objects used in the current epoch may still be referenced by the
+   * running measurement and are never spilled, nor are pinned ones.
+   * The InlineMeasurementRunner starts an epoch per measurement; if
+   * nobody does, nothing is ever spilled.
    */
   class NamedObjectMap 
   {
   public:
     // Creation: clear the std::map
-    NamedObjectMap() {
+    NamedObjectMap() : max_bytes(0), use_clock(0), cur_epoch(0), create_count(0), warned(false) {
       the_map.clear();
     };
 
     // Destruction: erase all elements of the std::map
-    ~NamedObjectMap() 
-    {
-      typedef std::map<std::string, NamedObjectBase*>::iterator I;
-      while( ! the_map.empty() ) 
-      {
-	I iter = the_map.begin();
-
-	delete iter->second;
-
-	the_map.erase(iter);
-      }
-    }
+    ~NamedObjectMap();
 
 
     //! Create an entry of arbitrary type.
@@ -198,6 +407,10 @@ namespace Chroma
         error_stream << "NamedObjectMap::create : error creating NamedObject for id= " << id << std::endl;
         throw error_stream.str();
       }
+
+      the_use[id].serial = ++create_count;
+      touch(id, *the_map[id]);
+      enforceBudget();
     }
 
     //! Create an entry of arbitrary type, with 1 parameter
@@ -224,6 +437,10 @@ namespace Chroma
         error_stream << "NamedObjectMap::create : error creating NamedObject for id= " << id << std::endl;
         throw error_stream.str();
       }
+
+      the_use[id].serial = ++create_count;
+      touch(id, *the_map[id]);
+      enforceBudget();
     }
 
 
@@ -239,57 +456,22 @@ namespace Chroma
   
   
     //! Delete an item that we no longer neeed
-    void erase(const std::string& id) 
-    {
-      // Do a lookup
-      MapType_t::iterator iter = the_map.find(id);
-    
-      // If found then delete it.
-      if( iter != the_map.end() ) 
-      { 
-      	// Delete the data.of the record
-	delete iter->second;
-
-	// Delete the record
-	the_map.erase(iter);
-      }
-      else 
-      {
-	// We attempt to erase something non existent
-	std::ostringstream error_stream;
-        error_stream << "NamedObjectMap::erase : erasing unknown id = " << id << std::endl;
-        throw error_stream.str();
-      }
-    }
-  
+    void erase(const std::string& id);
+
+    //! Creation number of an id, 0 if it does not exist
+    /*!
+     * Changes when the id is erased and created again, and is the same
+     * on all nodes, so together with the id it identifies the object for
+     * caches of derived data. Changes made in place are not seen.
+     */
+    unsigned long serial(const std::string& id) const;
   
     //! Dump out all objects
-    void dump() const
-    {
-      QDPIO::cout << "Available Keys are : " << std::endl;
-      for(MapType_t::const_iterator j = the_map.begin(); j != the_map.end(); j++) 
-	QDPIO::cout << j->first << std::endl;
-    }
-  
+    void dump() const;
   
     //! Look something up and return a NamedObjectBase reference
-    NamedObjectBase& get(const std::string& id) const
-    {
-      // Find it
-      MapType_t::const_iterator iter = the_map.find(id);
-      if (iter == the_map.end()) 
-      {
-	// Not found -- lookup exception
-	std::ostringstream error_stream;
-        error_stream << "NamedObjectMap::get : unknown id = " << id << std::endl;
-        throw error_stream.str();
-      }
-      else 
-      {
-	// Found, return the reference
-	return *(iter->second);
-      }
-    }
+    /*! A spilled object is read back first */
+    NamedObjectBase& get(const std::string& id) const;
 
     //! Look something up and return a ref to the derived named object
     template<typename T>
@@ -319,9 +501,59 @@ namespace Chroma
       return dynamic_cast<NamedObject<T>&>(get(id)).getData();
     }
 
+
+    //! Set the memory budget per node; 0 turns spilling off
+    void setBudget(size_t max_bytes_, const std::string& scratch_dir_);
+
+    //! Bytes of all the objects in memory on this node
+    size_t bytes() const;
+
+    //! Start a new epoch, e.g. a new measurement, and enforce the budget
+    void beginEpoch();
+
+    //! Never spill id, e.g. while a measurement that declared it runs
+    /*! Pins nest; the id need not exist yet */
+    void pin(const std::string& id);
+
+    //! Undo one pin
+    void unpin(const std::string& id);
+
   private:
+    //! Use of an object
+    struct Use_t
+    {
+      Use_t() : serial(0), last_use(0), epoch(0) {}
+
+      unsigned long serial;      /*!< creation number */
+      unsigned long last_use;    /*!< LRU clock at the last lookup */
+      unsigned long epoch;       /*!< epoch of the last lookup */
+      std::string   spill_file;  /*!< the file while spilled */
+    };
+
+    //! Record a use of id, reading it back if spilled
+    void touch(const std::string& id, NamedObjectBase& obj) const;
+
+    //! Bytes in memory
+    size_t residentBytes() const;
+
+    //! Spill least recently used objects until within budget
+    void enforceBudget() const;
+
+    //! Warn once about each object the budget does not count
+    void warnUncounted() const;
+
     typedef std::map<std::string, NamedObjectBase*> MapType_t;
     MapType_t the_map;
+
+    mutable std::map<std::string, Use_t> the_use;
+    std::map<std::string, int> pins;
+    size_t        max_bytes;
+    std::string   scratch_dir;
+    mutable unsigned long use_clock;
+    unsigned long cur_epoch;
+    unsigned long create_count;
+    mutable bool  warned;
+    mutable std::set<std::string> uncounted_warned;
   };
 
 }
@@ -10,6 +10,52 @@
 
 namespace Chroma
 {
+  //-----------------------------------------------------------------------------------
+  //! Performance counters of a SystemSolver call
+  /*! @ingroup solvers
+   *
+   * Filled only by solvers wrapped for counting, see solver_perf.h.
+   * Flops and bytes are summed over all the nodes; times are averages
+   * over the nodes.
+   */
+  struct SolverPerf_t
+  {
+    SolverPerf_t() : n_linop(0), n_reduce(0),
+		     linop_flops(0), linop_bytes(0), linop_secs(0), linop_secs_max(0),
+		     blas_flops(0), blas_bytes(0), blas_secs(0),
+		     reduce_flops(0), reduce_bytes(0), reduce_secs(0),
+		     secs(0), peak_gflops(0) {}
+
+    int     n_linop;          /*!< Number of operator applications */
+    int     n_reduce;         /*!< Number of global reductions */
+
+    double  linop_flops;      /*!< Flops of the operator */
+    double  linop_bytes;      /*!< Nominal bytes of the operator */
+    double  linop_secs;       /*!< Time in the operator */
+    double  linop_secs_max;   /*!< Time in the operator on the slowest node */
+
+    double  blas_flops;       /*!< Flops of the local vector kernels */
+    double  blas_bytes;       /*!< Bytes of the local vector kernels */
+    double  blas_secs;        /*!< Time in the local vector kernels */
+
+    double  reduce_flops;     /*!< Flops of the global reductions */
+    double  reduce_bytes;     /*!< Bytes of the global reductions */
+    double  reduce_secs;      /*!< Time in the global reductions */
+
+    double  secs;             /*!< Wall time of the solve */
+    double  peak_gflops;      /*!< Peak GFLOP/s of all the nodes, 0 if not known */
+
+    //! Total flops
+    double flops() const {return linop_flops + blas_flops + reduce_flops;}
+
+    //! GFLOP/s of the solve
+    double gflops() const {return (secs > 0) ? 1.0e-9*flops()/secs : 0;}
+
+    //! Percentage of the peak, 0 if the peak is not known
+    double percentPeak() const {return (peak_gflops > 0) ? 100*gflops()/peak_gflops : 0;}
+  };
+
+
   //-----------------------------------------------------------------------------------
   //! Holds return info from SystemSolver call
   /*! @ingroup solvers */
@@ -20,6 +66,7 @@ namespace Chroma
     int  n_count;      /*!< Number of iterations */
     Real resid;        /*!< (True) Residual of unpreconditioned problem, 
 			*    resid = sqrt(norm2(rhs - A.soln)) */
+    SolverPerf_t perf; /*!< Performance counters, if collected */
   };
 
 
@@ -2,6 +2,7 @@
 #include "chromabase.h"
 #include "util/gauge/su2extract.h"
 #include "util/gauge/sunfill.h"
+#include "util/rng/counter_rng.h"
 
 namespace Chroma 
 {
@@ -24,6 +25,7 @@ namespace Chroma
     // ******************************************
     //              Temp Storages
     LatticeBoolean lbtmp; // storage for lattice booleans
+    LatticeRandomStream rng; // lattice random numbers
     //LatticeReal lftmp; // storage for lattice float tmps
     // ******************************************
     //V=U*U_staple
@@ -75,7 +77,7 @@ namespace Chroma
     if(iWarning>0) QDPIO::cerr <<"large a_0!!!"<<std::endl;
     LatticeReal a_r;
     a_r[sub]=sqrt(a_abs);
-    random(CosTheta,sub);
+    rng.random(CosTheta,sub);
     Real RDummy;
     random(RDummy);
     CosTheta[sub]=1.0-2.0*CosTheta;
@@ -85,7 +87,7 @@ namespace Chroma
     //print_field(pr_a);
     CosTheta[sub]=(1-CosTheta*CosTheta);
     CosTheta[sub]=sqrt(CosTheta);//SinTheta
-    random(Phi,sub);
+    rng.random(Phi,sub);
     random(RDummy);
     Phi[sub]*=8.0*atan(1.0);
     a_r[sub]*=CosTheta; //a_r*SinTheta
@@ -114,18 +116,19 @@ namespace Chroma
     LatticeReal w_exp;
     w_exp[sub]=exp(-2.0*weight); //too small, need to avoid
     LatticeReal x; //container for random numbers
+    LatticeRandomStream rng;
     int n_runs=0;
     Real RDummy;
     do {
       n_runs++;
       //random(x[sub]);
-      random(x,sub);
+      rng.random(x,sub);
       random(RDummy);
       //a_0[sub]=where(lAccept,a_0,1.0+log(x*(1.0-w_exp)+w_exp)/weight);
       a_0[sub]=where(lAccept,a_0,1.0+log(w_exp*(1-x)+x)/weight);
       //print_field(a_0);exit(1);
       //random(x[sub]);
-      random(x,sub);
+      rng.random(x,sub);
       random(RDummy);
       //lAccept[sub] = where(lAccept,(1 > 0),((x*x) < (1.0-a_0*a_0)));
       //x=1.0l-x;
@@ -150,13 +153,14 @@ namespace Chroma
     LatticeInt ilbtmp=0;
     int vol_accept;
     LatticeReal xr1,xr2,xr3,xr4;
+    LatticeRandomStream rng;
     int n_runs=0;
     do {
       n_runs++;
-      random(xr1);
-      random(xr2);
-      random(xr3);
-      random(xr4);
+      rng.random(xr1);
+      rng.random(xr2);
+      rng.random(xr3);
+      rng.random(xr4);
       xr1=-(log(xr1)/weight);
       xr3 = cos(2.0l*M_PI*xr3);
       xr3=xr3*xr3;
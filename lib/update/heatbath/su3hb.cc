@@ -6,6 +6,7 @@
 #include "update/heatbath/su3hb.h"
 #include "util/gauge/su2extract.h"
 #include "util/gauge/sunfill.h"
+#include "util/rng/counter_rng.h"
 
 namespace Chroma 
 {
@@ -36,6 +37,9 @@ namespace Chroma
 	     const Subset& sub)
   {
     START_CODE();
+
+    // Lattice random numbers
+    LatticeRandomStream rng;
   
     /* V = U*W */
     LatticeColorMatrix v;
@@ -105,13 +109,13 @@ namespace Chroma
       {
 	ntrials += itrials;
 
-	random(r[1], sub);
+	rng.random(r[1], sub);
 	r[1][sub] = log(r[1]);
 
-	random(r[2], sub);
+	rng.random(r[2], sub);
 	r[2][sub] = log(r[2]);
 
-	random(lftmp, sub);
+	rng.random(lftmp, sub);
 	r[3][sub] = pow(cos(Real(twopi)*lftmp),2);
 
 	r[1][sub] += r[2] * r[3];
@@ -119,7 +123,7 @@ namespace Chroma
 
 	/* r[2] is now a trial for 1+r[0] */
 	/* see if this is accepted */
-	random(lftmp, sub);
+	rng.random(lftmp, sub);
 	r[1][sub] = lftmp*lftmp;
 
 	lbtmp[sub]  = r[1] <= (1 + 0.5*r[2]);
@@ -155,12 +159,12 @@ namespace Chroma
       {
 	ntrials += itrials;
 
-	random(r[1], sub);
+	rng.random(r[1], sub);
 	r[2][sub] = log(1 + r[1] * lftmp2) / r_l  - 1;
 
 	/* r[2] is now a trial for r[0] */
 	/* see if this is accepted */
-	random(lftmp1, sub);
+	rng.random(lftmp1, sub);
 	r[1][sub] = lftmp1 * lftmp1;
 
 	lbtmp = r[1] <= (1 - r[2] * r[2]);
@@ -188,7 +192,7 @@ namespace Chroma
       
     /* Now create r[1], r[2] and r[3] according to the spherical measure */
     /* Take absolute value to guard against round-off */
-    random(lftmp1, sub);
+    rng.random(lftmp1, sub);
     r[2][sub] = 1 - 2*lftmp1;
 
     lftmp1[sub] = fabs(1 - r[0]*r[0]);
@@ -197,7 +201,7 @@ namespace Chroma
     /* Take absolute value to guard against round-off */
     r_l[sub] = sqrt(fabs(lftmp1 - r[3]*r[3]));
 
-    random(lftmp1, sub);
+    rng.random(lftmp1, sub);
     lftmp1[sub] *= twopi;
     r[1][sub] = r_l * cos(lftmp1);
     r[2][sub] = r_l * sin(lftmp1);
@@ -18,6 +18,7 @@
 #include "update/molecdyn/hmc/global_metropolis_accrej.h"
 
 #include "util/gauge/taproj.h" 
+#include "util/rng/counter_rng.h"
 
 
 namespace Chroma 
@@ -62,13 +63,14 @@ namespace Chroma
       START_CODE();
       
       LatticeColorMatrix P ;
+      LatticeRandomStream rng;
       // Loop over direcsions
       for(int mu = 0; mu < Nd; mu++) 
       {
 	// Given that gauge fields are constant 
 	// Pull a single matrix noise gaussian noise
 	
-	gaussian(P);
+	rng.gaussian(P);
        
 	s.getP()[mu] = sum(P)/sqrt(toDouble(Layout::vol())) ;
 	// Old conventions
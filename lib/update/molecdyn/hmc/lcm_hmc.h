@@ -18,6 +18,7 @@
 #include "update/molecdyn/hmc/global_metropolis_accrej.h"
 
 #include "util/gauge/taproj.h" 
+#include "util/rng/counter_rng.h"
 
 
 namespace Chroma 
@@ -61,11 +62,13 @@ namespace Chroma
     {
       START_CODE();
       
+      LatticeRandomStream rng;
+
       // Loop over direcsions
       for(int mu = 0; mu < Nd; mu++) 
       {
 	// Pull the gaussian noise
-	gaussian(s.getP()[mu]);
+	rng.gaussian(s.getP()[mu]);
 
 	// Old conventions
 	//s.getP()[mu] *= sqrt(0.5);  // Gaussian Normalisation
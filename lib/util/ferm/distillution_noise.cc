@@ -5,6 +5,7 @@
 #include "util/ferm/distillution_noise.h"
 #include "util/ferm/crc48.h"
 #include "qdp_rannyu.h"
+#include <vector>
 
 namespace Chroma 
 {
@@ -158,4 +159,153 @@ namespace Chroma
   }
 
 
+
+  //---------------------------------------------------------------------
+  //! Counter based key of the noise of this line
+  CounterRNG::Key_t DistillutionNoise::getKey(const DistQuarkLines_t& info) const
+  {
+    // Same tags as the sequential generator, under a marker
+    BinaryBufferWriter bin;
+    write(bin, std::string("DistillutionNoise"));
+    write(bin, ensemble);
+    write(bin, seqno);
+    write(bin, info.quark_line);
+    write(bin, (info.annih) ? 1 : 0);
+    write(bin, info.mass);
+
+    return CounterRNG::makeKey(bin.str());
+  }
+
+
+  //---------------------------------------------------------------------
+  //! Z(4) noise in the distillation space of one time source and dilution
+  multi1d<Complex> DistillutionNoise::getNoise(const DistQuarkLines_t& info, int t_source, int dil) const
+  {
+    CounterRNG::Key_t key = getKey(info);
+
+    // The counter is (t_source, even stream of dil, pair of vectors)
+    multi1d<Complex> eta(info.num_vecs);
+
+    for(int i=0; i < info.num_vecs; i += 2)
+    {
+      double u[2];
+      CounterRNG::uniform2(u[0], u[1], key, t_source, 2*dil, i/2);
+
+      for(int k=0; k < 2 && i+k < info.num_vecs; ++k)
+      {
+	Real theta = 0.25 * Chroma::twopi * floor(4*u[k]);
+	eta[i+k] = cmplx(cos(theta),sin(theta));
+      }
+    }
+
+    return eta;
+  }
+
+
+  //---------------------------------------------------------------------
+  //! Z(4) lattice noise of one time source and spatial dilution
+  LatticeColorVector DistillutionNoise::getSpatialNoise(const DistQuarkLines_t& info, int t_source, int dil,
+							const multi1d<int>& spatial_mask_size) const
+  {
+    if (spatial_mask_size.size() != Nd-1)
+    {
+      QDPIO::cerr << __func__ << ": spatial_mask_size needs Nd-1 entries\n";
+      QDP_abort(1);
+    }
+
+    // Position within the mask
+    multi1d<int> pos(Nd-1);
+    int n = dil;
+    for(int mu=0; mu < Nd-1; ++mu)
+    {
+      pos[mu] = n % spatial_mask_size[mu];
+      n /= spatial_mask_size[mu];
+    }
+
+    if (dil < 0 || n != 0)
+    {
+      QDPIO::cerr << __func__ << ": invalid spatial dilution = " << dil 
+		  << "  for spatial_mask_size = " << spatial_mask_size << std::endl;
+      QDP_abort(1);
+    }
+
+    // The odd streams of dil, so it differs from the distillation space noise
+    LatticeColorVector eta = zero;
+
+#ifndef QDP_IS_QDPJIT
+    // The sites of this node on the time slice and under the mask
+    std::vector<int> tab;
+    const int me = Layout::nodeNumber();
+
+    for(int site=0; site < Layout::sitesOnNode(); ++site)
+    {
+      multi1d<int> x = Layout::siteCoords(me, site);
+
+      if (x[decay_dir] != t_source)
+	continue;
+
+      bool in = true;
+      for(int mu=0; mu < Nd-1; ++mu)
+	if (x[mu] % spatial_mask_size[mu] != pos[mu])
+	  in = false;
+
+      if (in)
+	tab.push_back(site);
+    }
+
+    if (tab.size() > 0)
+    {
+      CounterRNG::fillSites((REAL *)&(eta.elem(0)), sizeof(eta.elem(0))/sizeof(REAL), &(tab[0]), tab.size(),
+			    getKey(info), 2*dil+1, CounterRNG::DIST_ZN, 4);
+    }
+#else
+    // The same numbers, poked one site at a time
+    const CounterRNG::Key_t key = getKey(info);
+    const multi1d<int>& latt_size = Layout::lattSize();
+
+    // Number of mask sites along each direction
+    multi1d<int> n_mask(Nd-1);
+    int nsites = 1;
+    for(int mu=0; mu < Nd-1; ++mu)
+    {
+      n_mask[mu] = (latt_size[mu] - pos[mu] + spatial_mask_size[mu] - 1) / spatial_mask_size[mu];
+      nsites *= n_mask[mu];
+    }
+
+    for(int j=0; j < nsites; ++j)
+    {
+      multi1d<int> x(Nd);
+      int m = j;
+      for(int mu=0; mu < Nd-1; ++mu)
+      {
+	x[mu] = pos[mu] + spatial_mask_size[mu] * (m % n_mask[mu]);
+	m /= n_mask[mu];
+      }
+      x[decay_dir] = t_source;
+
+      unsigned long long g = 0;
+      for(int mu=Nd-1; mu >= 0; --mu)
+	g = g*latt_size[mu] + x[mu];
+
+      ColorVector v = zero;
+      for(int c=0; c < Nc; c += 2)
+      {
+	double u[2];
+	CounterRNG::uniform2(u[0], u[1], key, g, 2*dil+1, c/2);
+
+	for(int k=0; k < 2 && c+k < Nc; ++k)
+	{
+	  Real theta = 0.25 * Chroma::twopi * floor(4*u[k]);
+	  pokeColor(v, cmplx(cos(theta),sin(theta)), c+k);
+	}
+      }
+
+      pokeSite(eta, v, x);
+    }
+#endif
+
+    return eta;
+  }
+
+
 }  // end namespace Chroma
@@ -7,6 +7,7 @@
 #define __distillution_noise_h__
 
 #include "chromabase.h"
+#include "util/rng/counter_rng.h"
 
 namespace Chroma
 {
@@ -58,6 +59,29 @@ namespace Chroma
     /*! Indexing is  (t_slice,vector_num)  */
     virtual multi2d<Complex> getRNG(const DistQuarkLines_t& info) const;
 
+    //! Counter based key of the noise of this line
+    /*! Made from the ensemble, sequence, quark line, annihilation flag and mass */
+    virtual CounterRNG::Key_t getKey(const DistQuarkLines_t& info) const;
+
+    //! Z(4) noise in the distillation space of one time source and dilution
+    /*! 
+     * Counter based, so any (t_source, dil) is made on its own and the
+     * noise can be regenerated by downstream tasks instead of stored.
+     * Indexing is  (vector_num)
+     */
+    virtual multi1d<Complex> getNoise(const DistQuarkLines_t& info, int t_source, int dil) const;
+
+    //! Z(4) lattice noise of one time source and spatial dilution
+    /*!
+     * Zero except on time slice t_source and the sites with
+     * x_mu % spatial_mask_size[mu] equal to the mask position dil, the
+     * lexicographic index over spatial_mask_size with mu = 0 fastest.
+     * Counter based in the global site, so it does not depend on the
+     * layout and can be regenerated instead of stored.
+     */
+    virtual LatticeColorVector getSpatialNoise(const DistQuarkLines_t& info, int t_source, int dil,
+					       const multi1d<int>& spatial_mask_size) const;
+
   private:
     std::string  ensemble;          /*!< Ensemble used for seed of RNG */
     std::string  seqno;             /*!< Sequence label used for seed of RNG */
@@ -0,0 +1,60 @@
+/*! \file
+ * \brief Lattice field on a single time slice, stored compactly
+ */
+
+#include "util/ferm/timeslice_field.h"
+#include "util/ft/time_slice_set.h"
+
+namespace Chroma
+{
+  namespace TimeSliceFieldEnv
+  {
+    //! Anonymous namespace
+    namespace
+    {
+      //! The time slice sets, made on first use and kept to the end
+      TimeSliceSet* sets[Nd] = {0};
+
+      //! The places in the time slice site tables, made on first use
+      multi1d<int>* slice_index[Nd] = {0};
+    }
+
+
+    // The time slice subsets in direction decay_dir, made once
+    const Set& getSet(int decay_dir)
+    {
+      if (decay_dir < 0 || decay_dir >= Nd)
+      {
+	QDPIO::cerr << __func__ << ": invalid decay_dir = " << decay_dir << std::endl;
+	QDP_abort(1);
+      }
+
+      if (sets[decay_dir] == 0)
+	sets[decay_dir] = new TimeSliceSet(decay_dir);
+
+      return sets[decay_dir]->getSet();
+    }
+
+
+    // Place of each site of the node in the site table of its time slice
+    const multi1d<int>& getSliceIndex(int decay_dir)
+    {
+      const Set& set = getSet(decay_dir);
+
+      if (slice_index[decay_dir] == 0)
+      {
+	multi1d<int>& index = *(slice_index[decay_dir] = new multi1d<int>(Layout::sitesOnNode()));
+
+	for(int t=0; t < set.numSubsets(); ++t)
+	{
+	  const int* tab = set[t].siteTable().slice();
+	  for(int i=0; i < set[t].numSiteTable(); ++i)
+	    index[tab[i]] = i;
+	}
+      }
+
+      return *(slice_index[decay_dir]);
+    }
+  }
+
+} // namespace Chroma
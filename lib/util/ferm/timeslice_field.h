@@ -0,0 +1,415 @@
+// -*- C++ -*-
+/*! \file
+ * \brief Lattice field on a single time slice, stored compactly
+ */
+
+#ifndef __timeslice_field_h__
+#define __timeslice_field_h__
+
+#include "chromabase.h"
+#include "qdp_map_obj_disk.h"
+
+namespace Chroma
+{
+  //----------------------------------------------------------------------------
+  //! Support for the time slice fields
+  /*! \ingroup ferm */
+  namespace TimeSliceFieldEnv
+  {
+    //! The time slice subsets in direction decay_dir, made once
+    const Set& getSet(int decay_dir);
+
+    //! Place of each site of the node in the site table of its time slice
+    const multi1d<int>& getSliceIndex(int decay_dir);
+  }
+
+
+  //----------------------------------------------------------------------------
+  //! Lattice field on a single time slice, stored compactly
+  /*! \ingroup ferm
+   *
+   * Holds only the sites of this node on time slice t, in the order of
+   * the site table of that time slice subset, so a distillation vector
+   * on one time slice costs 1/Lt of a lattice field.
+   *
+   * T is a complex valued lattice type like LatticeColorVectorF. Fields
+   * of other precisions, e.g. LatticeColorVector, can be gathered,
+   * scattered into and contracted with.
+   *
+   * The binary I/O uses the layout of TimeSliceIO<T>, so a
+   * MapObjectDisk<KeyTimeSliceColorVec_t, TimeSliceField<T> > reads and
+   * writes the same files as the TimeSliceIO<T> ones. The sites go
+   * through the primary node one at a time, without a lattice field in
+   * between. As with TimeSliceIO, the time slice must be set before
+   * reading.
+   */
+  template<typename T>
+  class TimeSliceField
+  {
+  public:
+    typedef typename T::Subtype_t            Site_t;
+    typedef typename WordType<T>::Type_t     Word_t;
+
+    //! Empty field
+    TimeSliceField() : t_slice(-1), decay_dir(Nd-1) {}
+
+    //! Zero field on time slice t
+    explicit TimeSliceField(int t_slice_, int decay_dir_ = Nd-1)
+    {
+      setTimeSlice(t_slice_, decay_dir_);
+    }
+
+    //! The time slice t of the lattice field f
+    template<typename T2>
+    TimeSliceField(const T2& f, int t_slice_, int decay_dir_ = Nd-1)
+    {
+      setTimeSlice(t_slice_, decay_dir_);
+      gather(f);
+    }
+
+    //! Move to time slice t and zero the field
+    void setTimeSlice(int t_slice_, int decay_dir_ = Nd-1)
+    {
+      if (decay_dir_ < 0 || decay_dir_ >= Nd ||
+	  t_slice_ < 0 || t_slice_ >= Layout::lattSize()[decay_dir_])
+      {
+	QDPIO::cerr << __func__ << ": invalid time slice " << t_slice_
+		    << " in direction " << decay_dir_ << std::endl;
+	QDP_abort(1);
+      }
+
+      t_slice   = t_slice_;
+      decay_dir = decay_dir_;
+      data.resize(subset().numSiteTable());
+      *this = zero;
+    }
+
+    //! The time slice
+    int getTimeSlice() const {return t_slice;}
+
+    //! The time direction
+    int getDecayDir() const {return decay_dir;}
+
+    //! The subset of the time slice
+    const Subset& subset() const {return TimeSliceFieldEnv::getSet(decay_dir)[t_slice];}
+
+    //! Number of sites held on this node
+    int numSites() const {return data.size();}
+
+    //! Site i of the site table of the subset
+    Site_t& elem(int i) {return data[i];}
+    const Site_t& elem(int i) const {return data[i];}
+
+    //! Copy the time slice of f
+    template<typename T2>
+    void gather(const T2& f)
+    {
+      typedef typename WordType<T2>::Type_t W2;
+      checkWords<T2>();
+
+      const int* tab = subset().siteTable().slice();
+      for(int i=0; i < data.size(); ++i)
+      {
+	const W2* src = reinterpret_cast<const W2*>(&(f.elem(tab[i])));
+	Word_t* dst = words(i);
+	for(int w=0; w < nwords; ++w)
+	  dst[w] = src[w];
+      }
+    }
+
+    //! Copy into the time slice of f, the other time slices are untouched
+    template<typename T2>
+    void scatter(T2& f) const
+    {
+      typedef typename WordType<T2>::Type_t W2;
+      checkWords<T2>();
+
+      const int* tab = subset().siteTable().slice();
+      for(int i=0; i < data.size(); ++i)
+      {
+	const Word_t* src = words(i);
+	W2* dst = reinterpret_cast<W2*>(&(f.elem(tab[i])));
+	for(int w=0; w < nwords; ++w)
+	  dst[w] = src[w];
+      }
+    }
+
+    //! The field on the whole lattice, zero off the time slice
+    T toLattice() const
+    {
+      T f = zero;
+      scatter(f);
+      return f;
+    }
+
+    //! Zero
+    TimeSliceField& operator=(const Zero&)
+    {
+      for(int i=0; i < data.size(); ++i)
+      {
+	Word_t* d = words(i);
+	for(int w=0; w < nwords; ++w)
+	  d[w] = 0;
+      }
+      return *this;
+    }
+
+    //! this += b
+    TimeSliceField& operator+=(const TimeSliceField& b)
+    {
+      return axpy(1, b);
+    }
+
+    //! this -= b
+    TimeSliceField& operator-=(const TimeSliceField& b)
+    {
+      return axpy(-1, b);
+    }
+
+    //! this *= a
+    TimeSliceField& operator*=(const Real& a)
+    {
+      const Word_t s = toDouble(a);
+      for(int i=0; i < data.size(); ++i)
+      {
+	Word_t* d = words(i);
+	for(int w=0; w < nwords; ++w)
+	  d[w] *= s;
+      }
+      return *this;
+    }
+
+    //! this += a b
+    TimeSliceField& axpy(const Real& a, const TimeSliceField& b)
+    {
+      checkSlice(b);
+      const Word_t s = toDouble(a);
+      for(int i=0; i < data.size(); ++i)
+      {
+	Word_t* d = words(i);
+	const Word_t* x = b.words(i);
+	for(int w=0; w < nwords; ++w)
+	  d[w] += s * x[w];
+      }
+      return *this;
+    }
+
+    //! this += a b, for complex a
+    TimeSliceField& caxpy(const DComplex& a, const TimeSliceField& b)
+    {
+      checkSlice(b);
+      const Word_t ar = toDouble(real(a));
+      const Word_t ai = toDouble(imag(a));
+      for(int i=0; i < data.size(); ++i)
+      {
+	Word_t* d = words(i);
+	const Word_t* x = b.words(i);
+	for(int w=0; w < nwords; w += 2)
+	{
+	  d[w]   += ar * x[w] - ai * x[w+1];
+	  d[w+1] += ar * x[w+1] + ai * x[w];
+	}
+      }
+      return *this;
+    }
+
+    //! Local sum of conj(this) b over the sites of the node, as (re, im)
+    template<typename T2>
+    void localInnerProduct(double& re, double& im, const T2& b) const
+    {
+      typedef typename WordType<T2>::Type_t W2;
+      checkWords<T2>();
+
+      const int* tab = subset().siteTable().slice();
+      re = im = 0;
+      for(int i=0; i < data.size(); ++i)
+      {
+	const Word_t* x = words(i);
+	const W2* y = reinterpret_cast<const W2*>(&(b.elem(tab[i])));
+	for(int w=0; w < nwords; w += 2)
+	{
+	  re += double(x[w]) * double(y[w])   + double(x[w+1]) * double(y[w+1]);
+	  im += double(x[w]) * double(y[w+1]) - double(x[w+1]) * double(y[w]);
+	}
+      }
+    }
+
+    //! Local sum of conj(this) b over the sites of the node, as (re, im)
+    void localInnerProduct(double& re, double& im, const TimeSliceField& b) const
+    {
+      checkSlice(b);
+      re = im = 0;
+      for(int i=0; i < data.size(); ++i)
+      {
+	const Word_t* x = words(i);
+	const Word_t* y = b.words(i);
+	for(int w=0; w < nwords; w += 2)
+	{
+	  re += double(x[w]) * double(y[w])   + double(x[w+1]) * double(y[w+1]);
+	  im += double(x[w]) * double(y[w+1]) - double(x[w+1]) * double(y[w]);
+	}
+      }
+    }
+
+  private:
+    //! Number of words per site
+    static const int nwords = sizeof(Site_t) / sizeof(Word_t);
+
+    Word_t* words(int i) {return reinterpret_cast<Word_t*>(&(data[i]));}
+    const Word_t* words(int i) const {return reinterpret_cast<const Word_t*>(&(data[i]));}
+
+    //! Does T2 have the same sites up to precision?
+    template<typename T2>
+    void checkWords() const
+    {
+      if (sizeof(typename T2::Subtype_t) / sizeof(typename WordType<T2>::Type_t) != nwords)
+      {
+	QDPIO::cerr << "TimeSliceField: lattice type does not match" << std::endl;
+	QDP_abort(1);
+      }
+    }
+
+    //! Are both on the same time slice?
+    void checkSlice(const TimeSliceField& b) const
+    {
+      if (b.t_slice != t_slice || b.decay_dir != decay_dir)
+      {
+	QDPIO::cerr << "TimeSliceField: fields on different time slices" << std::endl;
+	QDP_abort(1);
+      }
+    }
+
+    int              t_slice;
+    int              decay_dir;
+    multi1d<Site_t>  data;
+  };
+
+
+  //----------------------------------------------------------------------------
+  /*! \ingroup ferm
+   * @{
+   */
+  //! Time slice color vectors
+  typedef TimeSliceField<LatticeColorVector>   TimeSliceColorVector;
+  typedef TimeSliceField<LatticeColorVectorF>  TimeSliceColorVectorF;
+  typedef TimeSliceField<LatticeColorVectorD>  TimeSliceColorVectorD;
+
+
+  //! Inner product over the time slice
+  template<typename T>
+  DComplex innerProduct(const TimeSliceField<T>& a, const TimeSliceField<T>& b)
+  {
+    double s[2];
+    a.localInnerProduct(s[0], s[1], b);
+    QDPInternal::globalSumArray(s, 2);
+    return cmplx(Double(s[0]), Double(s[1]));
+  }
+
+  //! Inner product with a lattice field over the time slice of a
+  template<typename T, typename T2>
+  DComplex innerProduct(const TimeSliceField<T>& a, const OLattice<T2>& b)
+  {
+    double s[2];
+    a.localInnerProduct(s[0], s[1], b);
+    QDPInternal::globalSumArray(s, 2);
+    return cmplx(Double(s[0]), Double(s[1]));
+  }
+
+  //! Norm squared
+  template<typename T>
+  Double norm2(const TimeSliceField<T>& a)
+  {
+    double s[2];
+    a.localInnerProduct(s[0], s[1], a);
+    QDPInternal::globalSumArray(s, 1);
+    return Double(s[0]);
+  }
+
+  //! Binary reader, in the layout of TimeSliceIO<T>
+  /*! The time slice of f must be set */
+  template<typename T>
+  void read(BinaryReader& bin, TimeSliceField<T>& f)
+  {
+    typedef typename TimeSliceField<T>::Site_t  Site_t;
+    typedef typename TimeSliceField<T>::Word_t  Word_t;
+
+    if (f.getDecayDir() != Nd-1 || f.getTimeSlice() < 0)
+    {
+      QDPIO::cerr << __func__ << ": time slice I/O needs a time slice in direction Nd-1" << std::endl;
+      QDP_abort(1);
+    }
+
+    // The sites of the time slice in lexicographic order
+    const multi1d<int>& index = TimeSliceFieldEnv::getSliceIndex(Nd-1);
+    const int vol3 = Layout::vol() / Layout::lattSize()[Nd-1];
+    const int start = f.getTimeSlice() * vol3;
+
+    Site_t buf;
+    for(int site=start; site < start+vol3; ++site)
+    {
+      multi1d<int> coord = crtesn(site, Layout::lattSize());
+      int node = Layout::nodeNumber(coord);
+
+      bin.readArrayPrimaryNode((char*)&buf, sizeof(Word_t), sizeof(Site_t)/sizeof(Word_t));
+
+#if defined(ARCH_PARSCALAR) || defined(ARCH_PARSCALARVEC)
+      if (node != 0)
+      {
+	if (Layout::primaryNode())
+	  QDPInternal::sendToWait((void *)&buf, node, sizeof(Site_t));
+	if (Layout::nodeNumber() == node)
+	  QDPInternal::recvFromWait((void *)&buf, 0, sizeof(Site_t));
+      }
+#endif
+
+      if (Layout::nodeNumber() == node)
+	f.elem(index[Layout::linearSiteIndex(coord)]) = buf;
+    }
+  }
+
+  //! Binary writer, in the layout of TimeSliceIO<T>
+  template<typename T>
+  void write(BinaryWriter& bin, const TimeSliceField<T>& f)
+  {
+    typedef typename TimeSliceField<T>::Site_t  Site_t;
+    typedef typename TimeSliceField<T>::Word_t  Word_t;
+
+    if (f.getDecayDir() != Nd-1 || f.getTimeSlice() < 0)
+    {
+      QDPIO::cerr << __func__ << ": time slice I/O needs a time slice in direction Nd-1" << std::endl;
+      QDP_abort(1);
+    }
+
+    // The sites of the time slice in lexicographic order
+    const multi1d<int>& index = TimeSliceFieldEnv::getSliceIndex(Nd-1);
+    const int vol3 = Layout::vol() / Layout::lattSize()[Nd-1];
+    const int start = f.getTimeSlice() * vol3;
+
+    Site_t buf;
+    for(int site=start; site < start+vol3; ++site)
+    {
+      multi1d<int> coord = crtesn(site, Layout::lattSize());
+      int node = Layout::nodeNumber(coord);
+
+      if (Layout::nodeNumber() == node)
+	buf = f.elem(index[Layout::linearSiteIndex(coord)]);
+
+#if defined(ARCH_PARSCALAR) || defined(ARCH_PARSCALARVEC)
+      if (node != 0)
+      {
+	if (Layout::nodeNumber() == node)
+	  QDPInternal::sendToWait((void *)&buf, 0, sizeof(Site_t));
+	if (Layout::primaryNode())
+	  QDPInternal::recvFromWait((void *)&buf, node, sizeof(Site_t));
+      }
+#endif
+
+      bin.writeArrayPrimaryNode((const char*)&buf, sizeof(Word_t), sizeof(Site_t)/sizeof(Word_t));
+    }
+  }
+
+  /*! @} */  // end of group ferm
+
+} // namespace Chroma
+
+#endif
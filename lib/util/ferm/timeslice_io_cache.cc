@@ -10,7 +10,7 @@ namespace Chroma
 {  
   //----------------------------------------------------------------------------
   // Constructor
-  TimeSliceIOCache::TimeSliceIOCache(QDP::MapObjectDisk< KeyTimeSliceColorVec_t,TimeSliceIO<LatticeColorVector> >& eigen_source_)
+  TimeSliceIOCache::TimeSliceIOCache(QDP::MapObjectDisk<KeyTimeSliceColorVec_t,TimeSliceColorVector>& eigen_source_)
     : eigen_source(eigen_source_)
   {
     const int Lt = Layout::lattSize()[Nd-1];
@@ -39,27 +39,32 @@ namespace Chroma
       QDPIO::cout << __func__ << ": found in eigenstd::vector source num_vecs= " << num_vecs << std::endl;
     }
 
-    eigen_cache.resize(num_vecs);
+    // The time slices are allocated when read
+    eigen_cache.resize(Lt,num_vecs);
     cache_marker.resize(Lt,num_vecs);
 
     for(int n=0; n < num_vecs; ++n)
     {
-      eigen_cache[n] = zero;
-      
       for(int t=0; t < Lt; ++t)
 	cache_marker(t,n) = false;
     }
   }
 
 
-  // Get a std::vector
-  LatticeColorVector& TimeSliceIOCache::getVec(int colorvec)
+  // Get the whole std::vector
+  LatticeColorVector TimeSliceIOCache::getVec(int colorvec)
   {
-    return eigen_cache[colorvec];
+    LatticeColorVector vec = zero;
+
+    for(int t=0; t < eigen_cache.size2(); ++t)
+      if (cache_marker(t,colorvec))
+	eigen_cache(t,colorvec).scatter(vec);
+
+    return vec;
   }
 
   // Get a std::vector
-  LatticeColorVector& TimeSliceIOCache::getVec(int t_actual, int colorvec)
+  const TimeSliceColorVector& TimeSliceIOCache::getVec(int t_actual, int colorvec)
   {
     // If not in cache, then retrieve
     if (! cache_marker(t_actual,colorvec))
@@ -68,13 +73,14 @@ namespace Chroma
       key_vec.t_slice  = t_actual;
       key_vec.colorvec = colorvec;
 
-      TimeSliceIO<LatticeColorVector> time_slice_io(eigen_cache[colorvec], t_actual);
+      TimeSliceColorVector& vec = eigen_cache(t_actual,colorvec);
+      vec.setTimeSlice(t_actual);
 
-      eigen_source.get(key_vec, time_slice_io);
+      eigen_source.get(key_vec, vec);
       cache_marker(t_actual,colorvec) = true;
     }
 
-    return eigen_cache[colorvec];
+    return eigen_cache(t_actual,colorvec);
   }
 
 } // namespace Chroma
@@ -11,18 +11,24 @@
 #include "chromabase.h"
 #include "qdp_map_obj_disk.h"
 #include "util/ferm/key_timeslice_colorvec.h"
+#include "util/ferm/timeslice_field.h"
 
-namespace Chroma 
-{ 
+namespace Chroma
+{
   /*! \ingroup inlinehadron */
   //----------------------------------------------------------------------------
   //----------------------------------------------------------------------------
   //! Cache for holding time slice eigenvectors
+  /*!
+   * Only the time slices asked for are read, and each is held as a
+   * TimeSliceColorVector, so the cache needs Lt times less memory than
+   * one lattice vector per eigenvector.
+   */
   class TimeSliceIOCache
   {
   public:
     //! Constructor
-    TimeSliceIOCache(QDP::MapObjectDisk<KeyTimeSliceColorVec_t,LatticeColorVector>& eigen_source_);
+    TimeSliceIOCache(QDP::MapObjectDisk<KeyTimeSliceColorVec_t,TimeSliceColorVector>& eigen_source_);
 
     //! Virtual destructor
     virtual ~TimeSliceIOCache() {}
@@ -30,20 +36,20 @@ namespace Chroma
     //! Get number of vectors
     virtual int getNumVecs() const {return num_vecs;}
 
-    //! Get the whole std::vector
-    virtual LatticeColorVector& getVec(int colorvec);
+    //! Get the whole std::vector, zero on the time slices not yet read
+    virtual LatticeColorVector getVec(int colorvec);
 
     //! Get a std::vector
-    virtual LatticeColorVector& getVec(int t_actual, int colorvec);
+    virtual const TimeSliceColorVector& getVec(int t_actual, int colorvec);
 
   private:
     // Arguments
-    QDP::MapObjectDisk< KeyTimeSliceColorVec_t,TimeSliceIO<LatticeColorVector> >& eigen_source;
+    QDP::MapObjectDisk<KeyTimeSliceColorVec_t,TimeSliceColorVector>& eigen_source;
 
     // Local
-    multi1d<LatticeColorVector>  eigen_cache;
-    multi2d<bool>                cache_marker;
-    int                          num_vecs;
+    multi2d<TimeSliceColorVector>  eigen_cache;
+    multi2d<bool>                  cache_marker;
+    int                            num_vecs;
   };
 
 }
@@ -16,5 +16,6 @@
 
 #include "sftmom.h"
 #include "single_phase.h"
+#include "lattice_fft.h"
 
 #endif
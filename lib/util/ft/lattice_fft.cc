@@ -0,0 +1,192 @@
+/*! \file
+ *  \brief Distributed fast Fourier transform of lattice fields
+ */
+
+#include "util/ft/lattice_fft.h"
+
+namespace Chroma
+{
+
+  namespace
+  {
+    //! Is a power of 2
+    bool isPow2(int n) {return n > 0 && (n & (n-1)) == 0;}
+
+    //! log2 of a power of 2
+    int log2i(int n)
+    {
+      int m = 0;
+      while((1 << m) < n)
+	++m;
+      return m;
+    }
+
+    //! Reverse the lowest m bits
+    int bitReverse(int j, int m)
+    {
+      int r = 0;
+      for(int b=0; b < m; ++b)
+	if ((j >> b) & 1)
+	  r |= 1 << (m-1-b);
+      return r;
+    }
+
+
+    //! Site with the coordinate along mu bit reversed
+    struct BitRevMapFunc : public MapFunc
+    {
+      BitRevMapFunc(int mu_, int m_) : mu(mu_), m(m_) {}
+
+      multi1d<int> operator()(const multi1d<int>& x, int sign) const
+      {
+	multi1d<int> y = x;
+	y[mu] = bitReverse(x[mu], m);
+	return y;
+      }
+
+      int mu, m;
+    };
+
+
+    //! Partner site of a butterfly, the coordinate along mu with bit h flipped
+    struct XorMapFunc : public MapFunc
+    {
+      XorMapFunc(int mu_, int h_) : mu(mu_), h(h_) {}
+
+      multi1d<int> operator()(const multi1d<int>& x, int sign) const
+      {
+	multi1d<int> y = x;
+	y[mu] = x[mu] ^ h;
+	return y;
+      }
+
+      int mu, h;
+    };
+  }
+
+
+  // Set up the maps
+  LatticeFFT::LatticeFFT(const multi1d<bool>& dirs_) : dirs(dirs_)
+  {
+    if (dirs.size() != Nd)
+    {
+      QDPIO::cerr << __func__ << ": need Nd directions" << std::endl;
+      QDP_abort(1);
+    }
+
+    bitrev.resize(Nd);
+    butterfly.resize(Nd);
+
+    for(int mu=0; mu < Nd; ++mu)
+    {
+      const int L = Layout::lattSize()[mu];
+      if (! dirs[mu] || ! isPow2(L) || L == 1)
+	continue;
+
+      const int m = log2i(L);
+
+      bitrev[mu] = new Map;
+      bitrev[mu]->make(BitRevMapFunc(mu, m));
+
+      butterfly[mu].resize(m);
+      for(int s=0; s < m; ++s)
+      {
+	butterfly[mu][s] = new Map;
+	butterfly[mu][s]->make(XorMapFunc(mu, 1 << s));
+      }
+    }
+  }
+
+
+  // Radix 2 along mu
+  template<typename T>
+  void LatticeFFT::fft1(T& x, int mu, int sign) const
+  {
+    const int L = Layout::lattSize()[mu];
+    const int m = log2i(L);
+    const Real pi = Chroma::twopi / 2;
+
+    // Into bit reversed order
+    T tmp = (*bitrev[mu])(x);
+    x = tmp;
+
+    const LatticeInteger j = Layout::latticeCoordinate(mu);
+
+    for(int s=0; s < m; ++s)
+    {
+      const int h = 1 << s;
+
+      // The twiddle of the pair, the lower site of the pair
+      LatticeReal theta = Real(sign) * pi * LatticeReal(j % h) / Real(h);
+      LatticeComplex w = cmplx(cos(theta), sin(theta));
+      LatticeBoolean lower = ((j / h) % 2) == 0;
+
+      // Lower site: a + w b, upper site: a - w b
+      T p = (*butterfly[mu][s])(x);
+      tmp = where(lower, x + w*p, p - w*x);
+      x = tmp;
+    }
+  }
+
+
+  // Direct sum along mu
+  template<typename T>
+  void LatticeFFT::dft1(T& x, int mu, int sign) const
+  {
+    const int L = Layout::lattSize()[mu];
+    const LatticeInteger k = Layout::latticeCoordinate(mu);
+
+    // Site k sums x(k+n) exp(sign 2 pi i k (k+n)/L) over n
+    T acc = zero;
+    T sh = x;
+
+    for(int n=0; n < L; ++n)
+    {
+      LatticeInteger y = (k + n) % L;
+      LatticeReal theta = Real(sign) * Chroma::twopi * LatticeReal((k * y) % L) / Real(L);
+
+      acc += cmplx(cos(theta), sin(theta)) * sh;
+
+      if (n+1 < L)
+      {
+	T tmp = shift(sh, FORWARD, mu);
+	sh = tmp;
+      }
+    }
+
+    x = acc;
+  }
+
+
+  // All the directions
+  template<typename T>
+  void LatticeFFT::transform(T& x, int sign) const
+  {
+    for(int mu=0; mu < Nd; ++mu)
+    {
+      const int L = Layout::lattSize()[mu];
+      if (! dirs[mu] || L == 1)
+	continue;
+
+      if (isPow2(L))
+	fft1(x, mu, sign);
+      else
+	dft1(x, mu, sign);
+    }
+  }
+
+
+  // In place transform
+  void LatticeFFT::operator()(LatticeColorMatrix& x, int sign) const
+  {
+    transform(x, sign);
+  }
+
+
+  // In place transform
+  void LatticeFFT::operator()(LatticeComplex& x, int sign) const
+  {
+    transform(x, sign);
+  }
+
+}  // end namespace Chroma
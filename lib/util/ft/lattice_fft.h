@@ -0,0 +1,67 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Distributed fast Fourier transform of lattice fields
+ */
+
+#ifndef __lattice_fft_h__
+#define __lattice_fft_h__
+
+#include "chromabase.h"
+#include "handle.h"
+
+namespace Chroma
+{
+
+  //! Distributed fast Fourier transform of lattice fields
+  /*!
+   * \ingroup ft
+   *
+   * Transform over a set of directions, done one direction at a time
+   *
+   *   x(k) = sum_y exp(sign * 2 pi i k.y/L) x(y)
+   *
+   * with no normalization, so a transform with sign = -1 followed by one
+   * with sign = +1 is the identity times the product of the extents.
+   * The momentum k sits at the site with coordinates k.
+   *
+   * A direction with a power of 2 extent uses the radix-2 decimation in
+   * time: a bit reversal then log2(L) butterfly stages, each a QDP Map to
+   * the partner site, so the cost is O(log L) communications. Other
+   * extents are summed directly over L-1 nearest neighbor shifts.
+   */
+  class LatticeFFT
+  {
+  public:
+    //! Transform over the directions with dirs[mu] true
+    LatticeFFT(const multi1d<bool>& dirs);
+
+    //! In place transform
+    void operator()(LatticeColorMatrix& x, int sign) const;
+
+    //! In place transform
+    void operator()(LatticeComplex& x, int sign) const;
+
+  private:
+    //! Hide default constructor
+    LatticeFFT() {}
+
+    //! All the directions
+    template<typename T>
+    void transform(T& x, int sign) const;
+
+    //! Radix 2 along mu
+    template<typename T>
+    void fft1(T& x, int mu, int sign) const;
+
+    //! Direct sum along mu
+    template<typename T>
+    void dft1(T& x, int mu, int sign) const;
+
+    multi1d<bool>                     dirs;
+    multi1d< Handle<Map> >            bitrev;     /*!< bit reversal along mu */
+    multi1d< multi1d< Handle<Map> > > butterfly;  /*!< partner of each stage along mu */
+  };
+
+}  // end namespace Chroma
+
+#endif
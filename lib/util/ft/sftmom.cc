@@ -27,7 +27,7 @@
 //  Added a default constructor.
 //
 //  Revision 3.2  2006/08/30 02:10:19  edwards
-//  Technically a bug fix. The test for a zero_offset should only be in directions
+//  Technically a bug fix. The test for a zero_offset should only be in directions
 //  not in the fourier transform. E.g., there was a missing test of mu==decay_dir.
 //
 //  Revision 3.1  2006/08/19 19:29:33  flemingg
@@ -98,8 +98,9 @@
 //
 
 #include "util/ft/sftmom.h"
-#include "util/ft/single_phase.h"
 #include "qdp_util.h"                 // part of QDP++, for crtesn()
+#include <cmath>
+#include <vector>
 
 namespace Chroma 
 {
@@ -158,6 +159,145 @@ namespace Chroma
   }
 
 
+#if ! defined(QDP_IS_QDPJIT) && ! defined(ARCH_PARSCALARVEC)
+  // Site kernels of the transforms
+  namespace SftMomEnv
+  {
+    //! Value of a site as a complex number
+    inline
+    void siteValue(const LatticeComplex& cf, int site, REAL64& re, REAL64& im)
+    {
+      re = cf.elem(site).elem().elem().real();
+      im = cf.elem(site).elem().elem().imag();
+    }
+
+    inline
+    void siteValue(const LatticeReal& cf, int site, REAL64& re, REAL64& im)
+    {
+      re = cf.elem(site).elem().elem().elem();
+      im = 0;
+    }
+
+#if BASE_PRECISION==32
+    inline
+    void siteValue(const LatticeComplexD& cf, int site, REAL64& re, REAL64& im)
+    {
+      re = cf.elem(site).elem().elem().real();
+      im = cf.elem(site).elem().elem().imag();
+    }
+#endif
+
+
+    //! One stage of the separable transform
+    /*!
+     * in is (outer, len, suf) and out is (outer, np, suf) complex:
+     *   out(o,p,y) = sum_x  tab(p,x) in(o,x,y)
+     */
+    struct StageArgs
+    {
+      const REAL64* in;
+      REAL64* out;
+      const REAL64* tab;
+      int len;
+      int np;
+      int suf;
+    };
+
+    inline
+    void stageLoop(int lo, int hi, int my_id, StageArgs* a)
+    {
+      const int len = a->len;
+      const int np  = a->np;
+      const int suf = a->suf;
+
+      for(int o=lo; o < hi; ++o)
+      {
+	const REAL64* in = a->in  + 2*size_t(o)*len*suf;
+	REAL64* out      = a->out + 2*size_t(o)*np*suf;
+
+	for(int p=0; p < np; ++p)
+	{
+	  REAL64* op = out + 2*size_t(p)*suf;
+	  const REAL64* e = a->tab + 2*size_t(p)*len;
+
+	  for(int y=0; y < 2*suf; ++y)
+	    op[y] = 0;
+
+	  for(int x=0; x < len; ++x)
+	  {
+	    const REAL64 er = e[2*x];
+	    const REAL64 ei = e[2*x+1];
+	    const REAL64* ip = in + 2*size_t(x)*suf;
+
+	    for(int y=0; y < suf; ++y)
+	    {
+	      op[2*y]   += er*ip[2*y]   - ei*ip[2*y+1];
+	      op[2*y+1] += er*ip[2*y+1] + ei*ip[2*y];
+	    }
+	  }
+	}
+      }
+    }
+
+
+    //! Direct sum over the local array for a list of momenta
+    struct DirectArgs
+    {
+      const REAL64* a;                          // local (t, x_0, x_1, ...) array
+      const multi1d< multi1d<REAL64> >& tab;    // 1D phase tables
+      const multi2d<int>& raw_mom;
+      const multi1d<int>& p_min;
+      const int* len;                           // local extents of the x_j
+      int spat;                                 // local spatial volume
+      int nt;                                   // number of fields times local time extent
+      REAL64* partial;                          // 2*nt*n_raw reals per thread
+    };
+
+    inline
+    void directLoop(int lo, int hi, int my_id, DirectArgs* a)
+    {
+      const int D = a->p_min.size();
+      const int n_raw = a->raw_mom.size2();
+      REAL64* acc = a->partial + 2*size_t(a->nt)*n_raw*my_id;
+
+      int x[Nd];
+
+      for(int off=lo; off < hi; ++off)
+      {
+	const REAL64 vr = a->a[2*off];
+	const REAL64 vi = a->a[2*off+1];
+	if (vr == 0 && vi == 0)
+	  continue;
+
+	// Local coordinates of this entry
+	int rem = off;
+	for(int j=D-1; j >= 0; --j)
+	{
+	  x[j] = rem % a->len[j];
+	  rem /= a->len[j];
+	}
+	REAL64* at = acc + 2*size_t(rem)*n_raw;   // rem = field*Tl + t
+
+	for(int r=0; r < n_raw; ++r)
+	{
+	  REAL64 pr = vr;
+	  REAL64 pi = vi;
+	  for(int j=0; j < D; ++j)
+	  {
+	    const REAL64* e = &(a->tab[j][2*((a->raw_mom[r][j] - a->p_min[j])*a->len[j] + x[j])]);
+	    REAL64 tr = pr*e[0] - pi*e[1];
+	    pi = pr*e[1] + pi*e[0];
+	    pr = tr;
+	  }
+	  at[2*r]   += pr;
+	  at[2*r+1] += pi;
+	}
+      }
+    }
+  }
+#endif
+
+
   SftMom::SftMom(int mom2_max, bool avg_mom, int j_decay)
   {
     multi1d<int> origin_off(Nd);
@@ -190,14 +330,17 @@ namespace Chroma
     num_mom = moms.size2();
     mom_list = moms;
 
-    phases.resize(num_mom);
-
-
+    // Each momentum is its own phase
+    raw_mom = moms;
+    raw_num.resize(num_mom);
     for (int m = 0 ; m < num_mom ; ++m)
-    {
-      phases[m] = singlePhase(orig, mom_list[m], decay_dir);
-    }
+      raw_num[m] = m;
+
+    mom_degen.resize(num_mom);
+    mom_degen = 0;
 
+    phases.resize(num_mom);
+    initTransform();
   }
 
   SftMom::SftMom(int mom2_max, multi1d<int> origin_offset_, bool avg_mom,
@@ -331,15 +474,11 @@ namespace Chroma
       }
     }
 
-    // Now resize and initialize the Fourier phase table.  Then, loop over
-    // allowed momenta, optionally averaging over equivalent momenta.
-    phases.resize(num_mom) ;
-    phases = 0. ;
-
-    // Coordinates for sink momenta
-    multi1d<LatticeInteger> my_coord(Nd);
-    for (int mu=0; mu < Nd; ++mu)
-      my_coord[mu] = Layout::latticeCoordinate(mu);
+    // Now loop over allowed momenta and record every momentum that enters
+    // the phase of each mom_num, optionally averaging over equivalent momenta.
+    // The phases themselves are only made on demand.
+    std::vector<int> raw_flat;
+    std::vector<int> raw_id;
 
     // Keep track of |mom| degeneracy for averaging
     mom_degen.resize(num_mom);
@@ -425,36 +564,323 @@ namespace Chroma
       } // end if (avg_equiv_mom)
 
       //
-      // Build the phase. 
+      // This momentum enters the phase of mom_num.
       // RGE: the origin_offset works with or without momentum averaging
       //
-      LatticeReal p_dot_x ;
-      p_dot_x = 0. ;
+      for(int mu=0; mu < mom_size.size(); ++mu)
+	raw_flat.push_back(mom[mu]);
+      raw_id.push_back(mom_num);
 
-      int j = 0;
-      for(int mu = 0; mu < Nd; ++mu) {
-	const Real twopi = 6.283185307179586476925286;
+      // increment mom_num for next valid momenta
+      ++mom_num ;
 
-	if (mu == j_decay) continue ;
+    } // end for (int n=0; n < mom_vol; ++n)
 
-	p_dot_x += LatticeReal(my_coord[mu] - origin_offset[mu]) * twopi *
-          Real(mom[j]) / Layout::lattSize()[mu];
-	++j ;
-      } // end for(mu)
+    raw_mom.resize(raw_id.size(), mom_size.size());
+    raw_num.resize(raw_id.size());
+    for (int r=0; r < raw_id.size(); ++r) {
+      raw_num[r] = raw_id[r];
+      for (int mu=0; mu < mom_size.size(); ++mu)
+	raw_mom[r][mu] = raw_flat[r*mom_size.size() + mu];
+    }
 
-      phases[mom_num] += cmplx(cos(p_dot_x), sin(p_dot_x)) ;
+    phases.resize(num_mom);
+    initTransform();
+  }
 
-      // increment mom_num for next valid momenta
-      ++mom_num ;
 
-    } // end for (int n=0; n < mom_vol; ++n)
+  // Phase tables and site offsets for the transforms
+  void
+  SftMom::initTransform()
+  {
+    const int D = ((decay_dir<0)||(decay_dir>=Nd)) ? Nd : Nd-1;
+    const int n_raw = raw_num.size();
+
+    if (n_raw > 0 && raw_mom.size1() != D)
+    {
+      QDPIO::cerr << "SftMom: momenta have " << raw_mom.size1() 
+		  << " components, expected " << D << std::endl;
+      QDP_abort(1);
+    }
+
+    const multi1d<int>& latt_size  = Layout::lattSize();
+    const multi1d<int>& sub_size   = Layout::subgridLattSize();
+    const multi1d<int>& node_coord = Layout::nodeCoord();
+    const REAL64 twopi = 6.283185307179586476925286;
+
+    ft_dir.resize(D);
+    p_min.resize(D);
+    p_len.resize(D);
+    phase_tab.resize(D);
+
+    for(int mu=0, j=0; mu < Nd; ++mu)
+    {
+      if (mu == decay_dir) continue;
+      ft_dir[j++] = mu;
+    }
+
+    // The box of momentum components and the 1D tables over it
+    for(int j=0; j < D; ++j)
+    {
+      int lo = 0, hi = 0;
+      for(int r=0; r < n_raw; ++r)
+      {
+	if (r == 0 || raw_mom[r][j] < lo) lo = raw_mom[r][j];
+	if (r == 0 || raw_mom[r][j] > hi) hi = raw_mom[r][j];
+      }
+      p_min[j] = lo;
+      p_len[j] = hi - lo + 1;
+
+      const int mu  = ft_dir[j];
+      const int len = sub_size[mu];
+      phase_tab[j].resize(2*p_len[j]*len);
+
+      for(int p=0; p < p_len[j]; ++p)
+      {
+	for(int x=0; x < len; ++x)
+	{
+	  int xg = node_coord[mu]*len + x - origin_offset[mu];
+	  REAL64 arg = twopi * REAL64(p + lo) * REAL64(xg) / REAL64(latt_size[mu]);
+	  phase_tab[j][2*(p*len + x)]   = std::cos(arg);
+	  phase_tab[j][2*(p*len + x)+1] = std::sin(arg);
+	}
+      }
+    }
+
+    // Offset of every site in the local (t, x_0, x_1, ...) array
+    const int me = Layout::nodeNumber();
+    site_off.resize(Layout::sitesOnNode());
+
+    for(int site=0; site < Layout::sitesOnNode(); ++site)
+    {
+      multi1d<int> x = Layout::siteCoords(me, site);
+
+      int off = 0;
+      if ((decay_dir>=0)&&(decay_dir<Nd))
+	off = x[decay_dir] - node_coord[decay_dir]*sub_size[decay_dir];
+
+      for(int j=0; j < D; ++j)
+      {
+	const int mu = ft_dir[j];
+	off = off*sub_size[mu] + (x[mu] - node_coord[mu]*sub_size[mu]);
+      }
+      site_off[site] = off;
+    }
+  }
+
+
+  // Make the phase of one momenta id
+  void
+  SftMom::makePhase(int mom_num) const
+  {
+    LatticeComplex phase = zero;
+
+    for(int r=0; r < raw_num.size(); ++r)
+    {
+      if (raw_num[r] != mom_num) continue;
+
+      LatticeReal p_dot_x = zero;
+
+      for(int j=0; j < ft_dir.size(); ++j)
+      {
+	const Real twopi = 6.283185307179586476925286;
+	const int mu = ft_dir[j];
+
+	p_dot_x += LatticeReal(Layout::latticeCoordinate(mu) - origin_offset[mu]) * twopi *
+	  Real(raw_mom[r][j]) / Layout::lattSize()[mu];
+      }
+
+      phase += cmplx(cos(p_dot_x), sin(p_dot_x));
+    }
 
-    // Finish averaging
     // Momentum averaging works even in the presence of an origin_offset
-    if (avg_equiv_mom) {
-      for (int mom_num=0; mom_num < num_mom; ++mom_num)
-	phases[mom_num] /= mom_degen[mom_num] ;
+    if (avg_equiv_mom)
+      phase /= mom_degen[mom_num];
+
+    phases[mom_num] = new LatticeComplex(phase);
+  }
+
+
+  // Fourier transform of nf fields on all (subset_color < 0) or one time slice
+  /*
+   * The fields are packed into a local (field, t, x_0, x_1, ...) array. Then
+   * either the separable transform runs over the box of momentum components,
+   * one direction at a time, or the momenta are summed directly from the 1D
+   * phase tables, whichever needs fewer operations. The per-node sums of all
+   * fields, momenta and time slices are combined in one global sum.
+   *
+   * Under QDP-JIT or with a vectorized layout the sites cannot be read one
+   * by one, and the phases are summed with sumMulti as before.
+   */
+  template<typename L>
+  multi1d< multi2d<DComplex> >
+  SftMom::transform(const L* cf, int nf, int subset_color) const
+  {
+    START_CODE();
+
+#if ! defined(QDP_IS_QDPJIT) && ! defined(ARCH_PARSCALARVEC)
+    const int D      = ft_dir.size();
+    const int n_raw  = raw_num.size();
+    const int length = sft_set.numSubsets();
+    const int vl     = Layout::sitesOnNode();
+    const multi1d<int>& sub_size = Layout::subgridLattSize();
+
+    int Tl = 1;
+    int t0 = 0;
+    if ((decay_dir>=0)&&(decay_dir<Nd))
+    {
+      Tl = sub_size[decay_dir];
+      t0 = Layout::nodeCoord()[decay_dir]*Tl;
+    }
+    const int spat = vl / Tl;
+
+    multi1d<int> len(D);
+    for(int j=0; j < D; ++j)
+      len[j] = sub_size[ft_dir[j]];
+
+    // Pack the fields
+    multi1d<REAL64> a(2*nf*vl);
+    a = 0;
+    for(int f=0; f < nf; ++f)
+    {
+      for(int site=0; site < vl; ++site)
+      {
+	int off = site_off[site];
+	if (subset_color >= 0 && t0 + off/spat != subset_color)
+	  continue;
+	off += f*vl;
+	SftMomEnv::siteValue(cf[f], site, a[2*off], a[2*off+1]);
+      }
+    }
+
+    // Operation counts of the two transforms
+    double cost_direct = double(vl)*n_raw*D;
+    double cost_sep = 0;
+    {
+      double outer = Tl;
+      double suf = spat;
+      for(int j=0; j < D; ++j)
+      {
+	suf /= len[j];
+	cost_sep += outer*len[j]*p_len[j]*suf;
+	outer *= p_len[j];
+      }
     }
+
+    // Sums of each field, time slice and momentum
+    multi1d<REAL64> rsum(2*nf*length*n_raw);
+    rsum = 0;
+
+    if (cost_sep < cost_direct)
+    {
+      // Separable transform, one direction at a time
+      std::vector<REAL64> in(a.slice(), a.slice() + 2*nf*vl);
+      std::vector<REAL64> out;
+      int outer = nf*Tl;
+      int suf = spat;
+
+      for(int j=0; j < D; ++j)
+      {
+	suf /= len[j];
+	out.resize(2*size_t(outer)*p_len[j]*suf);
+
+	SftMomEnv::StageArgs arg = {&(in[0]), &(out[0]), phase_tab[j].slice(),
+				    len[j], p_len[j], suf};
+	dispatch_to_threads(outer, arg, SftMomEnv::stageLoop);
+
+	outer *= p_len[j];
+	in.swap(out);
+      }
+
+      // in is now (field, t, box of momenta)
+      const int box = outer / (nf*Tl);
+      for(int r=0; r < n_raw; ++r)
+      {
+	int b = 0;
+	for(int j=0; j < D; ++j)
+	  b = b*p_len[j] + (raw_mom[r][j] - p_min[j]);
+
+	for(int f=0; f < nf; ++f)
+	{
+	  for(int tl=0; tl < Tl; ++tl)
+	  {
+	    int i = (f*length + t0 + tl)*n_raw + r;
+	    int k = (f*Tl + tl)*box + b;
+	    rsum[2*i]   = in[2*k];
+	    rsum[2*i+1] = in[2*k+1];
+	  }
+	}
+      }
+    }
+    else
+    {
+      // Direct sums with per-thread partials
+      const int nthr = qdpNumThreads();
+      const int nt = nf*Tl;
+      multi1d<REAL64> partial(2*nt*n_raw*nthr);
+      partial = 0;
+
+      SftMomEnv::DirectArgs arg = {a.slice(), phase_tab, raw_mom, p_min, len.slice(),
+				   spat, nt, partial.slice()};
+      dispatch_to_threads(nf*vl, arg, SftMomEnv::directLoop);
+
+      for(int t=0; t < nthr; ++t)
+	for(int f=0; f < nf; ++f)
+	  for(int i=0; i < 2*Tl*n_raw; ++i)
+	    rsum[2*(f*length + t0)*n_raw + i] += partial[2*(nt*t + f*Tl)*n_raw + i];
+    }
+
+    QDPInternal::globalSumArray(rsum.slice(), 2*nf*length*n_raw);
+
+    // Collect the momenta of each id
+    multi1d< multi2d<DComplex> > hsum(nf);
+
+    for(int f=0; f < nf; ++f)
+    {
+      hsum[f].resize(num_mom, length);
+      for(int mom_num=0; mom_num < num_mom; ++mom_num)
+	hsum[f][mom_num] = zero;
+
+      for(int r=0; r < n_raw; ++r)
+      {
+	for(int t=0; t < length; ++t)
+	{
+	  int i = (f*length + t)*n_raw + r;
+	  hsum[f][raw_num[r]][t] += cmplx(Double(rsum[2*i]), Double(rsum[2*i+1]));
+	}
+      }
+
+      if (avg_equiv_mom)
+      {
+	for(int mom_num=0; mom_num < num_mom; ++mom_num)
+	  for(int t=0; t < length; ++t)
+	    hsum[f][mom_num][t] /= Double(mom_degen[mom_num]);
+      }
+    }
+#else
+    const int length = sft_set.numSubsets();
+    multi1d< multi2d<DComplex> > hsum(nf);
+
+    for(int f=0; f < nf; ++f)
+    {
+      hsum[f].resize(num_mom, length);
+
+      for(int mom_num=0; mom_num < num_mom; ++mom_num)
+      {
+	if (subset_color < 0)
+	  hsum[f][mom_num] = sumMulti((*this)[mom_num]*cf[f], sft_set);
+	else
+	{
+	  hsum[f][mom_num] = zero;
+	  hsum[f][mom_num][subset_color] = sum((*this)[mom_num]*cf[f], sft_set[subset_color]);
+	}
+      }
+    }
+#endif
+
+    END_CODE();
+
+    return hsum;
   }
 
 
@@ -523,80 +949,47 @@ namespace Chroma
   multi2d<DComplex>
   SftMom::sft(const LatticeComplex& cf) const
   {
-    multi2d<DComplex> hsum(num_mom, sft_set.numSubsets()) ;
-
-    for (int mom_num=0; mom_num < num_mom; ++mom_num)
-      hsum[mom_num] = sumMulti(phases[mom_num]*cf, sft_set) ;
-
-    return hsum ;
+    return transform(&cf, 1, -1)[0];
   }
 
   multi2d<DComplex>
   SftMom::sft(const LatticeComplex& cf, int subset_color) const
   {
-    int length = sft_set.numSubsets();
-    multi2d<DComplex> hsum(num_mom, length);
-
-    for (int mom_num=0; mom_num < num_mom; ++mom_num)
-    {
-      hsum[mom_num] = zero;
-      hsum[mom_num][subset_color] = sum(phases[mom_num]*cf, sft_set[subset_color]);
-    }
-
-    return hsum ;
+    return transform(&cf, 1, subset_color)[0];
   }
 
   multi2d<DComplex>
   SftMom::sft(const LatticeReal& cf) const
   {
-    multi2d<DComplex> hsum(num_mom, sft_set.numSubsets()) ;
-
-    for (int mom_num=0; mom_num < num_mom; ++mom_num)
-      hsum[mom_num] = sumMulti(phases[mom_num]*cf, sft_set) ;
-
-    return hsum ;
+    return transform(&cf, 1, -1)[0];
   }
 
   multi2d<DComplex>
   SftMom::sft(const LatticeReal& cf, int subset_color) const
   {
-    int length = sft_set.numSubsets();
-    multi2d<DComplex> hsum(num_mom, length);
+    return transform(&cf, 1, subset_color)[0];
+  }
 
-    for (int mom_num=0; mom_num < num_mom; ++mom_num)
-    {
-      hsum[mom_num] = zero;
-      hsum[mom_num][subset_color] = sum(phases[mom_num]*cf, sft_set[subset_color]);
-    }
+  multi1d< multi2d<DComplex> >
+  SftMom::sft(const multi1d<LatticeComplex>& cf) const
+  {
+    if (cf.size() == 0)
+      return multi1d< multi2d<DComplex> >();
 
-    return hsum ;
+    return transform(cf.slice(), cf.size(), -1);
   }
 
 #if BASE_PRECISION==32
   multi2d<DComplex>
   SftMom::sft(const LatticeComplexD& cf) const
   {
-    multi2d<DComplex> hsum(num_mom, sft_set.numSubsets()) ;
-
-    for (int mom_num=0; mom_num < num_mom; ++mom_num)
-      hsum[mom_num] = sumMulti(phases[mom_num]*cf, sft_set) ;
-
-    return hsum ;
+    return transform(&cf, 1, -1)[0];
   }
 
   multi2d<DComplex>
   SftMom::sft(const LatticeComplexD& cf, int subset_color) const
   {
-    int length = sft_set.numSubsets();
-    multi2d<DComplex> hsum(num_mom, length);
-
-    for (int mom_num=0; mom_num < num_mom; ++mom_num)
-    {
-      hsum[mom_num] = zero;
-      hsum[mom_num][subset_color] = sum(phases[mom_num]*cf, sft_set[subset_color]);
-    }
-
-    return hsum ;
+    return transform(&cf, 1, subset_color)[0];
   }
 #endif
 
@@ -8,6 +8,7 @@
 #define __sftmom_h__
 
 #include "chromabase.h"
+#include "handle.h"
 
 namespace Chroma 
 {
@@ -30,6 +31,17 @@ namespace Chroma
   //! Fourier transform phase factor support
   /*!
    * \ingroup ft
+   *
+   * No phase fields are held. The phase of a momentum is made on the
+   * first call of operator[] and then kept.
+   *
+   * sft() evaluates all the momenta on each node at once with the
+   * cheaper of two local transforms, followed by one global sum:
+   *  - a separable (row-column) DFT over the box of momentum components,
+   *    the FFT-like choice when most of the box is used (large mom2_max);
+   *  - a direct sum over sites of products of 1D phase tables,
+   *    the choice when only a few momenta are requested.
+   * Neither needs a lattice field per momentum.
    */
   class SftMom
   {
@@ -86,8 +98,13 @@ namespace Chroma
     multi1d<int> canonicalOrder(const multi1d<int>& mom) const;
 
     //! Return the phase for this particular momenta id
+    /*! Made on first use and kept */
     const LatticeComplex& operator[](int mom_num) const
-      { return phases[mom_num]; }
+      { 
+	if (phases[mom_num].operator->() == 0)
+	  makePhase(mom_num);
+	return *(phases[mom_num]);
+      }
 
     //! Return the the multiplicity for this momenta id.
     /*! Only nonzero if momentum averaging is turned on */
@@ -106,6 +123,10 @@ namespace Chroma
     //! Do a sumMulti(cf*phases,getSet()[my_subset])
     multi2d<DComplex> sft(const LatticeReal& cf, int subset_color) const;
 
+    //! Do a sumMulti(cf[i]*phases,getSet()) for all the fields in one pass
+    /*! \return  element i holds sft(cf[i]) */
+    multi1d< multi2d<DComplex> > sft(const multi1d<LatticeComplex>& cf) const;
+
 #if BASE_PRECISION==32
     multi2d<DComplex> sft(const LatticeComplexD& cf) const;
     //! Do a sum(cf*phases,getSet()[my_subset])
@@ -118,15 +139,41 @@ namespace Chroma
     void init(int mom2_max, multi1d<int> origin_offset, multi1d<int> mom_offset,
 	      bool avg_mom_=false, int j_decay=-1);
 
+    //! Phase tables and site offsets for the transforms
+    void initTransform();
+
+    //! Make the phase of one momenta id
+    void makePhase(int mom_num) const;
+
+    //! Fourier transform of nf fields on all (subset_color < 0) or one time slice
+    template<typename L>
+    multi1d< multi2d<DComplex> > transform(const L* cf, int nf, int subset_color) const;
+
     multi2d<int> mom_list;
     bool         avg_equiv_mom;
     int          decay_dir;
     int          num_mom;
     multi1d<int> origin_offset;
     multi1d<int> mom_offset;
-    multi1d<LatticeComplex> phases;
     multi1d<int> mom_degen;
     Set sft_set;
+
+    // Lazily made phases
+    mutable multi1d< Handle<LatticeComplex> > phases;
+
+    // All the momenta entering a phase, before averaging, and their id
+    multi2d<int> raw_mom;
+    multi1d<int> raw_num;
+
+    // Transforms: directions of the momentum components, the box of
+    // momentum components, 1D phase tables over the local extent
+    // (re,im pairs indexed by (p - p_min)*local extent + x) and, per
+    // site on this node, its offset in the local (t, x_0, x_1, ...) array
+    multi1d<int> ft_dir;
+    multi1d<int> p_min;
+    multi1d<int> p_len;
+    multi1d< multi1d<REAL64> > phase_tab;
+    multi1d<int> site_off;
   };
 
 }  // end namespace Chroma
@@ -0,0 +1,197 @@
+/*! \file
+ *  \brief Neighbor tables and halo exchange for site-loop kernels
+ */
+
+#include "util/gauge/site_neighbor_table.h"
+
+namespace Chroma
+{
+
+  //! Build the tables for the given hop lengths
+  SiteNeighborTable::SiteNeighborTable(const multi1d<int>& hop_lengths) :
+    lengths(hop_lengths), nsites(Layout::sitesOnNode())
+  {
+    START_CODE();
+
+    const multi1d<int>& latt_size = Layout::lattSize();
+    const multi1d<int>& sub_size  = Layout::subgridLattSize();
+    const multi1d<int>& node_size = Layout::logicalSize();
+    const multi1d<int>& node_coord = Layout::nodeCoord();
+    const int me = Layout::nodeNumber();
+
+    halo_depth = 0;
+    for(int l=0; l < lengths.size(); ++l)
+      if (lengths[l] > halo_depth)
+	halo_depth = lengths[l];
+
+    // Communicating directions and the face sizes
+    comm_dir.resize(Nd);
+    face_size.resize(Nd);
+    halo_offset.resize(2*Nd);
+    num_halo = 0;
+
+    for(int mu=0; mu < Nd; ++mu)
+    {
+      comm_dir[mu] = (node_size[mu] > 1);
+
+      if (comm_dir[mu] && sub_size[mu] < halo_depth)
+      {
+	QDPIO::cerr << __func__ << ": subgrid extent " << sub_size[mu]
+		    << " in direction " << mu << " is smaller than the halo depth "
+		    << halo_depth << std::endl;
+	QDP_abort(1);
+      }
+
+      face_size[mu] = halo_depth;
+      for(int nu=0; nu < Nd; ++nu)
+	if (nu != mu)
+	  face_size[mu] *= sub_size[nu];
+
+      for(int isign=+1; isign >= -1; isign -= 2)
+      {
+	int side = 2*mu + ((isign > 0) ? 0 : 1);
+	halo_offset[side] = num_halo;
+	if (comm_dir[mu])
+	  num_halo += face_size[mu];
+      }
+    }
+
+    // Subgrid coordinates of every site on this node
+    multi2d<int> lcoord(nsites, Nd);
+    for(int site=0; site < nsites; ++site)
+    {
+      multi1d<int> x = Layout::siteCoords(me, site);
+      for(int mu=0; mu < Nd; ++mu)
+	lcoord(site,mu) = x[mu] - node_coord[mu]*sub_size[mu];
+    }
+
+    // Faces to send. The face on side isign of the node at mu-isign
+    // is our face at the opposite end of the subgrid.
+    send_sites.resize(2*Nd);
+    for(int mu=0; mu < Nd; ++mu)
+    {
+      for(int isign=+1; isign >= -1; isign -= 2)
+      {
+	int side = 2*mu + ((isign > 0) ? 0 : 1);
+	multi1d<int>& snd = send_sites[side];
+
+	if (! comm_dir[mu])
+	{
+	  snd.resize(0);
+	  continue;
+	}
+
+	snd.resize(face_size[mu]);
+	int lo = (isign > 0) ? 0 : sub_size[mu] - halo_depth;
+
+	multi1d<int> lc(Nd);
+	for(int site=0; site < nsites; ++site)
+	{
+	  int d = lcoord(site,mu) - lo;
+	  if (d < 0 || d >= halo_depth)
+	    continue;
+
+	  for(int nu=0; nu < Nd; ++nu)
+	    lc[nu] = lcoord(site,nu);
+
+	  snd[faceIndex(lc, mu, isign)] = site;
+	}
+      }
+    }
+
+    // The neighbor tables
+    nbr.resize(numHops()*nsites);
+
+    for(int site=0; site < nsites; ++site)
+    {
+      multi1d<int> x = Layout::siteCoords(me, site);
+
+      for(int mu=0; mu < Nd; ++mu)
+      {
+	for(int isign=+1; isign >= -1; isign -= 2)
+	{
+	  for(int l=0; l < lengths.size(); ++l)
+	  {
+	    int h = hop(mu, isign, l);
+	    int lc_new = lcoord(site,mu) + isign*lengths[l];
+
+	    if (! comm_dir[mu] || (lc_new >= 0 && lc_new < sub_size[mu]))
+	    {
+	      // On this node, possibly wrapping around the lattice
+	      multi1d<int> y = x;
+	      y[mu] = (x[mu] + isign*lengths[l] + latt_size[mu]) % latt_size[mu];
+	      nbr[h*nsites + site] = Layout::linearSiteIndex(y);
+	    }
+	    else
+	    {
+	      // In the halo filled from the node at mu+isign
+	      multi1d<int> lc(Nd);
+	      for(int nu=0; nu < Nd; ++nu)
+		lc[nu] = lcoord(site,nu);
+	      lc[mu] = (lc_new + sub_size[mu]) % sub_size[mu];
+
+	      nbr[h*nsites + site] = nsites + haloOffset(mu, isign) + faceIndex(lc, mu, isign);
+	    }
+	  }
+	}
+      }
+    }
+
+    // Split each checkerboard into sites that need the halo and those that do not
+    inner_sites.resize(2);
+    face_sites.resize(2);
+
+    for(int cb=0; cb < 2; ++cb)
+    {
+      const int* tab = rb[cb].siteTable().slice();
+      int n = rb[cb].numSiteTable();
+
+      multi1d<bool> is_face(n);
+      int n_face = 0;
+      for(int j=0; j < n; ++j)
+      {
+	is_face[j] = false;
+	for(int h=0; h < numHops(); ++h)
+	  if (nbr[h*nsites + tab[j]] >= nsites)
+	    is_face[j] = true;
+
+	if (is_face[j])
+	  ++n_face;
+      }
+
+      inner_sites[cb].resize(n - n_face);
+      face_sites[cb].resize(n_face);
+
+      int i_in = 0, i_face = 0;
+      for(int j=0; j < n; ++j)
+      {
+	if (is_face[j])
+	  face_sites[cb][i_face++] = tab[j];
+	else
+	  inner_sites[cb][i_in++] = tab[j];
+      }
+    }
+
+    END_CODE();
+  }
+
+
+  //! Lexicographic position of subgrid coordinate lc in the face (mu, isign)
+  int SiteNeighborTable::faceIndex(const multi1d<int>& lc, int mu, int isign) const
+  {
+    const multi1d<int>& sub_size = Layout::subgridLattSize();
+    int lo = (isign > 0) ? 0 : sub_size[mu] - halo_depth;
+
+    int index = 0;
+    for(int nu=Nd-1; nu >= 0; --nu)
+    {
+      if (nu == mu)
+	index = index*halo_depth + (lc[nu] - lo);
+      else
+	index = index*sub_size[nu] + lc[nu];
+    }
+
+    return index;
+  }
+
+}  // end namespace Chroma
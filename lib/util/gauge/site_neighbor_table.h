@@ -0,0 +1,253 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Neighbor tables and halo exchange for site-loop kernels
+ */
+
+#ifndef __site_neighbor_table_h__
+#define __site_neighbor_table_h__
+
+#include "chromabase.h"
+#include <cstring>
+
+namespace Chroma
+{
+  //! Neighbor tables for straight hops along the lattice axes
+  /*! \ingroup gauge
+   *
+   * For every site on this node and every hop   x -> x + isign*len*mu
+   * (len taken from a list of hop lengths) the table holds an index.
+   * Indices below Layout::sitesOnNode() are sites on this node; the
+   * others point into a halo of depth max(len) filled by a SiteHaloField.
+   *
+   * The halo for direction mu and side isign is one contiguous block,
+   * ordered lexicographically in the subgrid coordinates of the face.
+   * Every node has the same subgrid, so the sending node packs its face
+   * in exactly the order the receiving node expects.
+   *
+   * The tables are built once; site kernels then gather neighbors
+   * directly instead of shifting whole lattice fields.
+   */
+  class SiteNeighborTable
+  {
+  public:
+    //! Build the tables for the given hop lengths, e.g. {1,3} for asqtad
+    SiteNeighborTable(const multi1d<int>& hop_lengths);
+
+    //! Number of hop lengths
+    int numLengths() const {return lengths.size();}
+
+    //! Total number of hops
+    int numHops() const {return 2*Nd*lengths.size();}
+
+    //! Index of the hop (mu, isign, length index l)
+    int hop(int mu, int isign, int l) const
+    {
+      return (2*mu + ((isign > 0) ? 0 : 1))*lengths.size() + l;
+    }
+
+    //! Neighbor index of site along hop h
+    int neighbor(int site, int h) const {return nbr[h*nsites + site];}
+
+    //! All the neighbors along hop h
+    const int* neighbors(int h) const {return &(nbr[h*nsites]);}
+
+    //! Halo depth
+    int depth() const {return halo_depth;}
+
+    //! Total number of halo sites
+    int numHalo() const {return num_halo;}
+
+    //! Does direction mu communicate
+    bool commDir(int mu) const {return comm_dir[mu];}
+
+    //! Number of sites in one face of direction mu
+    int faceSize(int mu) const {return face_size[mu];}
+
+    //! Offset of the halo block filled from the node at mu+isign
+    int haloOffset(int mu, int isign) const {return halo_offset[2*mu + ((isign > 0) ? 0 : 1)];}
+
+    //! Local sites sent to node mu-isign, where they fill its halo on side isign
+    const multi1d<int>& sendSites(int mu, int isign) const {return send_sites[2*mu + ((isign > 0) ? 0 : 1)];}
+
+    //! Sites of checkerboard cb whose neighbors are all on this node
+    const multi1d<int>& innerSites(int cb) const {return inner_sites[cb];}
+
+    //! Sites of checkerboard cb that need the halo
+    const multi1d<int>& faceSites(int cb) const {return face_sites[cb];}
+
+  private:
+    //! Lexicographic position of subgrid coordinate lc in the face (mu, isign)
+    int faceIndex(const multi1d<int>& lc, int mu, int isign) const;
+
+    multi1d<int> lengths;
+    int halo_depth;
+    int nsites;
+    int num_halo;
+    multi1d<bool> comm_dir;
+    multi1d<int>  face_size;
+    multi1d<int>  halo_offset;
+    multi1d< multi1d<int> > send_sites;
+    multi1d< multi1d<int> > inner_sites;
+    multi1d< multi1d<int> > face_sites;
+    multi1d<int>  nbr;
+  };
+
+
+  //! Halo storage and exchange for one lattice field type
+  /*! \ingroup gauge
+   *
+   * L is the lattice type, e.g. LatticeStaggeredFermion. All the faces
+   * are exchanged with a single start()/finish() pair; site kernels that
+   * do not touch the halo may run in between.
+   */
+  template<typename L>
+  class SiteHaloField
+  {
+  public:
+    typedef typename L::Subtype_t  Site_t;
+
+    //! Allocate the halo and the communication buffers
+    SiteHaloField(const SiteNeighborTable& table_);
+
+    //! Release the communication buffers
+    ~SiteHaloField();
+
+    //! Pack the faces of f and start the communications
+    void start(const L& f);
+
+    //! Wait for the communications to complete
+    void finish();
+
+    //! Neighbor site idx of field f, on node or from the halo
+    const Site_t& site(const L& f, int idx) const
+    {
+      return (idx < nsites) ? f.elem(idx) : halo[idx - nsites];
+    }
+
+  private:
+    //! Hide copies - the message handles are not shareable
+    SiteHaloField(const SiteHaloField&);
+    void operator=(const SiteHaloField&);
+
+    const SiteNeighborTable& table;
+    int nsites;
+    multi1d<Site_t> halo;
+    multi1d<Site_t> send_buf;
+
+#if defined(ARCH_PARSCALAR)
+    int nmsg;
+    multi1d<QMP_msgmem_t>    msg;
+    multi1d<QMP_msghandle_t> mh_a;
+    QMP_msghandle_t          mh;
+#endif
+  };
+
+
+  template<typename L>
+  SiteHaloField<L>::SiteHaloField(const SiteNeighborTable& table_) :
+    table(table_), nsites(Layout::sitesOnNode())
+  {
+    halo.resize(table.numHalo());
+    send_buf.resize(table.numHalo());
+
+#if defined(ARCH_PARSCALAR)
+    nmsg = 0;
+    if (table.numHalo() == 0)
+      return;
+
+    msg.resize(4*Nd);
+    mh_a.resize(4*Nd);
+
+    // The receive and send for each (mu,isign) are declared in the same
+    // order on every node, so messages between the same pair of nodes
+    // (a node grid of extent 2) cannot be mismatched.
+    for(int mu=0; mu < Nd; ++mu)
+    {
+      if (! table.commDir(mu))
+	continue;
+
+      for(int isign=+1; isign >= -1; isign -= 2)
+      {
+	int n   = table.faceSize(mu);
+	int off = table.haloOffset(mu, isign);
+
+	msg[nmsg] = QMP_declare_msgmem(&(halo[off]), n*sizeof(Site_t));
+	mh_a[nmsg] = QMP_declare_receive_relative(msg[nmsg], mu, isign, 0);
+	if (mh_a[nmsg] == (QMP_msghandle_t)NULL)
+	  QDP_error_exit("SiteHaloField: QMP_declare_receive_relative failed");
+	++nmsg;
+
+	msg[nmsg] = QMP_declare_msgmem(&(send_buf[off]), n*sizeof(Site_t));
+	mh_a[nmsg] = QMP_declare_send_relative(msg[nmsg], mu, -isign, 0);
+	if (mh_a[nmsg] == (QMP_msghandle_t)NULL)
+	  QDP_error_exit("SiteHaloField: QMP_declare_send_relative failed");
+	++nmsg;
+      }
+    }
+
+    mh = QMP_declare_multiple(mh_a.slice(), nmsg);
+    if (mh == (QMP_msghandle_t)NULL)
+      QDP_error_exit("SiteHaloField: QMP_declare_multiple failed");
+#endif
+  }
+
+
+  template<typename L>
+  SiteHaloField<L>::~SiteHaloField()
+  {
+#if defined(ARCH_PARSCALAR)
+    if (nmsg > 0)
+    {
+      QMP_free_msghandle(mh);
+      for(int i=0; i < nmsg; ++i)
+	QMP_free_msgmem(msg[i]);
+    }
+#endif
+  }
+
+
+  template<typename L>
+  void SiteHaloField<L>::start(const L& f)
+  {
+    if (table.numHalo() == 0)
+      return;
+
+    // Pack the faces in the order of the receiving halo
+    for(int mu=0; mu < Nd; ++mu)
+    {
+      if (! table.commDir(mu))
+	continue;
+
+      for(int isign=+1; isign >= -1; isign -= 2)
+      {
+	const multi1d<int>& snd = table.sendSites(mu, isign);
+	Site_t* buf = &(send_buf[table.haloOffset(mu, isign)]);
+	for(int i=0; i < snd.size(); ++i)
+	  std::memcpy(&(buf[i]), &(f.elem(snd[i])), sizeof(Site_t));
+      }
+    }
+
+#if defined(ARCH_PARSCALAR)
+    QMP_status_t err;
+    if ((err = QMP_start(mh)) != QMP_SUCCESS)
+      QDP_error_exit(QMP_error_string(err));
+#endif
+  }
+
+
+  template<typename L>
+  void SiteHaloField<L>::finish()
+  {
+#if defined(ARCH_PARSCALAR)
+    if (nmsg > 0)
+    {
+      QMP_status_t err;
+      if ((err = QMP_wait(mh)) != QMP_SUCCESS)
+	QDP_error_exit(QMP_error_string(err));
+    }
+#endif
+  }
+
+}  // end namespace Chroma
+
+#endif
@@ -17,6 +17,7 @@
 
 #include "proginfo.h"
 #include "printgeom.h"
+#include "region_profiler.h"
 
 #endif
 
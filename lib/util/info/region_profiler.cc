@@ -0,0 +1,339 @@
+/*! \file
+ *  \brief Nested region profiler
+ */
+
+#include "util/info/region_profiler.h"
+
+#include <vector>
+#include <map>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <sys/time.h>
+
+namespace Chroma
+{
+
+  namespace RegionProfilerEnv
+  {
+    // Is the profiler recording?
+    bool on = false;
+
+    //! Anonymous namespace
+    namespace
+    {
+      //! A path of nested regions
+      struct Region
+      {
+	std::string  name;
+	int          parent;
+	long         calls;
+	double       incl;      /*!< inclusive seconds on this node */
+	std::map<std::string, int>  children;
+      };
+
+      //! An open region
+      struct Frame
+      {
+	int     region;
+	double  t0;
+      };
+
+      //! A closed region for the trace
+      struct Event
+      {
+	int     region;
+	double  ts;
+	double  dur;
+      };
+
+      //! Most trace events kept per node
+      const size_t max_events = 2000000;
+
+      std::vector<Region>  regions;
+      std::vector<Frame>   stack;
+      std::vector<Event>   events;
+      std::string          trace;
+      double               t_start = 0;
+      bool                 dropped = false;
+
+      //! Wall clock in seconds
+      double now()
+      {
+	struct timeval t;
+	gettimeofday(&t, NULL);
+	return double(t.tv_sec) + 1.0e-6*double(t.tv_usec);
+      }
+
+      //! Quote a string for JSON
+      std::string jsonQuote(const std::string& s)
+      {
+	std::string r("\"");
+	for(int i=0; i < s.size(); ++i)
+	{
+	  if (s[i] == '"' || s[i] == '\\')
+	    r += '\\';
+	  r += s[i];
+	}
+	r += '"';
+	return r;
+      }
+
+      //! Full name of a region
+      std::string path(int r)
+      {
+	std::string p = regions[r].name;
+	for(int q = regions[r].parent; q > 0; q = regions[q].parent)
+	  p = regions[q].name + "/" + p;
+	return p;
+      }
+
+      //! The regions in depth first order
+      void depthFirst(int r, int depth, std::vector<int>& order, std::vector<int>& depths)
+      {
+	order.push_back(r);
+	depths.push_back(depth);
+
+	for(std::map<std::string, int>::const_iterator c = regions[r].children.begin();
+	    c != regions[r].children.end(); ++c)
+	  depthFirst(c->second, depth+1, order, depths);
+      }
+
+      //! Write the trace of this node
+      void writeTrace()
+      {
+	std::string file = trace;
+	if (Layout::numNodes() > 1)
+	{
+	  std::ostringstream os;
+	  os << trace << "." << Layout::nodeNumber();
+	  file = os.str();
+	}
+
+	std::ofstream os(file.c_str());
+	if (! os)
+	{
+	  std::cerr << "RegionProfiler: cannot open " << file << std::endl;
+	  return;
+	}
+
+	const int pid = Layout::nodeNumber();
+
+	os << std::fixed << std::setprecision(3);
+	os << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n";
+	for(int i=0; i < events.size(); ++i)
+	{
+	  const Event& e = events[i];
+	  os << "{\"name\": " << jsonQuote(regions[e.region].name)
+	     << ", \"cat\": " << jsonQuote(path(e.region))
+	     << ", \"ph\": \"X\", \"ts\": " << 1.0e6*(e.ts - t_start)
+	     << ", \"dur\": " << 1.0e6*e.dur
+	     << ", \"pid\": " << pid << ", \"tid\": 0}"
+	     << ((i+1 < events.size()) ? ",\n" : "\n");
+	}
+	os << "]}\n";
+      }
+    }
+
+
+    // Start recording
+    void enable(const std::string& trace_file)
+    {
+      if (on)
+	return;
+
+      regions.clear();
+      stack.clear();
+      events.clear();
+      trace = trace_file;
+      dropped = false;
+
+      Region root;
+      root.name   = "total";
+      root.parent = -1;
+      root.calls  = 1;
+      root.incl   = 0;
+      regions.push_back(root);
+
+      t_start = now();
+      on = true;
+    }
+
+
+    // Open a region
+    void begin(const std::string& name)
+    {
+      if (! on)
+	return;
+
+      int parent = stack.empty() ? 0 : stack.back().region;
+
+      std::map<std::string, int>::const_iterator c = regions[parent].children.find(name);
+      int r;
+      if (c == regions[parent].children.end())
+      {
+	Region n;
+	n.name   = name;
+	n.parent = parent;
+	n.calls  = 0;
+	n.incl   = 0;
+
+	r = regions.size();
+	regions.push_back(n);
+	regions[parent].children[name] = r;
+      }
+      else
+	r = c->second;
+
+      Frame f;
+      f.region = r;
+      f.t0     = now();
+      stack.push_back(f);
+    }
+
+
+    // Close the innermost region
+    void end()
+    {
+      if (! on)
+	return;
+
+      if (stack.empty())
+      {
+	QDPIO::cerr << "RegionProfilerEnv::" << __func__ << ": no open region" << std::endl;
+	QDP_abort(1);
+      }
+
+      Frame f = stack.back();
+      stack.pop_back();
+
+      double dur = now() - f.t0;
+      Region& r = regions[f.region];
+      ++r.calls;
+      r.incl += dur;
+
+      if (! trace.empty())
+      {
+	if (events.size() < max_events)
+	{
+	  Event e;
+	  e.region = f.region;
+	  e.ts     = f.t0;
+	  e.dur    = dur;
+	  events.push_back(e);
+	}
+	else
+	  dropped = true;
+      }
+    }
+
+
+    // Print the table and write the trace
+    void finish()
+    {
+      if (! on)
+	return;
+
+      // Close what is left open
+      while(! stack.empty())
+	end();
+
+      on = false;
+      regions[0].incl = now() - t_start;
+
+      const int nodes = Layout::numNodes();
+      const int me    = Layout::nodeNumber();
+      const int n     = regions.size();
+
+      // The reductions below need the same regions on all the nodes
+      double n_sum = n;
+      QDPInternal::globalSumArray(&n_sum, 1);
+      const bool same = (n_sum == double(n)*nodes);
+      if (! same)
+	QDPIO::cerr << "RegionProfiler: the nodes have different regions, showing the primary node only" << std::endl;
+
+      // Exclusive times on this node
+      std::vector<double> excl(n);
+      for(int r=0; r < n; ++r)
+	excl[r] = regions[r].incl;
+      for(int r=1; r < n; ++r)
+	excl[regions[r].parent] -= regions[r].incl;
+
+      // Average, minimum and maximum over the nodes
+      std::vector<double> incl_avg(n), excl_avg(n), incl_min(n), incl_max(n);
+      std::vector<double> node_incl(nodes);
+      for(int r=0; r < n; ++r)
+      {
+	incl_avg[r] = incl_min[r] = incl_max[r] = regions[r].incl;
+	excl_avg[r] = excl[r];
+
+	if (! same)
+	  continue;
+
+	double sums[2] = {regions[r].incl, excl[r]};
+	QDPInternal::globalSumArray(sums, 2);
+	incl_avg[r] = sums[0] / nodes;
+	excl_avg[r] = sums[1] / nodes;
+
+	for(int k=0; k < nodes; ++k)
+	  node_incl[k] = 0;
+	node_incl[me] = regions[r].incl;
+	QDPInternal::globalSumArray(&node_incl[0], nodes);
+
+	incl_min[r] = incl_max[r] = node_incl[0];
+	for(int k=1; k < nodes; ++k)
+	{
+	  if (node_incl[k] < incl_min[r]) incl_min[r] = node_incl[k];
+	  if (node_incl[k] > incl_max[r]) incl_max[r] = node_incl[k];
+	}
+      }
+
+      // The table, in tree order
+      std::vector<int> order, depths;
+      depthFirst(0, 0, order, depths);
+
+      const double total = (incl_avg[0] > 0) ? incl_avg[0] : 1;
+
+      std::ostringstream os;
+      os << std::fixed << std::setprecision(3);
+      os << "RegionProfiler: seconds, averaged over " << nodes << " nodes\n"
+	 << std::left << std::setw(48) << "region" << std::right
+	 << std::setw(10) << "calls"
+	 << std::setw(13) << "inclusive"
+	 << std::setw(13) << "exclusive"
+	 << std::setw(13) << "min"
+	 << std::setw(13) << "max"
+	 << std::setw(8)  << "%" << "\n";
+
+      for(int i=0; i < order.size(); ++i)
+      {
+	int r = order[i];
+	std::string label = std::string(2*depths[i], ' ') + regions[r].name;
+	if (label.size() > 47)
+	  label = label.substr(0, 44) + "...";
+
+	os << std::left << std::setw(48) << label << std::right
+	   << std::setw(10) << regions[r].calls
+	   << std::setw(13) << incl_avg[r]
+	   << std::setw(13) << excl_avg[r]
+	   << std::setw(13) << incl_min[r]
+	   << std::setw(13) << incl_max[r]
+	   << std::setw(8)  << std::setprecision(1) << 100*incl_avg[r]/total << std::setprecision(3)
+	   << "\n";
+      }
+
+      QDPIO::cout << os.str() << std::flush;
+
+      if (! trace.empty())
+      {
+	if (dropped)
+	  QDPIO::cerr << "RegionProfiler: more than " << max_events
+		      << " regions, the trace is truncated" << std::endl;
+
+	writeTrace();
+	QDPIO::cout << "RegionProfiler: trace written to " << trace << std::endl;
+      }
+    }
+  }
+
+}  // end namespace Chroma
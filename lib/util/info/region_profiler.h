@@ -0,0 +1,89 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Nested region profiler
+ */
+
+#ifndef __region_profiler_h__
+#define __region_profiler_h__
+
+#include "chroma_config.h"
+#include "chromabase.h"
+
+namespace Chroma
+{
+
+  //! Nested region profiler
+  /*! \ingroup info
+   *
+   * Regions are opened and closed in stack order, normally with a
+   * RegionTimer or the CHROMA_REGION macro. For every path of nested
+   * regions the profiler counts the calls and the inclusive and
+   * exclusive time. finish() prints a table of them, with the minimum
+   * and maximum over the nodes, and can write the regions as a Chrome
+   * trace-event file, one per node, for chrome://tracing or Perfetto.
+   *
+   * The profiler is turned on at run time with --chroma-profile or
+   * --chroma-trace <file>. It is compiled in only with
+   * --enable-region-profiler; otherwise CHROMA_REGION expands to
+   * nothing. The profiler is not thread safe; regions are opened on the
+   * main thread only.
+   */
+  namespace RegionProfilerEnv
+  {
+    //! Is the profiler recording?
+    extern bool on;
+
+    //! Start recording
+    /*!
+     * \param trace_file  Chrome trace file, or empty for the table only ( Read )
+     */
+    void enable(const std::string& trace_file);
+
+    //! Open a region
+    void begin(const std::string& name);
+
+    //! Close the innermost region
+    void end();
+
+    //! Print the table and write the trace
+    /*! Collective; called by Chroma::finalize() */
+    void finish();
+  }
+
+
+  //! Times a scope as a region of the profiler
+  /*! \ingroup info */
+  class RegionTimer
+  {
+  public:
+    //! Open the region
+    explicit RegionTimer(const std::string& name) : opened(RegionProfilerEnv::on)
+    {
+      if (opened)
+	RegionProfilerEnv::begin(name);
+    }
+
+    //! Close the region
+    ~RegionTimer()
+    {
+      if (opened)
+	RegionProfilerEnv::end();
+    }
+
+  private:
+    bool opened;
+  };
+
+}  // end namespace Chroma
+
+
+//! Time the rest of the enclosing scope as a region of the profiler
+#ifdef BUILD_REGION_PROFILER
+#define CHROMA_REGION_CAT2(a,b) a##b
+#define CHROMA_REGION_CAT(a,b) CHROMA_REGION_CAT2(a,b)
+#define CHROMA_REGION(name) Chroma::RegionTimer CHROMA_REGION_CAT(chroma_region_, __LINE__)(name)
+#else
+#define CHROMA_REGION(name)
+#endif
+
+#endif
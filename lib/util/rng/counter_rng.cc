@@ -0,0 +1,282 @@
+/*! \file
+ *  \brief Counter based random numbers keyed by (seed, site, stream)
+ */
+
+#include "util/rng/counter_rng.h"
+#include "util/ferm/crc48.h"
+
+namespace Chroma
+{
+
+  namespace CounterRNG
+  {
+    namespace
+    {
+      //! Philox-4x32 multipliers and Weyl key increments
+      const unsigned int philox_m0 = 0xD2511F53U;
+      const unsigned int philox_m1 = 0xCD9E8D57U;
+      const unsigned int philox_w0 = 0x9E3779B9U;
+      const unsigned int philox_w1 = 0xBB67AE85U;
+
+      const double twopi = 6.283185307179586476925286766559;
+
+      //! Uniform number in (0,1) from two words
+      inline
+      double toUniform(unsigned int a, unsigned int b)
+      {
+	return ((a >> 5)*67108864.0 + (b >> 6) + 0.5) * (1.0/9007199254740992.0);
+      }
+
+
+      //! Arguments of the site kernel
+      template<typename W>
+      struct FillArgs
+      {
+	W* base;
+	int nword;
+	const int* tab;
+	const unsigned long long* gsite;
+	Key_t key;
+	unsigned int stream;
+	Dist_t dist;
+	int N;
+      };
+
+
+      //! Fill a block of sites
+      template<typename W>
+      void fillSiteLoop(int lo, int hi, int my_id, FillArgs<W>* a)
+      {
+	const int nword = a->nword;
+
+	for(int ssite=lo; ssite < hi; ++ssite)
+	{
+	  int site = a->tab[ssite];
+	  W* x = a->base + site*nword;
+	  unsigned long long g = a->gsite[site];
+
+	  if (a->dist == DIST_ZN)
+	  {
+	    // One number per complex entry
+	    const double dtheta = twopi / a->N;
+	    const int ncomplex = nword / 2;
+
+	    for(int c=0; c < ncomplex; c += 2)
+	    {
+	      double u[2];
+	      uniform2(u[0], u[1], a->key, g, a->stream, c/2);
+
+	      for(int k=0; k < 2 && c+k < ncomplex; ++k)
+	      {
+		double theta = dtheta * floor(a->N * u[k]);
+		x[2*(c+k)]   = cos(theta);
+		x[2*(c+k)+1] = sin(theta);
+	      }
+	    }
+
+	    continue;
+	  }
+
+	  for(int w=0; w < nword; w += 2)
+	  {
+	    double u0, u1;
+	    uniform2(u0, u1, a->key, g, a->stream, w/2);
+
+	    double v0, v1;
+	    switch (a->dist)
+	    {
+	    case DIST_GAUSSIAN:
+	    {
+	      double r = sqrt(-2.0*log(u0));
+	      v0 = r*cos(twopi*u1);
+	      v1 = r*sin(twopi*u1);
+	    }
+	    break;
+
+	    case DIST_Z2:
+	      v0 = (u0 > 0.5) ? 1.0 : -1.0;
+	      v1 = (u1 > 0.5) ? 1.0 : -1.0;
+	      break;
+
+	    default:
+	      v0 = u0;
+	      v1 = u1;
+	      break;
+	    }
+
+	    x[w] = v0;
+	    if (w+1 < nword)
+	      x[w+1] = v1;
+	  }
+	}
+      }
+
+
+      //! Fill the sites of a table
+      template<typename W>
+      void fillSitesT(W* base, int nword, const int* tab, int nsites,
+		      const Key_t& key, unsigned int stream, Dist_t dist, int N)
+      {
+	if (dist == DIST_ZN && N < 1)
+	{
+	  QDPIO::cerr << __func__ << ": invalid N = " << N << std::endl;
+	  QDP_abort(1);
+	}
+
+	// Made before the threads start
+	const std::vector<unsigned long long>& gsite = globalSites();
+
+	FillArgs<W> arg = {base, nword, tab, &(gsite[0]), key, stream, dist, N};
+	dispatch_to_threads(nsites, arg, fillSiteLoop<W>);
+      }
+    }
+
+
+    // Key from a tag
+    Key_t makeKey(const std::string& tag)
+    {
+      // Two 48 bit hashes, the second of the tag behind a marker
+      CRC48::CRC48_t crc_a;
+      CRC48::initCRC48(crc_a);
+      CRC48::calcCRC48(crc_a, tag.c_str(), tag.length());
+
+      std::string tag_b = "CounterRNG:" + tag;
+      CRC48::CRC48_t crc_b;
+      CRC48::initCRC48(crc_b);
+      CRC48::calcCRC48(crc_b, tag_b.c_str(), tag_b.length());
+
+      unsigned int b[8];
+      for(int i=0; i < 6; ++i)
+	b[i] = (unsigned int)(crc_a.crc[i]) & 0xff;
+      for(int i=0; i < 2; ++i)
+	b[6+i] = (unsigned int)(crc_b.crc[i]) & 0xff;
+
+      Key_t key;
+      key.k[0] = b[0] | (b[1] << 8) | (b[2] << 16) | (b[3] << 24);
+      key.k[1] = b[4] | (b[5] << 8) | (b[6] << 16) | (b[7] << 24);
+
+      return key;
+    }
+
+
+    // Key from a QDP seed
+    Key_t makeKey(const Seed& seed)
+    {
+      XMLBufferWriter xml;
+      write(xml, "Seed", seed);
+
+      return makeKey(xml.str());
+    }
+
+
+    // Key from the global QDP seed
+    Key_t nextKey()
+    {
+      Seed seed;
+      QDP::RNG::savern(seed);
+
+      Key_t key = makeKey(seed);
+
+      // Move on, the next key is different
+      Real dummy;
+      QDP::random(dummy);
+
+      return key;
+    }
+
+
+    // Philox-4x32-10
+    void philox(unsigned int out[4], const unsigned int ctr[4], const Key_t& key)
+    {
+      unsigned int c0 = ctr[0], c1 = ctr[1], c2 = ctr[2], c3 = ctr[3];
+      unsigned int k0 = key.k[0], k1 = key.k[1];
+
+      for(int r=0; r < 10; ++r)
+      {
+	if (r > 0)
+	{
+	  k0 += philox_w0;
+	  k1 += philox_w1;
+	}
+
+	unsigned long long p0 = (unsigned long long)(philox_m0) * c0;
+	unsigned long long p1 = (unsigned long long)(philox_m1) * c2;
+
+	unsigned int hi0 = (unsigned int)(p0 >> 32), lo0 = (unsigned int)(p0);
+	unsigned int hi1 = (unsigned int)(p1 >> 32), lo1 = (unsigned int)(p1);
+
+	c0 = hi1 ^ c1 ^ k0;
+	c1 = lo1;
+	c2 = hi0 ^ c3 ^ k1;
+	c3 = lo0;
+      }
+
+      out[0] = c0;
+      out[1] = c1;
+      out[2] = c2;
+      out[3] = c3;
+    }
+
+
+    // Two uniform numbers of one block
+    void uniform2(double& u0, double& u1, const Key_t& key,
+		  unsigned long long site, unsigned int stream, unsigned int block)
+    {
+      unsigned int ctr[4];
+      ctr[0] = (unsigned int)(site);
+      ctr[1] = (unsigned int)(site >> 32);
+      ctr[2] = stream;
+      ctr[3] = block;
+
+      unsigned int out[4];
+      philox(out, ctr, key);
+
+      u0 = toUniform(out[0], out[1]);
+      u1 = toUniform(out[2], out[3]);
+    }
+
+
+    // Global lexicographic index of every site on this node
+    const std::vector<unsigned long long>& globalSites()
+    {
+      static std::vector<unsigned long long> gsite;
+
+      if (gsite.size() != Layout::sitesOnNode())
+      {
+	const multi1d<int>& latt_size = Layout::lattSize();
+	const int me = Layout::nodeNumber();
+
+	gsite.resize(Layout::sitesOnNode());
+	for(int site=0; site < gsite.size(); ++site)
+	{
+	  multi1d<int> x = Layout::siteCoords(me, site);
+
+	  unsigned long long g = 0;
+	  for(int mu=Nd-1; mu >= 0; --mu)
+	    g = g*latt_size[mu] + x[mu];
+
+	  gsite[site] = g;
+	}
+      }
+
+      return gsite;
+    }
+
+
+    // Fill the words of the sites in the table
+    void fillSites(float* base, int nword, const int* tab, int nsites,
+		   const Key_t& key, unsigned int stream, Dist_t dist, int N)
+    {
+      fillSitesT(base, nword, tab, nsites, key, stream, dist, N);
+    }
+
+
+    // Fill the words of the sites in the table
+    void fillSites(double* base, int nword, const int* tab, int nsites,
+		   const Key_t& key, unsigned int stream, Dist_t dist, int N)
+    {
+      fillSitesT(base, nword, tab, nsites, key, stream, dist, N);
+    }
+  }
+
+}  // end namespace Chroma
@@ -0,0 +1,178 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Counter based random numbers keyed by (seed, site, stream)
+ */
+
+#ifndef __counter_rng_h__
+#define __counter_rng_h__
+
+#include "chromabase.h"
+#include "chroma_config.h"
+#include <vector>
+
+namespace Chroma
+{
+
+  //! Counter based random numbers
+  /*! \ingroup util
+   *
+   * The numbers are the Philox-4x32-10 bijection of the counter
+   *
+   *   (global site index, stream, block)
+   *
+   * under a 64 bit key made from a seed. Each site is computed
+   * independently of all the others, so the fields come out the same for
+   * any node and thread decomposition, the sites are filled in parallel,
+   * and any field can be made again from (key, stream) instead of being
+   * stored. Each block gives two uniform numbers with 53 bits in (0,1).
+   *
+   * Different fields drawn with the same key must use different streams.
+   */
+  namespace CounterRNG
+  {
+    //! A key
+    struct Key_t
+    {
+      unsigned int k[2];
+    };
+
+    //! Key from a QDP seed
+    Key_t makeKey(const Seed& seed);
+
+    //! Key from a tag, e.g. the serialized parameters of a noise vector
+    Key_t makeKey(const std::string& tag);
+
+    //! Key from the global QDP seed, which is advanced by one draw
+    /*! Keeps the update algorithms reproducible from the saved seed */
+    Key_t nextKey();
+
+    //! Philox-4x32-10
+    void philox(unsigned int out[4], const unsigned int ctr[4], const Key_t& key);
+
+    //! Two uniform numbers in (0,1) of one block
+    void uniform2(double& u0, double& u1, const Key_t& key,
+		  unsigned long long site, unsigned int stream, unsigned int block);
+
+    //! Global lexicographic index of every site on this node
+    const std::vector<unsigned long long>& globalSites();
+
+    //! Distributions
+    enum Dist_t
+    {
+      DIST_UNIFORM,       /*!< every real in (0,1) */
+      DIST_GAUSSIAN,      /*!< every real normal with unit variance */
+      DIST_Z2,            /*!< every real +1 or -1 */
+      DIST_ZN             /*!< every complex a Z(N) phase */
+    };
+
+    //! Fill the words of the sites in the table
+    /*!
+     * \param base    first word of site 0 ( Modify )
+     * \param nword   words per site ( Read )
+     * \param tab     sites to fill ( Read )
+     * \param nsites  number of sites to fill ( Read )
+     */
+    void fillSites(float* base, int nword, const int* tab, int nsites,
+		   const Key_t& key, unsigned int stream, Dist_t dist, int N = 2);
+
+    //! Fill the words of the sites in the table
+    void fillSites(double* base, int nword, const int* tab, int nsites,
+		   const Key_t& key, unsigned int stream, Dist_t dist, int N = 2);
+
+    //! Fill a field on a subset
+    template<typename T>
+    inline
+    void fill(OLattice<T>& x, const Key_t& key, unsigned int stream, Dist_t dist, int N, const Subset& s)
+    {
+      typedef typename WordType<T>::Type_t W;
+
+      fillSites((W *)&(x.elem(0)), sizeof(T)/sizeof(W), s.siteTable().slice(), s.numSiteTable(),
+		key, stream, dist, N);
+    }
+
+    //! Uniform numbers in (0,1)
+    template<typename T>
+    inline
+    void random(OLattice<T>& x, const Key_t& key, unsigned int stream, const Subset& s = all)
+    {
+      fill(x, key, stream, DIST_UNIFORM, 2, s);
+    }
+
+    //! Gaussian numbers with unit variance
+    template<typename T>
+    inline
+    void gaussian(OLattice<T>& x, const Key_t& key, unsigned int stream, const Subset& s = all)
+    {
+      fill(x, key, stream, DIST_GAUSSIAN, 2, s);
+    }
+
+    //! Real and imaginary parts +1 or -1
+    template<typename T>
+    inline
+    void z2(OLattice<T>& x, const Key_t& key, unsigned int stream, const Subset& s = all)
+    {
+      fill(x, key, stream, DIST_Z2, 2, s);
+    }
+
+    //! Z(N) phases
+    template<typename T>
+    inline
+    void zN(OLattice<T>& x, int N, const Key_t& key, unsigned int stream, const Subset& s = all)
+    {
+      fill(x, key, stream, DIST_ZN, N, s);
+    }
+  }
+
+
+  //! Random lattice fields for the update algorithms
+  /*! \ingroup util
+   *
+   * With configure --enable-counter-rng the fields are counter based. The
+   * key is taken from the global seed when the object is made, and every
+   * draw uses the next stream. Otherwise, and always under QDP-JIT, they
+   * come from the QDP generator, as they always have.
+   */
+  class LatticeRandomStream
+  {
+  public:
+    //! Start drawing
+    LatticeRandomStream()
+    {
+#if defined(BUILD_COUNTER_RNG) && ! defined(QDP_IS_QDPJIT)
+      key = CounterRNG::nextKey();
+      stream = 0;
+#endif
+    }
+
+    //! Uniform numbers
+    template<typename T>
+    void random(OLattice<T>& x, const Subset& s = all)
+    {
+#if defined(BUILD_COUNTER_RNG) && ! defined(QDP_IS_QDPJIT)
+      CounterRNG::random(x, key, stream++, s);
+#else
+      QDP::random(x, s);
+#endif
+    }
+
+    //! Gaussian numbers
+    template<typename T>
+    void gaussian(OLattice<T>& x, const Subset& s = all)
+    {
+#if defined(BUILD_COUNTER_RNG) && ! defined(QDP_IS_QDPJIT)
+      CounterRNG::gaussian(x, key, stream++, s);
+#else
+      QDP::gaussian(x, s);
+#endif
+    }
+
+  private:
+#if defined(BUILD_COUNTER_RNG) && ! defined(QDP_IS_QDPJIT)
+    CounterRNG::Key_t key;
+    unsigned int stream;
+#endif
+  };
+
+}  // end namespace Chroma
+
+#endif
@@ -16,6 +16,11 @@ struct Params_t
 {
   multi1d<int>    nrow;
   std::string     inline_measurement_xml;
+
+  Real            named_obj_max_mbytes;    // memory budget of named objects per node, 0 for none
+  std::string     named_obj_scratch_dir;   // where named objects spill to
+
+  Real            disp_cache_max_mbytes;   // bound of each shared displaced vector cache per node, 0 for off
 };
 
 struct Inline_input_t
@@ -31,6 +36,23 @@ void read(XMLReader& xml, const std::string& path, Params_t& p)
   XMLReader paramtop(xml, path);
   read(paramtop, "nrow", p.nrow);
 
+  p.named_obj_max_mbytes  = 0;
+  p.named_obj_scratch_dir = ".";
+  if (paramtop.count("NamedObjectMemory") != 0)
+  {
+    XMLReader memtop(paramtop, "NamedObjectMemory");
+    read(memtop, "MaxMBytes", p.named_obj_max_mbytes);
+    if (memtop.count("ScratchDir") != 0)
+      read(memtop, "ScratchDir", p.named_obj_scratch_dir);
+  }
+
+  p.disp_cache_max_mbytes = 0;
+  if (paramtop.count("DisplacementCache") != 0)
+  {
+    XMLReader disptop(paramtop, "DisplacementCache");
+    read(disptop, "MaxMBytes", p.disp_cache_max_mbytes);
+  }
+
   XMLReader measurements_xml(paramtop, "InlineMeasurements");
   std::ostringstream inline_os;
   measurements_xml.print(inline_os);
@@ -144,6 +166,7 @@ int main(int argc, char *argv[])
   swatch.start();
   try 
   {
+    CHROMA_REGION("gauge_init");
     std::istringstream  xml_c(input.cfg.xml);
     XMLReader  cfgtop(xml_c);
     QDPIO::cout << "Gauge initialization: cfg_type = " << input.cfg.id << std::endl;
@@ -205,12 +228,49 @@ int main(int argc, char *argv[])
     multi1d < Handle< AbsInlineMeasurement > > the_measurements;
     read(MeasXML, "/InlineMeasurements", the_measurements);
 
+    // Their names, to label the profiler regions
+    multi1d<std::string> meas_names(the_measurements.size());
+    for(int m=0; m < meas_names.size(); ++m)
+    {
+      std::ostringstream path;
+      path << "/InlineMeasurements/elem[" << (m+1) << "]/Name";
+      read(MeasXML, path.str(), meas_names[m]);
+    }
+
     QDPIO::cout << "There are " << the_measurements.size() << " measurements " << std::endl;
 
     // Reset and set the default gauge field
     InlineDefaultGaugeField::reset();
     InlineDefaultGaugeField::set(u, config_xml);
 
+    // Displaced vectors shared by the measurements
+    if (toDouble(input.param.disp_cache_max_mbytes) > 0)
+    {
+      size_t max_bytes = size_t(toDouble(input.param.disp_cache_max_mbytes) * 1024 * 1024);
+      DispVectorCacheEnv::setMaxBytes(max_bytes);
+
+      QDPIO::cout << "Displaced vector cache bound = " << input.param.disp_cache_max_mbytes 
+		  << " MB/node for each of the color vector and fermion caches" << std::endl;
+    }
+
+    // Named objects over the budget spill to the scratch directory. The
+    // shared displaced vector caches count against the budget
+    if (toDouble(input.param.named_obj_max_mbytes) > 0)
+    {
+      Real max_mbytes = input.param.named_obj_max_mbytes - 2*input.param.disp_cache_max_mbytes;
+      if (toDouble(max_mbytes) <= 0)
+      {
+	QDPIO::cerr << "The displaced vector caches exceed the named object memory budget" << std::endl;
+	QDP_abort(1);
+      }
+
+      size_t max_bytes = size_t(toDouble(max_mbytes) * 1024 * 1024);
+      TheNamedObjMap::Instance().setBudget(max_bytes, input.param.named_obj_scratch_dir);
+
+      QDPIO::cout << "Named object memory budget = " << max_mbytes 
+		  << " MB/node, spilling to " << input.param.named_obj_scratch_dir << std::endl;
+    }
+
     // Measure inline observables 
     push(xml_out, "InlineObservables");
     xml_out.flush();
@@ -219,19 +279,14 @@ int main(int argc, char *argv[])
 		<<" measurements" << std::endl;
     swatch.start();
     unsigned long cur_update = 0;
-    for(int m=0; m < the_measurements.size(); m++) 
-    {
-      AbsInlineMeasurement& the_meas = *(the_measurements[m]);
-      if( cur_update % the_meas.getFrequency() == 0 ) 
-      {
-	// Caller writes elem rule
-	push(xml_out, "elem");
-	the_meas(cur_update, xml_out);
-	pop(xml_out); 
 
-	xml_out.flush();
-      }
+    // In program order
+    {
+      CHROMA_REGION("measurements");
+      InlineMeasurementRunner runner(the_measurements, meas_names);
+      runner(cur_update, xml_out);
     }
+
     swatch.stop();
 
     QDPIO::cout << "CHROMA measurements: time= " 
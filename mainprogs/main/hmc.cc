@@ -459,7 +459,10 @@ namespace Chroma
 	  swatch.start();
 
 	  // This may do a reversibility check 
-	  theHMCTrj( gauge_state, warm_up_p, do_reverse ); 
+	  {
+	    CHROMA_REGION("trajectory");
+	    theHMCTrj( gauge_state, warm_up_p, do_reverse ); 
+	  }
 	  swatch.stop(); 
 	  
 	  QDPIO::cout << "After HMC trajectory call: time= "
@@ -487,7 +490,10 @@ namespace Chroma
 	  swatch.reset(); 
 	  swatch.start();
 	  // Dont repeat the reversibility check in the repro test
-	  theHMCTrj( gauge_state, warm_up_p, false ); 
+	  {
+	    CHROMA_REGION("repro_trajectory");
+	    theHMCTrj( gauge_state, warm_up_p, false ); 
+	  }
 	  swatch.stop(); 
 	  
 	  QDPIO::cout << "After HMC repro trajectory call: time= "
@@ -532,7 +538,10 @@ namespace Chroma
 	  QDPIO::cout << "Before HMC trajectory call" << std::endl;
 	  swatch.reset();
 	  swatch.start();
-	  theHMCTrj( gauge_state, warm_up_p, do_reverse  );
+	  {
+	    CHROMA_REGION("trajectory");
+	    theHMCTrj( gauge_state, warm_up_p, do_reverse  );
+	  }
 	  swatch.stop();
 	
 	  QDPIO::cout << "After HMC trajectory call: time= "
@@ -554,6 +563,7 @@ namespace Chroma
 	//
 	QDPIO::cout << "HMC: start inline measurements" << std::endl;
 	{
+	  CHROMA_REGION("measurements");
 	  XMLBufferWriter gauge_xml;
 	  push(gauge_xml, "ChromaHMC");
 	  write(gauge_xml, "update_no", cur_update);
@@ -579,6 +589,7 @@ namespace Chroma
 
 	    // Caller writes elem rule 
 	    AbsInlineMeasurement& the_meas = *(default_measurements[m]);
+	    CHROMA_REGION("default_measurement");
 	    push(xml_out, "elem");
 	    the_meas(cur_update, xml_out);
 	    pop(xml_out);
@@ -598,6 +609,12 @@ namespace Chroma
 	      if( cur_update % the_meas.getFrequency() == 0 ) 
 	      { 
 		// Caller writes elem rule
+#ifdef BUILD_REGION_PROFILER
+		std::ostringstream region;
+		region << "inline[" << m << "]";
+		CHROMA_REGION(region.str());
+#endif
+
 		push(xml_out, "elem");
 		QDPIO::cout << "HMC: calling user measurement number = " << m << std::endl;
 		the_meas(cur_update, xml_out);
@@ -629,6 +646,7 @@ namespace Chroma
 	  swatch.start();
 
 	  // Save state
+	  CHROMA_REGION("save_state");
 	  saveState<UpdateParams>(update_params, mc_control, cur_update, gauge_state.getQ());
 
 	  swatch.stop();
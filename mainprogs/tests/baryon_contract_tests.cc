@@ -0,0 +1,220 @@
+/*! \file
+ *  \brief Batched baryon contractions against the quarkContract13 expressions
+ */
+
+#include "gtest/gtest.h"
+#include "chromabase.h"
+#include "util/ft/sftmom.h"
+#include "meas/hadron/baryon_w.h"
+#include "meas/hadron/barhqlq_w.h"
+#include "meas/hadron/barspinmat_w.h"
+#include "meas/hadron/baryon_contract_batch_w.h"
+
+using namespace Chroma;
+
+namespace
+{
+  //! The nucleon 2-pt as baryon() made it
+  LatticeComplex nucl2ptRef(const LatticePropagator& q, const SpinMatrix& T, const SpinMatrix& sp)
+  {
+    LatticePropagator di_quark = quarkContract13(q * sp, sp * q);
+    return LatticeComplex(trace(T * traceColor(q * traceSpin(di_quark)))
+			  + trace(T * traceColor(q * di_quark)));
+  }
+
+
+  //! The delta 2-pt as baryon() made it
+  LatticeComplex delta2ptRef(const LatticePropagator& q, const SpinMatrix& T, const SpinMatrix& sp)
+  {
+    LatticePropagator di_quark = quarkContract13(q * sp, sp * q);
+    return LatticeComplex(trace(T * traceColor(q * traceSpin(di_quark)))
+			  + 2*trace(T * traceColor(q * di_quark)));
+  }
+
+
+  //! The 22 correlators of baryon(), in its order
+  LatticeComplex baryonRef(const LatticePropagator& q, int baryons)
+  {
+    SpinMatrix T_mixed = BaryonSpinMats::Tmixed();
+    SpinMatrix T_unpol = BaryonSpinMats::Tunpol();
+    SpinMatrix Cg5 = BaryonSpinMats::Cg5();
+    SpinMatrix Cg5g4 = BaryonSpinMats::Cg5g4();
+    SpinMatrix Cg5NR = BaryonSpinMats::Cg5NR();
+
+    switch (baryons)
+    {
+    case 0:  return nucl2ptRef(q, T_mixed, Cg5);
+    case 1:  return 3.0 * nucl2ptRef(q, T_mixed, Cg5);
+    case 2:  return 3.0 * delta2ptRef(q, T_mixed, BaryonSpinMats::Cgm());
+    case 3:  return nucl2ptRef(q, T_mixed, Cg5g4);
+    case 4:  return 3.0 * nucl2ptRef(q, T_mixed, Cg5g4);
+    case 5:  return 3.0 * delta2ptRef(q, T_mixed, BaryonSpinMats::Cg4m());
+    case 6:  return nucl2ptRef(q, T_mixed, Cg5NR);
+    case 7:  return 3.0 * nucl2ptRef(q, T_mixed, Cg5NR);
+    case 8:  return 4.0 * 3.0 * delta2ptRef(q, T_mixed, BaryonSpinMats::CgmNR());
+    case 9:  return nucl2ptRef(q, T_unpol, Cg5);
+    case 10: return nucl2ptRef(q, T_mixed, Cg5g4);
+    case 11: return nucl2ptRef(q, T_unpol, Cg5NR);
+    case 12: return 3.0 * delta2ptRef(q, T_unpol, BaryonSpinMats::Cgk(1));
+    case 13: return 3.0 * delta2ptRef(q, T_unpol, BaryonSpinMats::Cgk(2));
+    case 14: return 3.0 * delta2ptRef(q, T_unpol, BaryonSpinMats::Cgk(3));
+    case 15: return 3.0 * delta2ptRef(q, T_unpol, BaryonSpinMats::Cg4gk(1));
+    case 16: return 3.0 * delta2ptRef(q, T_unpol, BaryonSpinMats::Cg4gk(2));
+    case 17: return 3.0 * delta2ptRef(q, T_unpol, BaryonSpinMats::Cg4gk(3));
+    case 18: return 3.0 * delta2ptRef(q, T_unpol, BaryonSpinMats::CgkNR(1));
+    case 19: return 3.0 * delta2ptRef(q, T_unpol, BaryonSpinMats::CgkNR(2));
+    case 20: return 3.0 * delta2ptRef(q, T_unpol, BaryonSpinMats::CgkNR(3));
+    case 21: return nucl2ptRef(q, BaryonSpinMats::TmixedNegPar(), BaryonSpinMats::Cg5NRnegPar());
+    }
+
+    LatticeComplex a = zero;
+    return a;
+  }
+
+
+  //! The 17 correlators of barhqlq(), in its order
+  LatticeComplex barhqlqRef(const LatticePropagator& q1, const LatticePropagator& q2, int baryons)
+  {
+    using namespace Baryon2PtContractions;
+
+    SpinMatrix T_mixed = BaryonSpinMats::Tmixed();
+    SpinMatrix T_unpol = BaryonSpinMats::Tunpol();
+    SpinMatrix Cg5 = BaryonSpinMats::Cg5();
+    SpinMatrix Cg5g4 = BaryonSpinMats::Cg5g4();
+    SpinMatrix Cg5NR = BaryonSpinMats::Cg5NR();
+
+    switch (baryons)
+    {
+    case 0:  return sigma2pt(q1, q2, T_mixed, Cg5);
+    case 1:  return lambda2pt(q1, q2, T_mixed, Cg5);
+    case 2:  return sigmast2pt(q1, q2, T_mixed, BaryonSpinMats::Cgm());
+    case 3:  return sigma2pt(q1, q2, T_mixed, Cg5g4);
+    case 4:  return lambda2pt(q1, q2, T_mixed, Cg5g4);
+    case 5:  return sigmast2pt(q1, q2, T_mixed, BaryonSpinMats::Cg4m());
+    case 6:  return sigma2pt(q1, q2, T_mixed, Cg5NR);
+    case 7:  return lambda2pt(q1, q2, T_mixed, Cg5NR);
+    case 8:  return 4.0 * sigmast2pt(q1, q2, T_mixed, BaryonSpinMats::CgmNR());
+    case 9:  return sigma2pt(q1, q2, T_unpol, Cg5);
+    case 10: return sigma2pt(q1, q2, T_unpol, Cg5g4);
+    case 11: return sigma2pt(q1, q2, T_unpol, Cg5NR);
+    case 12: return lambdaNaive2pt(q1, q2, T_unpol, Cg5);
+    case 13: return xi2pt(q1, q2, T_unpol, Cg5);
+    case 14: return lambdaNaive2pt(q1, q2, T_unpol, Cg5);
+    case 15: return xi2pt(q1, q2, T_mixed, Cg5);
+    case 16: return sigma2pt(q1, q2, BaryonSpinMats::TmixedNegPar(), BaryonSpinMats::Cg5NRnegPar());
+    }
+
+    LatticeComplex a = zero;
+    return a;
+  }
+
+
+  //! max |a - b| over momenta and time slices, relative to max |b|
+  double relDiff(const multi3d<DComplex>& a, int p, const multi2d<DComplex>& b)
+  {
+    double dmax = 0;
+    double bmax = 0;
+    for(int m=0; m < b.size2(); ++m)
+      for(int t=0; t < b.size1(); ++t)
+      {
+	dmax = std::max(dmax, toDouble(sqrt(localNorm2(a[p][m][t] - b[m][t]))));
+	bmax = std::max(bmax, toDouble(sqrt(localNorm2(b[m][t]))));
+      }
+    return dmax / bmax;
+  }
+
+
+  const double tol = 1.0e-5;
+}
+
+
+class BaryonContractTests : public ::testing::Test {
+public:
+  BaryonContractTests() : phases(2, false, Nd-1)
+  {
+    gaussian(quark_prop_1);
+    gaussian(quark_prop_2);
+  }
+
+  LatticePropagator quark_prop_1;
+  LatticePropagator quark_prop_2;
+  SftMom phases;
+};
+
+
+TEST_F(BaryonContractTests, baryonMatchesQuarkContract13)
+{
+  if (Nc != 3)
+    return;
+
+  multi3d<DComplex> barprop;
+  baryon(quark_prop_1, phases, barprop);
+  ASSERT_EQ(barprop.size3(), 22);
+
+  for(int b=0; b < barprop.size3(); ++b)
+    EXPECT_LT(relDiff(barprop, b, phases.sft(baryonRef(quark_prop_1, b))), tol) << "baryon " << b;
+}
+
+
+TEST_F(BaryonContractTests, barhqlqMatchesQuarkContract13)
+{
+  if (Nc != 3)
+    return;
+
+  multi3d<DComplex> barprop;
+  barhqlq(quark_prop_1, quark_prop_2, phases, barprop);
+  ASSERT_EQ(barprop.size3(), 17);
+
+  for(int b=0; b < barprop.size3(); ++b)
+    EXPECT_LT(relDiff(barprop, b, phases.sft(barhqlqRef(quark_prop_1, quark_prop_2, b))), tol) << "baryon " << b;
+}
+
+
+TEST_F(BaryonContractTests, sharedDiquarksMatchQuarkContract13)
+{
+  if (Nc != 3)
+    return;
+
+  // Three flavors, diquarks shared between correlators and terms
+  LatticePropagator quark_prop_3;
+  gaussian(quark_prop_3);
+
+  BaryonContractBatch bar;
+  const int f1 = bar.addFlavor(quark_prop_1);
+  const int f2 = bar.addFlavor(quark_prop_2);
+  const int f3 = bar.addFlavor(quark_prop_3);
+
+  SpinMatrix T  = BaryonSpinMats::Tmixed();
+  SpinMatrix T2 = BaryonSpinMats::Tunpol();
+  SpinMatrix sp = BaryonSpinMats::Cg5();
+  SpinMatrix sp2 = BaryonSpinMats::Cgm();
+
+  const int c0 = bar.addCorr();
+  bar.addTerm(c0, T, sp, f1, f2, f3, Real(1), Real(2));
+  bar.addTerm(c0, T2, sp, f1, f2, f1, Real(-0.5), Real(0));
+
+  const int c1 = bar.addCorr();
+  bar.addTerm(c1, T2, sp, f1, f2, f3, Real(0), Real(3));
+  bar.addTerm(c1, T, sp2, f3, f3, f2, Real(1), Real(1));
+
+  EXPECT_EQ(bar.numCorrs(), 2);
+  EXPECT_EQ(bar.numDiquarks(), 2);
+
+  multi1d<LatticeComplex> corr;
+  bar.evaluate(corr);
+  ASSERT_EQ(corr.size(), 2);
+
+  LatticePropagator d12 = quarkContract13(quark_prop_1 * sp, sp * quark_prop_2);
+  LatticePropagator d33 = quarkContract13(quark_prop_3 * sp2, sp2 * quark_prop_3);
+
+  LatticeComplex ref0 = trace(T * traceColor(quark_prop_3 * traceSpin(d12)))
+    + 2*trace(T * traceColor(quark_prop_3 * d12))
+    - 0.5*trace(T2 * traceColor(quark_prop_1 * traceSpin(d12)));
+
+  LatticeComplex ref1 = 3*trace(T2 * traceColor(quark_prop_3 * d12))
+    + trace(T * traceColor(quark_prop_2 * traceSpin(d33)))
+    + trace(T * traceColor(quark_prop_2 * d33));
+
+  EXPECT_LT(toDouble(sqrt(norm2(corr[c0] - ref0) / norm2(ref0))), tol);
+  EXPECT_LT(toDouble(sqrt(norm2(corr[c1] - ref1) / norm2(ref1))), tol);
+}
@@ -0,0 +1,174 @@
+/*! \file
+ *  \brief Micro-benchmarks of the BLAS, Fourier and contraction kernels
+ *
+ * The BLAS kernels run in single and double precision; the Fourier
+ * sum and the meson contraction in the precision of the build. The
+ * bytes are those the kernel must stream, not a measurement.
+ */
+
+#include <string>
+
+#include "chroma.h"
+#include "gtest/gtest.h"
+#include "chroma_bench_env.h"
+
+using namespace Chroma;
+
+namespace
+{
+  //! y = a*x + y
+  template<typename T>
+  struct AxpyKernel
+  {
+    AxpyKernel(T& y_, const T& x_) : y(y_), x(x_), a(1.0e-3) {}
+    void operator()() const {y += a*x;}
+
+    T& y;
+    const T& x;
+    OScalar< PScalar< PScalar< RScalar<typename WordType<T>::Type_t> > > > a;
+  };
+
+
+  //! |x|^2
+  template<typename T>
+  struct Norm2Kernel
+  {
+    Norm2Kernel(const T& x_, Double& r_) : x(x_), r(r_) {}
+    void operator()() const {r = norm2(x);}
+
+    const T& x;
+    Double& r;
+  };
+
+
+  //! <x,y>
+  template<typename T>
+  struct InnerProductKernel
+  {
+    InnerProductKernel(const T& x_, const T& y_, DComplex& r_) : x(x_), y(y_), r(r_) {}
+    void operator()() const {r = innerProduct(x, y);}
+
+    const T& x;
+    const T& y;
+    DComplex& r;
+  };
+
+
+  //! Momentum and time slice sums
+  struct SftKernel
+  {
+    SftKernel(const SftMom& phases_, const LatticeComplex& c_, multi2d<DComplex>& r_) :
+      phases(phases_), c(c_), r(r_) {}
+    void operator()() const {r = phases.sft(c);}
+
+    const SftMom& phases;
+    const LatticeComplex& c;
+    multi2d<DComplex>& r;
+  };
+
+
+  //! All the meson correlators of a propagator
+  struct MesonKernel
+  {
+    MesonKernel(const LatticePropagator& prop_, const SftMom& phases_) : prop(prop_), phases(phases_) {}
+    void operator()() const
+    {
+      XMLBufferWriter xml;
+      push(xml, "Bench");
+      mesons(prop, prop, phases, 0, xml, "Point_Point_Wilson_Mesons");
+      pop(xml);
+    }
+
+    const LatticePropagator& prop;
+    const SftMom& phases;
+  };
+}
+
+
+//! The BLAS kernels in both precisions
+template<typename T>
+class BlasBench : public ::testing::Test
+{
+public:
+  BlasBench()
+  {
+    gaussian(x);
+    gaussian(y);
+  }
+
+  //! Real words of a fermion on the whole lattice
+  static double words() {return 2*Nc*Ns*double(Layout::vol());}
+
+  //! Bytes of one word
+  static double wordSize() {return sizeof(typename WordType<T>::Type_t);}
+
+  T x;
+  T y;
+};
+
+typedef ::testing::Types<LatticeFermionF, LatticeFermionD> BlasTypes;
+TYPED_TEST_CASE(BlasBench, BlasTypes);
+
+
+TYPED_TEST(BlasBench, axpy)
+{
+  typedef typename WordType<TypeParam>::Type_t W;
+
+  runBench(AxpyKernel<TypeParam>(this->y, this->x), "axpy", "", precisionName<W>(),
+	   2*this->words(), 3*this->words()*this->wordSize());
+}
+
+
+TYPED_TEST(BlasBench, norm2)
+{
+  typedef typename WordType<TypeParam>::Type_t W;
+
+  Double r;
+  runBench(Norm2Kernel<TypeParam>(this->x, r), "norm2", "", precisionName<W>(),
+	   2*this->words(), this->words()*this->wordSize());
+}
+
+
+TYPED_TEST(BlasBench, innerProduct)
+{
+  typedef typename WordType<TypeParam>::Type_t W;
+
+  DComplex r;
+  runBench(InnerProductKernel<TypeParam>(this->x, this->y, r), "innerProduct", "", precisionName<W>(),
+	   4*this->words(), 2*this->words()*this->wordSize());
+}
+
+
+TEST(SftBench, sft)
+{
+  SftMom phases(3, false, Nd-1);
+
+  LatticeComplex c;
+  gaussian(c);
+
+  multi2d<DComplex> r;
+
+  // A complex multiply-add per site and momentum, and the phases read
+  const double sites = Layout::vol();
+  const double nmom  = phases.numMom();
+
+  runBench(SftKernel(phases, c, r), "sft", "", precisionName<REAL>(),
+	   8*nmom*sites, (1 + nmom)*2*sizeof(REAL)*sites);
+}
+
+
+TEST(MesonBench, contraction)
+{
+  SftMom phases(0, true, Nd-1);
+
+  LatticePropagator prop;
+  gaussian(prop);
+
+  // Each of the Ns*Ns gammas: a product of two propagators, its trace
+  // and the time slice sum
+  const double sites = Layout::vol();
+  const double nprop = 2*Nc*Nc*Ns*Ns;
+
+  runBench(MesonKernel(prop, phases), "meson_contraction", "", precisionName<REAL>(),
+	   Ns*Ns*(4*Nc*Ns*nprop)*sites, Ns*Ns*2*nprop*sizeof(REAL)*sites);
+}
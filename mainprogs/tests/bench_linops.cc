@@ -0,0 +1,258 @@
+/*! \file
+ *  \brief Micro-benchmarks of the fermion linear operators
+ *
+ * Each operator is made from its XML on a random gauge field and one
+ * application M psi is timed. The flops are those of nFlops(); the
+ * bytes are a nominal streaming model of the spinors, links and clover
+ * terms touched per site, not a measurement.
+ */
+
+#include <sstream>
+#include <string>
+
+#include "chroma.h"
+#include "gtest/gtest.h"
+#include "chroma_bench_env.h"
+
+using namespace Chroma;
+
+namespace
+{
+  //! An operator to time
+  struct LinOpBenchParam
+  {
+    const char* name;     /*!< the FermAct */
+    const char* xml;      /*!< the FermionAction group */
+    double words;         /*!< nominal real words moved per lattice site */
+  };
+
+  std::ostream& operator<<(std::ostream& os, const LinOpBenchParam& p)
+  {
+    return os << p.name;
+  }
+
+  // Nominal traffic per lattice site of one application of the even-odd
+  // operator. A hopping term reads 8 spinors and 8 links and writes one
+  // spinor, (8*(24+18)+24) words per output site, and there are two of
+  // them on half the sites plus the axpy. The clover term adds two packed
+  // clover applications, the DWF operator repeats the 4D one N5 times and
+  // the asqtad operator reads 16 color vectors and 16 links instead.
+  const LinOpBenchParam linop_params[] =
+  {
+    {"WILSON",
+     "<FermionAction>"
+     "  <FermAct>WILSON</FermAct>"
+     "  <Kappa>0.12</Kappa>"
+     "  <FermionBC>"
+     "    <FermBC>SIMPLE_FERMBC</FermBC>"
+     "    <boundary>1 1 1 -1</boundary>"
+     "  </FermionBC>"
+     "</FermionAction>",
+     396},
+
+    {"CLOVER",
+     "<FermionAction>"
+     "  <FermAct>CLOVER</FermAct>"
+     "  <Kappa>0.12</Kappa>"
+     "  <clovCoeff>1.0</clovCoeff>"
+     "  <FermionBC>"
+     "    <FermBC>SIMPLE_FERMBC</FermBC>"
+     "    <boundary>1 1 1 -1</boundary>"
+     "  </FermionBC>"
+     "</FermionAction>",
+     516},
+
+    {"DWF",
+     "<FermionAction>"
+     "  <FermAct>DWF</FermAct>"
+     "  <OverMass>1.8</OverMass>"
+     "  <Mass>0.05</Mass>"
+     "  <N5>8</N5>"
+     "  <FermionBC>"
+     "    <FermBC>SIMPLE_FERMBC</FermBC>"
+     "    <boundary>1 1 1 -1</boundary>"
+     "  </FermionBC>"
+     "</FermionAction>",
+     8*396},
+
+    {"ASQTAD",
+     "<FermionAction>"
+     "  <FermAct>ASQTAD</FermAct>"
+     "  <Mass>0.05</Mass>"
+     "  <u0>1.0</u0>"
+     "  <FermionBC>"
+     "    <FermBC>SIMPLE_FERMBC</FermBC>"
+     "    <boundary>1 1 1 -1</boundary>"
+     "  </FermionBC>"
+     "</FermionAction>",
+     400},
+  };
+
+
+  //! A random gauge field
+  multi1d<LatticeColorMatrix> randomGauge()
+  {
+    multi1d<LatticeColorMatrix> u(Nd);
+    for(int mu=0; mu < Nd; ++mu)
+    {
+      gaussian(u[mu]);
+      reunit(u[mu]);
+    }
+    return u;
+  }
+
+
+  //! One application of a 4D operator
+  template<typename T>
+  struct LinOpKernel
+  {
+    LinOpKernel(const LinearOperator<T>& M_, T& chi_, const T& psi_) : M(M_), chi(chi_), psi(psi_) {}
+    void operator()() const {M(chi, psi, PLUS);}
+
+    const LinearOperator<T>& M;
+    T& chi;
+    const T& psi;
+  };
+
+
+  //! One application of a 5D operator
+  template<typename T>
+  struct LinOpArrayKernel
+  {
+    LinOpArrayKernel(const LinearOperatorArray<T>& M_, multi1d<T>& chi_, const multi1d<T>& psi_) :
+      M(M_), chi(chi_), psi(psi_) {}
+    void operator()() const {M(chi, psi, PLUS);}
+
+    const LinearOperatorArray<T>& M;
+    multi1d<T>& chi;
+    const multi1d<T>& psi;
+  };
+
+
+  //! One application of the clover term on a checkerboard
+  struct CloverKernel
+  {
+    CloverKernel(const CloverTerm& A_, LatticeFermion& chi_, const LatticeFermion& psi_) :
+      A(A_), chi(chi_), psi(psi_) {}
+    void operator()() const {A.apply(chi, psi, PLUS, 0);}
+
+    const CloverTerm& A;
+    LatticeFermion& chi;
+    const LatticeFermion& psi;
+  };
+}
+
+
+class LinOpBench : public ::testing::TestWithParam<LinOpBenchParam>
+{
+public:
+  typedef multi1d<LatticeColorMatrix>  P;
+  typedef multi1d<LatticeColorMatrix>  Q;
+
+  static void SetUpTestCase()
+  {
+    WilsonTypeFermActsEnv::registerAll();
+    StaggeredTypeFermActsEnv::registerAll();
+  }
+
+  //! Nominal bytes of one application
+  double bytes() const
+  {
+    return GetParam().words * sizeof(REAL) * Layout::vol();
+  }
+};
+
+
+TEST_P(LinOpBench, apply)
+{
+  const std::string name(GetParam().name);
+  const std::string path("/FermionAction");
+  const double nodes = Layout::numNodes();
+
+  multi1d<LatticeColorMatrix> u = randomGauge();
+
+  std::istringstream is(GetParam().xml);
+  XMLReader xml(is);
+
+  if (name == "ASQTAD")
+  {
+    typedef LatticeStaggeredFermion T;
+
+    Handle< StaggeredTypeFermAct<T,P,Q> > S_f(TheStagTypeFermActFactory::Instance().createObject(name, xml, path));
+    Handle< FermState<T,P,Q> > state(S_f->createState(u));
+    Handle< LinearOperator<T> > M(S_f->linOp(state));
+
+    T psi, chi;
+    gaussian(psi);
+    chi = zero;
+
+    runBench(LinOpKernel<T>(*M, chi, psi), "linop", name, precisionName<REAL>(),
+	     M->nFlops()*nodes, bytes());
+  }
+  else if (name == "DWF")
+  {
+    typedef LatticeFermion T;
+
+    Handle< WilsonTypeFermAct5D<T,P,Q> > S_f(TheWilsonTypeFermAct5DFactory::Instance().createObject(name, xml, path));
+    Handle< FermState<T,P,Q> > state(S_f->createState(u));
+    Handle< LinearOperatorArray<T> > M(S_f->linOp(state));
+
+    multi1d<T> psi(M->size()), chi(M->size());
+    for(int s=0; s < M->size(); ++s)
+    {
+      gaussian(psi[s]);
+      chi[s] = zero;
+    }
+
+    runBench(LinOpArrayKernel<T>(*M, chi, psi), "linop", name, precisionName<REAL>(),
+	     M->nFlops()*nodes, bytes());
+  }
+  else
+  {
+    typedef LatticeFermion T;
+
+    Handle< WilsonTypeFermAct<T,P,Q> > S_f(TheWilsonTypeFermActFactory::Instance().createObject(name, xml, path));
+    Handle< FermState<T,P,Q> > state(S_f->createState(u));
+    Handle< LinearOperator<T> > M(S_f->linOp(state));
+
+    T psi, chi;
+    gaussian(psi);
+    chi = zero;
+
+    runBench(LinOpKernel<T>(*M, chi, psi), "linop", name, precisionName<REAL>(),
+	     M->nFlops()*nodes, bytes());
+  }
+}
+
+INSTANTIATE_TEST_CASE_P(Operators, LinOpBench, ::testing::ValuesIn(linop_params));
+
+
+TEST(CloverBench, apply)
+{
+  typedef LatticeFermion               T;
+  typedef multi1d<LatticeColorMatrix>  P;
+  typedef multi1d<LatticeColorMatrix>  Q;
+
+  multi1d<LatticeColorMatrix> u = randomGauge();
+
+  std::istringstream is(linop_params[1].xml);
+  XMLReader xml(is);
+  CloverFermActParams param(xml, "/FermionAction");
+
+  multi1d<int> boundary(Nd);
+  boundary = 1;
+  Handle< FermState<T,P,Q> > fs(new SimpleFermState<T,P,Q>(boundary, u));
+
+  CloverTerm A;
+  A.create(fs, param);
+
+  T psi, chi;
+  gaussian(psi);
+  chi = zero;
+
+  // Packed clover term in, spinor in and out, on half the sites
+  const double half = 0.5*Layout::vol();
+
+  runBench(CloverKernel(A, chi, psi), "clover_apply", "CLOVER", precisionName<REAL>(),
+	   A.nFlops()*half, (72+24+24)*sizeof(REAL)*half);
+}
@@ -0,0 +1,144 @@
+// -*- C++ -*-
+/*! \file
+ *  \brief Support for the micro-benchmarks: timing and the JSON report
+ *
+ * A benchmark is a gtest test that times a kernel object with
+ * timeKernel() and records the result with BenchReport::add(). The
+ * lattice size, the minimum time per kernel and the report file come
+ * from the command line, see t_benchmarks.cc.
+ */
+
+#ifndef __chroma_bench_env_h__
+#define __chroma_bench_env_h__
+
+#include <string>
+#include <vector>
+#include "chroma.h"
+#include "gtest/gtest.h"
+
+namespace Chroma
+{
+  //! Options of a benchmark run
+  struct BenchConfig
+  {
+    BenchConfig() : min_secs(1.0), json_file("bench.json") {}
+
+    multi1d<int>  nrow;        /*!< lattice size */
+    double        min_secs;    /*!< each kernel runs at least this long */
+    std::string   json_file;   /*!< the report */
+  };
+
+  //! The options of this run
+  BenchConfig& theBenchConfig();
+
+
+  //! One timed kernel
+  struct BenchResult
+  {
+    std::string  kernel;      /*!< e.g. dslash, axpy */
+    std::string  op;          /*!< e.g. WILSON, or empty */
+    std::string  precision;   /*!< single or double */
+    int          iters;       /*!< calls timed */
+    double       secs;        /*!< wall time of all the calls */
+    double       flops;       /*!< flops of one call, all nodes */
+    double       bytes;       /*!< nominal memory traffic of one call, all nodes */
+  };
+
+
+  //! All the results of a run, written as JSON by the primary node
+  class BenchReport
+  {
+  public:
+    //! Record a result and print it
+    void add(const BenchResult& r);
+
+    //! Write the report
+    void write(const std::string& file) const;
+
+  private:
+    std::vector<BenchResult> results;
+  };
+
+  //! The report of this run
+  BenchReport& theBenchReport();
+
+
+  //! Precision name of a word type
+  template<typename W> inline std::string precisionName() {return (sizeof(W) == 4) ? "single" : "double";}
+
+
+  //! Time a kernel object
+  /*!
+   * K has  void operator()() const. The number of calls doubles until
+   * they take at least BenchConfig::min_secs; one untimed call warms up.
+   *
+   * \param kernel   the kernel ( Read )
+   * \param iters    number of calls timed ( Write )
+   * \return wall time of the calls
+   */
+  template<typename K>
+  double timeKernel(const K& kernel, int& iters)
+  {
+    kernel();
+
+    double secs = 0;
+    for(iters = 1; ; iters <<= 1)
+    {
+      QDP::StopWatch swatch;
+      swatch.reset();
+      swatch.start();
+
+      for(int i=0; i < iters; ++i)
+	kernel();
+
+      swatch.stop();
+
+      // All nodes must agree when to stop, so use the average
+      secs = swatch.getTimeInSeconds();
+      QDPInternal::globalSumArray(&secs, 1);
+      secs /= Layout::numNodes();
+
+      if (secs >= theBenchConfig().min_secs || iters >= (1 << 24))
+	break;
+    }
+
+    return secs;
+  }
+
+
+  //! Time a kernel and record it
+  template<typename K>
+  void runBench(const K& kernel, const std::string& kernel_name, const std::string& op,
+		const std::string& precision, double flops, double bytes)
+  {
+    BenchResult r;
+    r.kernel    = kernel_name;
+    r.op        = op;
+    r.precision = precision;
+    r.flops     = flops;
+    r.bytes     = bytes;
+    r.secs      = timeKernel(kernel, r.iters);
+
+    theBenchReport().add(r);
+  }
+
+
+  //! Lays out the lattice and writes the report at the end
+  class BenchEnvironment : public ::testing::Environment
+  {
+  public:
+    BenchEnvironment()
+    {
+      Layout::setLattSize(theBenchConfig().nrow);
+      Layout::create();
+    }
+
+    void TearDown()
+    {
+      theBenchReport().write(theBenchConfig().json_file);
+    }
+  };
+
+}  // end namespace Chroma
+
+#endif
@@ -0,0 +1,169 @@
+/*! \file
+ *  \brief CounterRNG against the Philox known answers and a site by site fill
+ */
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "gtest/gtest.h"
+#include "chromabase.h"
+#include "util/ft/sftmom.h"
+#include "util/rng/counter_rng.h"
+
+using namespace Chroma;
+
+#ifndef QDP_IS_QDPJIT
+
+namespace
+{
+  //! A Philox-4x32-10 known answer of Random123
+  struct PhiloxKat
+  {
+    unsigned int ctr[4];
+    unsigned int key[2];
+    unsigned int out[4];
+  };
+
+  const PhiloxKat philox_kat[] = {
+    {{0x00000000U, 0x00000000U, 0x00000000U, 0x00000000U},
+     {0x00000000U, 0x00000000U},
+     {0x6627e8d5U, 0xe169c58dU, 0xbc57ac4cU, 0x9b00dbd8U}},
+    {{0xffffffffU, 0xffffffffU, 0xffffffffU, 0xffffffffU},
+     {0xffffffffU, 0xffffffffU},
+     {0x408f276dU, 0x41c83b0eU, 0xa20bc7c6U, 0x6d5451fdU}},
+    {{0x243f6a88U, 0x85a308d3U, 0x13198a2eU, 0x03707344U},
+     {0xa4093822U, 0x299f31d0U},
+     {0xd16cfe09U, 0x94fdccebU, 0x5001e420U, 0x24126ea1U}}
+  };
+
+
+  //! |a - b| / |b|
+  double relDiff(const LatticeFermion& a, const LatticeFermion& b)
+  {
+    return toDouble(sqrt(norm2(a - b) / norm2(b)));
+  }
+
+
+  const double tol = 1.0e-6;
+}
+
+
+class CounterRNGTests : public ::testing::Test {
+public:
+  CounterRNGTests() : key(CounterRNG::makeKey(std::string("CounterRNGTests"))), stream(7) {}
+
+  CounterRNG::Key_t key;
+  unsigned int stream;
+};
+
+
+TEST_F(CounterRNGTests, philoxKnownAnswers)
+{
+  for(int n=0; n < sizeof(philox_kat)/sizeof(philox_kat[0]); ++n)
+  {
+    const PhiloxKat& kat = philox_kat[n];
+
+    CounterRNG::Key_t k;
+    k.k[0] = kat.key[0];
+    k.k[1] = kat.key[1];
+
+    unsigned int out[4];
+    CounterRNG::philox(out, kat.ctr, k);
+
+    for(int i=0; i < 4; ++i)
+      EXPECT_EQ(out[i], kat.out[i]) << "kat " << n << " word " << i;
+  }
+}
+
+
+TEST_F(CounterRNGTests, uniformMatchesSiteBlocks)
+{
+  LatticeFermion x;
+  CounterRNG::random(x, key, stream);
+
+  // Every complex entry (s,c) is the block s*Nc+c of its global site
+  const multi1d<int>& latt_size = Layout::lattSize();
+  for(int site=0; site < Layout::vol(); ++site)
+  {
+    multi1d<int> coord = crtesn(site, latt_size);
+
+    unsigned long long g = 0;
+    for(int mu=Nd-1; mu >= 0; --mu)
+      g = g*latt_size[mu] + coord[mu];
+
+    Fermion f = peekSite(x, coord);
+
+    for(int s=0; s < Ns; ++s)
+      for(int c=0; c < Nc; ++c)
+      {
+	double u0, u1;
+	CounterRNG::uniform2(u0, u1, key, g, stream, s*Nc + c);
+
+	Complex z = peekColor(peekSpin(f, s), c);
+	EXPECT_NEAR(toDouble(real(z)), u0, tol) << "site " << site << " s= " << s << " c= " << c;
+	EXPECT_NEAR(toDouble(imag(z)), u1, tol) << "site " << site << " s= " << s << " c= " << c;
+      }
+  }
+}
+
+
+TEST_F(CounterRNGTests, fillIndependentOfSubsets)
+{
+  for(int d=0; d < 4; ++d)
+  {
+    CounterRNG::Dist_t dist = CounterRNG::Dist_t(d);
+
+    LatticeFermion ref;
+    CounterRNG::fill(ref, key, stream, dist, 4, all);
+
+    // The two checkerboards
+    LatticeFermion x = zero;
+    for(int cb=0; cb < rb.numSubsets(); ++cb)
+      CounterRNG::fill(x, key, stream, dist, 4, rb[cb]);
+
+    EXPECT_LT(relDiff(x, ref), tol) << "dist " << d;
+
+    // The time slices, in reverse
+    SftMom phases(0, false, Nd-1);
+    x = zero;
+    for(int t=phases.numSubsets()-1; t >= 0; --t)
+      CounterRNG::fill(x, key, stream, dist, 4, phases.getSet()[t]);
+
+    EXPECT_LT(relDiff(x, ref), tol) << "dist " << d;
+
+    // A different stream is a different field
+    LatticeFermion y;
+    CounterRNG::fill(y, key, stream+1, dist, 4, all);
+    EXPECT_GT(relDiff(y, ref), 0.1) << "dist " << d;
+  }
+}
+
+
+#ifdef _OPENMP
+TEST_F(CounterRNGTests, fillIndependentOfThreads)
+{
+  const int nthr = omp_get_max_threads();
+
+  LatticeFermion ref;
+  CounterRNG::gaussian(ref, key, stream);
+
+  for(int n=1; n <= 2*nthr; n *= 2)
+  {
+    omp_set_num_threads(n);
+
+    LatticeFermion x;
+    CounterRNG::gaussian(x, key, stream);
+    EXPECT_EQ(toDouble(norm2(x - ref)), 0.0) << "threads " << n;
+
+    x = zero;
+    CounterRNG::gaussian(x, key, stream, rb[1]);
+    CounterRNG::gaussian(x, key, stream, rb[0]);
+    EXPECT_EQ(toDouble(norm2(x - ref)), 0.0) << "threads " << n;
+  }
+
+  omp_set_num_threads(nthr);
+}
+#endif
+
+#endif
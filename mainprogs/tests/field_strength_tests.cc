@@ -0,0 +1,156 @@
+/*! \file
+ *  \brief FieldStrengthKernel and the Wilson flow against mesField
+ */
+
+#include "gtest/gtest.h"
+#include "chromabase.h"
+#include "meas/glue/mesfield.h"
+#include "meas/glue/field_strength_kernel.h"
+#include "meas/glue/wilson_flow_w.h"
+#include "util/gauge/weak_field.h"
+
+using namespace Chroma;
+
+namespace
+{
+  //! The action densities summed over the lattice, as the Wilson flow made them with mesField
+  void mesFieldAction(const multi1d<LatticeColorMatrix>& u, int jomit,
+		      Double& gspace, Double& gtime)
+  {
+    multi1d<LatticeColorMatrix> f;
+    mesField(f, u);
+
+    gspace = zero;
+    gtime  = zero;
+
+    int offset = 0;
+    for(int mu=0; mu < Nd; ++mu)
+    {
+      for(int nu=mu+1; nu < Nd; ++nu)
+      {
+	LatticeColorMatrix tmp = f[offset] * f[offset];
+	Double tr = sum(real(trace(tmp)));
+
+	if (mu == jomit || nu == jomit)
+	  gtime += tr;
+	else
+	  gspace += tr;
+
+	++offset;
+      }
+    }
+
+    gspace /= -Double(Layout::vol());
+    gtime  /= -Double(Layout::vol());
+  }
+
+
+  //! |a - b| / |b|
+  Double relDiff(const LatticeColorMatrix& a, const LatticeColorMatrix& b)
+  {
+    return sqrt(norm2(a - b) / norm2(b));
+  }
+
+
+  const double tol = 1.0e-5;
+}
+
+
+class FieldStrengthTests : public ::testing::Test {
+public:
+  FieldStrengthTests() : j_decay(Nd-1)
+  {
+    u.resize(Nd);
+    weakField(u);
+  }
+
+  multi1d<LatticeColorMatrix> u;
+  int j_decay;
+};
+
+
+TEST_F(FieldStrengthTests, cloverMatchesMesField)
+{
+  multi1d<LatticeColorMatrix> f_ref;
+  mesField(f_ref, u);
+
+  FieldStrengthKernel fs(FieldStrengthKernel::CLOVER, j_decay, false);
+  multi1d<LatticeColorMatrix> f;
+  FieldStrengthDensities_t dens;
+  fs(f, dens, u);
+
+  ASSERT_EQ(f.size(), f_ref.size());
+  for(int p=0; p < f.size(); ++p)
+    EXPECT_LT(toDouble(relDiff(f[p], f_ref[p])), tol) << "plane " << p;
+
+  // The densities from the planes of mesField
+  LatticeReal e_space = zero;
+  LatticeReal e_time  = zero;
+  int offset = 0;
+  for(int mu=0; mu < Nd; ++mu)
+  {
+    for(int nu=mu+1; nu < Nd; ++nu)
+    {
+      LatticeReal e = -real(trace(f_ref[offset] * f_ref[offset]));
+      if (mu == j_decay || nu == j_decay)
+	e_time += e;
+      else
+	e_space += e;
+
+      ++offset;
+    }
+  }
+
+  LatticeReal q = -Real(1) / (Real(twopi)*Real(twopi))
+    * real(trace(f_ref[0]*f_ref[5] - f_ref[1]*f_ref[4] + f_ref[2]*f_ref[3]));
+
+  EXPECT_LT(toDouble(sqrt(norm2(dens.e_space - e_space) / norm2(e_space))), tol);
+  EXPECT_LT(toDouble(sqrt(norm2(dens.e_time - e_time) / norm2(e_time))), tol);
+  EXPECT_LT(toDouble(sqrt(norm2(dens.q - q) / norm2(q))), tol);
+
+  // Time slice sums
+  const int lt = Layout::lattSize()[j_decay];
+  ASSERT_EQ(dens.e_space_t.size(), lt);
+  Double es = zero, et = zero, qs = zero;
+  for(int t=0; t < lt; ++t)
+  {
+    es += dens.e_space_t[t];
+    et += dens.e_time_t[t];
+    qs += dens.q_t[t];
+  }
+
+  EXPECT_NEAR(toDouble(es), toDouble(sum(e_space)), tol*toDouble(fabs(sum(e_space))));
+  EXPECT_NEAR(toDouble(et), toDouble(sum(e_time)), tol*toDouble(fabs(sum(e_time))));
+  EXPECT_NEAR(toDouble(qs), toDouble(sum(q)), tol*(1 + toDouble(sqrt(norm2(q)))));
+}
+
+
+TEST_F(FieldStrengthTests, wilsonFlowMatchesMesField)
+{
+  const int nstep = 2;
+  const Real eps = 0.01;
+
+  multi1d<LatticeColorMatrix> u_flow = u;
+
+  XMLBufferWriter xml_buf;
+  push(xml_buf, "Test");
+  wilson_flow(xml_buf, u_flow, nstep, eps, j_decay);
+  pop(xml_buf);
+
+  XMLReader xml_in(xml_buf);
+  multi1d<Real> gact4i, gactij;
+  read(xml_in, "/Test/wilson_flow_results/wflow_gact4i", gact4i);
+  read(xml_in, "/Test/wilson_flow_results/wflow_gactij", gactij);
+  ASSERT_EQ(gact4i.size(), nstep+1);
+  ASSERT_EQ(gactij.size(), nstep+1);
+
+  // Before the flow, and after the last step on the flowed field
+  Double gspace, gtime;
+  mesFieldAction(u, j_decay, gspace, gtime);
+  EXPECT_NEAR(toDouble(gactij[0]), toDouble(gspace), tol*toDouble(gspace));
+  EXPECT_NEAR(toDouble(gact4i[0]), toDouble(gtime), tol*toDouble(gtime));
+
+  mesFieldAction(u_flow, j_decay, gspace, gtime);
+  EXPECT_NEAR(toDouble(gactij[nstep]), toDouble(gspace), tol*toDouble(gspace));
+  EXPECT_NEAR(toDouble(gact4i[nstep]), toDouble(gtime), tol*toDouble(gtime));
+}
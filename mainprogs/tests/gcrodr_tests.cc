@@ -0,0 +1,154 @@
+#include "gtest/gtest.h"
+#include "chromabase.h"
+#include "util/gauge/reunit.h"
+#include "actions/ferm/fermacts/fermact_factory_w.h"
+#include "actions/ferm/invert/syssolver_gcrodr_params.h"
+#include "actions/ferm/invert/syssolver_linop_gcrodr.h"
+
+using namespace Chroma;
+
+  const std::string xml_for_gcrodr =
+    "<?xml version='1.0'?> \
+   <Params>					      \
+     <FermionAction>				      \
+        <FermAct>CLOVER</FermAct>		      \
+        <Kappa>0.115</Kappa>			      \
+        <clovCoeff>1.17</clovCoeff>		      \
+        <clovCoeffR>0.91</clovCoeffR>		      \
+        <clovCoeffT>1.07</clovCoeffT>		      \
+        <AnisoParam>				      \
+          <anisoP>true</anisoP>			      \
+          <t_dir>3</t_dir>			      \
+          <xi_0>2.464</xi_0>			      \
+          <nu>0.95</nu>				      \
+        </AnisoParam>				      \
+        <FermState>				      \
+          <Name>STOUT_FERM_STATE</Name>		      \
+          <rho>0.22</rho>			      \
+          <n_smear>2</n_smear>			      \
+          <orthog_dir>3</orthog_dir>		      \
+          <FermionBC>				      \
+            <FermBC>SIMPLE_FERMBC</FermBC>	      \
+            <boundary>1 1 1 -1</boundary>	      \
+          </FermionBC>				      \
+        </FermState>				      \
+       </FermionAction>				      \
+     <InvertParam>				      \
+     <invType>GCRODR_INVERTER</invType>	      \
+     <RsdTarget>1.0e-7</RsdTarget>		      \
+     <NKrylov>10</NKrylov>			      \
+     <NDefl>4</NDefl>				      \
+     <MaxIter>500</MaxIter>			      \
+   </InvertParam>				      \
+  </Params>";
+
+
+class GCRODRTests : public ::testing::Test {
+public:
+
+  // Type aliases should be visible to all tests
+  using T = LatticeFermion;
+  using Q = multi1d<LatticeColorMatrix>;
+  using P = multi1d<LatticeColorMatrix>;
+
+
+  GCRODRTests()
+  {
+    u.resize(Nd);
+    for(int mu=0; mu < Nd; ++mu) {
+      gaussian(u[mu]);
+      reunit(u[mu]);
+    }
+
+    std::istringstream input(xml_for_gcrodr);
+    XMLReader xml_in(input);
+
+    S_f = dynamic_cast<FermAct4D<T,P,Q>*>(TheFermionActionFactory::Instance().createObject("CLOVER",
+											   xml_in,
+											   "FermionAction")
+					  );
+    state = S_f->createState(u);
+    linop = S_f->linOp(state);
+  }
+
+  //! Solve for nrhs gaussian sources with one solver, check each residuum
+  void solveSeveral(const SysSolverGCRODRParams& p, int nrhs, multi1d<int>& n_count)
+  {
+    LinOpSysSolverGCRODR sol(linop,state,p);
+    const Subset& s = linop->subset();
+
+    n_count.resize(nrhs);
+    for(int k=0; k < nrhs; ++k) {
+      LatticeFermion rhs;
+      gaussian(rhs,s);
+
+      LatticeFermion x = zero;
+      SystemSolverResults_t res = sol(x,rhs);
+      n_count[k] = res.n_count;
+
+      // The recycled space is full after the first solve
+      EXPECT_EQ( sol.recycledDim(), p.NDefl );
+
+      LatticeFermion r = zero;
+      (*linop)(r,x,PLUS);   // r = Ax
+      r[s] -= rhs;          // r = Ax - b
+
+      Double resid_rel = sqrt( norm2(r,s)/norm2(rhs,s) );
+      EXPECT_LE( toDouble(resid_rel), toDouble(p.RsdTarget) ) << "rhs " << k;
+    }
+  }
+
+  // Virtual destructor
+  virtual
+  ~GCRODRTests() {}
+
+
+  multi1d<LatticeColorMatrix> u;
+  Handle< FermAct4D<T,P,Q> > S_f;
+  Handle< FermState<T,P,Q> > state;
+  Handle< LinearOperator<T> > linop;
+};
+
+
+TEST_F(GCRODRTests, canReadXML)
+{
+  std::istringstream input(xml_for_gcrodr);
+  XMLReader xml_in(input);
+  SysSolverGCRODRParams p( xml_in, "/Params/InvertParam" );
+  ASSERT_EQ(p.NKrylov, 10);
+  ASSERT_EQ(p.NDefl, 4);
+  ASSERT_EQ(p.MaxIter, 500);
+}
+
+TEST_F(GCRODRTests, canCreateGCRODRClassFromFactory)
+{
+  std::istringstream input(xml_for_gcrodr);
+  XMLReader xml_in(input);
+  Handle< LinOpSystemSolver<T> > solver_handle =  TheLinOpFermSystemSolverFactory::Instance().createObject( "GCRODR_INVERTER", xml_in, std::string("/Params/InvertParam"), state, linop);
+}
+
+TEST_F(GCRODRTests, severalRHSNoRecycling)
+{
+  std::istringstream input(xml_for_gcrodr);
+  XMLReader xml_in(input);
+  SysSolverGCRODRParams p( xml_in, "/Params/InvertParam" );
+  p.NDefl = 0;
+
+  multi1d<int> n_count;
+  solveSeveral(p, 3, n_count);
+}
+
+TEST_F(GCRODRTests, severalRHSRecycling)
+{
+  std::istringstream input(xml_for_gcrodr);
+  XMLReader xml_in(input);
+  SysSolverGCRODRParams p( xml_in, "/Params/InvertParam" );
+
+  multi1d<int> n_count;
+  solveSeveral(p, 4, n_count);
+
+  // The later solves start with the low modes of the earlier ones
+  for(int k=1; k < n_count.size(); ++k) {
+    EXPECT_LT( n_count[k], n_count[0] ) << "rhs " << k;
+  }
+}
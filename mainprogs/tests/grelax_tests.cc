@@ -0,0 +1,80 @@
+/*! \file
+ *  \brief GRelaxSite against grelax() called for every SU(2) subgroup
+ */
+
+#include "gtest/gtest.h"
+#include "chromabase.h"
+#include "meas/gfix/grelax.h"
+#include "meas/gfix/grelax_site.h"
+#include "util/gauge/reunit.h"
+#include "util/gauge/weak_field.h"
+
+using namespace Chroma;
+
+#ifndef QDP_IS_QDPJIT
+
+namespace
+{
+  const double tol = 1.0e-5;
+}
+
+
+//! The slice direction, checkerboard and overrelaxation
+struct GRelaxCase
+{
+  int   j_decay;
+  int   cb;
+  bool  ordo;
+};
+
+
+class GRelaxSiteTests : public ::testing::TestWithParam<GRelaxCase> {
+public:
+  GRelaxSiteTests()
+  {
+    u.resize(Nd);
+    weakField(u);
+
+    // A generic gauge transformation
+    gaussian(g);
+    reunit(g);
+  }
+
+  multi1d<LatticeColorMatrix> u;
+  LatticeColorMatrix g;
+};
+
+
+TEST_P(GRelaxSiteTests, sweepMatchesSubgroupHits)
+{
+  const GRelaxCase c = GetParam();
+  const Real orpara = 1.7;
+
+  LatticeColorMatrix g_ref = g;
+  for(int su2_index=0; su2_index < Nc*(Nc-1)/2; ++su2_index)
+    grelax(g_ref, u, c.j_decay, su2_index, c.cb, c.ordo, orpara);
+
+  LatticeColorMatrix g0 = g;
+  GRelaxSite relax(u, c.j_decay);
+  relax(g, c.cb, c.ordo, orpara);
+
+  EXPECT_LT(toDouble(sqrt(norm2(g - g_ref) / norm2(g_ref))), tol);
+
+  // The other checkerboard is untouched
+  LatticeColorMatrix diff = g - g0;
+  EXPECT_EQ(toDouble(norm2(diff, rb[1-c.cb])), 0.0);
+}
+
+
+const GRelaxCase grelax_cases[] = {
+  {Nd-1, 0, false},
+  {Nd-1, 1, false},
+  {Nd-1, 0, true},
+  {Nd-1, 1, true},
+  {Nd,   0, false},
+  {Nd,   1, true}
+};
+
+INSTANTIATE_TEST_CASE_P(GRelaxCases, GRelaxSiteTests, ::testing::ValuesIn(grelax_cases));
+
+#endif
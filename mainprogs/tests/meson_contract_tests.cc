@@ -0,0 +1,91 @@
+/*! \file
+ *  \brief Batched meson contractions against the trace of the propagators
+ */
+
+#include "gtest/gtest.h"
+#include "chromabase.h"
+#include "meas/hadron/meson_contract_batch_w.h"
+
+using namespace Chroma;
+
+namespace
+{
+  //! The correlator as mesons() made it
+  LatticeComplex mesonRef(const LatticePropagator& quark_prop_1,
+			  const LatticePropagator& quark_prop_2,
+			  int gamma_snk, int gamma_src)
+  {
+    int G5 = Ns*Ns-1;
+    LatticePropagator anti_quark_prop = Gamma(G5) * quark_prop_2 * Gamma(G5);
+
+    return trace(adj(anti_quark_prop) * (Gamma(gamma_snk) * quark_prop_1 * Gamma(gamma_src)));
+  }
+
+
+  //! |a - b| / |b|
+  double relDiff(const LatticeComplex& a, const LatticeComplex& b)
+  {
+    return toDouble(sqrt(norm2(a - b) / norm2(b)));
+  }
+
+
+  const double tol = 1.0e-5;
+}
+
+
+class MesonContractTests : public ::testing::Test {
+public:
+  MesonContractTests()
+  {
+    gaussian(quark_prop_1);
+    gaussian(quark_prop_2);
+  }
+
+  LatticePropagator quark_prop_1;
+  LatticePropagator quark_prop_2;
+};
+
+
+TEST_F(MesonContractTests, diagGammaMatchesTrace)
+{
+  multi1d<LatticeComplex> corr;
+  mesonCorrsDiagGamma(corr, quark_prop_1, quark_prop_2);
+  ASSERT_EQ(corr.size(), Ns*Ns);
+
+  for(int g=0; g < Ns*Ns; ++g)
+    EXPECT_LT(relDiff(corr[g], mesonRef(quark_prop_1, quark_prop_2, g, g)), tol) << "gamma= " << g;
+}
+
+
+TEST_F(MesonContractTests, allGammaMatchesTrace)
+{
+  multi1d<LatticeComplex> corr;
+  mesonCorrsAllGamma(corr, quark_prop_1, quark_prop_2);
+  ASSERT_EQ(corr.size(), Ns*Ns*Ns*Ns);
+
+  for(int g_snk=0; g_snk < Ns*Ns; ++g_snk)
+    for(int g_src=0; g_src < Ns*Ns; ++g_src)
+      EXPECT_LT(relDiff(corr[g_snk*Ns*Ns + g_src], mesonRef(quark_prop_1, quark_prop_2, g_snk, g_src)), tol)
+	<< "gamma_snk= " << g_snk << " gamma_src= " << g_src;
+}
+
+
+TEST_F(MesonContractTests, gammaListMatchesTrace)
+{
+  // An arbitrary list, with repeats, and the same propagator twice
+  const int snk[5] = {15, 3, 7, 0, 3};
+  const int src[5] = {15, 12, 1, 9, 3};
+  multi1d<int> gamma_snk(5), gamma_src(5);
+  for(int p=0; p < 5; ++p)
+  {
+    gamma_snk[p] = snk[p];
+    gamma_src[p] = src[p];
+  }
+
+  multi1d<LatticeComplex> corr;
+  mesonCorrs(corr, quark_prop_1, quark_prop_1, gamma_snk, gamma_src);
+  ASSERT_EQ(corr.size(), 5);
+
+  for(int p=0; p < 5; ++p)
+    EXPECT_LT(relDiff(corr[p], mesonRef(quark_prop_1, quark_prop_1, snk[p], src[p])), tol) << "pair " << p;
+}
@@ -0,0 +1,229 @@
+/*! \file
+ *  \brief SftMom transforms against the explicit sums of the phases
+ */
+
+#include <vector>
+#include <algorithm>
+
+#include "gtest/gtest.h"
+#include "chromabase.h"
+#include "util/ft/sftmom.h"
+
+using namespace Chroma;
+
+namespace
+{
+  //! The phase of a momentum id, summed over all the momenta with that id
+  LatticeComplex phaseRef(const SftMom& sft, int mom_num, int mom2_max,
+			  const multi1d<int>& origin, int j_decay, bool avg)
+  {
+    multi1d<int> dirs;
+    {
+      std::vector<int> d;
+      for(int mu=0; mu < Nd; ++mu)
+	if (mu != j_decay)
+	  d.push_back(mu);
+      dirs.resize(d.size());
+      for(int j=0; j < d.size(); ++j)
+	dirs[j] = d[j];
+    }
+
+    const int D = dirs.size();
+    const int pmax = int(sqrt(double(mom2_max)));
+    int box = 1;
+    for(int j=0; j < D; ++j)
+      box *= 2*pmax + 1;
+
+    LatticeComplex phase = zero;
+    int n = 0;
+
+    for(int idx=0; idx < box; ++idx)
+    {
+      multi1d<int> p(D);
+      int rem = idx;
+      int p2 = 0;
+      for(int j=0; j < D; ++j)
+      {
+	p[j] = rem % (2*pmax + 1) - pmax;
+	rem /= 2*pmax + 1;
+	p2 += p[j]*p[j];
+      }
+
+      if (p2 > mom2_max || sft.momToNum(p) != mom_num)
+	continue;
+
+      LatticeReal p_dot_x = zero;
+      for(int j=0; j < D; ++j)
+      {
+	const int mu = dirs[j];
+	p_dot_x += LatticeReal(Layout::latticeCoordinate(mu) - origin[mu]) * Real(twopi)
+	  * Real(p[j]) / Real(Layout::lattSize()[mu]);
+      }
+
+      phase += cmplx(cos(p_dot_x), sin(p_dot_x));
+      ++n;
+    }
+
+    if (avg)
+      phase /= Real(n);
+
+    return phase;
+  }
+
+
+  //! max |a - b| over momenta and time slices, relative to max |b|
+  double relDiff(const multi2d<DComplex>& a, const multi2d<DComplex>& b)
+  {
+    double dmax = 0;
+    double bmax = 0;
+    for(int m=0; m < b.size2(); ++m)
+      for(int t=0; t < b.size1(); ++t)
+      {
+	dmax = std::max(dmax, toDouble(sqrt(localNorm2(a[m][t] - b[m][t]))));
+	bmax = std::max(bmax, toDouble(sqrt(localNorm2(b[m][t]))));
+      }
+    return dmax / bmax;
+  }
+
+
+  const double tol = 1.0e-5;
+}
+
+
+//! The momentum cutoff, the averaging and the decay direction
+struct SftMomCase
+{
+  int   mom2_max;
+  bool  avg;
+  int   j_decay;
+};
+
+
+class SftMomTests : public ::testing::TestWithParam<SftMomCase> {
+public:
+  SftMomTests() : origin(Nd)
+  {
+    // A source away from the origin
+    for(int mu=0; mu < Nd; ++mu)
+      origin[mu] = (mu + 1) % Layout::lattSize()[mu];
+  }
+
+  multi1d<int> origin;
+};
+
+
+TEST_P(SftMomTests, sftMatchesPhaseSums)
+{
+  const SftMomCase c = GetParam();
+  SftMom sft(c.mom2_max, origin, c.avg, c.j_decay);
+
+  const int nf = 3;
+  multi1d<LatticeComplex> cf(nf);
+  for(int f=0; f < nf; ++f)
+    gaussian(cf[f]);
+
+  LatticeReal rf;
+  gaussian(rf);
+
+  multi1d< multi2d<DComplex> > batch = sft.sft(cf);
+  ASSERT_EQ(batch.size(), nf);
+
+  multi2d<DComplex> real_sft = sft.sft(rf);
+
+  const int t_slice = sft.numSubsets() / 2;
+  multi2d<DComplex> slice_sft = sft.sft(cf[0], t_slice);
+
+  multi1d< multi2d<DComplex> > ref(nf);
+  multi2d<DComplex> real_ref(sft.numMom(), sft.numSubsets());
+  for(int f=0; f < nf; ++f)
+    ref[f].resize(sft.numMom(), sft.numSubsets());
+
+  for(int m=0; m < sft.numMom(); ++m)
+  {
+    LatticeComplex phase = phaseRef(sft, m, c.mom2_max, origin, c.j_decay, c.avg);
+
+    // The phase made by the class itself
+    EXPECT_LT(toDouble(sqrt(norm2(sft[m] - phase) / norm2(phase))), tol) << "mom= " << m;
+
+    for(int f=0; f < nf; ++f)
+      ref[f][m] = sumMulti(phase*cf[f], sft.getSet());
+
+    real_ref[m] = sumMulti(phase*rf, sft.getSet());
+  }
+
+  for(int f=0; f < nf; ++f)
+  {
+    EXPECT_LT(relDiff(batch[f], ref[f]), tol) << "field " << f;
+    EXPECT_LT(relDiff(sft.sft(cf[f]), ref[f]), tol) << "field " << f;
+  }
+
+  EXPECT_LT(relDiff(real_sft, real_ref), tol);
+
+  // One time slice, the others are zero
+  for(int m=0; m < sft.numMom(); ++m)
+    for(int t=0; t < sft.numSubsets(); ++t)
+    {
+      DComplex expect = zero;
+      if (t == t_slice)
+	expect = ref[0][m][t];
+
+      EXPECT_LT(toDouble(sqrt(localNorm2(slice_sft[m][t] - expect))), tol*(1 + toDouble(sqrt(localNorm2(ref[0][m][t])))))
+	<< "mom= " << m << " t= " << t;
+    }
+}
+
+
+const SftMomCase sft_cases[] = {
+  {1, false, Nd-1},
+  {3, false, Nd-1},
+  {3, true,  Nd-1},
+  {6, true,  Nd-1},
+  {2, true,  -1}
+};
+
+INSTANTIATE_TEST_CASE_P(SftMomCases, SftMomTests, ::testing::ValuesIn(sft_cases));
+
+
+// Two momenta far apart in a large box are summed directly, not separably
+TEST(SftMomListTests, directSumMatchesPhaseSums)
+{
+  const int j_decay = Nd-1;
+  multi2d<int> moms(2, Nd-1);
+  for(int j=0; j < Nd-1; ++j)
+  {
+    moms[0][j] = -2 + (j % 2);
+    moms[1][j] = 2 - (j % 2);
+  }
+
+  SftMom sft(moms, j_decay);
+  ASSERT_EQ(sft.numMom(), 2);
+
+  multi1d<LatticeComplex> cf(2);
+  gaussian(cf[0]);
+  gaussian(cf[1]);
+
+  multi1d< multi2d<DComplex> > batch = sft.sft(cf);
+
+  for(int f=0; f < cf.size(); ++f)
+  {
+    multi2d<DComplex> ref(sft.numMom(), sft.numSubsets());
+    for(int m=0; m < sft.numMom(); ++m)
+    {
+      multi1d<int> p = sft.numToMom(m);
+      LatticeReal p_dot_x = zero;
+      for(int mu=0, j=0; mu < Nd; ++mu)
+      {
+	if (mu == j_decay)
+	  continue;
+	p_dot_x += LatticeReal(Layout::latticeCoordinate(mu)) * Real(twopi)
+	  * Real(p[j]) / Real(Layout::lattSize()[mu]);
+	++j;
+      }
+
+      ref[m] = sumMulti(cmplx(cos(p_dot_x), sin(p_dot_x))*cf[f], sft.getSet());
+    }
+
+    EXPECT_LT(relDiff(batch[f], ref), tol) << "field " << f;
+    EXPECT_LT(relDiff(sft.sft(cf[f]), ref), tol) << "field " << f;
+  }
+}
@@ -0,0 +1,151 @@
+/*! \file
+ *  \brief Jacobi and Gaussian smearing against the shift based iterations
+ */
+
+#include "gtest/gtest.h"
+#include "chromabase.h"
+#include "actions/boson/operator/klein_gord.h"
+#include "meas/smear/gaus_smear.h"
+#include "meas/smear/jacobi_smear.h"
+#include "meas/smear/fused_smear_kernel.h"
+#include "util/gauge/weak_field.h"
+
+using namespace Chroma;
+
+namespace
+{
+  //! Gaussian smearing as iterations of the Klein-Gordon operator
+  template<typename T>
+  void gausSmearRef(const multi1d<LatticeColorMatrix>& u, T& chi,
+		    const Real& width, int ItrGaus, int j_decay)
+  {
+    T psi;
+
+    Real ftmp = - (width*width) / Real(4*ItrGaus);
+    Real ftmpi = Real(1) / ftmp;
+
+    for(int n = 0; n < ItrGaus; ++n)
+    {
+      psi = chi * ftmp;
+      klein_gord(u, psi, chi, ftmpi, j_decay);
+    }
+  }
+
+
+  //! Jacobi smearing with a shift per hop
+  template<typename T>
+  void jacobiSmearRef(const multi1d<LatticeColorMatrix>& u, T& chi,
+		      const Real& kappa, int iter, int no_smear_dir)
+  {
+    T s_0 = chi;
+
+    for(int n = 0; n < iter; ++n)
+    {
+      T psi = chi;
+      T h_smear = zero;
+
+      for(int mu = 0; mu < Nd; ++mu)
+	if (mu != no_smear_dir)
+	  h_smear += u[mu]*shift(psi, FORWARD, mu) + shift(adj(u[mu])*psi, BACKWARD, mu);
+
+      chi = s_0 + kappa * h_smear;
+    }
+  }
+
+
+  //! |a - b| / |b|
+  template<typename T>
+  double relDiff(const T& a, const T& b)
+  {
+    return toDouble(sqrt(norm2(a - b) / norm2(b)));
+  }
+
+
+  const double tol = 1.0e-5;
+}
+
+
+template<typename T>
+class SmearTests : public ::testing::Test {
+public:
+  SmearTests()
+  {
+    u.resize(Nd);
+    weakField(u);
+    gaussian(chi);
+  }
+
+  void TearDown()
+  {
+    FusedSmearKernelEnv::clear();
+  }
+
+  multi1d<LatticeColorMatrix> u;
+  T chi;
+};
+
+typedef ::testing::Types<LatticeColorVector, LatticeFermion,
+			 LatticeStaggeredPropagator, LatticePropagator> SmearTypes;
+TYPED_TEST_CASE(SmearTests, SmearTypes);
+
+
+TYPED_TEST(SmearTests, gausMatchesKleinGord)
+{
+  const Real width = 2.0;
+  const int  iter = 7;
+
+  for(int j_decay = Nd-1; j_decay <= Nd; ++j_decay)
+  {
+    TypeParam ref = this->chi;
+    gausSmearRef(this->u, ref, width, iter, j_decay);
+
+    for(int depth = 0; depth <= 3; ++depth)
+    {
+      TypeParam res = this->chi;
+      gausSmear(this->u, res, width, iter, j_decay, depth);
+      EXPECT_LT(relDiff(res, ref), tol) << "j_decay= " << j_decay << " depth= " << depth;
+    }
+  }
+}
+
+
+TYPED_TEST(SmearTests, jacobiMatchesShifts)
+{
+  const Real kappa = 0.2;
+  const int  iter = 7;
+
+  for(int j_decay = Nd-1; j_decay <= Nd; ++j_decay)
+  {
+    TypeParam ref = this->chi;
+    jacobiSmearRef(this->u, ref, kappa, iter, j_decay);
+
+    for(int depth = 0; depth <= 3; ++depth)
+    {
+      TypeParam res = this->chi;
+      jacobiSmear(this->u, res, kappa, iter, j_decay, depth);
+      EXPECT_LT(relDiff(res, ref), tol) << "j_decay= " << j_decay << " depth= " << depth;
+    }
+  }
+}
+
+
+TYPED_TEST(SmearTests, keptKernelFollowsGaugeField)
+{
+  const Real kappa = 0.2;
+  const int  iter = 3;
+  const int  j_decay = Nd-1;
+
+  TypeParam res = this->chi;
+  jacobiSmear(this->u, res, kappa, iter, j_decay);
+
+  // A new gauge field must not reuse the links of the kept kernel
+  multi1d<LatticeColorMatrix> u2(Nd);
+  weakField(u2);
+
+  TypeParam ref = this->chi;
+  jacobiSmearRef(u2, ref, kappa, iter, j_decay);
+
+  res = this->chi;
+  jacobiSmear(u2, res, kappa, iter, j_decay);
+  EXPECT_LT(relDiff(res, ref), tol);
+}
@@ -0,0 +1,146 @@
+/*! \file
+ *  \brief Micro-benchmarks of the linear operators, BLAS and contraction kernels
+ *
+ * Usage:
+ *
+ *   t_benchmarks [--bench-lattice=4,4,4,8] [--bench-time=1.0]
+ *                [--bench-json=bench.json] [gtest flags] [QDP flags]
+ *
+ * e.g. --gtest_filter=LinOp* to run a subset. The report is a JSON
+ * array with one object per kernel holding the lattice, the kernel,
+ * operator and precision, the number of calls, the time, and the
+ * GFLOP/s and nominal GB/s over all the nodes.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <string>
+#include <cstring>
+#include <cstdlib>
+
+#include "chroma.h"
+
+#include "gtest/gtest.h"
+#include "chroma_gtest_env.h"
+#include "chroma_bench_env.h"
+
+using namespace Chroma;
+
+
+namespace Chroma
+{
+  // The options of this run
+  BenchConfig& theBenchConfig()
+  {
+    static BenchConfig config;
+    return config;
+  }
+
+
+  // The report of this run
+  BenchReport& theBenchReport()
+  {
+    static BenchReport report;
+    return report;
+  }
+
+
+  // Record a result and print it
+  void BenchReport::add(const BenchResult& r)
+  {
+    results.push_back(r);
+
+    double per_call = r.secs / r.iters;
+    QDPIO::cout << "BENCH: " << r.kernel << " " << r.op << " " << r.precision
+		<< "  calls= " << r.iters
+		<< "  usec/call= " << 1.0e6*per_call
+		<< "  GFLOP/s= " << 1.0e-9*r.flops/per_call
+		<< "  GB/s= " << 1.0e-9*r.bytes/per_call << std::endl;
+  }
+
+
+  // Write the report
+  void BenchReport::write(const std::string& file) const
+  {
+    if (! Layout::primaryNode())
+      return;
+
+    std::ofstream os(file.c_str());
+    if (! os)
+    {
+      std::cerr << "BenchReport: cannot open " << file << std::endl;
+      return;
+    }
+
+    const multi1d<int>& nrow = Layout::lattSize();
+
+    os << std::setprecision(6) << "[\n";
+    for(int i=0; i < results.size(); ++i)
+    {
+      const BenchResult& r = results[i];
+      double per_call = r.secs / r.iters;
+
+      os << "  {\"lattice\": [";
+      for(int mu=0; mu < nrow.size(); ++mu)
+	os << ((mu > 0) ? ", " : "") << nrow[mu];
+      os << "], \"nodes\": " << Layout::numNodes()
+	 << ", \"kernel\": \"" << r.kernel << "\""
+	 << ", \"op\": \"" << r.op << "\""
+	 << ", \"precision\": \"" << r.precision << "\""
+	 << ", \"calls\": " << r.iters
+	 << ", \"seconds\": " << r.secs
+	 << ", \"gflops\": " << 1.0e-9*r.flops/per_call
+	 << ", \"gbytes_per_sec\": " << 1.0e-9*r.bytes/per_call
+	 << "}" << ((i+1 < results.size()) ? "," : "") << "\n";
+    }
+    os << "]\n";
+
+    QDPIO::cout << "BenchReport: " << results.size() << " results written to " << file << std::endl;
+  }
+}
+
+
+//! Read and remove the benchmark options from the command line
+static void parseBenchArgs(int* argc, char** argv)
+{
+  BenchConfig& config = theBenchConfig();
+
+  config.nrow.resize(Nd);
+  config.nrow = 4;
+  config.nrow[Nd-1] = 8;
+
+  int n = 1;
+  for(int i=1; i < *argc; ++i)
+  {
+    std::string arg(argv[i]);
+
+    if (arg.compare(0, 16, "--bench-lattice=") == 0)
+    {
+      std::istringstream is(arg.substr(16));
+      std::string tok;
+      for(int mu=0; mu < Nd && std::getline(is, tok, ','); ++mu)
+	config.nrow[mu] = std::atoi(tok.c_str());
+    }
+    else if (arg.compare(0, 13, "--bench-time=") == 0)
+      config.min_secs = std::atof(arg.substr(13).c_str());
+    else if (arg.compare(0, 13, "--bench-json=") == 0)
+      config.json_file = arg.substr(13);
+    else
+      argv[n++] = argv[i];
+  }
+
+  *argc = n;
+}
+
+
+int main(int argc, char *argv[])
+{
+  parseBenchArgs(&argc, argv);
+
+  ::testing::InitGoogleTest(&argc, argv);
+  ::testing::AddGlobalTestEnvironment(new ChromaEnvironment(&argc,&argv));
+  ::testing::AddGlobalTestEnvironment(new BenchEnvironment());
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,253 @@
+/*! \file
+ *  \brief Time-like Wilson loops of wilslp and fuzwilp against direct products of shifted links
+ */
+
+#include <vector>
+#include <sstream>
+
+#include "gtest/gtest.h"
+#include "chromabase.h"
+#include "meas/glue/wilslp.h"
+#include "meas/glue/fuzwilp.h"
+#include "util/gauge/weak_field.h"
+
+using namespace Chroma;
+
+namespace
+{
+  //! A step of a path: direction and +1 or -1
+  typedef std::pair<int,int> Step;
+
+  //! f(x + d)
+  LatticeColorMatrix shiftTo(const LatticeColorMatrix& f, const multi1d<int>& d)
+  {
+    LatticeColorMatrix r = f;
+    for(int mu=0; mu < Nd; ++mu)
+    {
+      for(int i=0; i < d[mu]; ++i)
+      {
+	LatticeColorMatrix tmp = shift(r, FORWARD, mu);
+	r = tmp;
+      }
+      for(int i=0; i < -d[mu]; ++i)
+      {
+	LatticeColorMatrix tmp = shift(r, BACKWARD, mu);
+	r = tmp;
+      }
+    }
+    return r;
+  }
+
+
+  //! Product of the links along a path starting at x, one shift per link
+  LatticeColorMatrix pathRef(const multi1d<LatticeColorMatrix>& u, const std::vector<Step>& steps,
+			     multi1d<int>& end)
+  {
+    end.resize(Nd);
+    end = 0;
+
+    LatticeColorMatrix p = 1;
+    for(int i=0; i < steps.size(); ++i)
+    {
+      int mu = steps[i].first;
+      LatticeColorMatrix tmp;
+      if (steps[i].second > 0)
+      {
+	tmp = p * shiftTo(u[mu], end);
+	end[mu] += 1;
+      }
+      else
+      {
+	end[mu] -= 1;
+	tmp = p * adj(shiftTo(u[mu], end));
+      }
+      p = tmp;
+    }
+    return p;
+  }
+
+
+  //! n steps in the direction mu with sign sgn
+  std::vector<Step> straight(int mu, int sgn, int n)
+  {
+    return std::vector<Step>(n, Step(mu, sgn));
+  }
+
+
+  //! Concatenation of two paths
+  std::vector<Step> join(const std::vector<Step>& a, const std::vector<Step>& b)
+  {
+    std::vector<Step> c = a;
+    c.insert(c.end(), b.begin(), b.end());
+    return c;
+  }
+
+
+  //! sum_x Re Tr[ S(x) L(x+d) S^dag(x+t j_decay) L^dag(x) ], L the temporal line of t links
+  Double loopRef(const multi1d<LatticeColorMatrix>& u, const LatticeColorMatrix& s,
+		 const multi1d<int>& d, int j_decay, int t)
+  {
+    multi1d<int> dt;
+    LatticeColorMatrix l = pathRef(u, straight(j_decay, +1, t), dt);
+
+    LatticeColorMatrix w = s * shiftTo(l, d);
+    LatticeColorMatrix tmp = w * adj(shiftTo(s, dt));
+    w = tmp * adj(l);
+
+    return sum(real(trace(w)));
+  }
+
+
+  //! Spatial path S with its end point d
+  struct SpacePath
+  {
+    SpacePath(const multi1d<LatticeColorMatrix>& u, const std::vector<Step>& steps)
+    {
+      s = pathRef(u, steps, d);
+    }
+
+    LatticeColorMatrix s;
+    multi1d<int> d;
+  };
+
+
+  const double tol = 1.0e-5;
+}
+
+
+class WilsonLoopTests : public ::testing::Test {
+public:
+  WilsonLoopTests() : j_decay(Nd-1)
+  {
+    u.resize(Nd);
+    weakField(u);
+  }
+
+  multi1d<LatticeColorMatrix> u;
+  int j_decay;
+};
+
+
+TEST_F(WilsonLoopTests, wilslpPlanarTimeLike)
+{
+  XMLBufferWriter xml_buf;
+  push(xml_buf, "Test");
+  wilslp(u, j_decay, j_decay, 2, xml_buf, "WilsonLoops");
+  pop(xml_buf);
+
+  XMLReader xml_in(xml_buf);
+  int lengthr, lengtht;
+  read(xml_in, "/Test/wils_loop2/lengthr", lengthr);
+  read(xml_in, "/Test/wils_loop2/lengtht", lengtht);
+  ASSERT_EQ(lengthr, Layout::lattSize()[0]);
+  ASSERT_EQ(lengtht, Layout::lattSize()[j_decay] / 2);
+
+  const int nspace = Nd-1;
+  const double norm = 1.0 / double(Layout::vol()*Nc*nspace);
+
+  for(int r=0; r < lengthr; ++r)
+  {
+    std::ostringstream path;
+    path << "/Test/wils_loop2/wloop2/elem[" << r+1 << "]/loop";
+    multi1d<Double> loop;
+    read(xml_in, path.str(), loop);
+    ASSERT_EQ(loop.size(), lengtht);
+
+    for(int t=0; t < lengtht; ++t)
+    {
+      Double ref = 0;
+      for(int mu=0; mu < Nd; ++mu)
+      {
+	if (mu == j_decay)
+	  continue;
+
+	SpacePath s(u, straight(mu, +1, r+1));
+	ref += loopRef(u, s.s, s.d, j_decay, t+1);
+      }
+
+      EXPECT_NEAR(toDouble(loop[t]), norm*toDouble(ref), tol) << "r= " << r << " t= " << t;
+    }
+  }
+}
+
+
+TEST_F(WilsonLoopTests, fuzwilpPlanarAndNonPlanar)
+{
+  const int tmax = 3;
+
+  XMLBufferWriter xml_buf;
+  push(xml_buf, "Test");
+  fuzwilp(u, j_decay, tmax, 0, Real(2.5), Real(1.0e-5), 100, xml_buf, "Fuzzed_Wilson_Loops");
+  pop(xml_buf);
+
+  XMLReader xml_in(xml_buf);
+  const int lengthr = Layout::lattSize()[0] / 2;
+  const int lengtht = tmax;
+
+  // Planar loops
+  const double norm1 = 1.0 / double(Layout::vol()*Nc*(Nd-1));
+  for(int r=0; r < lengthr; ++r)
+  {
+    std::ostringstream path;
+    path << "/Test/fuz_wlp1/wloopr[" << r+1 << "]";
+    multi1d<Real> loop;
+    read(xml_in, path.str(), loop);
+    ASSERT_EQ(loop.size(), lengtht);
+
+    for(int t=0; t < lengtht; ++t)
+    {
+      Double ref = 0;
+      for(int mu=0; mu < Nd; ++mu)
+      {
+	if (mu == j_decay)
+	  continue;
+
+	SpacePath s(u, straight(mu, +1, r+1));
+	ref += loopRef(u, s.s, s.d, j_decay, t+1);
+      }
+
+      EXPECT_NEAR(toDouble(loop[t]), norm1*toDouble(ref), tol) << "r= " << r << " t= " << t;
+    }
+  }
+
+  // Non-planar loops, the two L shaped paths of each corner summed
+  const double norm2 = 1.0 / double(Layout::vol()*8*Nc*(Nd-1)*(Nd-2));
+  int n = 0;
+  for(int r=0; r < lengthr; ++r)
+  {
+    for(int s=0; s <= r; ++s, ++n)
+    {
+      std::ostringstream path;
+      path << "/Test/fuz_wlp2/wlooprs[" << n+1 << "]";
+      multi1d<Real> loop;
+      read(xml_in, path.str(), loop);
+      ASSERT_EQ(loop.size(), lengtht);
+
+      for(int t=0; t < lengtht; ++t)
+      {
+	Double ref = 0;
+	for(int mu=0; mu < Nd; ++mu)
+	{
+	  if (mu == j_decay)
+	    continue;
+
+	  for(int nu=0; nu < Nd; ++nu)
+	  {
+	    if (nu == j_decay || nu == mu)
+	      continue;
+
+	    for(int sgn=-1; sgn <= 1; sgn += 2)
+	    {
+	      SpacePath a(u, join(straight(mu, +1, r+1), straight(nu, sgn, s+1)));
+	      SpacePath b(u, join(straight(nu, sgn, s+1), straight(mu, +1, r+1)));
+	      LatticeColorMatrix corner = a.s + b.s;
+	      ref += loopRef(u, corner, a.d, j_decay, t+1);
+	    }
+	  }
+	}
+
+	EXPECT_NEAR(toDouble(loop[t]), norm2*toDouble(ref), tol) << "r= " << r << " s= " << s << " t= " << t;
+      }
+    }
+  }
+}